@@ -0,0 +1,323 @@
+"""
+DFNGen benchmark suite.
+
+Runs the cases listed in suite.txt with fixed seeds and reports, per case,
+accepted fractures/sec and attempts/sec of the fracture insertion, the time
+spent writing output, peak RSS, and a hash of the output files. Timings come
+from the --profile instrumentation of DFNGen (profile.json).
+
+Hashes cover every output file except the log files and profile.json; the
+time stamp line of DFN_output.txt is skipped. Two runs with the same hash
+generated the same network, so a performance change can be checked with
+
+    python3 benchmark/benchmark.py --save before.json        (old DFNGen)
+    python3 benchmark/benchmark.py --baseline before.json    (new DFNGen)
+
+which prints the speedup per case and exits with status 1 if any network
+changed. --functions adds the time per call of instrumented functions, for
+changes to a single function, e.g.
+
+    python3 benchmark/benchmark.py --cases near_boundary --functions domainTruncation
+
+The input files in inputFiles/ were written for older versions of DFNGen.
+Keys added since then are filled in with values which keep the old behavior
+(no regions, no user polygons, etc.), and paths of user fracture files are
+pointed at inputFiles/userPolygons, before a case is run.
+"""
+
+import argparse
+import hashlib
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import threading
+import time
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+DFNGEN_DIR = os.path.dirname(SCRIPT_DIR)
+
+# Output files which change from run to run
+SKIP_FILES = {"dfngen_logfile.txt", "run.log", "profile.json", "input.inp"}
+
+
+def find_key(text, key):
+    """Position after the first whitespace separated word equal to 'key',
+    same lookup as searchVar() in readInputFunctions.cpp. None if missing."""
+    match = re.search(r"(?<!\S)" + re.escape(key) + r"(?!\S)", text)
+    return match.end() if match else None
+
+
+def get_value(text, key, default=None):
+    """First word after 'key'"""
+    pos = find_key(text, key)
+    if pos is None:
+        return default
+    return text[pos:].split()[0]
+
+
+def set_value(text, key, value):
+    """Replaces the first word after 'key' (single values only)"""
+    pos = find_key(text, key)
+    match = re.compile(r"\s*(\S+)").match(text, pos)
+    return text[:match.start(1)] + str(value) + text[match.end(1):]
+
+
+def scale_lists(text, key, count, factor):
+    """Multiplies every number of the 'count' {...} lists after 'key' by 'factor'"""
+    pos = find_key(text, key)
+    if pos is None:
+        return text
+    for _ in range(count):
+        match = re.compile(r"\{([^}]*)\}").search(text, pos)
+        values = [float(v) * factor for v in match.group(1).split(",")]
+        new = "{" + ",".join(repr(v) for v in values) + "}"
+        text = text[:match.start()] + new + text[match.end():]
+        pos = match.start() + len(new)
+    return text
+
+
+def upgrade_input(text):
+    """Adds keys which old input files are missing, with values which keep
+    the behavior those files were written for"""
+    n_ell = int(get_value(text, "nFamEll:", 0))
+    n_rect = int(get_value(text, "nFamRect:", 0))
+    defaults = [
+        ("numOfRegions:", "0"),
+        ("rFram:", "0"),
+        ("keepIsolatedFractures:", "0"),
+        ("removeFracturesLessThan:", "0"),
+        ("radiiListIncrease:", "0.1"),
+        ("orientationOption:", "0"),
+        ("polygonBoundaryFlag:", "0"),
+        # Older files have separate eAngleOption/rAngleOption
+        ("angleOption:",
+         get_value(text, "rAngleOption:", get_value(text, "eAngleOption:", "0"))),
+        ("eRegion:", "{" + ",".join(["0"] * n_ell) + "}"),
+        ("rRegion:", "{" + ",".join(["0"] * n_rect) + "}"),
+        ("userEllByCoord:", "0"),
+        ("userRecByCoord:", "0"),
+        ("userPolygonByCoord:", "0"),
+        ("insertUserRectanglesFirst:", "0"),
+        ("userOrientationOption:", "0"),
+    ]
+    # User fracture files are given relative to the DFNGen folder, or with
+    # paths of the machines the files were written on
+    text = re.sub(r"(\S+_Input_File_Path:\s+)\S*?inputFiles/(\S+)",
+                  lambda m: m.group(1) + os.path.join(DFNGEN_DIR, "inputFiles", m.group(2)), text)
+    added = [key + " " + value for key, value in defaults if find_key(text, key) is None]
+    if added:
+        text += "\n// Added by benchmark.py\n" + "\n".join(added) + "\n"
+    return text
+
+
+def scale_input(text, domain_scale, density_scale, seed):
+    """Scales the domain and fracture density, fixes the seed"""
+    for key in ("domainSize:", "domainSizeIncrease:"):
+        text = scale_lists(text, key, 1, domain_scale)
+    text = scale_lists(text, "layers:", int(get_value(text, "numOfLayers:", 0)), domain_scale)
+    text = scale_lists(text, "regions:", int(get_value(text, "numOfRegions:", 0)), domain_scale)
+    if int(get_value(text, "stopCondition:")) == 0:
+        n_poly = int(get_value(text, "nPoly:"))
+        text = set_value(text, "nPoly:", max(1, int(round(n_poly * density_scale * domain_scale**3))))
+    else:
+        n_ell = int(get_value(text, "nFamEll:", 0))
+        n_rect = int(get_value(text, "nFamRect:", 0))
+        if n_ell > 0:
+            text = scale_lists(text, "e_p32Targets:", 1, density_scale)
+        if n_rect > 0:
+            text = scale_lists(text, "r_p32Targets:", 1, density_scale)
+    return set_value(text, "seed:", seed)
+
+
+def read_suite(path):
+    cases = []
+    with open(path) as suite:
+        for line in suite:
+            line = line.split("#")[0].split()
+            if not line:
+                continue
+            name, input_file, domain_scale, density_scale, seed = line
+            cases.append({
+                "name": name,
+                "input": input_file,
+                "domainScale": float(domain_scale),
+                "densityScale": float(density_scale),
+                "seed": int(seed)
+            })
+    return cases
+
+
+def hash_output(folder, skip=()):
+    """sha256 over all output files, in path order, except the files named in 'skip'"""
+    network = hashlib.sha256()
+    for root, dirs, files in os.walk(folder):
+        dirs.sort()
+        for name in sorted(files):
+            if name in SKIP_FILES or name in skip:
+                continue
+            path = os.path.join(root, name)
+            network.update(os.path.relpath(path, folder).encode())
+            network.update(read_output(path))
+    return network.hexdigest()
+
+
+def read_output(path):
+    """Contents of an output file, without the time stamp line of DFN_output.txt"""
+    with open(path, "rb") as f:
+        data = f.read()
+    if os.path.basename(path) == "DFN_output.txt":
+        data = re.sub(rb"Time Stamp:[^\n]*\n", b"", data)
+    return data
+
+
+def prepare_case(case, folder):
+    """Creates an empty output folder with the case's input file, returns the input file path"""
+    if os.path.exists(folder):
+        shutil.rmtree(folder)
+    for sub in ("dfnGen_output/radii", "intersections", "polys", "radii"):
+        os.makedirs(os.path.join(folder, sub))
+
+    with open(os.path.join(DFNGEN_DIR, case["input"])) as f:
+        text = upgrade_input(f.read())
+    text = scale_input(text, case["domainScale"], case["densityScale"], case["seed"])
+    input_file = os.path.join(folder, "input.inp")
+    with open(input_file, "w") as f:
+        f.write(text)
+    return input_file
+
+
+def run_case(dfngen, case, output_dir, timeout):
+    """Runs one case, returns its results"""
+    folder = os.path.join(output_dir, case["name"])
+    input_file = prepare_case(case, folder)
+
+    start = time.time()
+    with open(os.path.join(folder, "run.log"), "w") as log:
+        process = subprocess.Popen([dfngen, input_file, ".", "--profile"], cwd=folder,
+                                   stdin=subprocess.DEVNULL, stdout=log, stderr=subprocess.STDOUT)
+        timer = threading.Timer(timeout, process.kill) if timeout else None
+        if timer:
+            timer.start()
+        # wait4() gives the resource usage of this run only
+        _, status, usage = os.wait4(process.pid, 0)
+        if timer:
+            timer.cancel()
+    wall = time.time() - start
+
+    result = dict(case)
+    result["exitCode"] = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -os.WTERMSIG(status)
+    result["wallSeconds"] = wall
+    # ru_maxrss is in kilobytes on Linux. Replaced by DFNGen's own number below,
+    # ru_maxrss includes the peak of this script if DFNGen was started with vfork()
+    result["peakRssMB"] = usage.ru_maxrss / 1024.0
+    if result["exitCode"] != 0:
+        return result
+
+    with open(os.path.join(folder, "dfnGen_output", "profile.json")) as f:
+        profile = json.load(f)
+    insertion = profile["phases"]["insertion"]["seconds"]
+    attempts = profile["accepted"] + profile["rejected"]
+    result["accepted"] = profile["accepted"]
+    result["attempts"] = attempts
+    result["insertionSeconds"] = insertion
+    result["acceptedPerSecond"] = profile["accepted"] / insertion if insertion > 0 else 0
+    result["attemptsPerSecond"] = attempts / insertion if insertion > 0 else 0
+    result["outputSeconds"] = profile["phases"]["output"]["seconds"]
+    result["peakRssMB"] = profile["peakRssKB"] / 1024.0
+    result["functions"] = {name: {"calls": entry["calls"], "seconds": entry["seconds"]}
+                           for name, entry in profile["generation"].items()}
+    result["hash"] = hash_output(folder)
+    return result
+
+
+def ns_per_call(result, name):
+    """Time per call of an instrumented function, None if it was not called"""
+    entry = result.get("functions", {}).get(name)
+    if not entry or entry["calls"] == 0:
+        return None
+    return entry["seconds"] * 1e9 / entry["calls"]
+
+
+def print_function(name, result, old):
+    """One line per function given with --functions, below the case"""
+    time = ns_per_call(result, name)
+    if time is None:
+        print("    %-28s not called" % name)
+        return
+    line = "    %-28s %9d calls %11.1f ns/call" % (name, result["functions"][name]["calls"], time)
+    old_time = ns_per_call(old, name) if old is not None else None
+    if old_time is not None:
+        line += "  baseline %.1f ns/call, speedup %.2fx" % (old_time, old_time / time)
+    print(line)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="DFNGen benchmark suite")
+    parser.add_argument("--dfngen", default=os.path.join(DFNGEN_DIR, "DFNGen"), help="DFNGen executable")
+    parser.add_argument("--suite", default=os.path.join(SCRIPT_DIR, "suite.txt"), help="Suite file")
+    parser.add_argument("--output", default="benchmark_output", help="Folder for the case outputs")
+    parser.add_argument("--cases", nargs="*", help="Only run these cases")
+    parser.add_argument("--timeout", type=float, help="Seconds before a case is stopped and reported as failed")
+    parser.add_argument("--repeat", type=int, default=1, help="Runs per case, the fastest run is reported")
+    parser.add_argument("--save", help="Write the results to this JSON file")
+    parser.add_argument("--baseline", help="Results of an earlier --save to compare with")
+    parser.add_argument("--functions", nargs="*", default=[],
+                        help="Also report the time per call of these instrumented functions, e.g. domainTruncation")
+    args = parser.parse_args()
+
+    dfngen = os.path.abspath(args.dfngen)
+    output_dir = os.path.abspath(args.output)
+    cases = read_suite(args.suite)
+    if args.cases:
+        cases = [case for case in cases if case["name"] in args.cases]
+    baseline = {}
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = {r["name"]: r for r in json.load(f)["cases"]}
+
+    print("%-18s %9s %11s %11s %9s %9s %9s  %-12s %s" %
+          ("case", "accepted", "accepted/s", "attempts/s", "insert s", "output s", "RSS MB", "hash", "baseline"))
+    results = []
+    changed = False
+    for case in cases:
+        runs = [run_case(dfngen, case, output_dir, args.timeout) for _ in range(args.repeat)]
+        failed = [r for r in runs if r["exitCode"] != 0]
+        if failed:
+            print("%-18s FAILED with exit code %d, see %s" %
+                  (case["name"], failed[0]["exitCode"], os.path.join(output_dir, case["name"], "run.log")))
+            results.append(failed[0])
+            changed = True
+            continue
+        if len(set(r["hash"] for r in runs)) > 1:
+            print("%-18s WARNING: repeated runs generated different networks" % case["name"])
+        result = min(runs, key=lambda r: r["insertionSeconds"])
+        result["peakRssMB"] = max(r["peakRssMB"] for r in runs)
+        results.append(result)
+
+        comparison = ""
+        old = baseline.get(case["name"])
+        if old is not None and "hash" in old:
+            if old["hash"] != result["hash"]:
+                comparison = "NETWORK CHANGED"
+                changed = True
+            else:
+                comparison = "same network, speedup %.2fx" % (old["insertionSeconds"] / result["insertionSeconds"])
+        print("%-18s %9d %11.1f %11.1f %9.2f %9.2f %9.1f  %-12s %s" %
+              (case["name"], result["accepted"], result["acceptedPerSecond"], result["attemptsPerSecond"],
+               result["insertionSeconds"], result["outputSeconds"], result["peakRssMB"], result["hash"][:12],
+               comparison))
+        for name in args.functions:
+            print_function(name, result, old)
+        sys.stdout.flush()
+
+    if args.save:
+        with open(args.save, "w") as f:
+            json.dump({"dfngen": dfngen, "cases": results}, f, indent=2)
+    return 1 if changed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,152 @@
+"""
+DFNGen equivalence checks, run with 'make check'.
+
+Checkpointing and the binary container both promise output identical to a
+plain run of the same case (see checkpoint.cpp and binaryOutput.cpp). For
+each case of suite.txt given with --cases, this script checks:
+
+    resume   A run with --checkpoint 1 is killed with SIGKILL once its first
+             checkpoint is written, then finished with --resume. Its output
+             must hash the same as the plain run.
+    binary   A run with --binary must hash the same as the plain run, apart
+             from dfn.bin and graph.bin. DFNBinaryToAscii then converts dfn.bin into a new
+             folder, and every file it writes must be byte-identical to the
+             file of the plain run.
+
+Hashes are computed as in benchmark.py (log files, profile.json and the time
+stamp of DFN_output.txt are skipped). The checkpoint interval is in seconds,
+so a case must insert fractures for more than a second. Exits with status 1
+if any check fails.
+"""
+
+import argparse
+import os
+import signal
+import subprocess
+import sys
+import time
+
+from benchmark import DFNGEN_DIR, SCRIPT_DIR, hash_output, prepare_case, read_output, read_suite
+
+# Left in the output folder by a checkpointed run
+CHECKPOINT_FILES = {"dfngen.ckpt"}
+
+# Written only by a --binary run
+BINARY_FILES = {"dfn.bin", "graph.bin"}
+
+
+def run(command, folder, timeout):
+    """Runs a command in 'folder', appends its output to run.log, returns the exit code"""
+    with open(os.path.join(folder, "run.log"), "a") as log:
+        try:
+            return subprocess.call(command, cwd=folder, stdin=subprocess.DEVNULL, stdout=log,
+                                   stderr=subprocess.STDOUT, timeout=timeout)
+        except subprocess.TimeoutExpired:
+            return -signal.SIGKILL
+
+
+def check_resume(dfngen, case, output_dir, plain_hash, timeout):
+    """Kills a checkpointed run after its first checkpoint and resumes it"""
+    folder = os.path.join(output_dir, case["name"] + "_resume")
+    input_file = prepare_case(case, folder)
+    checkpoint = os.path.join(folder, "dfngen.ckpt")
+    with open(os.path.join(folder, "run.log"), "w") as log:
+        process = subprocess.Popen([dfngen, input_file, ".", "--checkpoint", "1"], cwd=folder,
+                                   stdin=subprocess.DEVNULL, stdout=log, stderr=subprocess.STDOUT)
+        start = time.time()
+        # The checkpoint is renamed into place once complete (see writeCheckpoint())
+        while process.poll() is None and not os.path.exists(checkpoint):
+            if timeout and time.time() - start > timeout:
+                break
+            time.sleep(0.02)
+        if process.poll() is not None:
+            return "FAILED, the run ended before its first checkpoint, use a larger case"
+        process.send_signal(signal.SIGKILL)
+        process.wait()
+        if not os.path.exists(checkpoint):
+            return "FAILED, no checkpoint written within the timeout"
+
+    status = run([dfngen, input_file, ".", "--resume"], folder, timeout)
+    if status != 0:
+        return "FAILED, --resume exited with code %d, see %s" % (status, os.path.join(folder, "run.log"))
+    if hash_output(folder, CHECKPOINT_FILES) != plain_hash:
+        return "FAILED, resumed output differs from the plain run"
+    return "same"
+
+
+def check_binary(dfngen, converter, case, output_dir, plain_folder, plain_hash, timeout):
+    """Compares a --binary run and its DFNBinaryToAscii conversion with the plain run"""
+    folder = os.path.join(output_dir, case["name"] + "_binary")
+    input_file = prepare_case(case, folder)
+    status = run([dfngen, input_file, ".", "--binary"], folder, timeout)
+    if status != 0:
+        return "FAILED, --binary exited with code %d, see %s" % (status, os.path.join(folder, "run.log"))
+    if hash_output(folder, BINARY_FILES) != plain_hash:
+        return "FAILED, --binary output differs from the plain run"
+
+    ascii_folder = os.path.join(output_dir, case["name"] + "_ascii")
+    prepare_case(case, ascii_folder)
+    os.remove(os.path.join(ascii_folder, "input.inp"))
+    status = run([converter, os.path.join(folder, "dfnGen_output", "dfn.bin"), "."], ascii_folder, timeout)
+    if status != 0:
+        return "FAILED, DFNBinaryToAscii exited with code %d, see %s" % (status, os.path.join(ascii_folder, "run.log"))
+
+    compared = 0
+    for root, dirs, files in os.walk(ascii_folder):
+        for name in files:
+            if name == "run.log" or name.endswith("logfile.txt"):
+                continue
+            path = os.path.join(root, name)
+            relative = os.path.relpath(path, ascii_folder)
+            plain = os.path.join(plain_folder, relative)
+            if not os.path.exists(plain):
+                return "FAILED, DFNBinaryToAscii wrote %s, which the plain run did not" % relative
+            if read_output(path) != read_output(plain):
+                return "FAILED, %s differs from the plain run" % relative
+            compared += 1
+    return "same (%d files)" % compared
+
+
+def main():
+    parser = argparse.ArgumentParser(description="DFNGen resume and binary output equivalence checks")
+    parser.add_argument("--dfngen", default=os.path.join(DFNGEN_DIR, "DFNGen"), help="DFNGen executable")
+    parser.add_argument("--converter", default=os.path.join(DFNGEN_DIR, "DFNBinaryToAscii"),
+                        help="DFNBinaryToAscii executable")
+    parser.add_argument("--suite", default=os.path.join(SCRIPT_DIR, "suite.txt"), help="Suite file")
+    parser.add_argument("--output", default="equivalence_output", help="Folder for the case outputs")
+    parser.add_argument("--cases", nargs="*", default=["TSA3m"], help="Cases to check")
+    parser.add_argument("--timeout", type=float, default=600, help="Seconds before a run is stopped")
+    args = parser.parse_args()
+
+    dfngen = os.path.abspath(args.dfngen)
+    converter = os.path.abspath(args.converter)
+    output_dir = os.path.abspath(args.output)
+    cases = [case for case in read_suite(args.suite) if case["name"] in args.cases]
+    failed = False
+
+    for case in cases:
+        plain_folder = os.path.join(output_dir, case["name"])
+        input_file = prepare_case(case, plain_folder)
+        status = run([dfngen, input_file, "."], plain_folder, args.timeout)
+        if status != 0:
+            print("%-18s FAILED, plain run exited with code %d" % (case["name"], status))
+            failed = True
+            continue
+        plain_hash = hash_output(plain_folder)
+        results = [("resume", check_resume(dfngen, case, output_dir, plain_hash, args.timeout)),
+                   ("binary", check_binary(dfngen, converter, case, output_dir, plain_folder, plain_hash,
+                                           args.timeout))]
+        for check, result in results:
+            print("%-18s %-7s %s" % (case["name"], check, result))
+            failed = failed or result.startswith("FAILED")
+        sys.stdout.flush()
+
+    missing = set(args.cases) - set(case["name"] for case in cases)
+    if missing:
+        print("Unknown cases: " + ", ".join(sorted(missing)))
+        failed = True
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
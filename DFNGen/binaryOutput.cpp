@@ -0,0 +1,572 @@
+#include "binaryOutput.h"
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <stdint.h>
+#include <stdlib.h>
+#include "input.h"
+#include "structures.h"
+#include "readInputFunctions.h" // error check for file open checkIfOpen()
+#include "logFile.h"
+
+/*
+    Binary container layout (all values in native byte order, written on little endian machines):
+
+    Header:  char magic[8] = "DFNBIN\0\0", uint32 version, uint32 reserved
+    Chunks:  char tag[4], uint32 reserved, uint64 payload size, payload
+
+    Every chunk is columnar, i.e. one array per variable instead of one record per fracture.
+    Fracture columns hold all accepted fractures (before isolated fracture removal), so that
+    files which mark removed fractures (radii.dat, translations.dat) can be regenerated.
+
+    META  run parameters, see BinaryMeta
+    FRAC  uint64 n, int32 numberOfNodes[n], int32 familyNum[n], f64 xradius[n], f64 yradius[n],
+          f32 aspectRatio[n], f32 area[n], f64 translation[3n], f64 normal[3n], uint8 faces[6n]
+    VERT  uint64 vertexStart[n+1], f64 vertices[3 * vertexStart[n]]
+    FADJ  CSR fracture -> intersection list: uint64 start[n+1], uint32 intersection[start[n]]
+          Optional, rebuilt from INTS when missing (streaming generation, see streaming.h)
+    FINL  uint64 m, uint32 finalFractures[m]
+    INTS  uint64 k, int64 fract1[k], int64 fract2[k], f64 endpoint1[3k], f64 endpoint2[3k],
+          CSR intersection -> triple points: uint64 start[k+1], uint32 triplePoint[start[k]]
+    TRIP  uint64 t, f64 triplePoints[3t]
+*/
+
+static const char binaryMagic[8] = {'D', 'F', 'N', 'B', 'I', 'N', 0, 0};
+static const char graphMagic[8] = {'D', 'F', 'N', 'G', 'R', 'A', 'P', 'H'};
+
+/* writeChunkHeader() ************************************************************************/
+/*! Writes the tag and size of a chunk, the payload follows
+    Arg 1: Container file
+    Arg 2: Four character chunk tag
+    Arg 3: Payload size in bytes */
+void writeChunkHeader(std::ofstream &file, const char *tag, uint64_t size) {
+    uint32_t reserved = 0;
+    file.write(tag, 4);
+    file.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+}
+
+/* writeChunk() ******************************************************************************/
+/*! Writes one chunk (tag, size, payload) to the container
+    Arg 1: Container file
+    Arg 2: Four character chunk tag
+    Arg 3: Chunk payload */
+static void writeChunk(std::ofstream &file, const char *tag, std::string &chunk) {
+    writeChunkHeader(file, tag, chunk.size());
+    file.write(chunk.data(), chunk.size());
+    chunk.clear();
+}
+
+/* writeContainerHeader() ********************************************************************/
+/*! Writes the header of a binary container, the chunks follow
+    Arg 1: Container file
+    Arg 2: Eight character magic
+    Arg 3: Format version */
+void writeContainerHeader(std::ofstream &file, const char *magic, uint32_t version) {
+    uint32_t reserved = 0;
+    file.write(magic, 8);
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+}
+
+/* writeBinaryHeader() ***********************************************************************/
+/*! Writes the container header and the META chunk
+    Arg 1: Container file
+    Arg 2: std::vector array of fracture families */
+void writeBinaryHeader(std::ofstream &file, std::vector<Shape> &shapeFamilies) {
+    writeContainerHeader(file, binaryMagic, DFN_BINARY_VERSION);
+    std::string chunk;
+    // META
+    BinaryMeta meta;
+    memset(&meta, 0, sizeof(meta));
+    meta.domainSize[0] = params->domainSize[0];
+    meta.domainSize[1] = params->domainSize[1];
+    meta.domainSize[2] = params->domainSize[2];
+    meta.h = params->h;
+    meta.eps = params->eps;
+    meta.seed = params->seed;
+    meta.numFamilies = shapeFamilies.size();
+    meta.visualizationMode = params->visualizationMode;
+    meta.keepIsolatedFractures = params->keepIsolatedFractures;
+    meta.tripleIntersections = params->tripleIntersections;
+    meta.outputAcceptedRadiiPerFamily = params->outputAcceptedRadiiPerFamily;
+    meta.outputFinalRadiiPerFamily = params->outputFinalRadiiPerFamily;
+    meta.userEllipsesOnOff = params->userEllipsesOnOff;
+    meta.userRectanglesOnOff = params->userRectanglesOnOff;
+    meta.userPolygonByCoord = params->userPolygonByCoord;
+    appendRaw(chunk, meta.domainSize, 3);
+    appendValue(chunk, meta.h);
+    appendValue(chunk, meta.eps);
+    appendValue(chunk, (uint32_t) meta.seed);
+    appendValue(chunk, (uint32_t) meta.numFamilies);
+    uint8_t flags[8] = {meta.visualizationMode, meta.keepIsolatedFractures, meta.tripleIntersections,
+                        meta.outputAcceptedRadiiPerFamily, meta.outputFinalRadiiPerFamily,
+                        meta.userEllipsesOnOff, meta.userRectanglesOnOff, meta.userPolygonByCoord
+                       };
+    appendRaw(chunk, flags, 8);
+    writeChunk(file, "META", chunk);
+}
+
+/* writeBinaryOutput() ***********************************************************************/
+/*! Writes the DFN into a single binary container (dfn.bin)
+    Must be called after adjustIntFractIDs() and before writeIntersectionFiles(), which rotates
+    the final fractures to the x-y plane.
+    Arg 1: std::vector array of indices of fractures left after isolated fracture removal
+    Arg 2: std::vector array of all accetped fractures
+    Arg 3: std::vector array of all intersections
+    Arg 4: std::vector array of all triple intersection points
+    Arg 5: std::vector array of fracture families
+    Arg 6: Path to output folder */
+void writeBinaryOutput(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts,
+                       std::vector<Point> &triplePoints, std::vector<Shape> &shapeFamilies, std::string &output) {
+    std::string logString = "Writing Binary DFN File (dfn.bin)\n";
+    logger.writeLogFile(INFO,  logString);
+    std::string fileName = output + "/dfn.bin";
+    std::ofstream file;
+    file.open(fileName.c_str(), std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+    checkIfOpen(file, fileName);
+    writeBinaryHeader(file, shapeFamilies);
+    std::string chunk;
+    // FRAC
+    uint64_t n = acceptedPoly.size();
+    appendValue(chunk, n);
+    
+    for (uint64_t i = 0; i < n; i++) {
+        appendValue(chunk, (int32_t) acceptedPoly[i].numberOfNodes);
+    }
+    
+    for (uint64_t i = 0; i < n; i++) {
+        appendValue(chunk, (int32_t) acceptedPoly[i].familyNum);
+    }
+    
+    for (uint64_t i = 0; i < n; i++) {
+        appendValue(chunk, acceptedPoly[i].xradius);
+    }
+    
+    for (uint64_t i = 0; i < n; i++) {
+        appendValue(chunk, acceptedPoly[i].yradius);
+    }
+    
+    for (uint64_t i = 0; i < n; i++) {
+        appendValue(chunk, acceptedPoly[i].aspectRatio);
+    }
+    
+    for (uint64_t i = 0; i < n; i++) {
+        appendValue(chunk, acceptedPoly[i].area);
+    }
+    
+    for (uint64_t i = 0; i < n; i++) {
+        appendRaw(chunk, acceptedPoly[i].translation, 3);
+    }
+    
+    for (uint64_t i = 0; i < n; i++) {
+        appendRaw(chunk, acceptedPoly[i].normal, 3);
+    }
+    
+    for (uint64_t i = 0; i < n; i++) {
+        for (int k = 0; k < 6; k++) {
+            appendValue(chunk, (uint8_t) acceptedPoly[i].faces[k]);
+        }
+    }
+    
+    writeChunk(file, "FRAC", chunk);
+    // VERT
+    uint64_t start = 0;
+    
+    for (uint64_t i = 0; i < n; i++) {
+        appendValue(chunk, start);
+        start += acceptedPoly[i].numberOfNodes;
+    }
+    
+    appendValue(chunk, start);
+    
+    for (uint64_t i = 0; i < n; i++) {
+        appendRaw(chunk, acceptedPoly[i].vertices, 3 * acceptedPoly[i].numberOfNodes);
+    }
+    
+    writeChunk(file, "VERT", chunk);
+    // FADJ
+    start = 0;
+    
+    for (uint64_t i = 0; i < n; i++) {
+        appendValue(chunk, start);
+        start += acceptedPoly[i].intersectionIndex.size();
+    }
+    
+    appendValue(chunk, start);
+    
+    for (uint64_t i = 0; i < n; i++) {
+        for (unsigned int j = 0; j < acceptedPoly[i].intersectionIndex.size(); j++) {
+            appendValue(chunk, (uint32_t) acceptedPoly[i].intersectionIndex[j]);
+        }
+    }
+    
+    writeChunk(file, "FADJ", chunk);
+    // FINL
+    appendValue(chunk, (uint64_t) finalFractures.size());
+    
+    for (unsigned int i = 0; i < finalFractures.size(); i++) {
+        appendValue(chunk, (uint32_t) finalFractures[i]);
+    }
+    
+    writeChunk(file, "FINL", chunk);
+    // INTS
+    uint64_t k = intPts.size();
+    appendValue(chunk, k);
+    
+    for (uint64_t i = 0; i < k; i++) {
+        appendValue(chunk, (int64_t) intPts[i].fract1);
+    }
+    
+    for (uint64_t i = 0; i < k; i++) {
+        appendValue(chunk, (int64_t) intPts[i].fract2);
+    }
+    
+    for (uint64_t i = 0; i < k; i++) {
+        double pt[3] = {intPts[i].x1, intPts[i].y1, intPts[i].z1};
+        appendRaw(chunk, pt, 3);
+    }
+    
+    for (uint64_t i = 0; i < k; i++) {
+        double pt[3] = {intPts[i].x2, intPts[i].y2, intPts[i].z2};
+        appendRaw(chunk, pt, 3);
+    }
+    
+    start = 0;
+    
+    for (uint64_t i = 0; i < k; i++) {
+        appendValue(chunk, start);
+        start += intPts[i].triplePointsIdx.size();
+    }
+    
+    appendValue(chunk, start);
+    
+    for (uint64_t i = 0; i < k; i++) {
+        for (unsigned int j = 0; j < intPts[i].triplePointsIdx.size(); j++) {
+            appendValue(chunk, (uint32_t) intPts[i].triplePointsIdx[j]);
+        }
+    }
+    
+    writeChunk(file, "INTS", chunk);
+    // TRIP
+    appendValue(chunk, (uint64_t) triplePoints.size());
+    
+    for (unsigned int i = 0; i < triplePoints.size(); i++) {
+        double pt[3] = {triplePoints[i].x, triplePoints[i].y, triplePoints[i].z};
+        appendRaw(chunk, pt, 3);
+    }
+    
+    writeChunk(file, "TRIP", chunk);
+    file.close();
+}
+
+/* writeBinaryGraph() ************************************************************************/
+/*! Writes the fracture graph of intersection_list.dat in binary CSR format (graph.bin), with
+    the same header and chunk structure as dfn.bin, char magic[8] = "DFNGRAPH"
+
+    NODE  uint64 n fractures, uint64 b boundaries (6). Node i < n is final fracture i + 1,
+          node n + j is boundary j + 1 (FEHM format: top, bottom, left, front, right, back)
+    EDGE  uint64 m, uint32 node1[m], uint32 node2[m], f64 length[m], f64 midPoint[3m],
+          in the order of intersection_list.dat
+    ADJC  CSR node -> edges, each edge is listed at both of its nodes:
+          uint64 start[n+b+1], uint32 neighbor[start[n+b]], uint32 edge[start[n+b]]
+
+    Arg 1: Number of final fractures
+    Arg 2: std::vector array of graph edges
+    Arg 3: Path to output folder */
+void writeBinaryGraph(unsigned int fractureCount, std::vector<GraphEdge> &edges, std::string &output) {
+    std::string fileName = output + "/graph.bin";
+    std::ofstream file;
+    file.open(fileName.c_str(), std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+    checkIfOpen(file, fileName);
+    writeContainerHeader(file, graphMagic, DFN_GRAPH_VERSION);
+    std::string chunk;
+    // NODE
+    uint64_t n = fractureCount;
+    uint64_t nodeCount = n + 6;
+    appendValue(chunk, n);
+    appendValue(chunk, (uint64_t) 6);
+    writeChunk(file, "NODE", chunk);
+    // EDGE
+    uint64_t m = edges.size();
+    std::vector<uint32_t> node1(m);
+    std::vector<uint32_t> node2(m);
+    
+    for (uint64_t i = 0; i < m; i++) {
+        // Boundaries are negative
+        node1[i] = edges[i].fract1 > 0 ? edges[i].fract1 - 1 : n - edges[i].fract1 - 1;
+        node2[i] = edges[i].fract2 > 0 ? edges[i].fract2 - 1 : n - edges[i].fract2 - 1;
+    }
+    
+    appendValue(chunk, m);
+    appendRaw(chunk, node1.data(), m);
+    appendRaw(chunk, node2.data(), m);
+    
+    for (uint64_t i = 0; i < m; i++) {
+        appendValue(chunk, edges[i].length);
+    }
+    
+    for (uint64_t i = 0; i < m; i++) {
+        appendRaw(chunk, edges[i].midPoint, 3);
+    }
+    
+    writeChunk(file, "EDGE", chunk);
+    // ADJC, counting sort of the edge ends by node
+    std::vector<uint64_t> start(nodeCount + 1, 0);
+    
+    for (uint64_t i = 0; i < m; i++) {
+        start[node1[i] + 1]++;
+        start[node2[i] + 1]++;
+    }
+    
+    for (uint64_t i = 0; i < nodeCount; i++) {
+        start[i + 1] += start[i];
+    }
+    
+    std::vector<uint32_t> neighbor(2 * m);
+    std::vector<uint32_t> edge(2 * m);
+    std::vector<uint64_t> next(start.begin(), start.end() - 1);
+    
+    for (uint64_t i = 0; i < m; i++) {
+        neighbor[next[node1[i]]] = node2[i];
+        edge[next[node1[i]]++] = i;
+        neighbor[next[node2[i]]] = node1[i];
+        edge[next[node2[i]]++] = i;
+    }
+    
+    appendRaw(chunk, start.data(), nodeCount + 1);
+    appendRaw(chunk, neighbor.data(), 2 * m);
+    appendRaw(chunk, edge.data(), 2 * m);
+    writeChunk(file, "ADJC", chunk);
+    file.close();
+}
+
+/* readBinaryOutput() ************************************************************************/
+/*! Reads a DFN binary container written by writeBinaryOutput()
+    Restores the state of the DFN as it was when the container was written, i.e. fracture ID's
+    of intersections already adjusted (see adjustIntFractIDs()) and fractures not rotated.
+    Arg 1: Path to dfn.bin
+    Arg 2: OUTPUT, std::vector array of indices of fractures left after isolated fracture removal
+    Arg 3: OUTPUT, std::vector array of all accetped fractures. Vertices are allocated with new[]
+    Arg 4: OUTPUT, std::vector array of all intersections
+    Arg 5: OUTPUT, std::vector array of all triple intersection points
+    Arg 6: OUTPUT, run parameters */
+void readBinaryOutput(std::string fileName, std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly,
+                      std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints, struct BinaryMeta &meta) {
+    std::ifstream file;
+    std::string logString;
+    file.open(fileName.c_str(), std::ifstream::in | std::ifstream::binary);
+    checkIfOpen(file, fileName);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    file.close();
+    std::string buffer = contents.str();
+    uint32_t version;
+    
+    if (buffer.size() < 16 || memcmp(buffer.data(), binaryMagic, sizeof(binaryMagic)) != 0) {
+        logString = "ERROR: " + fileName + " is not a binary DFN file\n";
+        logger.writeLogFile(ERROR,  logString);
+        throw DFNError();
+    }
+    
+    memcpy(&version, buffer.data() + 8, sizeof(version));
+    
+    if (version != DFN_BINARY_VERSION) {
+        logString = "ERROR: " + fileName + " has binary DFN format version " + std::to_string(version)
+                    + ", expected version " + std::to_string(DFN_BINARY_VERSION) + "\n";
+        logger.writeLogFile(ERROR,  logString);
+        throw DFNError();
+    }
+    
+    memset(&meta, 0, sizeof(meta));
+    finalFractures.clear();
+    acceptedPoly.clear();
+    intPts.clear();
+    triplePoints.clear();
+    uint64_t pos = 16;
+    uint64_t n = 0;
+    std::vector<uint64_t> vertexStart, adjStart;
+    std::vector<double> vertices;
+    std::vector<uint32_t> adjacency;
+    
+    while (pos + 16 <= buffer.size()) {
+        ChunkReader chunk;
+        chunk.tag = buffer.data() + pos;
+        memcpy(&chunk.size, buffer.data() + pos + 8, sizeof(chunk.size));
+        pos += 16;
+        
+        if (chunk.size > buffer.size() - pos) {
+            logString = "ERROR: binary DFN file, chunk " + std::string(chunk.tag, 4) + " is truncated\n";
+            logger.writeLogFile(ERROR,  logString);
+            throw DFNError();
+        }
+        
+        chunk.data = buffer.data() + pos;
+        chunk.pos = 0;
+        pos += chunk.size;
+        
+        if (memcmp(chunk.tag, "META", 4) == 0) {
+            uint8_t flags[8];
+            chunk.read(meta.domainSize, 3);
+            meta.h = chunk.value<double>();
+            meta.eps = chunk.value<double>();
+            meta.seed = chunk.value<uint32_t>();
+            meta.numFamilies = chunk.value<uint32_t>();
+            chunk.read(flags, 8);
+            meta.visualizationMode = flags[0];
+            meta.keepIsolatedFractures = flags[1];
+            meta.tripleIntersections = flags[2];
+            meta.outputAcceptedRadiiPerFamily = flags[3];
+            meta.outputFinalRadiiPerFamily = flags[4];
+            meta.userEllipsesOnOff = flags[5];
+            meta.userRectanglesOnOff = flags[6];
+            meta.userPolygonByCoord = flags[7];
+        } else if (memcmp(chunk.tag, "FRAC", 4) == 0) {
+            n = chunk.value<uint64_t>();
+            acceptedPoly.resize(n);
+            
+            for (uint64_t i = 0; i < n; i++) {
+                acceptedPoly[i].numberOfNodes = chunk.value<int32_t>();
+            }
+            
+            for (uint64_t i = 0; i < n; i++) {
+                acceptedPoly[i].familyNum = chunk.value<int32_t>();
+            }
+            
+            for (uint64_t i = 0; i < n; i++) {
+                acceptedPoly[i].xradius = chunk.value<double>();
+            }
+            
+            for (uint64_t i = 0; i < n; i++) {
+                acceptedPoly[i].yradius = chunk.value<double>();
+            }
+            
+            for (uint64_t i = 0; i < n; i++) {
+                acceptedPoly[i].aspectRatio = chunk.value<float>();
+            }
+            
+            for (uint64_t i = 0; i < n; i++) {
+                acceptedPoly[i].area = chunk.value<float>();
+            }
+            
+            for (uint64_t i = 0; i < n; i++) {
+                chunk.read(acceptedPoly[i].translation, 3);
+            }
+            
+            for (uint64_t i = 0; i < n; i++) {
+                chunk.read(acceptedPoly[i].normal, 3);
+            }
+            
+            for (uint64_t i = 0; i < n; i++) {
+                for (int k = 0; k < 6; k++) {
+                    acceptedPoly[i].faces[k] = chunk.value<uint8_t>();
+                }
+            }
+        } else if (memcmp(chunk.tag, "VERT", 4) == 0) {
+            vertexStart.resize(n + 1);
+            chunk.read(vertexStart.data(), n + 1);
+            vertices.resize(3 * vertexStart[n]);
+            chunk.read(vertices.data(), vertices.size());
+        } else if (memcmp(chunk.tag, "FADJ", 4) == 0) {
+            adjStart.resize(n + 1);
+            chunk.read(adjStart.data(), n + 1);
+            adjacency.resize(adjStart[n]);
+            chunk.read(adjacency.data(), adjacency.size());
+        } else if (memcmp(chunk.tag, "FINL", 4) == 0) {
+            finalFractures.resize(chunk.value<uint64_t>());
+            
+            for (unsigned int i = 0; i < finalFractures.size(); i++) {
+                finalFractures[i] = chunk.value<uint32_t>();
+            }
+        } else if (memcmp(chunk.tag, "INTS", 4) == 0) {
+            uint64_t k = chunk.value<uint64_t>();
+            intPts.resize(k);
+            
+            for (uint64_t i = 0; i < k; i++) {
+                intPts[i].fract1 = chunk.value<int64_t>();
+            }
+            
+            for (uint64_t i = 0; i < k; i++) {
+                intPts[i].fract2 = chunk.value<int64_t>();
+            }
+            
+            for (uint64_t i = 0; i < k; i++) {
+                intPts[i].x1 = chunk.value<double>();
+                intPts[i].y1 = chunk.value<double>();
+                intPts[i].z1 = chunk.value<double>();
+            }
+            
+            for (uint64_t i = 0; i < k; i++) {
+                intPts[i].x2 = chunk.value<double>();
+                intPts[i].y2 = chunk.value<double>();
+                intPts[i].z2 = chunk.value<double>();
+            }
+            
+            std::vector<uint64_t> tripleStart(k + 1);
+            chunk.read(tripleStart.data(), k + 1);
+            
+            for (uint64_t i = 0; i < k; i++) {
+                for (uint64_t j = tripleStart[i]; j < tripleStart[i + 1]; j++) {
+                    intPts[i].triplePointsIdx.push_back(chunk.value<uint32_t>());
+                }
+            }
+        } else if (memcmp(chunk.tag, "TRIP", 4) == 0) {
+            triplePoints.resize(chunk.value<uint64_t>());
+            
+            for (unsigned int i = 0; i < triplePoints.size(); i++) {
+                triplePoints[i].x = chunk.value<double>();
+                triplePoints[i].y = chunk.value<double>();
+                triplePoints[i].z = chunk.value<double>();
+            }
+        }
+        
+        // Chunks unknown to this version are skipped
+    }
+    
+    if (vertexStart.size() != n + 1) {
+        logString = "ERROR: binary DFN file " + fileName + " is missing fracture data\n";
+        logger.writeLogFile(ERROR,  logString);
+        throw DFNError();
+    }
+    
+    for (uint64_t i = 0; i < n; i++) {
+        uint64_t nodes = vertexStart[i + 1] - vertexStart[i];
+        
+        if (nodes != (uint64_t) acceptedPoly[i].numberOfNodes) {
+            logString = "ERROR: binary DFN file " + fileName + " has inconsistent vertex data\n";
+            logger.writeLogFile(ERROR,  logString);
+            throw DFNError();
+        }
+        
+        acceptedPoly[i].vertices = new double[3 * nodes];
+        memcpy(acceptedPoly[i].vertices, vertices.data() + 3 * vertexStart[i], 3 * nodes * sizeof(double));
+        
+        if (adjStart.size() == n + 1) {
+            acceptedPoly[i].intersectionIndex.assign(adjacency.begin() + adjStart[i], adjacency.begin() + adjStart[i + 1]);
+        }
+    }
+    
+    if (adjStart.size() != n + 1) {
+        // No FADJ chunk: intersections are listed by both their fractures, in order.
+        // Final fractures are -(index into finalFractures + 1), see adjustIntFractIDs()
+        for (unsigned int i = 0; i < intPts.size(); i++) {
+            long int fract[2] = {intPts[i].fract1, intPts[i].fract2};
+            
+            for (int j = 0; j < 2; j++) {
+                uint64_t idx = fract[j] < 0 ? -fract[j] - 1 : fract[j];
+                
+                if (fract[j] < 0) {
+                    idx = idx < finalFractures.size() ? finalFractures[idx] : n;
+                }
+                
+                if (idx >= n) {
+                    logString = "ERROR: binary DFN file " + fileName + " has inconsistent intersection data\n";
+                    logger.writeLogFile(ERROR,  logString);
+                    throw DFNError();
+                }
+                
+                acceptedPoly[idx].intersectionIndex.push_back(i);
+            }
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef _binaryOutput_h_
+#define _binaryOutput_h_
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <stdint.h>
+#include <stdlib.h>
+#include "structures.h"
+#include "logFile.h"
+#include "input.h" // DFNError
+
+extern Logger logger;
+
+/*! Binary container format version. Increment when the layout of an existing chunk changes.
+    New chunks can be added without changing the version, readers skip unknown chunks. */
+#define DFN_BINARY_VERSION 1
+
+/*! Run parameters stored with the DFN in the binary container. They are the
+    global input variables needed to regenerate the legacy ASCII output. */
+struct BinaryMeta {
+    double domainSize[3];
+    double h;
+    double eps;
+    unsigned int seed;
+    unsigned int numFamilies;
+    bool visualizationMode;
+    bool keepIsolatedFractures;
+    bool tripleIntersections;
+    bool outputAcceptedRadiiPerFamily;
+    bool outputFinalRadiiPerFamily;
+    bool userEllipsesOnOff;
+    bool userRectanglesOnOff;
+    bool userPolygonByCoord;
+};
+
+/*! Graph file format version, see writeBinaryGraph() */
+#define DFN_GRAPH_VERSION 1
+
+/*! Edge of the fracture graph: the line of intersection of two final fractures, or
+    of a final fracture with a domain boundary. Fractures are numbered from 1, boundaries
+    are numbered -1 to -6 (FEHM format) as in intersection_list.dat */
+struct GraphEdge {
+    int fract1;
+    int fract2;
+    double midPoint[3];
+    double length;
+};
+
+/* appendRaw() *******************************************************************************/
+/*! Appends count values to a chunk buffer
+    Arg 1: Chunk buffer
+    Arg 2: Pointer to first value
+    Arg 3: Number of values */
+template <typename T>
+inline void appendRaw(std::string &chunk, const T *data, size_t count) {
+    chunk.append(reinterpret_cast<const char*>(data), count * sizeof(T));
+}
+
+template <typename T>
+inline void appendValue(std::string &chunk, T value) {
+    appendRaw(chunk, &value, 1);
+}
+
+/* ChunkReader *******************************************************************************/
+/*! Sequential reader of one chunk payload, throws DFNError if the chunk is too short */
+struct ChunkReader {
+    const char *data;
+    uint64_t size;
+    uint64_t pos;
+    const char *tag;
+    
+    template <typename T>
+    void read(T *values, uint64_t count) {
+        uint64_t bytes = count * sizeof(T);
+        
+        if (count > size || bytes > size - pos) {
+            std::string logString = "ERROR: binary file, chunk " + std::string(tag, 4) + " is truncated\n";
+            logger.writeLogFile(ERROR,  logString);
+            throw DFNError();
+        }
+        
+        memcpy(values, data + pos, bytes);
+        pos += bytes;
+    }
+    
+    template <typename T>
+    T value() {
+        T v;
+        read(&v, 1);
+        return v;
+    }
+};
+
+void writeContainerHeader(std::ofstream &file, const char *magic, uint32_t version);
+void writeBinaryHeader(std::ofstream &file, std::vector<Shape> &shapeFamilies);
+void writeChunkHeader(std::ofstream &file, const char *tag, uint64_t size);
+void writeBinaryOutput(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts,
+                       std::vector<Point> &triplePoints, std::vector<Shape> &shapeFamilies, std::string &output);
+void writeBinaryGraph(unsigned int fractureCount, std::vector<GraphEdge> &edges, std::string &output);
+void readBinaryOutput(std::string fileName, std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly,
+                      std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints, struct BinaryMeta &meta);
+
+#endif
@@ -0,0 +1,534 @@
+#include "checkpoint.h"
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include <stdlib.h>
+#include "input.h"
+#include "structures.h"
+#include "binaryOutput.h" // appendRaw(), appendValue(), ChunkReader
+#include "readInputFunctions.h" // error check for file open checkIfOpen()
+#include "logFile.h"
+
+/*
+    Checkpoint layout (native byte order), same chunk structure as the binary container dfn.bin:
+
+    Header:  char magic[8] = "DFNCKPT\0", uint32 version, uint32 reserved
+    Chunks:  char tag[4], uint32 reserved, uint64 payload size, payload
+
+    META  uint64 input file hash, uint32 seed, uint32 number of families, int32 cdfSize,
+          uint64 size of radii_All.dat
+    RNGS  state of the random generator (text, as written by operator<<)
+    FAMS  per family: uint32 radiiIdx, f32 currentP32, uint8 p32Status, uint64 size, f64 radiiList[size],
+          then f32 famProb[cdfSize], f32 CDF[cdfSize]
+    STAT  Stats counters and cluster data gathered during insertion. Values computed after
+          generation (areas, volumes, node counts) are not saved.
+    POLY  uint64 n, then one record per accepted fracture including vertices and intersection indices
+    INTS  uint64 k, then one record per intersection including triple point indices
+    TRIP  uint64 t, f64 triplePoints[3t]
+
+    A checkpoint holds the state at the start of a main loop iteration, i.e. between two fractures.
+*/
+
+static const char checkpointMagic[8] = {'D', 'F', 'N', 'C', 'K', 'P', 'T', 0};
+
+/*! Path of the checkpoint file, <output folder>/dfngen.ckpt */
+static std::string checkpointFile;
+
+/*! Hash of the input file. Resuming with a different input file is an error. */
+static uint64_t inputHash = 0;
+
+/*! Background thread writing the last checkpoint to disk */
+static std::thread checkpointThread;
+
+/* appendChunk() *****************************************************************************/
+/*! Appends one chunk (tag, size, payload) to the checkpoint buffer
+    Arg 1: Checkpoint buffer
+    Arg 2: Four character chunk tag
+    Arg 3: Chunk payload, cleared after appending */
+static void appendChunk(std::string &buffer, const char *tag, std::string &chunk) {
+    uint32_t reserved = 0;
+    buffer.append(tag, 4);
+    appendValue(buffer, reserved);
+    appendValue(buffer, (uint64_t) chunk.size());
+    buffer.append(chunk);
+    chunk.clear();
+}
+
+/* saveCheckpoint() **************************************************************************/
+/*! Writes a serialized checkpoint to disk. Runs on the checkpoint thread.
+    The checkpoint is written to a temporary file which then replaces the previous
+    checkpoint, a job killed while writing keeps the previous checkpoint.
+    Arg 1: Serialized checkpoint, deleted when written */
+static void saveCheckpoint(std::string *buffer) {
+    std::string tmpFile = checkpointFile + ".tmp";
+    FILE *file = fopen(tmpFile.c_str(), "wb");
+    bool ok = file != NULL;
+    
+    if (ok) {
+        ok = fwrite(buffer->data(), 1, buffer->size(), file) == buffer->size();
+        ok = (fclose(file) == 0) && ok;
+    }
+    
+    if (ok) {
+        ok = rename(tmpFile.c_str(), checkpointFile.c_str()) == 0;
+    }
+    
+    if (!ok) {
+        // A failed checkpoint does not stop the generation
+        std::string logString = "Warning: Unable to write checkpoint " + checkpointFile + "\n";
+        logger.writeLogFile(WARNING,  logString);
+    }
+    
+    delete buffer;
+}
+
+/* initCheckpoint() **************************************************************************/
+/*! Sets the checkpoint file name and hashes the input file. Must be called before
+    writeCheckpoint() or readCheckpoint().
+    Arg 1: Path to input file
+    Arg 2: Path to output folder */
+void initCheckpoint(std::string inputFile, std::string output) {
+    checkpointFile = output + "/dfngen.ckpt";
+    std::ifstream file;
+    file.open(inputFile.c_str(), std::ifstream::in | std::ifstream::binary);
+    checkIfOpen(file, inputFile);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    file.close();
+    std::string input = contents.str();
+    // 64 bit FNV-1a
+    inputHash = 14695981039346656037ULL;
+    
+    for (unsigned int i = 0; i < input.size(); i++) {
+        inputHash ^= (unsigned char) input[i];
+        inputHash *= 1099511628211ULL;
+    }
+    
+    // exit() must not destroy a running thread
+    atexit(waitForCheckpoint);
+}
+
+/* waitForCheckpoint() ***********************************************************************/
+/*! Waits until the checkpoint being written, if any, is on disk */
+void waitForCheckpoint() {
+    if (checkpointThread.joinable()) {
+        checkpointThread.join();
+    }
+}
+
+/* writeCheckpoint() *************************************************************************/
+/*! Saves the state of DFN generation. The state is serialized by the calling thread and
+    written to disk in the background, so that generation continues while the file is
+    written. Waits for the previous checkpoint if it is still being written.
+    Arg 1: std::vector array of all accetped fractures
+    Arg 2: std::vector array of all intersections
+    Arg 3: std::vector array of all triple intersection points
+    Arg 4: Stats structure of DFN statistics
+    Arg 5: std::vector array of fracture families
+    Arg 6: CDF of the family probabilities
+    Arg 7: Size of CDF
+    Arg 8: Random generator
+    Arg 9: Size of radii_All.dat in bytes */
+void writeCheckpoint(std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints,
+                     Stats &pstats, std::vector<Shape> &shapeFamilies, float *CDF, int cdfSize,
+                     std::mt19937_64 &generator, unsigned long long radiiAllSize) {
+    std::string logString = "Writing checkpoint, " + to_string(pstats.acceptedPolyCount) + " fractures accepted\n";
+    logger.writeLogFile(INFO,  logString);
+    std::string *buffer = new std::string;
+    std::string chunk;
+    uint32_t version = DFN_CHECKPOINT_VERSION;
+    uint32_t reserved = 0;
+    buffer->append(checkpointMagic, sizeof(checkpointMagic));
+    appendValue(*buffer, version);
+    appendValue(*buffer, reserved);
+    unsigned int numFamilies = shapeFamilies.size();
+    // META
+    appendValue(chunk, inputHash);
+    appendValue(chunk, (uint32_t) params->seed);
+    appendValue(chunk, (uint32_t) numFamilies);
+    appendValue(chunk, (int32_t) cdfSize);
+    appendValue(chunk, (uint64_t) radiiAllSize);
+    appendChunk(*buffer, "META", chunk);
+    // RNGS
+    std::ostringstream rngState;
+    rngState << generator;
+    chunk = rngState.str();
+    appendChunk(*buffer, "RNGS", chunk);
+    
+    // FAMS
+    for (unsigned int i = 0; i < numFamilies; i++) {
+        appendValue(chunk, (uint32_t) shapeFamilies[i].radiiIdx);
+        appendValue(chunk, shapeFamilies[i].currentP32);
+        appendValue(chunk, (uint8_t) (params->stopCondition == 1 ? params->p32Status[i] : 0));
+        appendValue(chunk, (uint64_t) shapeFamilies[i].radiiList.size());
+        appendRaw(chunk, shapeFamilies[i].radiiList.data(), shapeFamilies[i].radiiList.size());
+    }
+    
+    appendRaw(chunk, params->famProb.data(), cdfSize);
+    appendRaw(chunk, CDF, cdfSize);
+    appendChunk(*buffer, "FAMS", chunk);
+    
+    // STAT
+    for (unsigned int i = 0; i < numFamilies; i++) {
+        appendValue(chunk, (int32_t) pstats.acceptedFromFam[i]);
+        appendValue(chunk, (int32_t) pstats.rejectedFromFam[i]);
+        appendValue(chunk, (int32_t) pstats.expectedFromFam[i]);
+    }
+    
+    appendValue(chunk, (uint32_t) pstats.acceptedPolyCount);
+    appendValue(chunk, (uint64_t) pstats.rejectedPolyCount);
+    appendValue(chunk, (uint32_t) pstats.retranslatedPolyCount);
+    appendValue(chunk, (uint32_t) pstats.truncated);
+    appendValue(chunk, (uint64_t) pstats.nextGroupNum);
+    uint64_t reasons[7] = {pstats.rejectionReasons.shortIntersection, pstats.rejectionReasons.closeToNode,
+                           pstats.rejectionReasons.closeToEdge, pstats.rejectionReasons.closePointToEdge,
+                           pstats.rejectionReasons.outside, pstats.rejectionReasons.triple,
+                           pstats.rejectionReasons.interCloseToInter
+                          };
+    appendRaw(chunk, reasons, 7);
+    appendValue(chunk, (uint32_t) pstats.intersectionsShortened);
+    appendValue(chunk, pstats.originalLength);
+    appendValue(chunk, pstats.discardedLength);
+    appendValue(chunk, (uint64_t) pstats.rejectsPerAttempt.size());
+    
+    for (unsigned int i = 0; i < pstats.rejectsPerAttempt.size(); i++) {
+        appendValue(chunk, (uint32_t) pstats.rejectsPerAttempt[i]);
+    }
+    
+    appendValue(chunk, (uint64_t) pstats.fractGroup.size());
+    
+    for (unsigned int i = 0; i < pstats.fractGroup.size(); i++) {
+        appendValue(chunk, (uint64_t) pstats.fractGroup[i].groupNum);
+        appendValue(chunk, (uint64_t) pstats.fractGroup[i].polyList.size());
+        
+        for (unsigned int j = 0; j < pstats.fractGroup[i].polyList.size(); j++) {
+            appendValue(chunk, (uint32_t) pstats.fractGroup[i].polyList[j]);
+        }
+    }
+    
+    appendValue(chunk, (uint64_t) pstats.groupData.size());
+    
+    for (unsigned int i = 0; i < pstats.groupData.size(); i++) {
+        appendValue(chunk, (uint32_t) pstats.groupData[i].size);
+        appendValue(chunk, (uint8_t) pstats.groupData[i].valid);
+        
+        for (int k = 0; k < 6; k++) {
+            appendValue(chunk, (uint8_t) pstats.groupData[i].faces[k]);
+        }
+    }
+    
+    appendValue(chunk, (uint64_t) pstats.rejectedUserFracture.size());
+    
+    for (unsigned int i = 0; i < pstats.rejectedUserFracture.size(); i++) {
+        appendValue(chunk, (int32_t) pstats.rejectedUserFracture[i].id);
+        appendValue(chunk, (int32_t) pstats.rejectedUserFracture[i].userFractureType);
+    }
+    
+    appendChunk(*buffer, "STAT", chunk);
+    // POLY
+    appendValue(chunk, (uint64_t) acceptedPoly.size());
+    
+    for (unsigned int i = 0; i < acceptedPoly.size(); i++) {
+        Poly &poly = acceptedPoly[i];
+        appendValue(chunk, (int32_t) poly.numberOfNodes);
+        appendValue(chunk, (int32_t) poly.familyNum);
+        appendValue(chunk, (uint32_t) poly.groupNum);
+        appendValue(chunk, poly.area);
+        appendValue(chunk, poly.xradius);
+        appendValue(chunk, poly.yradius);
+        appendValue(chunk, poly.aspectRatio);
+        appendRaw(chunk, poly.translation, 3);
+        appendRaw(chunk, poly.normal, 3);
+        appendRaw(chunk, poly.boundingBox, 6);
+        
+        for (int k = 0; k < 6; k++) {
+            appendValue(chunk, (uint8_t) poly.faces[k]);
+        }
+        
+        appendValue(chunk, (uint8_t) poly.XYPlane);
+        appendValue(chunk, (uint8_t) poly.truncated);
+        appendRaw(chunk, poly.vertices, 3 * poly.numberOfNodes);
+        appendValue(chunk, (uint64_t) poly.intersectionIndex.size());
+        
+        for (unsigned int j = 0; j < poly.intersectionIndex.size(); j++) {
+            appendValue(chunk, (uint32_t) poly.intersectionIndex[j]);
+        }
+    }
+    
+    appendChunk(*buffer, "POLY", chunk);
+    // INTS
+    appendValue(chunk, (uint64_t) intPts.size());
+    
+    for (unsigned int i = 0; i < intPts.size(); i++) {
+        double pts[6] = {intPts[i].x1, intPts[i].y1, intPts[i].z1, intPts[i].x2, intPts[i].y2, intPts[i].z2};
+        appendValue(chunk, (int64_t) intPts[i].fract1);
+        appendValue(chunk, (int64_t) intPts[i].fract2);
+        appendRaw(chunk, pts, 6);
+        appendValue(chunk, (uint8_t) intPts[i].intersectionShortened);
+        appendValue(chunk, (uint64_t) intPts[i].triplePointsIdx.size());
+        
+        for (unsigned int j = 0; j < intPts[i].triplePointsIdx.size(); j++) {
+            appendValue(chunk, (uint32_t) intPts[i].triplePointsIdx[j]);
+        }
+    }
+    
+    appendChunk(*buffer, "INTS", chunk);
+    // TRIP
+    appendValue(chunk, (uint64_t) triplePoints.size());
+    
+    for (unsigned int i = 0; i < triplePoints.size(); i++) {
+        double pt[3] = {triplePoints[i].x, triplePoints[i].y, triplePoints[i].z};
+        appendRaw(chunk, pt, 3);
+    }
+    
+    appendChunk(*buffer, "TRIP", chunk);
+    // At most one checkpoint is written at a time
+    waitForCheckpoint();
+    checkpointThread = std::thread(saveCheckpoint, buffer);
+}
+
+/* readCheckpoint() **************************************************************************/
+/*! Restores the state of DFN generation from the checkpoint in the output folder.
+    Called in place of user fracture insertion, after the families, radii lists and
+    statistics arrays have been set up from the same input file.
+    Arg 1: OUTPUT, std::vector array of all accetped fractures. Vertices are allocated with new[]
+    Arg 2: OUTPUT, std::vector array of all intersections
+    Arg 3: OUTPUT, std::vector array of all triple intersection points
+    Arg 4: OUTPUT, Stats structure of DFN statistics
+    Arg 5: OUTPUT, std::vector array of fracture families
+    Arg 6: OUTPUT, CDF of the family probabilities, reallocated
+    Arg 7: OUTPUT, Size of CDF
+    Arg 8: OUTPUT, Random generator
+    Arg 9: OUTPUT, Size of radii_All.dat in bytes at the time of the checkpoint */
+void readCheckpoint(std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints,
+                    Stats &pstats, std::vector<Shape> &shapeFamilies, float *&CDF, int &cdfSize,
+                    std::mt19937_64 &generator, unsigned long long &radiiAllSize) {
+    std::ifstream file;
+    std::string logString = "Resuming from checkpoint " + checkpointFile + "\n";
+    logger.writeLogFile(INFO,  logString);
+    file.open(checkpointFile.c_str(), std::ifstream::in | std::ifstream::binary);
+    checkIfOpen(file, checkpointFile);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    file.close();
+    std::string buffer = contents.str();
+    uint32_t version;
+    
+    if (buffer.size() < 16 || memcmp(buffer.data(), checkpointMagic, sizeof(checkpointMagic)) != 0) {
+        logString = "ERROR: " + checkpointFile + " is not a DFNGen checkpoint\n";
+        logger.writeLogFile(ERROR,  logString);
+        throw DFNError();
+    }
+    
+    memcpy(&version, buffer.data() + 8, sizeof(version));
+    
+    if (version != DFN_CHECKPOINT_VERSION) {
+        logString = "ERROR: " + checkpointFile + " has checkpoint version " + std::to_string(version)
+                    + ", expected version " + std::to_string(DFN_CHECKPOINT_VERSION) + "\n";
+        logger.writeLogFile(ERROR,  logString);
+        throw DFNError();
+    }
+    
+    for (unsigned int i = 0; i < acceptedPoly.size(); i++) {
+        delete[] acceptedPoly[i].vertices;
+    }
+    
+    acceptedPoly.clear();
+    intPts.clear();
+    triplePoints.clear();
+    unsigned int numFamilies = shapeFamilies.size();
+    int chunksRead = 0;
+    uint64_t pos = 16;
+    
+    while (pos + 16 <= buffer.size()) {
+        ChunkReader chunk;
+        chunk.tag = buffer.data() + pos;
+        memcpy(&chunk.size, buffer.data() + pos + 8, sizeof(chunk.size));
+        pos += 16;
+        
+        if (chunk.size > buffer.size() - pos) {
+            logString = "ERROR: checkpoint, chunk " + std::string(chunk.tag, 4) + " is truncated\n";
+            logger.writeLogFile(ERROR,  logString);
+            throw DFNError();
+        }
+        
+        chunk.data = buffer.data() + pos;
+        chunk.pos = 0;
+        pos += chunk.size;
+        
+        if (memcmp(chunk.tag, "META", 4) == 0) {
+            if (chunk.value<uint64_t>() != inputHash) {
+                logString = "ERROR: Checkpoint " + checkpointFile + " was written for a different input file\n";
+                logger.writeLogFile(ERROR,  logString);
+                throw DFNError();
+            }
+            
+            params->seed = chunk.value<uint32_t>();
+            
+            if (chunk.value<uint32_t>() != numFamilies) {
+                logString = "ERROR: Checkpoint " + checkpointFile + " has a different number of families\n";
+                logger.writeLogFile(ERROR,  logString);
+                throw DFNError();
+            }
+            
+            cdfSize = chunk.value<int32_t>();
+            radiiAllSize = chunk.value<uint64_t>();
+        } else if (memcmp(chunk.tag, "RNGS", 4) == 0) {
+            std::istringstream rngState(std::string(chunk.data, chunk.size));
+            rngState >> generator;
+        } else if (memcmp(chunk.tag, "FAMS", 4) == 0) {
+            for (unsigned int i = 0; i < numFamilies; i++) {
+                shapeFamilies[i].radiiIdx = chunk.value<uint32_t>();
+                shapeFamilies[i].currentP32 = chunk.value<float>();
+                uint8_t status = chunk.value<uint8_t>();
+                
+                if (params->stopCondition == 1) {
+                    params->p32Status[i] = status;
+                }
+                
+                shapeFamilies[i].radiiList.resize(chunk.value<uint64_t>());
+                chunk.read(shapeFamilies[i].radiiList.data(), shapeFamilies[i].radiiList.size());
+            }
+            
+            // Completed families (P32 option) have been removed from famProb and CDF
+            params->famProb.resize(cdfSize);
+            chunk.read(params->famProb.data(), cdfSize);
+            delete[] CDF;
+            CDF = new float[cdfSize];
+            chunk.read(CDF, cdfSize);
+        } else if (memcmp(chunk.tag, "STAT", 4) == 0) {
+            for (unsigned int i = 0; i < numFamilies; i++) {
+                pstats.acceptedFromFam[i] = chunk.value<int32_t>();
+                pstats.rejectedFromFam[i] = chunk.value<int32_t>();
+                pstats.expectedFromFam[i] = chunk.value<int32_t>();
+            }
+            
+            pstats.acceptedPolyCount = chunk.value<uint32_t>();
+            pstats.rejectedPolyCount = chunk.value<uint64_t>();
+            pstats.retranslatedPolyCount = chunk.value<uint32_t>();
+            pstats.truncated = chunk.value<uint32_t>();
+            pstats.nextGroupNum = chunk.value<uint64_t>();
+            uint64_t reasons[7];
+            chunk.read(reasons, 7);
+            pstats.rejectionReasons.shortIntersection = reasons[0];
+            pstats.rejectionReasons.closeToNode = reasons[1];
+            pstats.rejectionReasons.closeToEdge = reasons[2];
+            pstats.rejectionReasons.closePointToEdge = reasons[3];
+            pstats.rejectionReasons.outside = reasons[4];
+            pstats.rejectionReasons.triple = reasons[5];
+            pstats.rejectionReasons.interCloseToInter = reasons[6];
+            pstats.intersectionsShortened = chunk.value<uint32_t>();
+            pstats.originalLength = chunk.value<double>();
+            pstats.discardedLength = chunk.value<double>();
+            pstats.rejectsPerAttempt.resize(chunk.value<uint64_t>());
+            
+            for (unsigned int i = 0; i < pstats.rejectsPerAttempt.size(); i++) {
+                pstats.rejectsPerAttempt[i] = chunk.value<uint32_t>();
+            }
+            
+            pstats.fractGroup.resize(chunk.value<uint64_t>());
+            
+            for (unsigned int i = 0; i < pstats.fractGroup.size(); i++) {
+                pstats.fractGroup[i].groupNum = chunk.value<uint64_t>();
+                pstats.fractGroup[i].polyList.resize(chunk.value<uint64_t>());
+                
+                for (unsigned int j = 0; j < pstats.fractGroup[i].polyList.size(); j++) {
+                    pstats.fractGroup[i].polyList[j] = chunk.value<uint32_t>();
+                }
+            }
+            
+            pstats.groupData.resize(chunk.value<uint64_t>());
+            
+            for (unsigned int i = 0; i < pstats.groupData.size(); i++) {
+                pstats.groupData[i].size = chunk.value<uint32_t>();
+                pstats.groupData[i].valid = chunk.value<uint8_t>();
+                
+                for (int k = 0; k < 6; k++) {
+                    pstats.groupData[i].faces[k] = chunk.value<uint8_t>();
+                }
+            }
+            
+            pstats.rejectedUserFracture.resize(chunk.value<uint64_t>());
+            
+            for (unsigned int i = 0; i < pstats.rejectedUserFracture.size(); i++) {
+                pstats.rejectedUserFracture[i].id = chunk.value<int32_t>();
+                pstats.rejectedUserFracture[i].userFractureType = chunk.value<int32_t>();
+            }
+        } else if (memcmp(chunk.tag, "POLY", 4) == 0) {
+            acceptedPoly.resize(chunk.value<uint64_t>());
+            
+            for (unsigned int i = 0; i < acceptedPoly.size(); i++) {
+                Poly &poly = acceptedPoly[i];
+                poly.numberOfNodes = chunk.value<int32_t>();
+                poly.familyNum = chunk.value<int32_t>();
+                poly.groupNum = chunk.value<uint32_t>();
+                poly.area = chunk.value<float>();
+                poly.xradius = chunk.value<double>();
+                poly.yradius = chunk.value<double>();
+                poly.aspectRatio = chunk.value<float>();
+                chunk.read(poly.translation, 3);
+                chunk.read(poly.normal, 3);
+                chunk.read(poly.boundingBox, 6);
+                
+                for (int k = 0; k < 6; k++) {
+                    poly.faces[k] = chunk.value<uint8_t>();
+                }
+                
+                poly.XYPlane = chunk.value<uint8_t>();
+                poly.truncated = chunk.value<uint8_t>();
+                poly.vertices = new double[3 * poly.numberOfNodes];
+                chunk.read(poly.vertices, 3 * poly.numberOfNodes);
+                poly.intersectionIndex.resize(chunk.value<uint64_t>());
+                
+                for (unsigned int j = 0; j < poly.intersectionIndex.size(); j++) {
+                    poly.intersectionIndex[j] = chunk.value<uint32_t>();
+                }
+            }
+        } else if (memcmp(chunk.tag, "INTS", 4) == 0) {
+            intPts.resize(chunk.value<uint64_t>());
+            
+            for (unsigned int i = 0; i < intPts.size(); i++) {
+                intPts[i].fract1 = chunk.value<int64_t>();
+                intPts[i].fract2 = chunk.value<int64_t>();
+                intPts[i].x1 = chunk.value<double>();
+                intPts[i].y1 = chunk.value<double>();
+                intPts[i].z1 = chunk.value<double>();
+                intPts[i].x2 = chunk.value<double>();
+                intPts[i].y2 = chunk.value<double>();
+                intPts[i].z2 = chunk.value<double>();
+                intPts[i].intersectionShortened = chunk.value<uint8_t>();
+                intPts[i].triplePointsIdx.resize(chunk.value<uint64_t>());
+                
+                for (unsigned int j = 0; j < intPts[i].triplePointsIdx.size(); j++) {
+                    intPts[i].triplePointsIdx[j] = chunk.value<uint32_t>();
+                }
+            }
+        } else if (memcmp(chunk.tag, "TRIP", 4) == 0) {
+            triplePoints.resize(chunk.value<uint64_t>());
+            
+            for (unsigned int i = 0; i < triplePoints.size(); i++) {
+                triplePoints[i].x = chunk.value<double>();
+                triplePoints[i].y = chunk.value<double>();
+                triplePoints[i].z = chunk.value<double>();
+            }
+        } else {
+            logString = "ERROR: Checkpoint " + checkpointFile + " has unknown chunk " + std::string(chunk.tag, 4) + "\n";
+            logger.writeLogFile(ERROR,  logString);
+            throw DFNError();
+        }
+        
+        chunksRead++;
+    }
+    
+    if (chunksRead != 7) {
+        logString = "ERROR: Checkpoint " + checkpointFile + " is incomplete\n";
+        logger.writeLogFile(ERROR,  logString);
+        throw DFNError();
+    }
+    
+    logString = "Resumed with " + to_string(pstats.acceptedPolyCount) + " accepted fractures\n";
+    logger.writeLogFile(INFO,  logString);
+}
@@ -0,0 +1,21 @@
+#ifndef _checkpoint_h_
+#define _checkpoint_h_
+#include <vector>
+#include <string>
+#include <random>
+#include "structures.h"
+
+/*! Checkpoint format version. Checkpoints are only read by the DFNGen version which
+    wrote them, increment whenever the saved state changes. */
+#define DFN_CHECKPOINT_VERSION 1
+
+void initCheckpoint(std::string inputFile, std::string output);
+void writeCheckpoint(std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints,
+                     Stats &pstats, std::vector<Shape> &shapeFamilies, float *CDF, int cdfSize,
+                     std::mt19937_64 &generator, unsigned long long radiiAllSize);
+void waitForCheckpoint();
+void readCheckpoint(std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints,
+                    Stats &pstats, std::vector<Shape> &shapeFamilies, float *&CDF, int &cdfSize,
+                    std::mt19937_64 &generator, unsigned long long &radiiAllSize);
+
+#endif
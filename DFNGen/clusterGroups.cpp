@@ -5,6 +5,7 @@
 #include "input.h"
 #include "mathFunctions.h"
 #include "logFile.h"
+#include "profile.h"
 
 /*  This code goes through all the polygons accepted into the domain and returns the indexes to those polygons
     which match the users boundary faces option.
@@ -37,7 +38,7 @@ fractGroups structure:
     Uses boundaryFaces input option to get the wanted fracture
     cluster before writing output files.
 
-    NOTE: 'boundaryFaces' array is a global variable
+    NOTE: 'boundaryFaces' array is an input parameter (params->boundaryFaces)
 
     Arg 1: Program statistics structure
     Return: Array (std vsector) of indices to fractures which remained after isolated and
@@ -55,7 +56,7 @@ std::vector<unsigned int> getCluster(Stats &pstats) {
     logString = "Number of groups: " + to_string(pstats.groupData.size()) +  "\n";
     logger.writeLogFile(INFO,  logString);
     
-    if (keepIsolatedFractures == 0) {
+    if (params->keepIsolatedFractures == 0) {
         // NOTE: (groupNumber-1) = corresponding groupData structures' index of the arary
         //       similarly, the index of groupData + 1 = groupNumber (due to groupNumber starting at 1, array starting at 0)
         
@@ -65,8 +66,8 @@ std::vector<unsigned int> getCluster(Stats &pstats) {
             // If the data is valid, meaning that group still exists (hasn't been merged to a new group) and
             // if the group has more than 1 fracture meaning there are intersections and
             // the cluster matches the requirements of the user's boundaryFaces option
-            if (ignoreBoundaryFaces == 0) {
-                if (pstats.groupData[i].valid == 1 && pstats.groupData[i].size > 1  && facesMatch(boundaryFaces, pstats.groupData[i].faces)) {
+            if (params->ignoreBoundaryFaces == 0) {
+                if (pstats.groupData[i].valid == 1 && pstats.groupData[i].size > 1  && facesMatch(params->boundaryFaces, pstats.groupData[i].faces)) {
                     matchingGroups.push_back(i + 1); //save matching group number
                 }
             } else { // Get all cluster groups
@@ -76,7 +77,7 @@ std::vector<unsigned int> getCluster(Stats &pstats) {
             }
         }
         
-        if (keepOnlyLargestCluster == 1 && matchingGroups.size() > 1) {
+        if (params->keepOnlyLargestCluster == 1 && matchingGroups.size() > 1) {
             // If only keeping the largest cluster, find group with largest size
             // Initialize largestGroup
             unsigned int largestGroup = matchingGroups[0];
@@ -101,6 +102,11 @@ std::vector<unsigned int> getCluster(Stats &pstats) {
                     for (unsigned int j = 0; j < pstats.fractGroup[k].polyList.size(); j++) {
                         finalPolyList.push_back(pstats.fractGroup[k].polyList[j]);
                     }
+                    
+                    // Streaming generation: all fractures are written, see streaming.h
+                    for (unsigned int j = 0; j < pstats.fractGroup[k].streamedList.size(); j++) {
+                        finalPolyList.push_back(pstats.fractGroup[k].streamedList[j]);
+                    }
                 }
             }
         }
@@ -152,6 +158,7 @@ bool facesMatch(bool *facesOption, bool *faces) {
     Arg 3: Index of 'newPoly' in the 'acceptedPoly' array (array of all accepted polys)
 */
 void assignGroup(Poly &newPoly, Stats &pstats, int newPolyIndex) {
+    ProfileTimer timer(PROF_CLUSTER_GROUPS);
     newPoly.groupNum = pstats.nextGroupNum;
     GroupData newGroupData; // Keeps fracture cluster data
     // Copy newPoly faces info to groupData
@@ -204,6 +211,7 @@ void assignGroup(Poly &newPoly, Stats &pstats, int newPolyIndex) {
 */
 
 void updateGroups(Poly &newPoly, std::vector<Poly> &acceptedPoly, std::vector<unsigned int> &encounteredGroups, Stats &pstats, int newPolyIndex) {
+    ProfileTimer timer(PROF_CLUSTER_GROUPS);
     if (encounteredGroups.size() == 0) {
         // 'newPoly' didn't encounter more than 1 other group of fractures
         // Save newPoly to the group structure
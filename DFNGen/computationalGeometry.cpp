@@ -13,6 +13,7 @@
 #include "testing.h"
 #include "clusterGroups.h"
 #include "logFile.h"
+#include "profile.h"
 
 /**********************************************************************/
 /*********************** 2D rotation matrix ***************************/
@@ -84,7 +85,7 @@ double *rotationMatrix_2(double *normalA, double *normalB) {
     
     // here, get the theta (z angle) between the normal vectors
     // If not parallel
-    if (!(std::abs(xProd[0]) < eps && std::abs(xProd[1]) < eps && std::abs(xProd[2]) < eps)) {
+    if (!(std::abs(xProd[0]) < params->eps && std::abs(xProd[1]) < params->eps && std::abs(xProd[2]) < params->eps)) {
         // sin = magnitude(AxB) and cos = A . B
         double sin = sqrt(xProd[0] * xProd[0] + xProd[1] * xProd[1] + xProd[2] * xProd[2]);
         double cos = dotProduct(normalA, normalB);
@@ -139,7 +140,7 @@ double *rotationMatrix(double *normalA, double *normalB) {
     double *xProd = crossProduct(normalA, normalB);
     
     // If not parallel
-    if (!(std::abs(xProd[0]) < eps && std::abs(xProd[1]) < eps && std::abs(xProd[2]) < eps)) {
+    if (!(std::abs(xProd[0]) < params->eps && std::abs(xProd[1]) < params->eps && std::abs(xProd[2]) < params->eps)) {
         // sin = magnitude(AxB) and cos = A . B
         double sin = sqrt(xProd[0] * xProd[0] + xProd[1] * xProd[1] + xProd[2] * xProd[2]);
         double cos = dotProduct(normalA, normalB);
@@ -202,7 +203,7 @@ void applyRotation3D(Poly &newPoly, double *normalB) {
     double *xProd = crossProduct(newPoly.normal, normalB);
     
     // If not parallel
-    if (!(std::abs(xProd[0]) < eps && std::abs(xProd[1]) < eps && std::abs(xProd[2]) < eps )) {
+    if (!(std::abs(xProd[0]) < params->eps && std::abs(xProd[1]) < params->eps && std::abs(xProd[2]) < params->eps )) {
         // NOTE: rotationMatrix() requires normals to be normalized
         double *R = rotationMatrix(newPoly.normal, normalB);
         
@@ -261,7 +262,7 @@ struct IntPoints polyAndIntersection_RotationToXY(struct IntPoints &intersection
     double *xProd = crossProduct(newPoly.normal, normalB);
     
     // If not parallel (zero vector)
-    if (!(std::abs(xProd[0]) < eps && std::abs(xProd[1]) < eps && std::abs(xProd[2]) < eps )) {
+    if (!(std::abs(xProd[0]) < params->eps && std::abs(xProd[1]) < params->eps && std::abs(xProd[2]) < params->eps )) {
         // rotationMatrix() requires normals to be normalized
         double *R = rotationMatrix(newPoly.normal, normalB);
         
@@ -416,6 +417,7 @@ void printBoundingBox(struct Poly &newPoly) {
     Arg 2: Poly 2
     Return: True if bounding box's intersect, false otherwise  */
 bool checkBoundingBox(Poly &poly1, Poly &poly2) {
+    ProfileSampledTimer timer(PROF_CHECK_BOUNDING_BOX);
     if (poly1.boundingBox[1] < poly2.boundingBox[0]) {
         return false;
     }
@@ -445,14 +447,273 @@ bool checkBoundingBox(Poly &poly1, Poly &poly2) {
 
 
 /**********************************************************************/
+/*********************************************************************/
+/****************** Plane Side ***************************************/
+/*! Signed distances of a polygon's vertices to the plane of another polygon,
+    computed as in findIntersections(). The loop has no branches so that the
+    compiler vectorizes it.
+    Template argument: Number of vertices of the polygon, 0 for any number
+    Arg 1: Polygon whose vertices are classified
+    Arg 2: Polygon defining the plane (first vertex and normal vector)
+    Arg 3: OUTPUT, distance of each vertex, poly.numberOfNodes values
+    Return: True if all vertices are on the same side of the plane, at least
+            eps away from it. The polygons do not intersect. */
+template <int N>
+static bool planeSide(const Poly &poly, const Poly &plane, double *dist) {
+    const double *vertices = poly.vertices;
+    const double px = plane.vertices[0], py = plane.vertices[1], pz = plane.vertices[2];
+    const double nx = plane.normal[0], ny = plane.normal[1], nz = plane.normal[2];
+    const int nNodes = N > 0 ? N : poly.numberOfNodes;
+    // Local copy, 'dist' could point to the global eps
+    const double tolerance = params->eps;
+    // Counted in doubles: same vector width as the distances, the loop is vectorized
+    double above = 0;
+    double below = 0;
+    
+    for (int i = 0; i < nNodes; i++) {
+        double d = (vertices[3 * i] - px) * nx + (vertices[3 * i + 1] - py) * ny + (vertices[3 * i + 2] - pz) * nz;
+        dist[i] = d;
+        above += d >= tolerance;
+        below += d <= -tolerance;
+    }
+    
+    return above == nNodes || below == nNodes;
+}
+
+
+/*********************************************************************/
+/****************** Plane Crossings **********************************/
+/*! One pass of findIntersections(): points where the edges of F2 cross
+    the plane of F1 (P1)
+    Template argument: Number of vertices of F2, 0 for any number. With a
+                       fixed number the vertex loops are unrolled.
+    Arg 1: F2
+    Arg 2: F1
+    Arg 3: OUTPUT, two intersection points of F2 and P1 {x,y,z} * 2,
+           the same point twice if a vertex of F2 is on P1
+    Return: Number of intersection points, 0 if F2 does not reach P1 */
+template <int N>
+static int planeCrossings(const Poly &F2, const Poly &F1, double *inters2) {
+    int count = 0; // Intersection point number
+    const int nVertices2 = N > 0 ? N : F2.numberOfNodes;
+    // Distances of the vertices of F2 to the plane of F1
+    double distBuffer[N > 0 ? N : 32];
+    std::vector<double> distHeap;
+    double *dist = distBuffer;
+    
+    if (N == 0 && nVertices2 > 32) {
+        distHeap.resize(nVertices2);
+        dist = distHeap.data();
+    }
+    
+    // Fast reject: if all vertices of F2 are on the same side of F1's plane, the
+    // loop below finds no intersection points. Bounding boxes of inclined
+    // fractures often overlap when the fractures do not.
+    if (planeSide<N>(F2, F1, dist)) {
+        return 0;
+    }
+    
+    const double *vertices = F2.vertices;
+    int index = (nVertices2 - 1) * 3; // Index to last vertice
+    /* vector of first vertex of F1 to a vertex on F2 dot normal vector of F1
+       it's absolute value is the distance, see planeSide() */
+    double prevdist = dist[nVertices2 - 1];
+    double currdist;
+    
+    for (int i = 0; i < nVertices2; i++) { // i: current point
+        currdist = dist[i];
+        
+        if (std::abs(prevdist) < params->eps) {
+            if (i == 0) {
+                // Previous point is intersection point
+                inters2[0] = vertices[index];   // x
+                inters2[1] = vertices[index + 1]; // y
+                inters2[2] = vertices[index + 2]; // z
+                count++;
+            } else {
+                int idx = (i - 1) * 3;
+                int countidx = count * 3;
+                inters2[countidx]   = vertices[idx];   // x
+                inters2[countidx + 1] = vertices[idx + 1]; // y
+                inters2[countidx + 2] = vertices[idx + 2]; // z
+                count++;
+            }
+        } else {
+            double currTimesPrev = currdist * prevdist;
+            
+            if (std::abs(currTimesPrev) < params->eps) {
+                currTimesPrev = 0;
+            }
+            
+            if (currTimesPrev < 0) {
+                // If consecutive vertices of F2 are at opposide sides of P1,
+                // computes intersection point of F2 and P1
+                double c = std::abs(prevdist) / (std::abs(currdist) + std::abs(prevdist));
+                int countidx = count * 3;
+                
+                if(i == 0) {
+                    inters2[countidx]   = vertices[index]
+                                          + (vertices[0] - vertices[index]) * c;
+                    inters2[countidx + 1] = vertices[index + 1]
+                                            + (vertices[1] - vertices[index + 1]) * c;
+                    inters2[countidx + 2] = vertices[index + 2]
+                                            + (vertices[2] - vertices[index + 2]) * c;
+                    count++;
+                } else {
+                    int idx = (i - 1) * 3;
+                    int x = i * 3;
+                    inters2[countidx]   = vertices[idx]
+                                          + (vertices[x] - vertices[idx]) * c;
+                    inters2[countidx + 1] = vertices[idx + 1]
+                                            + (vertices[x + 1] - vertices[idx + 1]) * c;
+                    inters2[countidx + 2] = vertices[idx + 2]
+                                            + (vertices[x + 2] - vertices[idx + 2]) * c;
+                    count++;
+                }
+            }
+        }
+        
+        prevdist = currdist;
+        
+        if (count == 2) {
+            break;
+        }
+    } // End vertice loop
+    
+    if (count == 0) {
+        return 0;
+    }
+    
+    if (count == 1) {
+        // If only one intersection point, happens only when a vertex of F2 is on P1
+        count = 2;
+        inters2[3] = inters2[0];
+        inters2[4] = inters2[1];
+        inters2[5] = inters2[2];
+    }
+    
+    for (int k = 0; k < 6; k++) {
+        if (std::abs(inters2[k]) < params->eps) {
+            inters2[k] = 0;
+        }
+    }
+    
+    return count;
+}
+
+
+/*********************************************************************/
+/****************** Intersection From Crossings **********************/
+/*! Intersection of two polygons from the points where each polygon
+    crosses the other's plane. Last part of findIntersections().
+    Arg 1: OUTPUT, flag (see findIntersections())
+    Arg 2: Number of intersection points of the last pass, 0 if the
+           polygons do not intersect
+    Arg 3: Intersection points, poly 2 with plane of poly 1 then
+           poly 1 with plane of poly 2, {x,y,z} * 4
+    Return: Intersection end points, Valid only if flag != 0 */
+static struct IntPoints intersectionFromCrossings(short &flag, int count, double *inters) {
+    IntPoints intPts; // Final intersection points
+    flag = 0;
+    
+    if (count == 0) {
+        return intPts;
+    }
+    
+    // Intersection points exist
+    if (count > 2) {
+        std::string logString = "Error in findIntersections()\n";
+        logger.writeLogFile(ERROR,  logString);
+    }
+    
+    // Use delete[] on 'stdev', created dynamically
+    double *stdev = sumDevAry3(inters);
+    int o = maxElmtIdx(stdev, 3);
+    double tempAry[4] = {inters[o], inters[o + 3], inters[o + 6], inters[o + 9]};
+    int *s = sortedIndex(tempAry, 4);
+    
+    if (!(s[0] + s[1] == 1 || s[0] + s[1] == 5)) {
+        // If the smallest two points are not on the bdy of the same poly,
+        // the polygons intersect. middle two points form intersetion
+        int idx1 = s[1] * 3;
+        int idx2 = s[2] * 3;
+        intPts.x1 = inters[idx1];   // x1
+        intPts.y1 = inters[idx1 + 1]; // y1
+        intPts.z1 = inters[idx1 + 2]; // z1
+        intPts.x2 = inters[idx2];   // x2
+        intPts.y2 = inters[idx2 + 1]; // y2
+        intPts.z2 = inters[idx2 + 2]; // z2
+        
+        // Assign flag (definitions at top of findIntersections())
+        if (s[1] + s[2] == 1) {
+            flag = 1;
+        }    // Intersection inside poly1
+        else if (s[1] + s[2] == 5 ) {
+            flag = 2;
+        }    // Intersection inside poly2
+        else {
+            flag = 3;
+        }    // Intersection on edges
+    } else { // Intersection doesn't exist
+        flag = 0; // No intersection
+    }
+    
+    delete[] s;
+    delete[] stdev;
+    return intPts;
+}
+
+
+/*********************************************************************/
+/*! findIntersections() for polygons with N1 and N2 vertices, 0 for any number */
+template <int N1, int N2>
+static struct IntPoints findIntersectionsKernel(short &flag, Poly &poly1, Poly &poly2) {
+    double inters[12]; // Stores 4 possible intersection points {x,y,z} * 3
+    // Intersections of poly 2 with the plane of poly 1
+    int count = planeCrossings<N2>(poly2, poly1, inters);
+    
+    if (count != 0) {
+        // Intersections of poly 1 with the plane of poly 2
+        count = planeCrossings<N1>(poly1, poly2, inters + 6);
+    }
+    
+    return intersectionFromCrossings(flag, count, inters);
+}
+
+
+/*! Selects the kernel for poly2's number of vertices */
+template <int N1>
+static struct IntPoints findIntersectionsKernel(short &flag, Poly &poly1, Poly &poly2) {
+    switch (poly2.numberOfNodes) {
+    case 4:
+        return findIntersectionsKernel<N1, 4>(flag, poly1, poly2);
+    
+    case 8:
+        return findIntersectionsKernel<N1, 8>(flag, poly1, poly2);
+    
+    case 12:
+        return findIntersectionsKernel<N1, 12>(flag, poly1, poly2);
+    
+    case 16:
+        return findIntersectionsKernel<N1, 16>(flag, poly1, poly2);
+    
+    default:
+        return findIntersectionsKernel<N1, 0>(flag, poly1, poly2);
+    }
+}
+
+
 /****************** Find Intersections ********************************/
 /*! Finds intersection end points of two intersecting polygons (Poly 1 and Poly 2)
     Or, finds that polygons do not intersect (flag will = 0 )
+    Rectangles (4 vertices) and ellipses with 8, 12 or 16 vertices use kernels
+    compiled for their number of vertices, selected once per pair.
     Arg 1: OUTPUT, flag (see definitions below)
     Arg 2: Poly 1
     Arg 3: Poly 2
     Return: Intersection end points, Valid only if flag != 0 */
 struct IntPoints findIntersections(short &flag, Poly &poly1, Poly &poly2) {
+    ProfileTimer timer(PROF_FIND_INTERSECTIONS);
     /* FLAGS: 0 = no intersection
        NOTE: The only flag which is currently used is '0'
              1 = intersection is completely inside poly 1 (new fracture)/poly)
@@ -463,175 +724,22 @@ struct IntPoints findIntersections(short &flag, Poly &poly1, Poly &poly2) {
     */
 // This code is mostly converted directly from the mathematica version.
 // Re-write may be worth doing for increased performance and code clarity
-    flag = 0;
-    IntPoints intPts; // Final intersection points
-    int count;
-    Poly *F1; // Fracture 1
-    Poly *F2; // Fracture 2
-    double inters2[6]; // Temporary intersection points of F2 and P1
-    double inters[12]; // Stores 4 possible intersection points {x,y,z} * 3
-    double temp[3];
+    switch (poly1.numberOfNodes) {
+    case 4:
+        return findIntersectionsKernel<4>(flag, poly1, poly2);
     
-    // Get intersecction points
-    for (int jj = 0; jj < 2; jj++) {
-        count = 0; // Intersection point number
-        
-        if (jj == 0 ) {
-            F1 = &poly1;
-            F2 = &poly2;
-        } else {
-            F1 = &poly2;
-            F2 = &poly1;
-        }
-        
-        int nVertices2 = F2->numberOfNodes;
-        int index = (nVertices2 - 1) * 3; // Index to last vertice
-        double vertex1[3] = { F1->vertices[0], F1->vertices[1], F1->vertices[2] };
-        temp[0] = F2->vertices[index]   - vertex1[0]; // x1 -x2
-        temp[1] = F2->vertices[index + 1] - vertex1[1]; // y1 - y2
-        temp[2] = F2->vertices[index + 2] - vertex1[2]; // z1 - z2
-        double prevdist = dotProduct(temp, F1->normal);
-        double currdist;
-        
-        for (int i = 0; i < nVertices2; i++) { // i: current point
-            int idx = i * 3;
-            /* vector of vertex1 to a vertex on F2 dot normal vector of F1
-               it's absolute value is the distance */
-            temp[0] = F2->vertices[idx]   - vertex1[0];
-            temp[1] = F2->vertices[idx + 1] - vertex1[1];
-            temp[2] = F2->vertices[idx + 2] - vertex1[2];
-            currdist = dotProduct(temp, F1->normal);
-            
-            if (std::abs(prevdist) < eps) {
-                if (i == 0) {
-                    // Previous point is intersection point
-                    inters2[0] = F2->vertices[index];   // x
-                    inters2[1] = F2->vertices[index + 1]; // y
-                    inters2[2] = F2->vertices[index + 2]; // z
-                    count++;
-                } else {
-                    int idx = (i - 1) * 3;
-                    int countidx = count * 3;
-                    inters2[countidx]   = F2->vertices[idx];   // x
-                    inters2[countidx + 1] = F2->vertices[idx + 1]; // y
-                    inters2[countidx + 2] = F2->vertices[idx + 2]; // z
-                    count++;
-                }
-            } else {
-                double currTimesPrev = currdist * prevdist;
-                
-                if (std::abs(currTimesPrev) < eps) {
-                    currTimesPrev = 0;
-                }
-                
-                if (currTimesPrev < 0) {
-                    // If consecutive vertices of F2 are at opposide sides of P1,
-                    // computes intersection point of F2 and P1
-                    double c = std::abs(prevdist) / (std::abs(currdist) + std::abs(prevdist));
-                    int countidx = count * 3;
-                    
-                    if(i == 0) {
-                        inters2[countidx]   = F2->vertices[index]
-                                              + (F2->vertices[0] - F2->vertices[index]) * c;
-                        inters2[countidx + 1] = F2->vertices[index + 1]
-                                                + (F2->vertices[1] - F2->vertices[index + 1]) * c;
-                        inters2[countidx + 2] = F2->vertices[index + 2]
-                                                + (F2->vertices[2] - F2->vertices[index + 2]) * c;
-                        count++;
-                    } else {
-                        int idx = (i - 1) * 3;
-                        int x = i * 3;
-                        inters2[countidx]   = F2->vertices[idx]
-                                              + (F2->vertices[x] - F2->vertices[idx]) * c;
-                        inters2[countidx + 1] = F2->vertices[idx + 1]
-                                                + (F2->vertices[x + 1] - F2->vertices[idx + 1]) * c;
-                        inters2[countidx + 2] = F2->vertices[idx + 2]
-                                                + (F2->vertices[x + 2] - F2->vertices[idx + 2]) * c;
-                        count++;
-                    }
-                }
-            }
-            
-            prevdist = currdist;
-            
-            if (count == 2) {
-                break;
-            }
-        } // End vertice loop
-        
-        if (count == 1) {
-            // If only one intersection point, happens only when a vertex of F2 is on P1
-            count = 2;
-            inters2[3] = inters2[0];
-            inters2[4] = inters2[1];
-            inters2[5] = inters2[2];
-        }
-        
-        for (int k = 0; k < 6; k++) {
-            if (std::abs(inters2[k]) < eps) {
-                inters2[k] = 0;
-            }
-        }
-        
-        // copy to inters array
-        int jindx = 6 * jj;
-        inters[jindx]   = inters2[0];
-        inters[jindx + 1] = inters2[1];
-        inters[jindx + 2] = inters2[2];
-        inters[jindx + 3] = inters2[3];
-        inters[jindx + 4] = inters2[4];
-        inters[jindx + 5] = inters2[5];
-        
-        if (count == 0) {
-            break;
-        } // No intersection
-    } // End loop for jj, loop for getting intersections for fracture i and newPoly
+    case 8:
+        return findIntersectionsKernel<8>(flag, poly1, poly2);
     
-    if (count == 0) {
-        flag = 0;
-    } else { // Intersection points exist
-        if (count > 2) {
-            std::string logString = "Error in findIntersections()\n";
-            logger.writeLogFile(ERROR,  logString);
-        }
-        
-        // Use delete[] on 'stdev', created dynamically
-        double *stdev = sumDevAry3(inters);
-        int o = maxElmtIdx(stdev, 3);
-        double tempAry[4] = {inters[o], inters[o + 3], inters[o + 6], inters[o + 9]};
-        int *s = sortedIndex(tempAry, 4);
-        
-        if (!(s[0] + s[1] == 1 || s[0] + s[1] == 5)) {
-            // If the smallest two points are not on the bdy of the same poly,
-            // the polygons intersect. middle two points form intersetion
-            int idx1 = s[1] * 3;
-            int idx2 = s[2] * 3;
-            intPts.x1 = inters[idx1];   // x1
-            intPts.y1 = inters[idx1 + 1]; // y1
-            intPts.z1 = inters[idx1 + 2]; // z1
-            intPts.x2 = inters[idx2];   // x2
-            intPts.y2 = inters[idx2 + 1]; // y2
-            intPts.z2 = inters[idx2 + 2]; // z2
-            
-            // Assign flag (definitions at top of funciton)
-            if (s[1] + s[2] == 1) {
-                flag = 1;
-            }    // Intersection inside poly1
-            else if (s[1] + s[2] == 5 ) {
-                flag = 2;
-            }    // Intersection inside poly2
-            else {
-                flag = 3;
-            }    // Intersection on edges
-        } else { // Intersection doesn't exist
-            flag = 0; // No intersection
-        }
-        
-        delete[] s;
-        delete[] stdev;
-    } // End  intersection points exist
+    case 12:
+        return findIntersectionsKernel<12>(flag, poly1, poly2);
     
-    return intPts;
+    case 16:
+        return findIntersectionsKernel<16>(flag, poly1, poly2);
+    
+    default:
+        return findIntersectionsKernel<0>(flag, poly1, poly2);
+    }
 }
 
 
@@ -656,15 +764,16 @@ struct IntPoints findIntersections(short &flag, Poly &poly1, Poly &poly2) {
             data untill newPoly has been accepted
     Return: 0 (False) if accepted, 1 (True) if rejected */
 int FRAM(IntPoints &intPts, unsigned int count, std::vector<IntPoints> &intPtsList, Poly &newPoly, Poly &poly2, Stats &pstats, std::vector<TriplePtTempData> &tempData, std::vector<Point> &triplePoints, std::vector<IntPoints> &tempIntPts) {
-    if (disableFram == false) {
+    ProfileTimer timer(PROF_FRAM);
+    if (params->disableFram == false) {
         /******* Check for intersection of length less than h *******/
-        if (magnitude(intPts.x1 - intPts.x2, intPts.y1 - intPts.y2, intPts.z1 - intPts.z2) < h) {
+        if (magnitude(intPts.x1 - intPts.x2, intPts.y1 - intPts.y2, intPts.z1 - intPts.z2) < params->h) {
             //std::cout+"\nrejectCode = -2: Intersection of length <= h.\n";
             pstats.rejectionReasons.shortIntersection++;
             return -2;
         }
         
-        if (rFram == false) {
+        if (params->rFram == false) {
             /******************* distance to edges *****************/
             // Reject if intersection shirnks < 'shrinkLimit'
             double shrinkLimit = 0.9 * magnitude(intPts.x1 - intPts.x2, intPts.y1 - intPts.y2, intPts.z1 - intPts.z2);
@@ -685,7 +794,7 @@ int FRAM(IntPoints &intPts, unsigned int count, std::vector<IntPoints> &intPtsLi
             // Check distance from new intersection to other intersections on
             // poly2 (fracture newPoly is intersecting with)
             
-            if (checkDistToOldIntersections(intPtsList, intPts, poly2, h)) {
+            if (checkDistToOldIntersections(intPtsList, intPts, poly2, params->h)) {
                 pstats.rejectionReasons.interCloseToInter++;
                 return -5;
             }
@@ -693,7 +802,7 @@ int FRAM(IntPoints &intPts, unsigned int count, std::vector<IntPoints> &intPtsLi
             // Check distance from new intersection to intersections already
             // existing on newPoly
             // Also checks for undetected triple points
-            if (checkDistToNewIntersections(tempIntPts, intPts, tempData, h)) {
+            if (checkDistToNewIntersections(tempIntPts, intPts, tempData, params->h)) {
                 pstats.rejectionReasons.interCloseToInter++;
                 return -5;
             }
@@ -704,15 +813,15 @@ int FRAM(IntPoints &intPts, unsigned int count, std::vector<IntPoints> &intPtsLi
         // -14 <= rejCode <= -10 are for triple intersection rejections
         int rejCode = checkForTripleIntersections(intPts, count, intPtsList, newPoly, poly2, tempData, triplePoints);
         
-        if (rejCode != 0 && rFram == false) {
+        if (rejCode != 0 && params->rFram == false) {
             pstats.rejectionReasons.triple++;
             return rejCode;
         }
         
         // Check if polys intersect on same plane
-        if (std::abs(newPoly.normal[0] - poly2.normal[0]) < eps // If the normals are the same
-                && std::abs(newPoly.normal[1] - poly2.normal[1]) < eps
-                && std::abs(newPoly.normal[2] - poly2.normal[2]) < eps ) {
+        if (std::abs(newPoly.normal[0] - poly2.normal[0]) < params->eps // If the normals are the same
+                && std::abs(newPoly.normal[1] - poly2.normal[1]) < params->eps
+                && std::abs(newPoly.normal[2] - poly2.normal[2]) < params->eps ) {
             return -7; // The intersection has already been found so we know that if the
             // normals are the same they must be on the same plane
         }
@@ -732,6 +841,7 @@ int FRAM(IntPoints &intPts, unsigned int count, std::vector<IntPoints> &intPtsLi
     Return: 0 if no all distances are larger than minDistance or minDistance = 0 with triple intersection point
             1 Otherwise */
 bool checkDistToOldIntersections(std::vector<IntPoints> &intPtsList, IntPoints &intPts, Poly &poly2, double minDistance) {
+    ProfileTimer timer(PROF_DIST_TO_OLD_INTERSECTIONS);
     double intersection[6] = {intPts.x1, intPts.y1, intPts.z1, intPts.x2, intPts.y2, intPts.z2};
     int intSize = poly2.intersectionIndex.size();
     double dist;
@@ -743,7 +853,7 @@ bool checkDistToOldIntersections(std::vector<IntPoints> &intPtsList, IntPoints &
                          };
         dist = lineSegToLineSeg(intersection, int2, pt);
         
-        if (dist < (minDistance - eps) && dist > eps) {
+        if (dist < (minDistance - params->eps) && dist > params->eps) {
             return 1;
         }
     }
@@ -766,6 +876,7 @@ bool checkDistToOldIntersections(std::vector<IntPoints> &intPtsList, IntPoints &
           Due to the shrinkIntersection algorithm, it may be possible for a triple intersection point
           to exist on only one fracture. This check resolves this issue. */
 bool checkDistToNewIntersections(std::vector<IntPoints> &tempIntPts, IntPoints &intPts, std::vector<TriplePtTempData> &tempTriPts, double minDistance) {
+    ProfileTimer timer(PROF_DIST_TO_NEW_INTERSECTIONS);
     int intSize = tempIntPts.size();
     double intersection[6] = {intPts.x1, intPts.y1, intPts.z1, intPts.x2, intPts.y2, intPts.z2};
     Point pt; // Pt of intersection if lines intersect
@@ -776,9 +887,9 @@ bool checkDistToNewIntersections(std::vector<IntPoints> &tempIntPts, IntPoints &
                          };
         double dist = lineSegToLineSeg(intersection, int2, pt);
         
-        if (dist < minDistance && dist > eps) {
+        if (dist < minDistance && dist > params->eps) {
             return 1;
-        } else if (dist < eps) {
+        } else if (dist < params->eps) {
             // Make sure there is a triple intersection point
             // before accepting
             bool reject = true;
@@ -786,9 +897,9 @@ bool checkDistToNewIntersections(std::vector<IntPoints> &tempIntPts, IntPoints &
             
             for (int i = 0; i < size; i++) {
                 // If the triple point is found, continue with checks, else reject
-                if (std:: abs(pt.x - tempTriPts[i].triplePoint.x) < eps
-                        && std::abs(pt.y - tempTriPts[i].triplePoint.y) < eps
-                        && std::abs(pt.z - tempTriPts[i].triplePoint.z) < eps) {
+                if (std:: abs(pt.x - tempTriPts[i].triplePoint.x) < params->eps
+                        && std::abs(pt.y - tempTriPts[i].triplePoint.y) < params->eps
+                        && std::abs(pt.z - tempTriPts[i].triplePoint.z) < params->eps) {
                     reject = false;
                     break;
                 }
@@ -824,10 +935,11 @@ bool checkDistToNewIntersections(std::vector<IntPoints> &tempIntPts, IntPoints &
               and minDist <= dist to edge && shrinkLimit <= intersection length
             1 If intersection length shrinks to less than shrinkLimit  */
 bool shrinkIntersection(IntPoints &intPts, double *edge, double shrinkLimit, double firstNodeMinDist, double minDist) {
+    ProfileTimer timer(PROF_SHRINK_INTERSECTION);
     double vect[3] = {(intPts.x2 - intPts.x1), (intPts.y2 - intPts.y1), (intPts.z2 - intPts.z1)};
     double dist = magnitude(vect[0], vect[1], vect[2]);
     // n is number of discrete points on intersection
-    int n = std::ceil(2 * dist / h);
+    int n = std::ceil(2 * dist / params->h);
     double stepSize = 1 / (double)n;
     double pt[3] = {intPts.x1, intPts.y1, intPts.z1};
     // Start step at first descrete point
@@ -860,7 +972,7 @@ bool shrinkIntersection(IntPoints &intPts, double *edge, double shrinkLimit, dou
             double dist = pointToLineSeg(ptOnIntersection, edge);
             
             if (firstPt == true && (dist > firstNodeMinDist)) { // || (stepSize == 1 && dist < eps)))  {
-                if (firstPtDistToEdge < eps || firstPtDistToEdge >= minDist) {
+                if (firstPtDistToEdge < params->eps || firstPtDistToEdge >= minDist) {
                     // Leave intersection end point un-modified
                     break;
                 }
@@ -907,7 +1019,7 @@ bool shrinkIntersection(IntPoints &intPts, double *edge, double shrinkLimit, dou
     This function saves intersections, and updates cluster groups when a poly is accepted.
     This functino returns 0 if the poly was accepted and 1 if rejected. User needs to push the newPoly
     into the accepted poly array if this function returns 0
-
+    
     Arg 1: Polygon being tested (newest poly to come into the DFN)
     Arg 2: Array of all accepted polygons
     Arg 3: Array of all accepted intersections
@@ -918,6 +1030,15 @@ bool shrinkIntersection(IntPoints &intPts, double *edge, double shrinkLimit, dou
                 the minimum feature size h (Passed all FRAM tests)
             1 - Otherwise */
 int intersectionChecking(struct Poly &newPoly, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPtsList, struct Stats &pstats, std::vector<Point> &triplePoints) {
+    return intersectionChecking(newPoly, acceptedPoly, NULL, intPtsList, pstats, triplePoints);
+}
+
+/*! Same as above. If 'found' is not NULL, it replaces the bounding box and intersection
+    search: it holds every intersection of newPoly with an accepted fracture, in order
+    of the accepted fracture's index (see FoundIntersection).
+    Arg 3: Intersections of newPoly found before, or NULL to search all accepted polygons */
+int intersectionChecking(struct Poly &newPoly, std::vector<Poly> &acceptedPoly, const std::vector<FoundIntersection> *found, std::vector<IntPoints> &intPtsList, struct Stats &pstats, std::vector<Point> &triplePoints) {
+    ProfileTimer timer(PROF_INTERSECTION_CHECKING);
     // List of fractures which new fracture intersected.
     // Used to update fractures intersections and
     // intersection count if newPoly is accepted
@@ -932,15 +1053,16 @@ int intersectionChecking(struct Poly &newPoly, std::vector<Poly> &acceptedPoly,
     // Counts number of accepted intersections on newPoly.
     unsigned int count = 0;
     std::vector<TriplePtTempData> tempData;
-    unsigned int size = acceptedPoly.size();
+    unsigned int size = found != NULL ? found->size() : acceptedPoly.size();
     
-    for (unsigned int ii = 0; ii < size; ii++) {
-        short flag;
+    for (unsigned int k = 0; k < size; k++) {
+        unsigned int ii = found != NULL ? (*found)[k].fracture : k;
+        short flag = 1;
         
         // NOTE: findIntersections() searches bounding boxes
         // Bounding box search
-        if (checkBoundingBox(newPoly, acceptedPoly[ii])) {
-            IntPoints intersection = findIntersections(flag, newPoly, acceptedPoly[ii]);
+        if (found != NULL || checkBoundingBox(newPoly, acceptedPoly[ii])) {
+            IntPoints intersection = found != NULL ? (*found)[k].intersection : findIntersections(flag, newPoly, acceptedPoly[ii]);
             
             if (flag != 0) { // If flag != 0, intersection exists
                 // Holds origintal intersection, used to update
@@ -957,8 +1079,6 @@ int intersectionChecking(struct Poly &newPoly, std::vector<Poly> &acceptedPoly,
                     intersection.fract2 = newPolyIndex; // newPolys ID/index in array of accpted polys, if accepted
                     // 'tempIntersectList' keeps all fracture #'s intersecting with newPoly
                     tempIntersectList.push_back(ii); // Save fracture index to update if newPoly accepted
-                    // Save index to polys intersections (intPts) array
-                    newPoly.intersectionIndex.push_back(intPtsIndex + count);
                     count++; // Increment counter of number of fractures intersecting with newPoly
                     tempIntPts.push_back(intersection); // Save intersection
                     
@@ -993,6 +1113,9 @@ int intersectionChecking(struct Poly &newPoly, std::vector<Poly> &acceptedPoly,
         
         // Update poly's indexs to intersections list (intpts)
         for (unsigned int i = 0; i < tempIntersectList.size(); i++) {
+            // Save index to newPoly's intersections. Only done once newPoly is
+            // accepted, rejected attempts do not take space in the index pool
+            newPoly.intersectionIndex.push_back(intPtsIndex + i);
             // Update each intersected poly's intersection index
             acceptedPoly[tempIntersectList[i]].intersectionIndex.push_back(intPtsIndex + i);
             // intPtsIndex+i will be the index position of the intersection once it is saved to the intersections array
@@ -1003,7 +1126,7 @@ int intersectionChecking(struct Poly &newPoly, std::vector<Poly> &acceptedPoly,
         // triple intersection points will be found 3 times (3 fractures make up one triple int point)
         // We need only to save the point to the permanent triplePoints array once, and then give each intersection a
         // reference to it.
-        if (tripleIntersections == 1) {
+        if (params->tripleIntersections == 1) {
             unsigned int tripIndex = triplePoints.size();
             
             for (unsigned int j = 0; j < tempData.size(); j++) { // Loop through newly found triple points
@@ -1069,7 +1192,7 @@ bool checkDistanceFromNodes(struct Poly &poly, IntPoints &intPts, double minDist
             dist = temp;
         }
         
-        if (dist < minDist && dist > eps) {
+        if (dist < minDist && dist > params->eps) {
             pstats.rejectionReasons.closeToNode++;
             return 1;
         }
@@ -1088,7 +1211,7 @@ bool checkDistanceFromNodes(struct Poly &poly, IntPoints &intPts, double minDist
 double pointToLineSeg(const double *point, const double *line) {
     const double sqrLineLen = sqrMagnitude(line[0] - line[3], line[1] - line[4], line[2] - line[5]); // i.e. |w-v|^2 -  avoid a sqrt
     
-    if (sqrLineLen < eps) {
+    if (sqrLineLen < params->eps) {
         // Line endpoints are equal to each other
         return magnitude(point[0] - line[0], point[1] - line[1], point[2] - line[2]);
     }
@@ -1111,7 +1234,7 @@ double pointToLineSeg(const double *point, const double *line) {
 double pointToLineSeg(const Point &point, const double *line) {
     const double sqrLineLen = sqrMagnitude(line[0] - line[3], line[1] - line[4], line[2] - line[5]); // i.e. |w-v|^2 -  avoid a sqrt
     
-    if (sqrLineLen < eps) {
+    if (sqrLineLen < params->eps) {
         // Line endpoints are equal to each other
         return magnitude(point.x - line[0], point.y - line[1], point.z - line[2]);
     }
@@ -1156,7 +1279,7 @@ bool pointOnLineSeg(const double *pt, const double *line) {
     // If zero, pt is between endpoints, and on line
     double result  = endPtToPt_Dist + ptToEndPt_Dist - endPttoEndPt_Dist;
     
-    if (-eps < result && result < eps) {
+    if (-params->eps < result && result < params->eps) {
         return true;
     }
     
@@ -1193,7 +1316,7 @@ bool pointOnLineSeg(const Point &pt, const double *line) {
     // if zero, pt is between and on line
     double result  = endPtToPt_Dist + ptToEndPt_Dist - endPttoEndPt_Dist;
     
-    if (-eps < result && result < eps) {
+    if (-params->eps < result && result < params->eps) {
         return true;
     }
     
@@ -1202,33 +1325,26 @@ bool pointOnLineSeg(const Point &pt, const double *line) {
 
 
 /********************************************************************************/
-/****************** Check if nodes are too close to edge ************************/
-/*! Checks distances from intersection to poly edges. If the distance is less than
-    h, the intersection is allowed to shrink by %10 of its original length. If
-    the intersection is still closer than h to a poly edge, the polygon is rejected.
-
-    Arg 1: Poly to be tested
-    Arg 2: IntPoints intersection to be tested
-    Arg 3: Minimum length the intersection is allowed to shinrk to
-    Arg 4: Stats program statistics structure, used to report stats on how much
-           intersection length is being reduced by from shrinkIntersection() */
-bool checkCloseEdge(Poly &poly1, IntPoints &intPts, double shrinkLimit, Stats &pstats) {
+/*! checkCloseEdge() for a polygon with N vertices, 0 for any number */
+template <int N>
+static bool checkCloseEdgeKernel(Poly &poly1, IntPoints &intPts, double shrinkLimit, Stats &pstats) {
     // 'line' is newest intersection end points
     double line[6] = {intPts.x1, intPts.y1, intPts.z1, intPts.x2, intPts.y2, intPts.z2};
     // minDist is the minimum distance allowed from an end point to the edge of a polygon
     // if the intersection does not land accross a poly's edge
-    double minDist = h;
+    double minDist = params->h;
     // Counts how many endPoints are on the polys edge.
     // If both end points of intersection are on polys edge,
     // we must check the distance from end points to
     // vertices
     int onEdgeCount = 0;
+    const int nNodes = N > 0 ? N : poly1.numberOfNodes;
     
-    for (int i = 0; i < poly1.numberOfNodes; i++) {
+    for (int i = 0; i < nNodes; i++) {
         int next;
         int idx = 3 * i;
         
-        if (i != poly1.numberOfNodes - 1) {
+        if (i != nNodes - 1) {
             next = (i + 1) * 3;
         } else { // If last edge on polygon
             next = 0;
@@ -1248,21 +1364,21 @@ bool checkCloseEdge(Poly &poly1, IntPoints &intPts, double shrinkLimit, Stats &p
         
         // If two smallest distances are < h,
         // the line is almost parallel and closer to edge than h, reject it
-        if ((endPtsToEdge[0] < h && endPtsToEdge[1] < h) && endPtsToEdge[0] > eps) {
+        if ((endPtsToEdge[0] < params->h && endPtsToEdge[1] < params->h) && endPtsToEdge[0] > params->eps) {
             return 1;
         }
         
         // Minimum dist from poly edge segment to intersection segment
         double dist = lineSegToLineSeg(edge, line, pt);
         
-        if (dist < minDist && dist > eps) {
+        if (dist < minDist && dist > params->eps) {
             // Try to shrink the intersection slightly in order to
             // not reject the polygon
-            if (shrinkIntersection(intPts, edge, shrinkLimit, h, h) == 1) {
+            if (shrinkIntersection(intPts, edge, shrinkLimit, params->h, params->h) == 1) {
                 // Returns one if insterection shrinks to less than .9*h
                 return 1;
             }
-        } else if (dist < eps) {
+        } else if (dist < params->eps) {
             // Endpoint is almost exactly on poly's edge, must check
             // whether the discretized nodes will ne closer
             // than the minimum allowed distance
@@ -1270,9 +1386,9 @@ bool checkCloseEdge(Poly &poly1, IntPoints &intPts, double shrinkLimit, Stats &p
             // distance to edge rules
             // NOTE: Intersections discretize with set size = .5*h
             // Minimum distance to edge must be less than .5*h to allow for angles
-            const static double minDist2 = 0.4 * h;
+            const static double minDist2 = 0.4 * params->h;
             
-            if (shrinkIntersection(intPts, edge, shrinkLimit, minDist2, h) == 1) {
+            if (shrinkIntersection(intPts, edge, shrinkLimit, minDist2, params->h) == 1) {
                 //returns one if insterection shrinks to less than .9*h
                 return 1;
             }
@@ -1284,24 +1400,58 @@ bool checkCloseEdge(Poly &poly1, IntPoints &intPts, double shrinkLimit, Stats &p
             // IF the intersecion is within the polygon, distances less than h to
             // edges and vertices will be caught by lineSegToLineSeg() in this function.
             if (onEdgeCount >= 2) {
-                if (checkDistanceFromNodes(poly1, intPts, h, pstats)) {
+                if (checkDistanceFromNodes(poly1, intPts, params->h, pstats)) {
                     return 1;
                 }
             }
         }
     }
-    
+
 #ifdef DISABLESHORTENINGINT
     
     if (intPts.intersectionShortened == true) {
         return 1;
     }
-    
+
 #endif
     return 0;
 }
 
 
+/********************************************************************************/
+/****************** Check if nodes are too close to edge ************************/
+/*! Checks distances from intersection to poly edges. If the distance is less than
+    h, the intersection is allowed to shrink by %10 of its original length. If
+    the intersection is still closer than h to a poly edge, the polygon is rejected.
+    
+    Arg 1: Poly to be tested
+    Arg 2: IntPoints intersection to be tested
+    Arg 3: Minimum length the intersection is allowed to shinrk to
+    Arg 4: Stats program statistics structure, used to report stats on how much
+           intersection length is being reduced by from shrinkIntersection()
+    Return: 1 (True) if rejected, 0 (False) if accepted */
+bool checkCloseEdge(Poly &poly1, IntPoints &intPts, double shrinkLimit, Stats &pstats) {
+    ProfileTimer timer(PROF_CHECK_CLOSE_EDGE);
+    
+    switch (poly1.numberOfNodes) {
+    case 4:
+        return checkCloseEdgeKernel<4>(poly1, intPts, shrinkLimit, pstats);
+    
+    case 8:
+        return checkCloseEdgeKernel<8>(poly1, intPts, shrinkLimit, pstats);
+    
+    case 12:
+        return checkCloseEdgeKernel<12>(poly1, intPts, shrinkLimit, pstats);
+    
+    case 16:
+        return checkCloseEdgeKernel<16>(poly1, intPts, shrinkLimit, pstats);
+    
+    default:
+        return checkCloseEdgeKernel<0>(poly1, intPts, shrinkLimit, pstats);
+    }
+}
+
+
 /********************************************************************************/
 /*****************  Find point of intersection between two lines ****************/
 /*! Used in lineSegToLineSeg()
@@ -1338,7 +1488,7 @@ Point lineIntersection3D(const double *p1, double *v1, const double *p2, double
 /************  Closest Distance from Line Seg to Line Seg ***********************/
 /*! Calculates the distance between two line segments.
     Also calculates the point of intersection if the lines overlap.
-
+    
     Arg 1: Array of 6 doubles for line 1 end points:
            {x1, y1, z1, x2, y2, z2}
     Arg 2: Array of 6 doubles for line 2 end points:
@@ -1361,7 +1511,7 @@ double lineSegToLineSeg(const double *line1, const double *line2, Point &pt) {
     double p1p2[3] = {p1[0] - p2[0], p1[1] - p2[1], p1[2] - p2[2]};
     
     if(parallel(v1, v2)) {
-        if(magnitude(p1p2[0], p1p2[1], p1p2[2]) < eps || parallel(p1p2, v1) == 1) {
+        if(magnitude(p1p2[0], p1p2[1], p1p2[2]) < params->eps || parallel(p1p2, v1) == 1) {
             // If 2 line segs overlap
             if(pointOnLineSeg(line1, line2) == 1 || pointOnLineSeg(&line1[3], line2) == 1) {
                 return 0;
@@ -1386,7 +1536,7 @@ double lineSegToLineSeg(const double *line1, const double *line2, Point &pt) {
 /********************************************************************************/
 /********** Dist. from line seg to line seg (seperated lines) *******************/
 /*! Calculates the minimum distance between two seperated line segments.
-
+    
     Arg 1: Array of 6 doubles for line 1 end points:
            {x1, y1, z1, x2, y2, z2}
     Arg 2: Array of 6 doubles for line 2 end points:
@@ -1409,7 +1559,7 @@ double lineSegToLineSegSep(const double *line1, const double *line2) {
 /********************************************************************************/
 /*! Check for triple intersection features of less than h.
     Returns rejection code if fracture is rejected,  zero if accepted
-
+    
     Rejection codes:
     0 = poly accepted
     -10 = triple_intersectionsNotAllowed (rejected triple intersections
@@ -1419,8 +1569,9 @@ double lineSegToLineSegSep(const double *line1, const double *line2) {
     -13 = triple_closeEndPoint   (triple intersection point too close to an endpoint)
     -14 = triple_closeToTriplePt  (new triple point too close to previous triple point) */
 int checkForTripleIntersections(IntPoints &intPts, unsigned int count, std::vector<IntPoints> &intPtsList, Poly &newPoly, Poly &poly2, std::vector<TriplePtTempData> &tempData,  std::vector<Point> &triplePoints) {
+    ProfileTimer timer(PROF_TRIPLE_INTERSECTIONS);
     Point pt;
-    double minDist = 1.5 * h;
+    double minDist = 1.5 * params->h;
     double intEndPts[6] = {intPts.x1, intPts.y1, intPts.z1, intPts.x2, intPts.y2, intPts.z2};//newest intersection
     // Number of intersections already on poly2
     int n = poly2.intersectionIndex.size();
@@ -1432,20 +1583,20 @@ int checkForTripleIntersections(IntPoints &intPts, unsigned int count, std::vect
         double line[6] = {intPtsList[intersectionIndex].x1, intPtsList[intersectionIndex].y1, intPtsList[intersectionIndex].z1, intPtsList[intersectionIndex].x2, intPtsList[intersectionIndex].y2, intPtsList[intersectionIndex].z2};
         double dist1 = lineSegToLineSeg(intEndPts, line, pt); //get distance and pt of intersection
         
-        if (dist1 >= h) {
+        if (dist1 >= params->h) {
             continue;
         }
         
-        if (tripleIntersections == 0 && dist1 < h) {
+        if (params->tripleIntersections == 0 && dist1 < params->h) {
             return -10; // Triple intersections not allowed (user input option)
         }
         
-        if (dist1 > eps && dist1 < h) {
+        if (dist1 > params->eps && dist1 < params->h) {
             return -11; // Point too close to other intersection
         }
         
         // Overlaping intersections
-        if (dist1 <= eps) {
+        if (dist1 <= params->eps) {
             // ANGLE CHECK, using definition of dot product: A dot B = Mag(A)*Mag(B) * Cos(angle)
             // Normalize  A and B first. Compare to precalculated values of cos(47deg)= .681998 and cos(133deg)= -.681998
             double U[3] =  {line[3] - line[0], line[4] - line[1], line[5] - line[2]};
@@ -1464,14 +1615,14 @@ int checkForTripleIntersections(IntPoints &intPts, unsigned int count, std::vect
             dist1 = euclideanDistance(point, intEndPts);
             dist2 = euclideanDistance(point, &intEndPts[3]);
             
-            if (dist1 < h || dist2 < h) {
+            if (dist1 < params->h || dist2 < params->h) {
                 return -13;
             }
             
             dist1 = euclideanDistance(point, line);
             dist2 = euclideanDistance(point, &line[3]);
             
-            if (dist1 < h || dist2 < h) {
+            if (dist1 < params->h || dist2 < params->h) {
                 return -13;
             }
             
@@ -1495,9 +1646,9 @@ int checkForTripleIntersections(IntPoints &intPts, unsigned int count, std::vect
             
             // See if the found triple pt is already saved
             for (k = 0; k < tempData.size(); k++) {
-                if (std::abs(pt.x - tempData[k].triplePoint.x) < eps
-                        &&  std::abs(pt.y - tempData[k].triplePoint.y) < eps
-                        &&  std::abs(pt.z - tempData[k].triplePoint.z) < eps) {
+                if (std::abs(pt.x - tempData[k].triplePoint.x) < params->eps
+                        &&  std::abs(pt.y - tempData[k].triplePoint.y) < params->eps
+                        &&  std::abs(pt.z - tempData[k].triplePoint.z) < params->eps) {
                     duplicate = 1;
                     break;
                 }
@@ -1537,7 +1688,7 @@ int checkForTripleIntersections(IntPoints &intPts, unsigned int count, std::vect
                 double point2[3] = {tempData[j].triplePoint.x, tempData[j].triplePoint.y, tempData[j].triplePoint.z};
                 double dist = euclideanDistance(point1, point2);
                 
-                if ( dist < minDist && dist > eps ) {
+                if ( dist < minDist && dist > params->eps ) {
                     return -14;
                 }
             }
@@ -188,7 +188,7 @@ void printShapeFams(std::vector<Shape> &shapeFamilies) {
         logger.writeLogFile(INFO,  logString);
         
         // p32 target
-        if (stopCondition == 1) {
+        if (params->stopCondition == 1) {
             logString = "P32 (Fracture Intensity) Target: " + to_string(shapeFamilies[i].p32Target)   + "\n";
             logger.writeLogFile(INFO,  logString);
         }
@@ -202,7 +202,7 @@ void printShapeFams(std::vector<Shape> &shapeFamilies) {
             logger.writeLogFile(INFO,  logString);
         }
         
-        if (orientationOption == 0) {
+        if (params->orientationOption == 0) {
             logString = "Theta: " + to_string(shapeFamilies[i].angleOne) + " rad, " + to_string(shapeFamilies[i].angleOne * radToDeg) + " deg"   + "\n";
             logger.writeLogFile(INFO,  logString);
             // Phi (angle the projection of normal onto x-y plane  makes with +x axis
@@ -210,7 +210,7 @@ void printShapeFams(std::vector<Shape> &shapeFamilies) {
             logger.writeLogFile(INFO,  logString);
         }
         // Theta (angle normal makes with z axis
-        else if (orientationOption == 1) {
+        else if (params->orientationOption == 1) {
             logString = "Trend: " + to_string(shapeFamilies[i].angleOne) + " rad, " + to_string(shapeFamilies[i].angleOne * radToDeg) + " deg"   + "\n";
             logger.writeLogFile(INFO,  logString);
             // Phi (angle the projection of normal onto x-y plane  makes with +x axis
@@ -228,7 +228,7 @@ void printShapeFams(std::vector<Shape> &shapeFamilies) {
             logger.writeLogFile(INFO,  logString);
         } else {
             int idx = (shapeFamilies[i].layer - 1) * 2;
-            logString = "Layer: " + to_string(shapeFamilies[i].layer) + " {" + to_string(layers[idx]) + ", " + to_string(layers[idx + 1]) + "}"   + "\n";
+            logString = "Layer: " + to_string(shapeFamilies[i].layer) + " {" + to_string(params->layers[idx]) + ", " + to_string(params->layers[idx + 1]) + "}"   + "\n";
             logger.writeLogFile(INFO,  logString);
         }
         
@@ -238,14 +238,14 @@ void printShapeFams(std::vector<Shape> &shapeFamilies) {
             logger.writeLogFile(INFO,  logString);
         } else {
             int idx = (shapeFamilies[i].region - 1) * 6;
-            logString = "Region Number " + to_string(shapeFamilies[i].region) + ": {-x,+x,-y,+y,-z,+z}: {" + to_string(regions[idx]) + "," + to_string(regions[idx + 1]) + "," + to_string(regions[idx + 2])  + "," + to_string(regions[idx + 3]) + "," + to_string(regions[idx + 4]) + "," + to_string(regions[idx + 5]) + "}\n";
+            logString = "Region Number " + to_string(shapeFamilies[i].region) + ": {-x,+x,-y,+y,-z,+z}: {" + to_string(params->regions[idx]) + "," + to_string(params->regions[idx + 1]) + "," + to_string(params->regions[idx + 2])  + "," + to_string(params->regions[idx + 3]) + "," + to_string(params->regions[idx + 4]) + "," + to_string(params->regions[idx + 5]) + "}\n";
             logger.writeLogFile(INFO,  logString);
         }
         
         if (shapeFamilies[i].layer  > 0 && shapeFamilies[i].region > 0) {
             logString = "ERROR Layer and Region both defined for this Family.\nExiting Program\n"  ;
             logger.writeLogFile(INFO,  logString);
-            exit(1);
+            throw DFNError();
         }
         
         // Print distribution data
@@ -294,7 +294,7 @@ void printShapeFams(std::vector<Shape> &shapeFamilies) {
             logger.writeLogFile(INFO,  logString);
         }
         
-        logString = "Family Insertion Probability: " + to_string(famProb[i]) + "\n";
+        logString = "Family Insertion Probability: " + to_string(params->famProb[i]) + "\n";
         logger.writeLogFile(INFO,  logString);
     }
 }
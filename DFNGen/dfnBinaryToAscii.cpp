@@ -0,0 +1,154 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sys/stat.h>
+#include "structures.h"
+#include "input.h"
+#include "output.h"
+#include "binaryOutput.h"
+#include "logFile.h"
+
+/*
+    Regenerates the legacy ASCII output of DFNGen from the binary container dfn.bin.
+
+    Usage: DFNBinaryToAscii <path to dfn.bin> <output folder>
+
+    Like DFNGen, run it from the job directory: the output folder gets dfnGen_output/,
+    ../intersections and ../polys (relative to dfnGen_output), and the graph and boundary
+    files go to ./dfnGen_output. Files which depend on generation statistics
+    (rejections.dat, rejectsPerAttempt.dat, families.dat, DFN_output.txt) are not regenerated.
+*/
+
+Logger logger("dfnBinaryToAscii_logfile.txt");
+
+/* makeMissingDIR() **************************************************************************/
+/*! Creates directory dir if it does not exist. Unlike makeDIR(), existing directories are kept.
+    Arg 1: Path to directory */
+void makeMissingDIR(std::string dir) {
+    if (!DIR_exists(dir.c_str())) {
+        if (mkdir(dir.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH) == -1) {
+            std::string logString = "Error creating directory " + dir + "\n";
+            logger.writeLogFile(ERROR,  logString);
+            exit(1);
+        }
+    }
+}
+
+/* run() ***********************************************************************************/
+/*! DFNBinaryToAscii program, see main()
+    Return: Exit status */
+static int run(int argc, char **argv) {
+    std::string logString;
+    
+    if (argc != 3) {
+        logString = "Usage: DFNBinaryToAscii <path to dfn.bin> <output folder>\n";
+        logger.writeLogFile(ERROR,  logString);
+        return 1;
+    }
+    
+    std::vector<unsigned int> finalFractures;
+    std::vector<Poly> acceptedPoly;
+    std::vector<IntPoints> intPts;
+    std::vector<Point> triplePoints;
+    BinaryMeta meta;
+    Stats pstats;
+    logString = "Reading " + std::string(argv[1]) + "\n";
+    logger.writeLogFile(INFO,  logString);
+    readBinaryOutput(argv[1], finalFractures, acceptedPoly, intPts, triplePoints, meta);
+    // Restore input variables used by the output functions
+    DFNInput input;
+    params = &input;
+    input.domainSize[0] = meta.domainSize[0];
+    input.domainSize[1] = meta.domainSize[1];
+    input.domainSize[2] = meta.domainSize[2];
+    input.h = meta.h;
+    input.eps = meta.eps;
+    input.seed = meta.seed;
+    input.visualizationMode = meta.visualizationMode;
+    input.keepIsolatedFractures = meta.keepIsolatedFractures;
+    input.tripleIntersections = meta.tripleIntersections;
+    input.userEllipsesOnOff = meta.userEllipsesOnOff;
+    input.userRectanglesOnOff = meta.userRectanglesOnOff;
+    input.userPolygonByCoord = meta.userPolygonByCoord;
+    // Only the number of families is used while writing radii and poly_info.dat
+    std::vector<Shape> shapeFamilies(meta.numFamilies);
+    std::string output = std::string(argv[2]) + "/dfnGen_output";
+    std::string intersectionFolder = output + "/../intersections";
+    std::string radiiFolder = output + "/radii/";
+    makeMissingDIR(argv[2]);
+    makeMissingDIR(output);
+    makeMissingDIR(intersectionFolder);
+    makeMissingDIR(output + "/../polys");
+    makeMissingDIR(radiiFolder);
+    // Same order as writeOutput(), intersection files rotate the final fractures to x-y plane
+    writeGraphData(finalFractures, acceptedPoly, intPts, output);
+    writePolys(finalFractures, acceptedPoly, output);
+    writeIntersectionFiles(finalFractures, acceptedPoly, intPts, triplePoints, intersectionFolder, pstats);
+    writePolysInp(finalFractures, acceptedPoly, output);
+    writeParamsFile(finalFractures, acceptedPoly, shapeFamilies, pstats, triplePoints, output);
+    writeRadiiFile(finalFractures, acceptedPoly, output);
+    writeFractureTranslations(finalFractures, acceptedPoly, output);
+    writeConnectivity(finalFractures, acceptedPoly, intPts, output);
+    writeRotationData(acceptedPoly, finalFractures, shapeFamilies, output);
+    writeNormalVectors(acceptedPoly, finalFractures, shapeFamilies, output);
+    writeFinalPolyRadii(finalFractures, acceptedPoly, output);
+    writeFinalPolyArea(finalFractures, acceptedPoly, output);
+    writeBoundaryFiles(finalFractures, acceptedPoly, output);
+    
+    if (meta.outputAcceptedRadiiPerFamily) {
+        for (unsigned int i = 0; i < meta.numFamilies; i++) {
+            writeAllAcceptedRadii_OfFamily(i, acceptedPoly, radiiFolder);
+        }
+        
+        if (input.userRectanglesOnOff) {
+            writeAllAcceptedRadii_OfFamily(-2, acceptedPoly, radiiFolder);
+        }
+        
+        if (input.userEllipsesOnOff) {
+            writeAllAcceptedRadii_OfFamily(-1, acceptedPoly, radiiFolder);
+        }
+        
+        if (input.userPolygonByCoord) {
+            writeAllAcceptedRadii_OfFamily(-3, acceptedPoly, radiiFolder);
+        }
+    }
+    
+    if (meta.outputFinalRadiiPerFamily) {
+        for (unsigned int i = 0; i < meta.numFamilies; i++) {
+            writeFinalRadii_OfFamily(finalFractures, i, acceptedPoly, radiiFolder);
+        }
+        
+        if (input.userRectanglesOnOff) {
+            writeFinalRadii_OfFamily(finalFractures, -1, acceptedPoly, radiiFolder);
+        }
+        
+        if (input.userEllipsesOnOff) {
+            writeFinalRadii_OfFamily(finalFractures, -2, acceptedPoly, radiiFolder);
+        }
+        
+        if (input.userPolygonByCoord) {
+            writeFinalRadii_OfFamily(finalFractures, -3, acceptedPoly, radiiFolder);
+        }
+    }
+    
+    if (input.tripleIntersections) {
+        writeTriplePts(triplePoints, finalFractures, acceptedPoly, intPts, output);
+    }
+    
+    for (unsigned int i = 0; i < acceptedPoly.size(); i++) {
+        delete[] acceptedPoly[i].vertices;
+    }
+    
+    logString = "DFNBinaryToAscii - Complete\n";
+    logger.writeLogFile(INFO,  logString);
+    return 0;
+}
+
+int main (int argc, char **argv) {
+    try {
+        return run(argc, argv);
+    } catch (DFNError &) {
+        // Already written to the log
+        return 1;
+    }
+}
@@ -0,0 +1,1119 @@
+#include "dfngen.h"
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <ctime>
+#include <random>
+#include <algorithm>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "structures.h"
+#include "indexList.h"
+#include "insertShape.h"
+#include "input.h"
+#include "logFile.h"
+#include "readInputFunctions.h"
+#include "clusterGroups.h"
+#include "mathFunctions.h"
+#include "domain.h"
+#include "computationalGeometry.h"
+#include "generatingPoints.h"
+#include "distributions.h"
+#include "fractureEstimating.h"
+#include "debugFunctions.h"
+#include "removeFractures.h"
+#include "polygonBoundary.h"
+#include "checkpoint.h"
+#include "profile.h"
+#include "streaming.h"
+#include "domainBlocks.h"
+#include "hotkey.h" // stopInsertion
+
+// Used for automated python testing
+#include "testing.h"
+
+extern Logger logger;
+
+using std::cout;
+using std::endl;
+using std::string;
+
+
+/* readInputFile() ***************************************************************************/
+/*! Reads the input file into params, sets the shape families. See readDFNInput().
+    Arg 1: Run settings
+    Arg 2: OUTPUT, shapeFamilies is set */
+static void readInputFile(DFNConfig &config, DFNResult &dfn) {
+    std::string logString;
+    // Read Input File
+    profilePhase(PROF_PHASE_INPUT);
+    // Parameters of an earlier read are replaced
+    config.input = DFNInput();
+    dfn.shapeFamilies.clear();
+    getInput(config.inputFile.c_str(), dfn.shapeFamilies);
+    // Set epsilon
+    params->eps = params->h * 1e-8;
+    std::string h_to_string = to_string(params->h);
+    logString =  "h: " + h_to_string + "\n";
+    logger.writeLogFile(INFO,  logString);
+    int totalFamilies = params->nFamEll + params->nFamRect;
+    
+    if (config.resume || config.checkpointInterval > 0) {
+        initCheckpoint(config.inputFile, config.outputFolder);
+    }
+    
+    // Print shape families to screen
+    if (totalFamilies > 0) {
+        printShapeFams(dfn.shapeFamilies);
+    }
+}
+
+
+/* readDFNInput() ****************************************************************************/
+/*! Reads the input file into config.input and sets the shape families.
+    Arg 1: Run settings, input is replaced
+    Arg 2: OUTPUT, shapeFamilies is set
+    Return: 0, 1 if the input file has an error (written to the log) */
+int readDFNInput(DFNConfig &config, DFNResult &dfn) {
+    params = &config.input;
+    
+    try {
+        readInputFile(config, dfn);
+    } catch (DFNError &) {
+        return 1;
+    }
+    
+    return 0;
+}
+
+
+/* failGeneration() **************************************************************************/
+/*! Ends a failed generation. The report is written to DFN_output.txt first,
+    it explains the failure.
+    Arg 1: Run settings
+    Arg 2: Report so far */
+static void failGeneration(DFNConfig &config, std::ostringstream &report) {
+    if (!config.outputFolder.empty()) {
+        std::string fileName = config.outputFolder + "/DFN_output.txt";
+        std::ofstream file(fileName.c_str(), std::ofstream::out | std::ofstream::trunc);
+        file << report.str();
+    }
+    
+    throw DFNError();
+}
+
+
+/* fractureCount() ***************************************************************************/
+/*! Return: Number of accepted fractures, in memory or written by streaming generation */
+static unsigned int fractureCount(std::vector<Poly> &acceptedPoly) {
+    return streaming() ? streamedFractureCount() : acceptedPoly.size();
+}
+
+
+/* fractureInfo() ****************************************************************************/
+/*! Family and area of an accepted fracture, in memory or written by streaming generation
+    Arg 1: Accepted fractures
+    Arg 2: Index into acceptedPoly, or number of the written fracture
+    Arg 3: OUTPUT, family index, < 0 for user fractures
+    Arg 4: OUTPUT, area */
+static void fractureInfo(std::vector<Poly> &acceptedPoly, unsigned int i, int &familyNum, double &area) {
+    if (streaming()) {
+        streamedFracture(i, familyNum, area);
+    } else {
+        familyNum = acceptedPoly[i].familyNum;
+        area = acceptedPoly[i].area;
+    }
+}
+
+
+/* generate() ********************************************************************************/
+/*! Generates the DFN with the parameters in params. See generateDFN().
+    Arg 1: Run settings
+    Arg 2: OUTPUT, the DFN
+    Return: 0, 1 on the first rejection if built with TESTING */
+static int generate(DFNConfig &config, DFNResult &dfn) {
+    std::string logString;
+    std::vector<Shape> &shapeFamilies = dfn.shapeFamilies;
+    // Vector to store accepted polygons/fractures
+    std::vector<Poly> &acceptedPoly = dfn.acceptedPoly;
+    acceptedPoly.reserve(500);
+    // Vector for storing intersections
+    std::vector<IntPoints> &intPts = dfn.intPts;
+    intPts.reserve(250);
+    // Vector for storing triple intersection points
+    std::vector<Point> &triplePoints = dfn.triplePoints;
+    std::vector<unsigned int> &finalFractures = dfn.finalFractures;
+    // Statistics structure:
+    // Keeps track of DFN statistics (see definition in structures.h)
+    Stats &pstats = dfn.pstats;
+    int totalFamilies = params->nFamEll + params->nFamRect;
+    
+    if (config.seed > 0) {
+        params->seed = config.seed;
+    }
+    
+    // Initialize random generator with seed ( see c++ <random> )
+    // Mersene Twister 19937 generator (64 bit)
+    if (params->seed == 0) {
+        params->seed = getTimeBasedSeed();
+    }
+    
+    std::mt19937_64 generator(params->seed);
+    // Init distributions class
+    // Currenlty used only for exponential distribution
+    Distributions distributions(generator, shapeFamilies);
+    float domVol = params->domainSize[0] * params->domainSize[1] * params->domainSize[2];
+    
+    if (totalFamilies > 0 ) {
+        if (params->stopCondition == 0) { // Npoly Option
+            // Estimate fractures, generate radii lists for nPoly option
+            generateRadiiLists_nPolyOption(shapeFamilies, params->famProb, generator, distributions);
+        } else { // P32 Option
+            // ESTIMATE # FRACTURES NEEDED
+            if (params->disableFram == false) {
+                logString =  "Estimating number of fractures needed...\n";
+                logger.writeLogFile(INFO,  logString);
+                dryRun(shapeFamilies, params->famProb, generator, distributions);
+            }
+        }
+        
+        // Add a percentage more radii to each radii
+        // list using families' distribution.
+        // First arg is percentage, eg: 0.1 will add 10% more fractures
+        // to the radii list for each family
+        if (params->disableFram == false) {
+            addRadiiToLists(params->radiiListIncrease, shapeFamilies, generator, distributions);
+            
+            for (unsigned int j = 0; j < shapeFamilies.size(); j++) {
+                if (shapeFamilies[j].distributionType == 4) {
+                    // Constant size
+                    logString =  std::string(shapeType(shapeFamilies[j])) + " family " + to_string(getFamilyNumber(j, shapeFamilies[j].shapeFamily)) + " using constant size\n";
+                    logger.writeLogFile(INFO,  logString);
+                } else {
+                    logString =  "Estimated " + to_string(shapeFamilies[j].radiiList.size()) + " fractures for " +  shapeType(shapeFamilies[j]) + " family " + to_string(getFamilyNumber(j, shapeFamilies[j].shapeFamily)) + "\n";
+                    logger.writeLogFile(INFO,  logString);
+                }
+            }
+            
+            sortRadii(shapeFamilies);
+        }
+        
+        // Keep count of accepted & rejected fractures by family
+        pstats.acceptedFromFam = new int[totalFamilies];
+        pstats.rejectedFromFam = new int[totalFamilies];
+        // Save sizes of pre-generated radii lists per family.
+        // Print as part of statistics to user
+        pstats.expectedFromFam = new int[totalFamilies];
+        
+        // Zero arrays, init expectedFromFam array
+        for (int i = 0; i < totalFamilies; i++) {
+            pstats.acceptedFromFam[i] = 0;
+            pstats.rejectedFromFam[i] = 0;
+            pstats.expectedFromFam[i] = shapeFamilies[i].radiiList.size();
+        }
+        
+        // Init first rejects per insertion attempt counter
+        pstats.rejectsPerAttempt.push_back(0);
+    }
+    
+    /********************* User Defined Shapes Insertion ************************/
+    // User Polygons are always inserted first
+    // On resume, user fractures are restored with the checkpoint
+    profilePhase(PROF_PHASE_USER_FRACTURES);
+    
+    if (!config.resume) {
+        if (params->userPolygonByCoord != 0) {
+            insertUserPolygonByCoord(acceptedPoly, intPts, pstats, triplePoints);
+        }
+        
+        if (params->insertUserRectanglesFirst == 1) {
+            // Insert user rects first
+            if (params->userRectanglesOnOff != 0) {
+                insertUserRects(acceptedPoly, intPts, pstats, triplePoints);
+            }
+            
+            // Insert all user rectangles by coordinates
+            if (params->userRecByCoord != 0 ) {
+                insertUserRectsByCoord(acceptedPoly, intPts, pstats, triplePoints);
+            }
+            
+            // Insert all user ellipses
+            if (params->userEllipsesOnOff != 0) {
+                insertUserEll(acceptedPoly, intPts, pstats, triplePoints);
+            }
+            
+            // Insert all user ellipses by coordinates
+            if (params->userEllByCoord != 0) {
+                insertUserEllByCoord(acceptedPoly, intPts, pstats, triplePoints);
+            }
+        } else {
+            // Insert all user ellipses first
+            if (params->userEllipsesOnOff != 0) {
+                insertUserEll(acceptedPoly, intPts, pstats, triplePoints);
+            }
+            
+            // Insert all user ellipses by coordinates
+            if (params->userEllByCoord != 0) {
+                insertUserEllByCoord(acceptedPoly, intPts, pstats, triplePoints);
+            }
+            
+            // Insert user rects
+            if (params->userRectanglesOnOff != 0) {
+                insertUserRects(acceptedPoly, intPts, pstats, triplePoints);
+            }
+            
+            // Insert all user rectangles by coordinates
+            if (params->userRecByCoord != 0 ) {
+                insertUserRectsByCoord(acceptedPoly, intPts, pstats, triplePoints);
+            }
+        }
+    }
+    
+    profilePhase(PROF_PHASE_INSERTION);
+    
+    /*********  Probabilities (famProb) setup, CDF init  *****************/
+    // 'CDF' size will shrink along when used with fracture intensity (P32) option
+    float *CDF = NULL;
+    int cdfSize = totalFamilies;
+    
+    if (totalFamilies > 0) {
+        // Convert famProb to CDF
+        CDF = createCDF(params->famProb, cdfSize);
+    }
+    
+    // Size of radii_All.dat at the time of the checkpoint
+    unsigned long long radiiAllSize = 0;
+    
+    if (config.resume) {
+        readCheckpoint(acceptedPoly, intPts, triplePoints, pstats, shapeFamilies, CDF, cdfSize, generator, radiiAllSize);
+    }
+    
+    std::ofstream radiiAll;
+    std::string radiiFolder = config.outputFolder + "/radii";
+    // Create output folder if not already created
+    //makeDIR(config.outputFolder);
+    // Create radii folder
+    //makeDIR(radiiFolder.c_str());
+    // Create polys folder
+    std::string  polyFolder = config.outputFolder + "/polys";
+    //makeDIR(polyFolder.c_str());
+    
+    if (params->outputAllRadii == 1) {
+        // Option to include all radii in output (accepted and rejected)
+        std::string file = radiiFolder + "/radii_All.dat";
+        
+        if (config.resume) {
+            // Continue after the radii written before the checkpoint
+            if (truncate(file.c_str(), radiiAllSize) != 0) {
+                logString = "Error: Unable to resume " + file + "\n";
+                logger.writeLogFile(ERROR,  logString);
+                throw DFNError();
+            }
+            
+            radiiAll.open(file.c_str(), std::ofstream::in | std::ofstream::out);
+            radiiAll.seekp(0, std::ofstream::end);
+        } else {
+            radiiAll.open(file.c_str(), std::ofstream::out | std::ofstream::trunc);
+            radiiAll << "Format: xRadius yRadius Family# (-1 = userRectangle, 0 = userEllipse, > 0 is family in order of famProb)\n";
+        }
+    }
+    
+    // Initialize uniform distribution on [0,1]
+    std::uniform_real_distribution<double> uniformDist(0, 1);
+    
+    // Domain decomposition: a block process fills its block, the parent process
+    // merges the blocks and replaces the fractures rejected at the seams
+    if (config.block >= 0) {
+        initBlock(config.blocks, config.block, shapeFamilies, pstats, CDF, cdfSize, generator);
+    } else if (config.blocks[0] * config.blocks[1] * config.blocks[2] > 1 && totalFamilies > 0) {
+        mergeBlocks(config.inputFile, config.outputFolder, config.blocks, acceptedPoly, intPts, triplePoints,
+                    pstats, shapeFamilies, CDF, cdfSize, radiiAll);
+    }
+    
+    if (config.streamSlabs > 0) {
+        initStreaming(config.outputFolder, config.streamSlabs, shapeFamilies, pstats);
+    }
+    
+    if (totalFamilies > 0) {
+        // Holds index to current 'shapeFamily' being inserted
+        int familyIndex;
+        
+        /******************************************************************************************/
+        /**************************             MAIN LOOP            ******************************/
+        
+        // NOTE: p32Complete() works on global array 'p32Status'
+        // p32Complete() only needs argument of the number of defined shape families
+        // ********* Begin stochastic fracture insertion ***********
+        time_t lastCheckpoint = time(NULL);
+        
+        while (((params->stopCondition == 0 && pstats.acceptedPolyCount < params->nPoly) || (params->stopCondition == 1 && p32Complete(totalFamilies) == 0)) && !stopInsertion ) {
+            if (config.checkpointInterval > 0 && difftime(time(NULL), lastCheckpoint) >= config.checkpointInterval) {
+                if (params->outputAllRadii == 1) {
+                    radiiAll.flush();
+                    radiiAllSize = radiiAll.tellp();
+                }
+                
+                writeCheckpoint(acceptedPoly, intPts, triplePoints, pstats, shapeFamilies, CDF, cdfSize, generator, radiiAllSize);
+                lastCheckpoint = time(NULL);
+            }
+            
+            // Streaming: write the fractures behind the next slab once the current one is complete
+            if (streaming()) {
+                advanceSlab(acceptedPoly, intPts, triplePoints, pstats, shapeFamilies);
+            }
+            
+            // cdfIdx holds the index to the CDF array for the current shape family being inserted
+            int cdfIdx;
+            
+            if (params->stopCondition == 0 ) { // nPoly Option
+                // Choose a family based purely on famProb probabilities
+                familyIndex = indexFromProb(streaming() ? slabCDF() : CDF, uniformDist(generator), totalFamilies);
+            }
+            // Choose a family based on probabiliyis AND their target p32 completion status.
+            // If a family has already met is fracture intinisty req. (p32) don't choose that family anymore
+            else { // P32 Option
+                familyIndex = indexFromProb_and_P32Status(CDF, uniformDist(generator), totalFamilies, cdfSize, cdfIdx);
+            }
+            
+            if (streaming() && !familyInSlab(familyIndex, shapeFamilies)) {
+                continue;
+            }
+            
+            struct Poly newPoly = generatePoly(shapeFamilies[familyIndex], generator, distributions, familyIndex, true);
+            
+            if (params->outputAllRadii == 1) {
+                // Output all radii
+                radiiAll << std::setprecision(8) <<  newPoly.xradius << " " << newPoly.yradius
+                         << " " << newPoly.familyNum + 1 << "\n";
+            }
+            
+            int rejectCode = 1;
+            int rejectCounter = 0;
+            
+            while (rejectCode != 0) { // Loop used to reinsert same poly with different translation
+                // Truncate poly if needed
+                // 1 if poly is outside of domain or has less than 3 vertices
+                if ( domainTruncation(newPoly, params->domainSize) == 1 || (streaming() && behindSlabs(newPoly))) {
+                    // Poly was completely outside domain, or was truncated to less than
+                    // 3 vertices due to vertices being too close together, or reaches
+                    // fractures already written by streaming generation
+                    pstats.rejectionReasons.outside++;
+                    
+                    // Test if newPoly has reached its limit of insertion attempts
+                    if (rejectCounter >= params->rejectsPerFracture) {
+                        delete[] newPoly.vertices; // Created with new, delete manually
+                        rejectCounter++;
+                        break; // Reject poly, generate new polygon
+                    } else { // Retranslate poly and try again, preserving normal, size, and shape
+                        reTranslatePoly(newPoly, shapeFamilies[familyIndex], generator);
+                        continue; // Go to next iteration of while loop, test new translation
+                    }
+                }
+                
+                // Create/assign bounding box
+                createBoundingBox(newPoly);
+                // Find line of intersection and FRAM check
+                // rejectCode = intersectionChecking(newPoly, acceptedPoly, intPts, pstats, triplePoints);
+                // Find line of intersection and FRAM check
+                //if (disableFram == false) {
+                rejectCode = intersectionChecking(newPoly, acceptedPoly, intPts, pstats, triplePoints);
+                //} else {
+                //    rejectCode = 0;
+                //}
+#ifdef TESTING
+                
+                if (rejectCode != 0) {
+                    return 1;
+                }
+
+#endif
+                
+                // IF POLY ACCEPTED:
+                if(rejectCode == 0) { // Intersections are ok
+                    // Incriment counter of accepted polys
+                    pstats.acceptedPolyCount++;
+                    pstats.acceptedFromFam[familyIndex]++;
+                    // Make new rejection counter for next fracture attempt
+                    pstats.rejectsPerAttempt.push_back(0);
+                    
+                    if (newPoly.truncated == 1) {
+                        pstats.truncated++;
+                    }
+                    
+                    // Calculate poly's area
+                    newPoly.area = getArea(newPoly);
+                    
+                    // Update P32
+                    if (shapeFamilies[familyIndex].layer == 0 && shapeFamilies[familyIndex].region == 0) { // Whole domain
+                        shapeFamilies[familyIndex].currentP32 += newPoly.area * 2 / domVol;
+                    } else if (shapeFamilies[familyIndex].layer > 0 && shapeFamilies[familyIndex].region == 0) { // Layer
+                        shapeFamilies[familyIndex].currentP32 += newPoly.area * 2 / params->layerVol[shapeFamilies[familyIndex].layer - 1];
+                    } else if (shapeFamilies[familyIndex].layer == 0 && shapeFamilies[familyIndex].region > 0) { // Region
+                        shapeFamilies[familyIndex].currentP32 += newPoly.area * 2 / params->regionVol[shapeFamilies[familyIndex].region - 1];
+                    }
+                    
+                    if (params->stopCondition == 1) {
+                        // If the last inserted pologon met the p32 reqirement, set that familiy to no longer
+                        // insert any more fractures. ajust the CDF and familiy probabilites to account for this
+                        if (shapeFamilies[familyIndex].currentP32 >= shapeFamilies[familyIndex].p32Target ) {
+                            params->p32Status[familyIndex] = 1; // Mark family as having its p32 requirement met
+                            logString =  "P32 For Family " + std::string(to_string(familyIndex + 1)) + " Completed\n\n";
+                            logger.writeLogFile(INFO,  logString);
+                            
+                            // Adjust CDF, PDF. Reduce their size by 1.
+                            // Remove the completed family's element in 'CDF[]' and 'famProb[]'
+                            // Distribute the removed family probability evenly among the others and rebuild the CDF
+                            // familyIndex = index of family's probability
+                            // cdfIdx = index of the completed family's correspongding CDF index
+                            if (cdfSize > 1 ) { // If there are still more families to insert
+                                // Remove completed family from CDF and famProb
+                                adjustCDF_and_famProb(CDF, params->famProb, cdfSize, cdfIdx);
+                            }
+                        }
+                    }
+                    
+                    // Output to user: print running program status to user
+                    if (pstats.acceptedPolyCount % 200 == 0) {
+                        logString =  "Accepted " + std::string(to_string(pstats.acceptedPolyCount)) + " fractures\n";
+                        logger.writeLogFile(INFO,  logString);
+                        logString =  "Rejected " + std::string(to_string(pstats.rejectedPolyCount)) + " fractures\n";
+                        logger.writeLogFile(INFO,  logString);
+                        logString =  "Re-translated " + std::string(to_string(pstats.retranslatedPolyCount)) + " fractures\n\n";
+                        logger.writeLogFile(INFO,  logString);
+                        profileSnapshot(pstats.acceptedPolyCount, pstats.rejectedPolyCount);
+                        logString =  "Current p32 values per family:\n";
+                        logger.writeLogFile(INFO,  logString);
+                        
+                        for (int i = 0; i < totalFamilies; i++) {
+                            if (params->stopCondition == 0) {
+                                logString =  shapeType(shapeFamilies[i]) + " family " + std::string(to_string(getFamilyNumber(i, shapeFamilies[i].shapeFamily))) + " Current P32 = " + std::string(to_string(shapeFamilies[i].currentP32)) + "\n";
+                                logger.writeLogFile(INFO,  logString);
+                            } else {
+                                logString =  shapeType(shapeFamilies[i]) + " family " + std::string(to_string(getFamilyNumber(i, shapeFamilies[i].shapeFamily))) + " target P32 = " + std::string(to_string(shapeFamilies[i].p32Target)) + ", Current P32 = " + std::string(to_string(shapeFamilies[i].currentP32)) +  "\n";
+                                logger.writeLogFile(INFO,  logString);
+                            }
+                            
+                            if (params->stopCondition == 1 && shapeFamilies[i].p32Target <= shapeFamilies[i].currentP32) {
+                                logString =  "...Done\n";
+                                logger.writeLogFile(INFO,  logString);
+                            } else {
+                                logString =  "\n";
+                                logger.writeLogFile(INFO,  logString);
+                            }
+                        }
+                    }
+                    
+                    // SAVING POLYGON (intersection and triple points saved witchin intersectionChecking())
+                    acceptedPoly.push_back(newPoly); // SAVE newPoly to accepted polys list
+                } else { // Poly rejected
+                    // Inc reject counter for current poly
+                    rejectCounter++;
+                    // Inc reject counter for current attempt
+                    // (number of rejects until next fracture accepted)
+                    pstats.rejectsPerAttempt[pstats.acceptedPolyCount]++;
+                    
+                    if (params->printRejectReasons != 0) {
+                        printRejectReason(rejectCode, newPoly);
+                    }
+                    
+                    if (rejectCounter >= params->rejectsPerFracture) {
+                        delete[] newPoly.vertices; // Delete manually, created with new[]
+                        pstats.rejectedPolyCount++;
+                        pstats.rejectedFromFam[familyIndex]++;
+                        // Stop retranslating polygon if its reached its reject limit
+                        break; // Break will cause code to go to next poly
+                    } else {
+                        // Translate poly to new position
+                        if (params->printRejectReasons != 0 && logger.enabled(INFO)) {
+                            logString =  "Translating rejected fracture to new position\n";
+                            logger.writeLogFile(INFO,  logString);
+                        }
+                        
+                        pstats.retranslatedPolyCount++;
+                        reTranslatePoly(newPoly, shapeFamilies[familyIndex], generator);
+                    }
+                } // End else poly rejected
+            } // End loop while for re-translating polys option (reject == 1)
+        } // !!!!  END MAIN LOOP !!!! end while loop for inserting polyons
+        
+        // Domain decomposition: the block is saved for the parent process, see mergeBlocks()
+        if (config.block >= 0) {
+            if (params->outputAllRadii == 1) {
+                radiiAll.flush();
+                radiiAllSize = radiiAll.tellp();
+            }
+            
+            initCheckpoint(config.inputFile, config.outputFolder);
+            writeCheckpoint(acceptedPoly, intPts, triplePoints, pstats, shapeFamilies, CDF, cdfSize, generator, radiiAllSize);
+        }
+        
+        waitForCheckpoint();
+        
+        if (stopInsertion) {
+            logString =  "Fracture insertion stopped by user, " + to_string(pstats.acceptedPolyCount) + " fractures accepted\n";
+            logger.writeLogFile(INFO,  logString);
+        }
+        
+        /************************** DFN GENERATION IS COMPLETE ***************************/
+        
+        // Remove last element off the rejects per attempt counter.
+        // It will have one extra item due to how eachelement is initialized.
+        if (!pstats.rejectsPerAttempt.empty()) {
+            pstats.rejectsPerAttempt.pop_back();
+        }
+    } // End if totalFamilies != 0
+    
+    if (config.block >= 0) {
+        return 0;
+    }
+    
+    if (streaming()) {
+        finishStreaming(acceptedPoly, intPts, triplePoints, pstats);
+    }
+    
+    profilePhase(PROF_PHASE_POST_PROCESSING);
+
+//    printIntersectionData(intPts);
+//    printGroupData(pstats,acceptedPoly);
+    // The close to node check is inside of the close to edge check function
+    // for optimization (only need do intersection close to node on one condition)
+    // On close to node rejections, close to edge is counted as well.
+    // To get the correct number we must subtract the close to node count
+    // (they were counted in closeToEdge AND closeToNode)
+    pstats.rejectionReasons.closeToEdge -= pstats.rejectionReasons.closeToNode;
+    
+    if (params->outputAllRadii == 1) {
+        radiiAll.close();
+    }
+    
+    // // Assign apertures and permiability to accepted polygons
+    // for (unsigned int i = 0; i < acceptedPoly.size(); i++) {
+    //     assignAperture(acceptedPoly[i], generator);
+    //     // NOTE: must assign aperture before permeability
+    //     assignPermeability(acceptedPoly[i]);
+    // }
+    // End of DFN generation stats for DFN_output.txt (dfn.report), as well as print to screen
+    std::ostringstream file;
+    file << "========================================================\n";
+    file << "            Network Generation Complete\n";
+    file << "========================================================\n";
+    file << "Version of DFNGen: 2.2\n";
+    std::time_t result = std::time(nullptr);
+    file << "Time Stamp: " << std::asctime(std::localtime(&result)) << "\n";
+    logString =  "========================================================\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "            Network Generation Complete\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "========================================================\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Version of DFNGen: 2.2\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Time Stamp: " + std::string(std::asctime(std::localtime(&result))) + "\n";
+    logger.writeLogFile(INFO,  logString);
+    
+    if (params->stopCondition == 1 ) {
+        logString =  "Final p32 values per family:\n";
+        logger.writeLogFile(INFO,  logString);
+        
+        for (int i = 0; i < totalFamilies; i++) {
+            logString =  "Family " + std::string(to_string(i + 1)) + " target P32 = " + std::string(to_string(shapeFamilies[i].p32Target))
+                         + ", Final P32 = " + std::string(to_string(shapeFamilies[i].currentP32)) + "\n";
+            logger.writeLogFile(INFO,  logString);
+            file << "Family " << i + 1 << " target P32 = " << shapeFamilies[i].p32Target
+                 << ", " << "Final P32 = " << shapeFamilies[i].currentP32 << "\n";
+        }
+    }
+    
+    logString =  "________________________________________________________\n\n";
+    logger.writeLogFile(INFO,  logString);
+    file << "\n________________________________________________________\n";
+    // Calculate total area, volume
+    double userDefinedShapesArea = 0;
+    double *familyArea = nullptr;
+    
+    if (totalFamilies > 0 ) {
+        familyArea = new double[totalFamilies]; // Holds fracture area per family
+        
+        // Zero array
+        for (int i = 0; i < totalFamilies; i++) {
+            familyArea[i] = 0;
+        }
+    }
+    
+    logString =  "Statistics Before Isolated Fractures Removed:\n\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Fractures: " + std::string(to_string(fractureCount(acceptedPoly))) + "\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Truncated: " + std::string(to_string(pstats.truncated)) + "\n\n";
+    logger.writeLogFile(INFO,  logString);
+    file << "Statistics Before Isolated Fractures Removed:\n\n";
+    file << "Fractures: " << fractureCount(acceptedPoly) << "\n";
+    file << "Truncated: " << pstats.truncated << "\n\n";
+    
+    // Calculate total fracture area, and area per family
+    for (unsigned int i = 0; i < fractureCount(acceptedPoly); i++) {
+        int familyNum;
+        double area;
+        fractureInfo(acceptedPoly, i, familyNum, area);
+        pstats.areaBeforeRemoval += area;
+        
+        if (familyNum >= 0) {
+            familyArea[familyNum] += area;
+        } else { // User-defined polygon
+            userDefinedShapesArea += area;
+        }
+    }
+    
+    logString =  "Total Surface Area:     " + std::string(to_string(pstats.areaBeforeRemoval * 2)) + " m^2\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Total Fracture Density   (P30): " + std::string(to_string(fractureCount(acceptedPoly) / domVol)) + "\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Total Fracture Intensity (P32): " + std::string(to_string((pstats.areaBeforeRemoval * 2) / domVol)) + "\n";
+    logger.writeLogFile(INFO,  logString);
+    // logString =  "Total Fracture Porosity  (P33): " << pstats.volBeforeRemoval / domVol << "\n\n";
+    file << "Total Surface Area:     " << pstats.areaBeforeRemoval * 2 << " m^2\n";
+    file << "Total Fracture Density   (P30): " << fractureCount(acceptedPoly) / domVol << "\n";
+    file << "Total Fracture Intensity (P32): " << (pstats.areaBeforeRemoval * 2) / domVol << "\n";
+    // file << "Total Fracture Porosity  (P33): " << pstats.volBeforeRemoval / domVol << "\n\n";
+    
+    // Print family stats to user
+    for (int i = 0; i < totalFamilies; i++) {
+        logString =  "Family: " + std::string(to_string(i + 1)) + "\n";
+        logger.writeLogFile(INFO,  logString);
+        logString =  "    Accepted: " + std::string(to_string(pstats.acceptedFromFam[i])) + "\n";
+        logger.writeLogFile(INFO,  logString);
+        logString =  "    Rejected: " + std::string(to_string(pstats.rejectedFromFam[i])) + "\n";
+        logger.writeLogFile(INFO,  logString);
+        file << "Family: " << i + 1 << "\n";
+        file << "    Accepted: " << pstats.acceptedFromFam[i] << "\n";
+        file << "    Rejected: " << pstats.rejectedFromFam[i] << "\n";
+        
+        if ( shapeFamilies[i].layer > 0) {
+            int idx = (shapeFamilies[i].layer - 1) * 2;
+            logString =  "    Layer: " + std::string(to_string(shapeFamilies[i].layer)) + "\n";
+            logger.writeLogFile(INFO,  logString);
+            logString =  "    Layer {-z, +z}: {" + std::string(to_string(params->layers[idx])) + ", " + std::string(to_string(params->layers[idx + 1])) + "}\n";
+            logger.writeLogFile(INFO,  logString);
+            file << "    Layer: " << shapeFamilies[i].layer << "\n";
+            file << "    Layer {-z, +z}: {" << params->layers[idx] << ", " << params->layers[idx + 1] << "}\n";
+        } else {
+            logString =  "    Layer: Whole Domain \n";
+            logger.writeLogFile(INFO,  logString);
+            file << "    Layer: Whole Domain \n";
+        }
+        
+        if ( shapeFamilies[i].region > 0) {
+            int idx = (shapeFamilies[i].region - 1) * 6;
+            logString =  "    Region: " + std::string(to_string(shapeFamilies[i].region)) + "\n";
+            logger.writeLogFile(INFO,  logString);
+            logString =  "    {-x,+x,-y,+y,-z,+z}: {" + std::string(to_string(params->regions[idx])) + "," + std::string(to_string(params->regions[idx + 1])) + "," + std::string(to_string(params->regions[idx + 2]))  + "," + std::string(to_string(params->regions[idx + 3])) + "," + std::string(to_string(params->regions[idx + 4])) + "," + std::string(to_string(params->regions[idx + 5])) + "}\n";
+            logger.writeLogFile(INFO,  logString);
+            file << "    Region: " << shapeFamilies[i].region << "\n";
+            file << "    {-x,+x,-y,+y,-z,+z}: {" << params->regions[idx] << "," << params->regions[idx + 1] << "," << params->regions[idx + 2]  << "," << params->regions[idx + 3] << "," << params->regions[idx + 4] << "," << params->regions[idx + 5] << "}\n";
+        } else {
+            logString =  "    Region: Whole Domain \n";
+            logger.writeLogFile(INFO,  logString);
+            file << "    Region: Whole Domain \n";
+        }
+        
+        logString =  "    Surface Area: " + std::string(to_string(familyArea[i] * 2)) + " m^2\n";
+        logger.writeLogFile(INFO,  logString);
+        logString =  "    Fracture Intensity (P32): " + std::string(to_string(shapeFamilies[i].currentP32)) + "\n\n";
+        logger.writeLogFile(INFO,  logString);
+        file << "    Surface Area: " << familyArea[i] * 2 << " m^2\n";
+        file << "    Fracture Intensity (P32): " << shapeFamilies[i].currentP32 << "\n\n";
+    }
+    
+    if (userDefinedShapesArea > 0) {
+        logString =  "User Defined: \n";
+        logger.writeLogFile(INFO,  logString);
+        logString =  "    Surface Area: " + std::string(to_string(userDefinedShapesArea * 2)) + " m^2\n";
+        logger.writeLogFile(INFO,  logString);
+        logString =  "    Fracture Intensity (P32): " + std::string(to_string(userDefinedShapesArea * 2 / domVol)) + "\n\n";
+        logger.writeLogFile(INFO,  logString);
+        file << "User Defined: \n";
+        file << "    Surface Area: " << userDefinedShapesArea * 2 << " m^2\n";
+        file << "    Fracture Intensity (P32): " << userDefinedShapesArea * 2 / domVol << "\n\n";
+    }
+    
+    if (params->removeFracturesLessThan > 0) {
+        logString =  "\nRemoving fractures with radius less than " + std::string(to_string(params->removeFracturesLessThan)) + " and rebuilding DFN\n";
+        logger.writeLogFile(INFO,  logString);
+        file      << "\nRemoving fractures with radius less than " << params->removeFracturesLessThan << " and rebuilding DFN\n";
+        int size = acceptedPoly.size();
+        removeFractures(params->removeFracturesLessThan, acceptedPoly, intPts, triplePoints, pstats);
+        logString =  "Removed " + std::string(to_string(size - acceptedPoly.size())) + " fractures with radius less than " + std::string(to_string(params->removeFracturesLessThan)) + "\n\n";
+        logger.writeLogFile(INFO,  logString);
+        file      << "Removed " << size - acceptedPoly.size() << " fractures with radius less than " << params->removeFracturesLessThan << "\n\n";
+    }
+    
+    if (params->polygonBoundaryFlag) {
+        logString =  "\nExtracting fractures from a polygon boundary domain";
+        logger.writeLogFile(INFO,  logString);
+        file << "\nExtracting fractures from a polygon boundary domain" << endl;
+        int size = acceptedPoly.size();
+        polygonBoundary(acceptedPoly, intPts, triplePoints, pstats);
+        logString =  "Removed " + std::string(to_string(size - acceptedPoly.size())) + " fractures outside subdomain \n\n";
+        logger.writeLogFile(INFO,  logString);
+        file      << "Removed " << size - acceptedPoly.size() << " fractures outside subdomain \n\n";
+    }
+    
+    // No fractures are added from here on, pack the intersection and triple point lists
+    compactIndexLists(acceptedPoly, intPts);
+    
+    /*  Remove any isolated fractures and return
+        a list of polygon indices matching the users
+        boundaryFaces option. If input option
+        keepOnlyLargestCluster = 1, return largest
+        cluster matching users boundaryFaces option
+        If ignoreBoundaryFaces input option is on,
+        DFN will keep all fractures with intersections.
+    */
+    finalFractures =  getCluster(pstats);
+    // Sort fracture indices to retain order by acceptance
+    std::sort (finalFractures.begin(), finalFractures.end());
+    // Error check for no boundary connection
+    bool printConnectivityError = 0;
+    
+    if (finalFractures.size() == 0 && params->ignoreBoundaryFaces == 0 ) {
+        printConnectivityError = 1;
+        //if there is no fracture network connected users defined boundary faces
+        //switch to ignore boundary faces option with notice to user that there is no connectivity
+        finalFractures =  getCluster(pstats);
+        //if still no fractures, there is no fracture network
+    }
+    
+    if (finalFractures.size() == 0) {
+        logString =  "Error: DFN Generation has finished, however there are no intersecting fractures. Please adjust input parameters.\n";
+        logger.writeLogFile(ERROR,  logString);
+        logString =  "Try increasing the fracture density, or shrinking the domain.\n";
+        logger.writeLogFile(ERROR,  logString);
+        file << "\nError: DFN Generation has finished, however"
+             << " there are no intersecting fractures."
+             << " Please adjust input parameters.\n";
+        file << "Try increasing the fracture density, or shrinking the domain.\n";
+        failGeneration(config, file);
+    }
+    
+    /************************* Print Statistics to User ***********************************/
+    logString =  "________________________________________________________\n\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Statistics After Isolated Fractures Removed:\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Final Number of Fractures: " + std::string(to_string(finalFractures.size())) + "\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Isolated Fractures Removed: " + std::string(to_string(fractureCount(acceptedPoly) - finalFractures.size())) + "\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Fractures before isolated fractures removed:: " + std::string(to_string(fractureCount(acceptedPoly))) + "\n\n";
+    logger.writeLogFile(INFO,  logString);
+    file << "________________________________________________________\n\n";
+    file << "Statistics After Isolated Fractures Removed:\n";
+    file << "Final Number of Fractures: " << finalFractures.size() << "\n";
+    file << "Isolated Fractures Removed: " << fractureCount(acceptedPoly) - finalFractures.size() << "\n";
+    file << "Fractures before isolated fractures removed:: " << fractureCount(acceptedPoly) << "\n\n";
+    // Reset totalArea to 0
+    userDefinedShapesArea = 0;
+    
+    if (totalFamilies > 0 ) {
+        //zero out array.
+        for (int i = 0; i < totalFamilies; i++) {
+            familyArea[i] = 0;
+        }
+    }
+    
+    // Calculate total fracture area, and area per family
+    for (unsigned int i = 0; i < finalFractures.size(); i++) {
+        int familyNum;
+        double area;
+        fractureInfo(acceptedPoly, finalFractures[i], familyNum, area);
+        pstats.areaAfterRemoval += area;
+        
+        if (familyNum >= 0) {
+            familyArea[familyNum] += area;
+        } else { // User-defined polygon
+            userDefinedShapesArea += area;
+        }
+    }
+    
+    // Re-count number of accepted fracture per family after isloated fractures were removed
+    int *acceptedFromFamCounters = nullptr;
+    
+    if (totalFamilies > 0) {
+        acceptedFromFamCounters = new int[totalFamilies];
+        
+        for (int i = 0; i < totalFamilies; i++) {
+            // zero counters
+            acceptedFromFamCounters[i] = 0;
+        }
+        
+        int size = finalFractures.size();
+        
+        for (int i = 0; i < size; i++) {
+            int familyNum;
+            double area;
+            fractureInfo(acceptedPoly, finalFractures[i], familyNum, area);
+            
+            if (familyNum >= 0) {
+                acceptedFromFamCounters[familyNum]++;
+            }
+        }
+    }
+    
+    logString =  "Total Surface Area:     " + std::string(to_string(pstats.areaAfterRemoval * 2)) + " m^2\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Total Fracture Density   (P30): " + std::string(to_string(finalFractures.size() / domVol)) + "\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Total Fracture Intensity (P32): " + std::string(to_string((pstats.areaAfterRemoval * 2) / domVol)) + "\n";
+    logger.writeLogFile(INFO,  logString);
+    file << "Total Surface Area:     " << pstats.areaAfterRemoval * 2 << " m^2\n";
+    file << "Total Fracture Density   (P30): " << finalFractures.size() / domVol << "\n";
+    file << "Total Fracture Intensity (P32): " << (pstats.areaAfterRemoval * 2) / domVol << "\n";
+    
+    // Print family stats to user
+    for (int i = 0; i < totalFamilies; i++) {
+        logString =  "Family: " + std::string(to_string(i + 1) + "\n");
+        logger.writeLogFile(INFO,  logString);
+        logString =  "    Fractures After Isolated Fracture Removal: " + std::string(to_string(acceptedFromFamCounters[i])) + "\n";
+        logger.writeLogFile(INFO,  logString);
+        logString =  "    Isolated Fractures Removed: " + std::string(to_string(pstats.acceptedFromFam[i] - acceptedFromFamCounters[i])) + "\n";
+        logger.writeLogFile(INFO,  logString);
+        logString =  "    Accepted: " + std::string(to_string(pstats.acceptedFromFam[i])) + "\n";
+        logger.writeLogFile(INFO,  logString);
+        logString =  "    Rejected: " + std::string(to_string(pstats.rejectedFromFam[i])) + "\n";
+        logger.writeLogFile(INFO,  logString);
+        file << "Family: " << i + 1 << "\n";
+        file << "    Fractures After Isolated Fracture Removal: " << acceptedFromFamCounters[i] << "\n";
+        file << "    Isolated Fractures Removed: " << pstats.acceptedFromFam[i] - acceptedFromFamCounters[i] << "\n";
+        file << "    Accepted: " << pstats.acceptedFromFam[i] << "\n";
+        file << "    Rejected: " << pstats.rejectedFromFam[i] << "\n";
+        
+        if ( shapeFamilies[i].layer > 0) {
+            int idx = (shapeFamilies[i].layer - 1) * 2;
+            logString =  "    Layer: " + std::string(to_string(shapeFamilies[i].layer)) + "\n";
+            logger.writeLogFile(INFO,  logString);
+            logString =  "    Layer {-z, +z}: {" + std::string(to_string(params->layers[idx])) + "," + std::string(to_string(params->layers[idx + 1])) + "}\n";
+            logger.writeLogFile(INFO,  logString);
+            file << "    Layer: " << shapeFamilies[i].layer << "\n";
+            file << "    Layer {-z, +z}: {" << params->layers[idx] << "," << params->layers[idx + 1] << "}\n";
+        } else {
+            logString =  "    Layer: Whole Domain \n";
+            logger.writeLogFile(INFO,  logString);
+            file << "    Layer: Whole Domain \n";
+        }
+        
+        if ( shapeFamilies[i].region > 0) {
+            int idx = (shapeFamilies[i].region - 1) * 6;
+            logString =  "    Region: " + std::string(to_string(shapeFamilies[i].region)) + "\n";
+            logger.writeLogFile(INFO,  logString);
+            logString =  "    {-x,+x,-y,+y,-z,+z}: {" + std::string(to_string(params->regions[idx])) + "," + std::string(to_string(params->regions[idx + 1])) + "," + std::string(to_string(params->regions[idx + 2]))  + "," + std::string(to_string(params->regions[idx + 3])) + "," + std::string(to_string(params->regions[idx + 4])) + "," + std::string(to_string(params->regions[idx + 5])) + "}\n";
+            logger.writeLogFile(INFO,  logString);
+            file << "    Region: " << shapeFamilies[i].region << "\n";
+            file << "    {-x,+x,-y,+y,-z,+z}: {" << params->regions[idx] << "," << params->regions[idx + 1] << "," << params->regions[idx + 2]  << "," << params->regions[idx + 3] << "," << params->regions[idx + 4] << "," << params->regions[idx + 5] << "}\n";
+        } else {
+            logString =  "    Region: Whole Domain \n";
+            logger.writeLogFile(INFO,  logString);
+            file << "    Region: Whole Domain \n";
+        }
+        
+        logString =  "    Surface Area: " + std::string(to_string(familyArea[i] * 2)) + " m^2\n";
+        logger.writeLogFile(INFO,  logString);
+        logString =  "    Fracture Intensity (P32): " + std::string(to_string(familyArea[i] * 2 / domVol)) + "\n\n";
+        logger.writeLogFile(INFO,  logString);
+        file << "    Surface Area: " << familyArea[i] * 2 << " m^2\n";
+        file << "    Fracture Intensity (P32): " << familyArea[i] * 2 / domVol << "\n\n";
+    }
+    
+    if (userDefinedShapesArea > 0) {
+        logString =  "User Defined Shapes: \n";
+        logger.writeLogFile(INFO,  logString);
+        logString =  "    Surface Area: " + std::string(to_string(userDefinedShapesArea * 2)) + " m^2\n";
+        logger.writeLogFile(INFO,  logString);
+        logString =  "    Fracture Intensity (P32): " + std::string(to_string(userDefinedShapesArea * 2 / domVol)) + "\n\n";
+        logger.writeLogFile(INFO,  logString);
+        file << "User Defined Shapes: \n";
+        file << "    Surface Area: " << userDefinedShapesArea * 2 << " m^2\n";
+        file << "    Fracture Intensity (P32): " << userDefinedShapesArea * 2 / domVol << "\n\n";
+    }
+    
+    if (acceptedFromFamCounters != nullptr) {
+        delete[] acceptedFromFamCounters;
+    }
+    
+    logString =  "________________________________________________________\n\n";
+    logger.writeLogFile(INFO,  logString);
+    file << "________________________________________________________\n\n";
+    logString = std::string(to_string(fractureCount(acceptedPoly))) + " Fractures Accepted (Before Isolated Fracture Removal)\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  std::string(to_string(finalFractures.size())) + " Final Fractures (After Isolated Fracture Removal)\n\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Total Fractures Rejected: " + std::string(to_string(pstats.rejectedPolyCount)) + "\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "Total Fractures Re-translated: " + std::string(to_string(pstats.retranslatedPolyCount)) + "\n";
+    logger.writeLogFile(INFO,  logString);
+    file << "\n" << fractureCount(acceptedPoly) << " Fractures Accepted (Before Isolated Fracture Removal)\n";
+    file << finalFractures.size() << " Final Fractures (After Isolated Fracture Removal)\n\n";
+    file << "Total Fractures Rejected: " << pstats.rejectedPolyCount << "\n";
+    file << "Total Fractures Re-translated: " << pstats.retranslatedPolyCount << "\n";
+    
+    if (printConnectivityError == 1) {
+        logString =  "ERROR: DFN generation has finished but the formed\nfracture network does not make a connection between\nthe user's specified boundary faces.\n";
+        logger.writeLogFile(ERROR,  logString);
+        logString =  "Try increasing the fracture density, shrinking the domain\nor consider using the 'ignoreBoundaryFaces' option.\n";
+        logger.writeLogFile(ERROR,  logString);
+        file << "\nERROR: DFN generation has finished but the formed\n"
+             << "fracture network does not make a connection between\n"
+             << "the user's specified boundary faces.\n";
+        file << "Try increasing the fracture density, shrinking the domain\n"
+             << "or consider using the 'ignoreBoundaryFaces' option.\n";
+        failGeneration(config, file);
+    }
+    
+    //************ Intersection Stats ***************
+    unsigned int triplePointCount = streaming() ? streamedTriplePointCount() : triplePoints.size();
+    unsigned int intersectionCount = streaming() ? streamedIntersectionCount() : intPts.size();
+    logString =  "Number of Triple Intersection Points (Before Isolated Fracture Removal): " + std::string(to_string(triplePointCount)) + "\n";
+    logger.writeLogFile(INFO,  logString);
+    file << "Number of Triple Intersection Points (Before Isolated Fracture Removal): " << triplePointCount << "\n";
+    // Shrink intersection stats
+    logString =  "Intersection Statistics:\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "    Number of Intersections: " + std::string(to_string(intersectionCount)) + " \n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "    Intersections Shortened: " + std::string(to_string(pstats.intersectionsShortened)) + " \n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "    Original Intersection (Before Intersection Shrinking) Length: " + std::string(to_string(pstats.originalLength)) + " m\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "    Intersection Length Discarded: " + std::string(to_string(pstats.discardedLength)) + " m\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "    Final Intersection Length: " + std::string(to_string(pstats.originalLength - pstats.discardedLength)) + " m\n";
+    logger.writeLogFile(INFO,  logString);
+    file << "Intersection Statistics:\n";
+    file << "    Number of Intersections: " << intersectionCount << " \n";
+    file << "    Intersections Shortened: " << pstats.intersectionsShortened << " \n";
+    file << "    Original Intersection (Before Intersection Shrinking) Length: " << pstats.originalLength << " m\n";
+    file << "    Intersection Length Discarded: " << pstats.discardedLength << " m\n";
+    file << "    Final Intersection Length: " << pstats.originalLength - pstats.discardedLength << " m\n";
+    //*********** Rejection Stats *******************
+    logString =  "Rejection Statistics: \n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "    " + std::string(to_string(pstats.rejectionReasons.shortIntersection)) + " Short Intersections \n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "    " + std::string(to_string(pstats.rejectionReasons.closeToNode)) + " Close to Node\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "    " + std::string(to_string(pstats.rejectionReasons.closeToEdge)) + " Close to Edge\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "    " + std::string(to_string(pstats.rejectionReasons.closePointToEdge)) + " Vertex Close to Edge\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "    " + std::string(to_string(pstats.rejectionReasons.outside)) + " Outside of Domain\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "    " + std::string(to_string(pstats.rejectionReasons.triple)) + " Triple intersection Rejections\n";
+    logger.writeLogFile(INFO,  logString);
+    logString =  "    " + std::string(to_string(pstats.rejectionReasons.interCloseToInter)) + " Intersections Close to Other Intersections\n\n";
+    logger.writeLogFile(INFO,  logString);
+    file << "\nRejection Statistics: \n";
+    file << "    " << pstats.rejectionReasons.shortIntersection << " Short Intersections \n";
+    file << "    " << pstats.rejectionReasons.closeToNode << " Close to Node\n";
+    file << "    " << pstats.rejectionReasons.closeToEdge << " Close to Edge\n";
+    file << "    " << pstats.rejectionReasons.closePointToEdge << " Vertice Close to Edge\n";
+    file << "    " << pstats.rejectionReasons.outside << " Outside of Domain\n";
+    file << "    " << pstats.rejectionReasons.triple << " Triple intersection Rejections\n";
+    file << "    " << pstats.rejectionReasons.interCloseToInter << " Intersections Close to Other Intersections\n\n";
+    logString =  "________________________________________________________\n";
+    logger.writeLogFile(INFO,  logString);
+    file << "\n________________________________________________________\n";
+    
+    if (totalFamilies > 0) {
+        logString =  "Fracture Estimation statistics:\n";
+        logger.writeLogFile(INFO,  logString);
+        file << "Fracture Estimation statistics:\n";
+        logString =  "NOTE: If estimation and actual are very different, expected family distributions might not be accurate. If this is the case, try increasing or decreasing the 'radiiListIncrease' option in the input file.\n";
+        logger.writeLogFile(INFO,  logString);
+        file << "NOTE: If estimation and actual are very different, expected family distributions might "
+             << "not be accurate. If this is the case, try increasing or decreasing the 'radiiListIncrease' option "
+             << "in the input file.\n";
+        
+        // Compare expected radii/poly size and actual
+        for (int i = 0; i < totalFamilies; i++) {
+            if (shapeFamilies[i].distributionType == 4) { // Constant
+                logString =  shapeType(shapeFamilies[i]) + " Family " + to_string(getFamilyNumber(i, shapeFamilies[i].shapeFamily)) + "\n" + "Using constant size\n\n";
+                logger.writeLogFile(INFO,  logString);
+                file << shapeType(shapeFamilies[i]) << " Family "
+                     << getFamilyNumber(i, shapeFamilies[i].shapeFamily) << "\n"
+                     << "Using constant size\n\n";
+            } else {
+                logString =  shapeType(shapeFamilies[i]) + " Family " + to_string(getFamilyNumber(i, shapeFamilies[i].shapeFamily)) + "\n";
+                logger.writeLogFile(INFO,  logString);
+                logString =  "Estimated: " + to_string(pstats.expectedFromFam[i]) + "\n";
+                logString =  "Actual:    " + to_string(pstats.acceptedFromFam[i]) + to_string(pstats.rejectedFromFam[i]) + "\n";
+                logger.writeLogFile(INFO,  logString);
+                file << shapeType(shapeFamilies[i]) << " Family "
+                     << getFamilyNumber(i, shapeFamilies[i].shapeFamily) << "\n"
+                     << "Estimated: " << pstats.expectedFromFam[i] << "\n";
+                file << "Actual:    " << pstats.acceptedFromFam[i] + pstats.rejectedFromFam[i] << "\n";
+            }
+        }
+        
+        logString =  "________________________________________________________\n\n";
+        logger.writeLogFile(INFO,  logString);
+        file << "\n________________________________________________________\n\n";
+    }
+    
+    logString = "Seed: " + to_string(params->seed) + "\n";
+    logger.writeLogFile(INFO,  logString);
+    file << "Seed: " << params->seed << "\n";
+    
+    if (streaming()) {
+        writeStreamedBinaryOutput(finalFractures, shapeFamilies, config.outputFolder);
+    }
+    
+    dfn.report = file.str();
+    return 0;
+}
+
+
+/* generateDFN() *****************************************************************************/
+/*! Generates the DFN: inserts the user defined fractures and the fractures of the
+    stochastic families, then removes isolated fractures and computes the statistics.
+    readDFNInput() must have been called with the same DFNConfig and DFNResult, and
+    succeeded. Insertion stops early when stopInsertion is set (see hotkey.cpp). A block
+    process (config.block >= 0) returns once its block is saved, the DFN is not complete.
+    Arg 1: Run settings, input is updated (see DFNInput)
+    Arg 2: OUTPUT, the DFN. Call freeDFN() also after a failed generation
+    Return: 0, 1 if the generation failed (written to the log),
+            1 on the first rejection if built with TESTING */
+int generateDFN(DFNConfig &config, DFNResult &dfn) {
+    params = &config.input;
+    
+    try {
+        return generate(config, dfn);
+    } catch (DFNError &) {
+        // A checkpoint being written is completed, it can be resumed from
+        waitForCheckpoint();
+        return 1;
+    }
+}
+
+
+/* freeDFN() *********************************************************************************/
+/*! Frees the memory of a generated DFN which is not owned by its vectors
+    (fracture vertices, per family counters)
+    Arg 1: DFN */
+void freeDFN(DFNResult &dfn) {
+    for (unsigned int i = 0; i < dfn.acceptedPoly.size(); i++) {
+        delete[] dfn.acceptedPoly[i].vertices;
+    }
+    
+    dfn.acceptedPoly.clear();
+    // Intersection and triple point lists are in the index pool
+    dfn.intPts.clear();
+    releaseIndexLists();
+    delete[] dfn.pstats.acceptedFromFam;
+    delete[] dfn.pstats.rejectedFromFam;
+    delete[] dfn.pstats.expectedFromFam;
+    dfn.pstats.acceptedFromFam = NULL;
+    dfn.pstats.rejectedFromFam = NULL;
+    dfn.pstats.expectedFromFam = NULL;
+}
+
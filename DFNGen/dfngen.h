@@ -0,0 +1,112 @@
+#ifndef _dfngen_h_
+#define _dfngen_h_
+#include <vector>
+#include <string>
+#include "structures.h"
+#include "input.h"
+
+/*
+    DFNGen library (libdfngen.a). Generates a DFN and returns it in memory, the
+    DFNGen program (DFNmain.cpp) is a command line interface on top of it which
+    writes the output files. A program using the library:
+
+        Logger logger("dfngen_logfile.txt"); // Defined by the program, see logFile.h
+        ...
+        DFNConfig config;
+        config.inputFile = "input.dat";
+        DFNResult dfn;
+        
+        if (readDFNInput(config, dfn) == 0 && generateDFN(config, dfn) == 0) {
+            // dfn.acceptedPoly[dfn.finalFractures[i]] are the fractures of the network
+        }
+        
+        freeDFN(dfn);
+
+    Notes:
+      - The parameters of the input file are in config.input (see input.h), they
+        can be changed between readDFNInput() and generateDFN(). The library reads
+        them through the params pointer, which both calls set to their config.
+      - Generation updates config.input (family probabilities, P32 status) and the
+        shape families of the DFNResult. For another network, call readDFNInput()
+        again, or copy config and dfn.shapeFamilies before generateDFN().
+      - One generation at a time per process, the calls are not thread safe: params
+        and the file scope state of checkpoint.cpp, streaming.cpp, profile.cpp,
+        indexList.cpp and stopInsertion are shared. Ensemble mode forks one process
+        per network (see ensemble.cpp).
+      - Errors in the input file or during generation are written to the log, and
+        readDFNInput() and generateDFN() return 1.
+*/
+
+/*! Settings of a run */
+struct DFNConfig {
+    /*! Parameters of the input file, set by readDFNInput() */
+    DFNInput input;
+    
+    /*! Path to the DFNGen input file */
+    std::string inputFile;
+    
+    /*! Folder for files written during generation: radii/radii_All.dat (input option
+        outputAllRadii), checkpoints and DFN_output.txt when generation fails.
+        Not used if empty. */
+    std::string outputFolder;
+    
+    /*! Seed of the random generator, replaces the input file's seed if > 0 */
+    unsigned int seed;
+    
+    /*! Save the generation state every checkpointInterval seconds, 0 for no checkpoints.
+        Requires outputFolder. */
+    int checkpointInterval;
+    
+    /*! Continue from the checkpoint in outputFolder */
+    bool resume;
+    
+    /*! Stream the DFN to disk in streamSlabs slabs along x, 0 to keep it in memory
+        (see streaming.h). Requires outputFolder, the DFN is written to
+        outputFolder/dfnGen_output/dfn.bin and not returned in DFNResult. */
+    unsigned int streamSlabs;
+    
+    /*! Domain decomposition (see domainBlocks.h): number of blocks along x, y and z, all 1
+        for none. Requires outputFolder. */
+    unsigned int blocks[3];
+    
+    /*! Block generated by this process, which returns after saving it to its block folder.
+        -1 in the process which merges the blocks once all are generated. */
+    int block;
+    
+    DFNConfig() : seed(0), checkpointInterval(0), resume(false), streamSlabs(0), block(-1) {
+        blocks[0] = blocks[1] = blocks[2] = 1;
+    }
+};
+
+/*! Generated DFN */
+struct DFNResult {
+    /*! Stochastic shape families, set by readDFNInput(). Radii lists and P32 are
+        updated during generation. */
+    std::vector<Shape> shapeFamilies;
+    
+    /*! All accepted fractures, including isolated fractures */
+    std::vector<Poly> acceptedPoly;
+    
+    /*! Intersections of accepted fractures, indices into acceptedPoly */
+    std::vector<IntPoints> intPts;
+    
+    /*! Triple intersection points */
+    std::vector<Point> triplePoints;
+    
+    /*! Indices into acceptedPoly of the fractures of the final network, after
+        isolated fracture removal, in order of acceptance. With streaming, numbers
+        of the fractures in dfn.bin, acceptedPoly, intPts and triplePoints are empty. */
+    std::vector<unsigned int> finalFractures;
+    
+    /*! Statistics and cluster data */
+    Stats pstats;
+    
+    /*! Report of the run, written to DFN_output.txt by the DFNGen program */
+    std::string report;
+};
+
+int readDFNInput(DFNConfig &config, DFNResult &dfn);
+int generateDFN(DFNConfig &config, DFNResult &dfn);
+void freeDFN(DFNResult &dfn);
+
+#endif
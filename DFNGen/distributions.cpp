@@ -5,6 +5,7 @@
 #include <cstdlib>
 #include <iostream>
 #include "logFile.h"
+#include "input.h" // DFNError
 
 /*
     The Distributions class was created specifically for
@@ -115,7 +116,7 @@ void Distributions::checkDistributionUserInput(std::vector<Shape> &shapeFamilies
                 logger.writeLogFile(INFO,  logString);
                 logString = "Please adjust the minimum value, or the mean, and try again.\n";
                 logger.writeLogFile(INFO,  logString);
-                exit(1);
+                throw DFNError();
             } else {
                 shapeFamilies[i].minDistInput = input;
             }
@@ -140,7 +141,7 @@ void Distributions::checkDistributionUserInput(std::vector<Shape> &shapeFamilies
                     logger.writeLogFile(ERROR,  logString);
                     logString = "Please adjust the exponential distribution parameters in " + shapeType(shapeFamilies[i]) + " family " + to_string(getFamilyNumber(i, shapeFamilies[i].shapeFamily)) ;
                     logger.writeLogFile(ERROR,  logString);
-                    exit(1);
+                    throw DFNError();
                 }
             }
             
@@ -167,7 +168,7 @@ void Distributions::quitOrContinue() {
         std::cin.ignore();
         
         if ((str[0] == 'q' && str[1] == '\0') || (str[0] == 'Q' && str[1] == '\0')) {
-            exit(1);
+            throw DFNError();
         }
         
         if (str[0] != 0) {
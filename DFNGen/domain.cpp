@@ -1,16 +1,150 @@
 #include <cmath>
 #include <vector>
+#include <algorithm>
 #include "domain.h"
 #include "input.h"
 #include "logFile.h"
 #include "structures.h"
 #include "vectorFunctions.h"
+#include "profile.h"
+
+/*! Vertices of a polygon being clipped are kept on the stack up to this number */
+static const int clipStackNodes = 64;
+
+/******************************************************************************/
+// Classifies all vertices of a polygon against the six sides of the domain
+// in one pass. The loop has no branches so that the compiler vectorizes it,
+// with a fixed number of vertices it is also unrolled.
+// Template argument: Number of vertices, 0 for any number
+// Arg 1: Polygon
+// Arg 2: Half of domain size, {x, y, z}
+// Return: Bit j is set if a vertex is outside domain side j, sides in the
+//         order of domainTruncation(): +z, -z, +y, -y, +x, -x. 0 if the
+//         polygon is inside the domain
+template <int N>
+static int outsideSidesKernel(const Poly &newPoly, const double *half) {
+    const int nNodes = N > 0 ? N : newPoly.numberOfNodes;
+    const double *vertices = newPoly.vertices;
+    // Counted in doubles: same vector width as the coordinates
+    double outside[6] = {0, 0, 0, 0, 0, 0};
+    
+    for (int k = 0; k < nNodes; k++) {
+        double x = vertices[3 * k];
+        double y = vertices[3 * k + 1];
+        double z = vertices[3 * k + 2];
+        outside[0] += z > half[2];
+        outside[1] += z < -half[2];
+        outside[2] += y > half[1];
+        outside[3] += y < -half[1];
+        outside[4] += x > half[0];
+        outside[5] += x < -half[0];
+    }
+    
+    int sides = 0;
+    
+    for (int j = 0; j < 6; j++) {
+        sides |= (outside[j] > 0) << j;
+    }
+    
+    return sides;
+}
+
+
+/******************************************************************************/
+// Selects outsideSidesKernel() for the polygon's number of vertices:
+// rectangles and ellipses with 8, 12 or 16 vertices, other polygons use the
+// generic kernel
+static int outsideSides(const Poly &newPoly, const double *half) {
+    switch (newPoly.numberOfNodes) {
+    case 4:
+        return outsideSidesKernel<4>(newPoly, half);
+    
+    case 8:
+        return outsideSidesKernel<8>(newPoly, half);
+    
+    case 12:
+        return outsideSidesKernel<12>(newPoly, half);
+    
+    case 16:
+        return outsideSidesKernel<16>(newPoly, half);
+    
+    default:
+        return outsideSidesKernel<0>(newPoly, half);
+    }
+}
+
+
+/******************************************************************************/
+// Signed distances of the vertices to a domain side, positive outside of the
+// domain. Same values as the dot product of the side's normal with the
+// vector from the center of the side to the vertex. Vectorized, no branches.
+// Arg 1: Vertices {x, y, z}
+// Arg 2: Number of vertices
+// Arg 3: Coordinate normal to the side, 0: x, 1: y, 2: z
+// Arg 4: 1 for the side at +half, -1 for the side at -half
+// Arg 5: Half of domain size in the direction of 'axis'
+// Arg 6: OUTPUT, distance of each vertex
+// Return: Number of vertices outside the side
+static int sideDistances(const double *vertices, int nNodes, int axis, double sign, double half, double *dist) {
+    const double side = sign * half;
+    double outside = 0;
+    
+    for (int i = 0; i < nNodes; i++) {
+        double d = (vertices[3 * i + axis] - side) * sign;
+        dist[i] = d;
+        outside += d > 0;
+    }
+    
+    return (int) outside;
+}
+
+
+/******************************************************************************/
+// One Sutherland-Hodgman pass: clips a polygon to the inside of one domain side.
+// A point is added where an edge crosses the side, a vertex is kept if it is
+// on or inside the side.
+// Arg 1: Vertices {x, y, z}
+// Arg 2: Number of vertices
+// Arg 3: Distances of the vertices to the side, sideDistances()
+// Arg 4: OUTPUT, clipped polygon. Room for the clipped vertices plus one
+// Return: Number of vertices of the clipped polygon
+static int clipToSide(const double *in, int nIn, const double *dist, double *out) {
+    int nOut = 0;
+    const double *prev = in + 3 * (nIn - 1);
+    double prevdist = dist[nIn - 1];
+    
+    for (int i = 0; i < nIn; i++) {
+        const double *curr = in + 3 * i;
+        double currdist = dist[i];
+        
+        if (currdist * prevdist < 0) { // If crosses boundary, store point on boundary
+            double *pt = out + 3 * nOut;
+            pt[0] = prev[0] + (curr[0] - prev[0]) * std::abs(prevdist) / (std::abs(currdist) + std::abs(prevdist));
+            pt[1] = prev[1] + (curr[1] - prev[1]) * std::abs(prevdist) / (std::abs(currdist) + std::abs(prevdist));
+            pt[2] = prev[2] + (curr[2] - prev[2]) * std::abs(prevdist) / (std::abs(currdist) + std::abs(prevdist));
+            nOut++;
+        }
+        
+        // Vertex is always copied, it is kept if towards the domain relative to the side
+        double *pt = out + 3 * nOut;
+        pt[0] = curr[0];
+        pt[1] = curr[1];
+        pt[2] = curr[2];
+        nOut += currdist <= 0;
+        prev = curr;
+        prevdist = currdist;
+    }
+    
+    return nOut;
+}
+
 
 /******************************************************************************/
 /***********************  Domain Truncation  **********************************/
-// NOTE: domainTruncation() may benefit from rewriting in a more
-//       efficient way which does not reallocate memory as often
 // Truncates polygons along the defined domain ('domainSize' in input file)
+// The polygon is clipped against the six domain sides in buffers on the stack
+// (heap for very large polygons), newPoly.vertices is only reallocated if the
+// truncated polygon has more vertices than the original.
 // Arg 1: Polygon being truncated (if truncation is necessary)
 // Arg 2: Point to domain size array, 3 doubles: {x, y, z}
 // Return:  0 - If Poly is inside domain and was truncated to more than 2 vertices,
@@ -18,198 +152,84 @@
 //          1 - If rejected due to being outside the domain or was truncated to
 //              less than 3 vertices
 bool domainTruncation(Poly &newPoly, double *domainSize) {
-    std::vector<double> points;
-    points.reserve(18); // Initialize with enough room for 6 vertices
-    IntPoints tmpPts; // tmp intersection points
-    int nNodes;
+    ProfileTimer timer(PROF_DOMAIN_TRUNCATION);
     double domainX = domainSize[0] * .5;
     double domainY = domainSize[1] * .5;
     double domainZ = domainSize[2] * .5;
-    int stop = newPoly.numberOfNodes;
+    double half[3] = {domainX, domainY, domainZ};
+    
+    if (newPoly.numberOfNodes <= 0) {
+        newPoly.truncated = 1;
+        return 1; // Reject
+    }
     
     // Check if truncation is necessay:
-    for (int k = 0; k < stop; k++) {
-        int idx = k * 3;
-        
-        if (newPoly.vertices[idx]   > domainX || newPoly.vertices[idx]   < -domainX) {
-            break;
-        }
-        
-        if (newPoly.vertices[idx + 1] > domainY || newPoly.vertices[idx + 1] < -domainY) {
-            break;
-        }
-        
-        if (newPoly.vertices[idx + 2] > domainZ || newPoly.vertices[idx + 2] < -domainZ) {
-            break;
-        }
-        
-        // If finished checking last node and code still hasn't broke
-        // from the for loop, then all nodes are inside domain
-        if (k + 1 == stop) {
-            return 0;
-        }
+    int sides = outsideSides(newPoly, half);
+    
+    if (sides == 0) {
+        return 0;
     }
     
     // If code does not return above, truncation is needed/
     newPoly.truncated = 1; // Mark poly as truncated
-    int nVertices;   // Same as newPoly.numberOfNodes;
-    double ntmp[3];  // Normal of domain side
-    double pttmp[3]; // Center point on domain side
+    int nNodes = newPoly.numberOfNodes;
+    // Polygon before and after a clipping pass, and distances to the side
+    double stackBuffer[7 * clipStackNodes];
+    std::vector<double> heapBuffer;
+    int capacity = clipStackNodes;
+    double *in = stackBuffer;
+    double *out = stackBuffer + 3 * capacity;
+    double *dist = stackBuffer + 6 * capacity;
     
-    // Check against the all the walls of the domain
-    for ( int j = 0; j < 6; j++) {
-        switch(j) {
-        case 0:
-            ntmp[0]  = 0;
-            ntmp[1] = 0;
-            ntmp[2] = 1;
-            pttmp[0] = 0;
-            pttmp[1] = 0;
-            pttmp[2] = domainZ;
-            break;
-            
-        case 1:
-            ntmp[0]  = 0;
-            ntmp[1] = 0;
-            ntmp[2] = -1;
-            pttmp[0] = 0;
-            pttmp[1] = 0;
-            pttmp[2] = -domainZ;
-            break;
-            
-        case 2:
-            ntmp[0]  = 0;
-            ntmp[1] = 1;
-            ntmp[2] = 0;
-            pttmp[0] = 0;
-            pttmp[1] = domainY;
-            pttmp[2] = 0;
-            break;
-            
-        case 3:
-            ntmp[0]  = 0;
-            ntmp[1] = -1;
-            ntmp[2] = 0;
-            pttmp[0] = 0;
-            pttmp[1] = -domainY;
-            pttmp[2] = 0;
-            break;
-            
-        case 4:
-            ntmp[0]  = 1;
-            ntmp[1] = 0;
-            ntmp[2] = 0;
-            pttmp[0] = domainX;
-            pttmp[1] = 0;
-            pttmp[2] = 0;
-            break;
-            
-        case 5:
-            ntmp[0]  = -1;
-            ntmp[1] = 0;
-            ntmp[2] = 0;
-            pttmp[0] = -domainX;
-            pttmp[1] = 0;
-            pttmp[2] = 0;
-            break;
+    if (nNodes > capacity) {
+        capacity = nNodes;
+        heapBuffer.resize(7 * capacity);
+        in = heapBuffer.data();
+        out = in + 3 * capacity;
+        dist = in + 6 * capacity;
+    }
+    
+    std::copy(newPoly.vertices, newPoly.vertices + 3 * nNodes, in);
+    bool clipped = false;
+    
+    // Clip against the all the walls of the domain, +z, -z, +y, -y, +x, -x
+    for (int j = 0; j < 6; j++) {
+        // Until the first pass, sides without outside vertices are known from
+        // outsideSides(). After, clipped points may be outside by round off
+        if (!clipped && (sides & (1 << j)) == 0) {
+            continue;
         }
         
-        nVertices = newPoly.numberOfNodes;
+        int axis = 2 - j / 2;
+        double sign = j % 2 == 0 ? 1 : -1;
+        int nOutside = sideDistances(in, nNodes, axis, sign, half[axis], dist);
         
-        if(nVertices <= 0) {
-            return 1; // Reject
+        if (nOutside == 0) {
+            continue; // Nothing to clip, the pass would copy the polygon
         }
         
-        nNodes = 0;     // Counter for final number of nodes
-        points.clear(); // Clear any points from last iteration
-        int last = (nVertices - 1) * 3; // Index to last node starting position in array
-        double temp[3];
-        temp[0] = newPoly.vertices[last]   - pttmp[0]; //x
-        temp[1] = newPoly.vertices[last + 1] - pttmp[1]; //y
-        temp[2] = newPoly.vertices[last + 2] - pttmp[2]; //z
-        // Previous distance - the dot product of the domain side normal
-        // and the distance between vertex number nVertices and the temp point on the
-        // domain side.
-        double prevdist = dotProduct(temp, ntmp);
+        // Each crossing adds a point, there is at most one per edge with an
+        // outside vertex. Plus one for the vertex clipToSide() always copies.
+        int maxNodes = nNodes - nOutside + std::min(nNodes, 2 * nOutside) + 1;
         
-        for (int i = 0; i < nVertices; i++) {
-            int index = i * 3;
-            temp[0] = newPoly.vertices[index]   - pttmp[0];
-            temp[1] = newPoly.vertices[index + 1] - pttmp[1];
-            temp[2] = newPoly.vertices[index + 2] - pttmp[2];
-            // Current distance, the dot product of domain side normal and
-            // the distance between the ii'th vertex and the temporary point
-            double currdist = dotProduct(temp, ntmp);
-            
-            if (currdist <= 0) { // if vertex is towards the domain relative to the domain side
-                // Save vertex
-                points.push_back(newPoly.vertices[index]);   // x
-                points.push_back(newPoly.vertices[index + 1]); // y
-                points.push_back(newPoly.vertices[index + 2]); // z
-                nNodes++;
-            }
-            
-            if (currdist * prevdist < 0) { //if crosses boundary
-                nNodes++;
-                
-                if (i == 0) { // Store point on boundary
-                    // 'last' is index to last vertice
-                    temp[0] = newPoly.vertices[last]
-                              + (newPoly.vertices[0] - newPoly.vertices[last])
-                              * std::abs(prevdist) / (std::abs(currdist) + std::abs(prevdist));
-                    temp[1] = newPoly.vertices[last + 1]
-                              + (newPoly.vertices[1] - newPoly.vertices[last + 1])
-                              * std::abs(prevdist) / (std::abs(currdist) + std::abs(prevdist));
-                    temp[2] = newPoly.vertices[last + 2]
-                              + (newPoly.vertices[2] - newPoly.vertices[last + 2])
-                              * std::abs(prevdist) / (std::abs(currdist) + std::abs(prevdist));
-                    points.push_back(temp[0]);
-                    points.push_back(temp[1]);
-                    points.push_back(temp[2]);
-                } else {
-                    // If from outside to inside
-                    temp[0] = newPoly.vertices[index - 3]
-                              + (newPoly.vertices[index] - newPoly.vertices[index - 3])
-                              * std::abs(prevdist) / (std::abs(currdist) + std::abs(prevdist));
-                    temp[1] = newPoly.vertices[index - 2]
-                              + (newPoly.vertices[index + 1] - newPoly.vertices[index - 2])
-                              * std::abs(prevdist) / (std::abs(currdist) + std::abs(prevdist));
-                    temp[2] = newPoly.vertices[index - 1]
-                              + (newPoly.vertices[index + 2] - newPoly.vertices[index - 1])
-                              * std::abs(prevdist) / (std::abs(currdist) + std::abs(prevdist));
-                    points.reserve(points.size() + 3); // Resize vector if needed
-                    points.push_back(temp[0]);
-                    points.push_back(temp[1]);
-                    points.push_back(temp[2]);
-                }
-                
-                if (currdist < 0) { // If from outside to inside - swap order
-                    int tmpIndex = (nNodes - 1) * 3; // Index to last saved point
-                    points[tmpIndex] = points[tmpIndex - 3];
-                    points[tmpIndex + 1] = points[tmpIndex - 2];
-                    points[tmpIndex + 2] = points[tmpIndex - 1];
-                    points[tmpIndex - 3] = temp[0];
-                    points[tmpIndex - 2] = temp[1];
-                    points[tmpIndex - 1] = temp[2];
-                }
-            }
-            
-            prevdist = currdist;
-        } // End vertice loops
+        if (maxNodes > capacity) {
+            std::vector<double> larger(7 * maxNodes);
+            std::copy(in, in + 3 * nNodes, larger.begin());
+            std::copy(dist, dist + nNodes, larger.begin() + 6 * maxNodes);
+            heapBuffer.swap(larger);
+            capacity = maxNodes;
+            in = heapBuffer.data();
+            out = in + 3 * capacity;
+            dist = in + 6 * capacity;
+        }
         
-        newPoly.numberOfNodes = nNodes;
+        nNodes = clipToSide(in, nNodes, dist, out);
+        std::swap(in, out);
+        clipped = true;
         
-        if (nNodes > 0) {
-            delete[] newPoly.vertices;
-            newPoly.vertices = new double[3 * nNodes];
-            
-            // Copy new nodes back to newPoly
-            for (int k = 0; k < nNodes; k++) {
-                int idxx = k * 3;
-                newPoly.vertices[idxx]   = points[idxx];
-                newPoly.vertices[idxx + 1] = points[idxx + 1];
-                newPoly.vertices[idxx + 2] = points[idxx + 2];
-            }
+        if (nNodes == 0) {
+            newPoly.numberOfNodes = 0;
+            return 1; // Reject, outside of domain
         }
     } // End main loop
     
@@ -226,28 +246,21 @@ bool domainTruncation(Poly &newPoly, double *domainSize) {
             next = (i + 1) * 3;
         }
         
-        temp[0] = newPoly.vertices[idx]   - newPoly.vertices[next];
-        temp[1] = newPoly.vertices[idx + 1] - newPoly.vertices[next + 1];
-        temp[2] = newPoly.vertices[idx + 2] - newPoly.vertices[next + 2];
+        temp[0] = in[idx]   - in[next];
+        temp[1] = in[idx + 1] - in[next + 1];
+        temp[2] = in[idx + 2] - in[next + 2];
         
-        if (magnitude(temp[0], temp[1], temp[2]) < (2 * h)) { // If distance between current and next vertex < h
+        if (magnitude(temp[0], temp[1], temp[2]) < (2 * params->h)) { // If distance between current and next vertex < h
             // If point is NOT on a boundary, delete current indexed point, ELSE delete next point
-            if ( std::abs(std::abs(newPoly.vertices[idx]) - domainX) > eps &&  std::abs(std::abs(newPoly.vertices[idx + 1]) - domainY) > eps && std::abs(std::abs(newPoly.vertices[idx + 2]) - domainZ) > eps ) {
-                // Loop deletes a vertice by shifting elements to the right of the element, to the left
-                for (int j = i; j < nNodes - 1 ; j++) {
-                    int idx = j * 3;
-                    newPoly.vertices[idx] = newPoly.vertices[idx + 3]; // Shift x coordinate left
-                    newPoly.vertices[idx + 1] = newPoly.vertices[idx + 4]; // Shift y coordinate left
-                    newPoly.vertices[idx + 2] = newPoly.vertices[idx + 5]; // Shift z coordinate left
-                }
+            if ( std::abs(std::abs(in[idx]) - domainX) > params->eps &&  std::abs(std::abs(in[idx + 1]) - domainY) > params->eps && std::abs(std::abs(in[idx + 2]) - domainZ) > params->eps ) {
+                // Deletes a vertice by shifting elements to the right of the element, to the left
+                std::copy(in + idx + 3, in + 3 * nNodes, in + idx);
             } else {
-                // Loop deletes a vertice by shifting elements to the right of the element to the left
+                // Deletes a vertice by shifting elements to the right of the element to the left
                 int end = (nNodes - 1) * 3;
                 
-                for (int j = next; j < end; j += 3) {
-                    newPoly.vertices[j] = newPoly.vertices[j + 3]; // Shift x coordinate left
-                    newPoly.vertices[j + 1] = newPoly.vertices[j + 4]; // Shift y coordinate left
-                    newPoly.vertices[j + 2] = newPoly.vertices[j + 5]; // Shift z coordinate left
+                if (next < end) {
+                    std::copy(in + next + 3, in + 3 * nNodes, in + next);
                 }
             }
             
@@ -257,11 +270,19 @@ bool domainTruncation(Poly &newPoly, double *domainSize) {
         }
     } // End while loop
     
+    // Copy new nodes back to newPoly, the vertex array is only replaced if it is too small
+    if (nNodes > newPoly.numberOfNodes) {
+        delete[] newPoly.vertices;
+        newPoly.vertices = new double[3 * nNodes];
+    }
+    
+    std::copy(in, in + 3 * nNodes, newPoly.vertices);
+    newPoly.numberOfNodes = nNodes;
+    
     if(nNodes < 3) {
         return 1; // Reject
     }
     
-    newPoly.numberOfNodes = nNodes;
     int temp = newPoly.numberOfNodes;
     
     for (int k = 0; k < temp; k++) {
@@ -269,21 +290,21 @@ bool domainTruncation(Poly &newPoly, double *domainSize) {
         // Update which boundaries newPoly touches
         int idx = k * 3;
         
-        if (newPoly.vertices[idx] >= domainX - eps) {
+        if (newPoly.vertices[idx] >= domainX - params->eps) {
             newPoly.faces[0] = 1;
-        } else if (newPoly.vertices[idx] <= -domainX + eps) {
+        } else if (newPoly.vertices[idx] <= -domainX + params->eps) {
             newPoly.faces[1] = 1;
         }
         
-        if (newPoly.vertices[idx + 1] >= domainY - eps) {
+        if (newPoly.vertices[idx + 1] >= domainY - params->eps) {
             newPoly.faces[2] = 1;
-        } else if (newPoly.vertices[idx + 1] <= -domainY + eps) {
+        } else if (newPoly.vertices[idx + 1] <= -domainY + params->eps) {
             newPoly.faces[3] = 1;
         }
         
-        if (newPoly.vertices[idx + 2] >= domainZ - eps) {
+        if (newPoly.vertices[idx + 2] >= domainZ - params->eps) {
             newPoly.faces[4] = 1;
-        } else if (newPoly.vertices[idx + 2] <= -domainZ + eps) {
+        } else if (newPoly.vertices[idx + 2] <= -domainZ + params->eps) {
             newPoly.faces[5] = 1;
         }
     }
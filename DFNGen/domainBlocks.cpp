@@ -0,0 +1,463 @@
+#include "domainBlocks.h"
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <cstdio>
+#include <stdlib.h>
+#include "input.h"
+#include "insertShape.h" // fractureReach()
+#include "mathFunctions.h" // createCDF(), adjustCDF_and_famProb()
+#include "computationalGeometry.h" // intersectionChecking()
+#include "checkpoint.h"
+#include "readInputFunctions.h" // error check for file open checkIfOpen()
+#include "logFile.h"
+
+/*! Translation bounds of the block generated by this process {xMin, xMax, yMin, yMax, zMin, zMax} */
+static double blockBox[6];
+/*! True in a block process */
+static bool blockProcess = false;
+
+
+/* blockFolder() *****************************************************************************/
+/*! Arg 1: Path to output folder
+    Arg 2: Block
+    Return: Folder of a block process, <output folder>/blocks/block_<b> */
+std::string blockFolder(std::string output, unsigned int block) {
+    return output + "/blocks/block_" + to_string(block);
+}
+
+/* blockRange() ******************************************************************************/
+/*! Translation bounds of a block. Blocks are numbered along x, then y, then z. The
+    outer blocks are open ended: translations of regions and layers outside the
+    domain go to them.
+    Arg 1: Number of blocks along x, y and z
+    Arg 2: Block
+    Arg 3: OUTPUT, {xMin, xMax, yMin, yMax, zMin, zMax} */
+static void blockRange(const unsigned int blocks[3], unsigned int block, double box[6]) {
+    unsigned int index[3] = {block % blocks[0], (block / blocks[0]) % blocks[1], block / (blocks[0] * blocks[1])};
+    
+    for (int a = 0; a < 3; a++) {
+        double half = (params->domainSize[a] + params->domainSizeIncrease[a]) / 2;
+        double width = 2 * half / blocks[a];
+        box[2 * a] = index[a] == 0 ? -HUGE_VAL : -half + index[a] * width;
+        box[2 * a + 1] = index[a] + 1 == blocks[a] ? HUGE_VAL : -half + (index[a] + 1) * width;
+    }
+}
+
+/* familyBox() *******************************************************************************/
+/*! Bounds of a family's translations: the domain, its layer or its region
+    Arg 1: Shape family
+    Arg 2: OUTPUT, {xMin, xMax, yMin, yMax, zMin, zMax} */
+static void familyBox(Shape &shapeFam, double box[6]) {
+    for (int a = 0; a < 3; a++) {
+        box[2 * a] = (-params->domainSize[a] - params->domainSizeIncrease[a]) / 2;
+        box[2 * a + 1] = (params->domainSize[a] + params->domainSizeIncrease[a]) / 2;
+    }
+    
+    if (shapeFam.layer > 0 && shapeFam.region == 0) {
+        int layerIdx = (shapeFam.layer - 1) * 2;
+        box[4] = params->layers[layerIdx];
+        box[5] = params->layers[layerIdx + 1];
+    } else if (shapeFam.layer == 0 && shapeFam.region > 0) {
+        int regionIdx = (shapeFam.region - 1) * 6;
+        
+        for (int k = 0; k < 6; k++) {
+            box[k] = params->regions[regionIdx + k];
+        }
+    }
+}
+
+/* blockShare() ******************************************************************************/
+/*! Part of a family's translations which fall in a block
+    Arg 1: Shape family
+    Arg 2: Block bounds, see blockRange()
+    Return: Share in [0, 1], the shares of all blocks add up to 1 */
+static double blockShare(Shape &shapeFam, const double box[6]) {
+    double fam[6];
+    familyBox(shapeFam, fam);
+    double share = 1;
+    
+    for (int a = 0; a < 3; a++) {
+        double lower = fam[2 * a];
+        double upper = fam[2 * a + 1];
+        
+        if (upper > lower) {
+            share *= std::max(0.0, std::min(upper, box[2 * a + 1]) - std::max(lower, box[2 * a])) / (upper - lower);
+        } else {
+            share *= lower >= box[2 * a] && lower < box[2 * a + 1] ? 1 : 0;
+        }
+    }
+    
+    return share;
+}
+
+/* initBlock() *******************************************************************************/
+/*! Restricts generation to one block, in a block process. Must be called after the
+    user fractures are inserted and the radii lists are generated, before the
+    stochastic fractures are inserted. Replaces the radii lists with the block's
+    radii, nPoly and the family probabilities (nPoly option) or the P32 targets
+    (P32 option) with the block's share, and reseeds the random generator with the
+    block number.
+    Arg 1: Number of blocks along x, y and z
+    Arg 2: Block generated by this process
+    Arg 3: Shape families
+    Arg 4: Program statistics, accepted fractures so far
+    Arg 5: CDF of the family probabilities, reallocated
+    Arg 6: Size of CDF
+    Arg 7: Random generator */
+void initBlock(const unsigned int blocks[3], unsigned int block, std::vector<Shape> &shapeFamilies, Stats &pstats,
+               float *&CDF, int &cdfSize, std::mt19937_64 &generator) {
+    std::string logString;
+    int totalFamilies = shapeFamilies.size();
+    unsigned int count = blocks[0] * blocks[1] * blocks[2];
+    
+    if (totalFamilies == 0) {
+        logString = "Error: Domain decomposition (--blocks) requires stochastic fracture families\n";
+        logger.writeLogFile(ERROR,  logString);
+        throw DFNError();
+    }
+    
+    // Shares of each family in each block, [family * count + block]
+    std::vector<double> shares(totalFamilies * count);
+    
+    for (unsigned int b = 0; b < count; b++) {
+        blockRange(blocks, b, blockBox);
+        
+        for (int i = 0; i < totalFamilies; i++) {
+            shares[i * count + b] = blockShare(shapeFamilies[i], blockBox);
+        }
+    }
+    
+    blockRange(blocks, block, blockBox);
+    blockProcess = true;
+    
+    // Radii lists are sorted, largest first. Each block gets radii from the whole list,
+    // by the family's shares (golden ratio sequence, as with streaming generation).
+    for (int i = 0; i < totalFamilies; i++) {
+        Shape &shapeFam = shapeFamilies[i];
+        std::vector<double> radii;
+        
+        for (unsigned int j = shapeFam.radiiIdx; j < shapeFam.radiiList.size(); j++) {
+            double u = std::fmod((j - shapeFam.radiiIdx + 0.5) * 0.6180339887498949, 1.0);
+            unsigned int b = 0;
+            double cumulative = shares[i * count];
+            
+            while (b + 1 < count && u >= cumulative) {
+                b++;
+                cumulative += shares[i * count + b];
+            }
+            
+            if (b == block) {
+                radii.push_back(shapeFam.radiiList[j]);
+            }
+        }
+        
+        shapeFam.radiiList.swap(radii);
+        shapeFam.radiiIdx = 0;
+    }
+    
+    if (params->stopCondition == 0) {
+        // nPoly option: the stochastic fractures are split by the families' shares,
+        // rounded so that the blocks add up to nPoly
+        unsigned int start = pstats.acceptedPolyCount;
+        unsigned int total = params->nPoly > start ? params->nPoly - start : 0;
+        double probSum = 0;
+        
+        for (int i = 0; i < totalFamilies; i++) {
+            probSum += params->famProb[i];
+        }
+        
+        double before = 0;
+        double upTo = 0;
+        
+        for (unsigned int b = 0; b <= block; b++) {
+            before = upTo;
+            
+            for (int i = 0; i < totalFamilies; i++) {
+                upTo += params->famProb[i] * shares[i * count + b] / probSum;
+            }
+        }
+        
+        unsigned int first = (unsigned int) std::floor(total * before + 0.5);
+        unsigned int last = block + 1 == count ? total : (unsigned int) std::floor(total * upTo + 0.5);
+        params->nPoly = start + (last > first ? last - first : 0);
+        // Family probabilities in the block
+        double sum = 0;
+        
+        for (int i = 0; i < totalFamilies; i++) {
+            sum += params->famProb[i] * shares[i * count + block];
+        }
+        
+        if (sum > 0) {
+            for (int i = 0; i < totalFamilies; i++) {
+                params->famProb[i] = params->famProb[i] * shares[i * count + block] / sum;
+            }
+            
+            delete[] CDF;
+            CDF = createCDF(params->famProb, cdfSize);
+        }
+        
+        logString = "Block " + to_string(block) + ": " + to_string(params->nPoly - start) + " of " + to_string(total) + " stochastic fractures\n";
+        logger.writeLogFile(INFO,  logString);
+    } else {
+        // P32 option: families outside the block are complete
+        for (int i = 0; i < totalFamilies; i++) {
+            double share = shares[i * count + block];
+            shapeFamilies[i].p32Target *= share;
+            
+            if (share <= 0 && params->p32Status[i] == 0) {
+                int cdfIdx = cdfIdxFromFamNum(CDF, params->p32Status, i);
+                params->p32Status[i] = 1;
+                
+                if (cdfSize > 1) {
+                    adjustCDF_and_famProb(CDF, params->famProb, cdfSize, cdfIdx);
+                }
+            }
+            
+            logString = "Block " + to_string(block) + ": " + shapeType(shapeFamilies[i]) + " family " + to_string(getFamilyNumber(i, shapeFamilies[i].shapeFamily))
+                        + " target P32 = " + to_string(shapeFamilies[i].p32Target) + "\n";
+            logger.writeLogFile(INFO,  logString);
+        }
+    }
+    
+    std::seed_seq sequence = {(unsigned int) params->seed, block + 1};
+    generator.seed(sequence);
+}
+
+/* limitToBlock() ****************************************************************************/
+/*! Limits the range of a new translation to the block of this process. No change
+    outside a block process or, on each axis, when the range is outside the block.
+    Used by randomTranslation().
+    Arg 1-6: Range {xMin, xMax, yMin, yMax, zMin, zMax}, changed */
+void limitToBlock(float &xMin, float &xMax, float &yMin, float &yMax, float &zMin, float &zMax) {
+    if (!blockProcess) {
+        return;
+    }
+    
+    float *range[6] = {&xMin, &xMax, &yMin, &yMax, &zMin, &zMax};
+    
+    for (int a = 0; a < 3; a++) {
+        double lower = std::max((double) *range[2 * a], blockBox[2 * a]);
+        double upper = std::min((double) *range[2 * a + 1], blockBox[2 * a + 1]);
+        
+        if (lower < upper) {
+            *range[2 * a] = lower;
+            *range[2 * a + 1] = upper;
+        }
+    }
+}
+
+/* inHalo() **********************************************************************************/
+/*! Checks if a fracture of a block can reach the fractures of a neighbouring block
+    Arg 1: Fracture, with bounding box
+    Arg 2: Block bounds, see blockRange()
+    Arg 3: Halo width, largest fracture size plus h
+    Return: True if the fracture's bounding box is within the halo of an inner block boundary */
+static bool inHalo(Poly &poly, const double box[6], double halo) {
+    for (int a = 0; a < 3; a++) {
+        if (poly.boundingBox[2 * a] < box[2 * a] + halo || poly.boundingBox[2 * a + 1] > box[2 * a + 1] - halo) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/* addToP32() ********************************************************************************/
+/*! Adds an accepted fracture to its family's P32
+    Arg 1: Shape family
+    Arg 2: Fracture area */
+static void addToP32(Shape &shapeFam, double area) {
+    if (shapeFam.layer == 0 && shapeFam.region == 0) { // Whole domain
+        shapeFam.currentP32 += area * 2 / (params->domainSize[0] * params->domainSize[1] * params->domainSize[2]);
+    } else if (shapeFam.layer > 0 && shapeFam.region == 0) { // Layer
+        shapeFam.currentP32 += area * 2 / params->layerVol[shapeFam.layer - 1];
+    } else if (shapeFam.layer == 0 && shapeFam.region > 0) { // Region
+        shapeFam.currentP32 += area * 2 / params->regionVol[shapeFam.region - 1];
+    }
+}
+
+/* mergeBlocks() *****************************************************************************/
+/*! Merges the blocks generated by the block processes, in block order, into the DFN
+    of the parent process, see domainBlocks.h. Must be called after the user
+    fractures are inserted, before the insertion loop, which then replaces the
+    fractures rejected at the seams. Rejections, re-translations and rejects per
+    attempt of the block processes are added to the statistics.
+    Arg 1: Path to input file
+    Arg 2: Path to output folder
+    Arg 3: Number of blocks along x, y and z
+    Arg 4: Accepted fractures, user fractures only
+    Arg 5: Intersections
+    Arg 6: Triple intersection points
+    Arg 7: Program statistics
+    Arg 8: Shape families, radii lists are replaced with the unused radii of the blocks
+    Arg 9: CDF of the family probabilities, reallocated
+    Arg 10: Size of CDF
+    Arg 11: radii_All.dat, if outputAllRadii is set */
+void mergeBlocks(std::string inputFile, std::string output, const unsigned int blocks[3], std::vector<Poly> &acceptedPoly,
+                 std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints, Stats &pstats,
+                 std::vector<Shape> &shapeFamilies, float *&CDF, int &cdfSize, std::ofstream &radiiAll) {
+    std::string logString;
+    int totalFamilies = shapeFamilies.size();
+    unsigned int count = blocks[0] * blocks[1] * blocks[2];
+    double halo = fractureReach(shapeFamilies) + params->h;
+    // Each block process has the same state before its stochastic fractures,
+    // its counters are added from there
+    unsigned int start = pstats.acceptedPolyCount;
+    unsigned long long baseRejected = pstats.rejectedPolyCount;
+    unsigned int baseRetranslated = pstats.retranslatedPolyCount;
+    RejectionReasons baseReasons = pstats.rejectionReasons;
+    unsigned int baseRejects = pstats.rejectsPerAttempt.back();
+    std::vector<int> baseRejectedFromFam(pstats.rejectedFromFam, pstats.rejectedFromFam + totalFamilies);
+    // readCheckpoint() restores the family probabilities, P32 status and seed
+    std::vector<float> savedProb = params->famProb;
+    std::vector<bool> savedStatus = params->p32Status;
+    unsigned int savedSeed = params->seed;
+    std::vector<std::vector<double> > unusedRadii(totalFamilies);
+    unsigned int merged = 0;
+    unsigned int seamRejected = 0;
+    logString = "Merging " + to_string(count) + " blocks, halo " + to_string(halo) + " m\n";
+    logger.writeLogFile(INFO,  logString);
+    
+    for (unsigned int b = 0; b < count; b++) {
+        std::string folder = blockFolder(output, b);
+        initCheckpoint(inputFile, folder);
+        std::vector<Poly> blockPoly;
+        std::vector<IntPoints> blockInts;
+        std::vector<Point> blockTriplePoints;
+        Stats blockStats;
+        blockStats.acceptedFromFam = new int[totalFamilies];
+        blockStats.rejectedFromFam = new int[totalFamilies];
+        blockStats.expectedFromFam = new int[totalFamilies];
+        std::vector<Shape> blockFamilies = shapeFamilies;
+        float *blockCDF = NULL;
+        int blockCdfSize;
+        std::mt19937_64 blockGenerator;
+        unsigned long long radiiAllSize;
+        readCheckpoint(blockPoly, blockInts, blockTriplePoints, blockStats, blockFamilies, blockCDF, blockCdfSize, blockGenerator, radiiAllSize);
+        delete[] blockCDF;
+        
+        if (blockPoly.size() < start || blockStats.rejectsPerAttempt.size() != blockPoly.size() + 1) {
+            logString = "Error: Block " + to_string(b) + " (" + folder + ") does not match the input\n";
+            logger.writeLogFile(ERROR,  logString);
+            throw DFNError();
+        }
+        
+        pstats.rejectedPolyCount += blockStats.rejectedPolyCount - baseRejected;
+        pstats.retranslatedPolyCount += blockStats.retranslatedPolyCount - baseRetranslated;
+        RejectionReasons &reasons = pstats.rejectionReasons;
+        RejectionReasons &blockReasons = blockStats.rejectionReasons;
+        reasons.shortIntersection += blockReasons.shortIntersection - baseReasons.shortIntersection;
+        reasons.closeToNode += blockReasons.closeToNode - baseReasons.closeToNode;
+        reasons.closeToEdge += blockReasons.closeToEdge - baseReasons.closeToEdge;
+        reasons.closePointToEdge += blockReasons.closePointToEdge - baseReasons.closePointToEdge;
+        reasons.outside += blockReasons.outside - baseReasons.outside;
+        reasons.triple += blockReasons.triple - baseReasons.triple;
+        reasons.interCloseToInter += blockReasons.interCloseToInter - baseReasons.interCloseToInter;
+        
+        for (int i = 0; i < totalFamilies; i++) {
+            pstats.rejectedFromFam[i] += blockStats.rejectedFromFam[i] - baseRejectedFromFam[i];
+            Shape &blockFam = blockFamilies[i];
+            unusedRadii[i].insert(unusedRadii[i].end(), blockFam.radiiList.begin() + std::min((size_t) blockFam.radiiIdx, blockFam.radiiList.size()), blockFam.radiiList.end());
+        }
+        
+        double box[6];
+        blockRange(blocks, b, box);
+        unsigned int accepted = 0;
+        unsigned int seam = 0;
+        
+        for (unsigned int k = 0; k < blockPoly.size(); k++) {
+            Poly &newPoly = blockPoly[k];
+            
+            // User fractures, already inserted
+            if (k < start) {
+                delete[] newPoly.vertices;
+                continue;
+            }
+            
+            // Rejects before the fracture was accepted by the block process
+            pstats.rejectsPerAttempt.back() += blockStats.rejectsPerAttempt[k] - (k == start ? baseRejects : 0);
+            
+            if (inHalo(newPoly, box, halo)) {
+                seam++;
+            }
+            
+            int familyIndex = newPoly.familyNum;
+            newPoly.groupNum = 0;
+            newPoly.intersectionIndex.clear();
+            
+            // Intersections with the fractures merged so far, FRAM checks
+            if (intersectionChecking(newPoly, acceptedPoly, intPts, pstats, triplePoints) == 0) {
+                pstats.acceptedPolyCount++;
+                pstats.acceptedFromFam[familyIndex]++;
+                pstats.rejectsPerAttempt.push_back(0);
+                
+                if (newPoly.truncated == 1) {
+                    pstats.truncated++;
+                }
+                
+                addToP32(shapeFamilies[familyIndex], newPoly.area);
+                acceptedPoly.push_back(newPoly);
+                
+                accepted++;
+            } else {
+                delete[] newPoly.vertices;
+                pstats.rejectedPolyCount++;
+                pstats.rejectedFromFam[familyIndex]++;
+                pstats.rejectsPerAttempt.back()++;
+            }
+        }
+        
+        // Rejects after the block's last fracture
+        pstats.rejectsPerAttempt.back() += blockStats.rejectsPerAttempt.back();
+        
+        if (params->outputAllRadii == 1) {
+            std::ifstream blockRadii;
+            std::string fileName = folder + "/radii/radii_All.dat";
+            blockRadii.open(fileName.c_str());
+            checkIfOpen(blockRadii, fileName);
+            std::string header;
+            std::getline(blockRadii, header);
+            
+            if (blockRadii.peek() != EOF) {
+                radiiAll << blockRadii.rdbuf();
+            }
+        }
+        
+        delete[] blockStats.acceptedFromFam;
+        delete[] blockStats.rejectedFromFam;
+        delete[] blockStats.expectedFromFam;
+        // The block's log stays in its folder
+        std::remove((folder + "/dfngen.ckpt").c_str());
+        merged += accepted;
+        seamRejected += blockPoly.size() - start - accepted;
+        logString = "Merged block " + to_string(b) + ": " + to_string(accepted) + " of " + to_string(blockPoly.size() - start)
+                    + " fractures, " + to_string(seam) + " within the halo\n";
+        logger.writeLogFile(INFO,  logString);
+    }
+    
+    params->famProb = savedProb;
+    params->p32Status = savedStatus;
+    params->seed = savedSeed;
+    
+    // The insertion loop continues with the radii the blocks did not use
+    for (int i = 0; i < totalFamilies; i++) {
+        std::sort(unusedRadii[i].begin(), unusedRadii[i].end(), std::greater<double>());
+        shapeFamilies[i].radiiList.swap(unusedRadii[i]);
+        shapeFamilies[i].radiiIdx = 0;
+        
+        if (params->stopCondition == 1 && params->p32Status[i] == 0 && shapeFamilies[i].currentP32 >= shapeFamilies[i].p32Target) {
+            int cdfIdx = cdfIdxFromFamNum(CDF, params->p32Status, i);
+            params->p32Status[i] = 1;
+            logString =  "P32 For Family " + std::string(to_string(i + 1)) + " Completed\n\n";
+            logger.writeLogFile(INFO,  logString);
+            
+            if (cdfSize > 1) {
+                adjustCDF_and_famProb(CDF, params->famProb, cdfSize, cdfIdx);
+            }
+        }
+    }
+    
+    logString = "Merged " + to_string(merged) + " fractures, " + to_string(seamRejected) + " rejected at block seams\n";
+    logger.writeLogFile(INFO,  logString);
+}
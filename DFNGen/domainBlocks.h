@@ -0,0 +1,38 @@
+#ifndef _domainBlocks_h_
+#define _domainBlocks_h_
+#include <vector>
+#include <string>
+#include <random>
+#include <fstream>
+#include "structures.h"
+
+/*
+    Domain decomposition (DFNGen --blocks <nx,ny,nz>): the domain is split into
+    nx * ny * nz blocks which are generated at the same time, one process per block.
+
+    Each block process (see runBlocks() in ensemble.cpp) starts from the same radii
+    lists and user fractures, then only translates stochastic fractures inside its
+    block. Each family gets the share of its fractures (nPoly option) or intensity
+    (P32 option) and of its radii list which matches the part of its domain, layer or
+    region inside the block. The block's state is saved in the checkpoint format to
+    <output folder>/blocks/block_<b>/dfngen.ckpt.
+
+    The parent process then merges the blocks in block order: the stochastic fractures
+    of each block are inserted again, in the order they were accepted, with the FRAM
+    checks of intersectionChecking(). Fractures within the halo of a block, the
+    largest fracture size plus h from an inner block boundary, can intersect fractures
+    of the neighbouring blocks: they are the only fractures which the merge can reject.
+    Fractures rejected at the seams are replaced by the usual insertion loop, over the
+    whole domain, from the unused radii of all blocks. The merged network only depends
+    on the seed and the number of blocks, not on the order the blocks finish in.
+*/
+
+std::string blockFolder(std::string output, unsigned int block);
+void initBlock(const unsigned int blocks[3], unsigned int block, std::vector<Shape> &shapeFamilies, Stats &pstats,
+               float *&CDF, int &cdfSize, std::mt19937_64 &generator);
+void limitToBlock(float &xMin, float &xMax, float &yMin, float &yMax, float &zMin, float &zMax);
+void mergeBlocks(std::string inputFile, std::string output, const unsigned int blocks[3], std::vector<Poly> &acceptedPoly,
+                 std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints, Stats &pstats,
+                 std::vector<Shape> &shapeFamilies, float *&CDF, int &cdfSize, std::ofstream &radiiAll);
+
+#endif
@@ -0,0 +1,427 @@
+#include "ecpm.h"
+#include <fstream>
+#include <cmath>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <stdint.h>
+#include "input.h"
+#include "structures.h"
+#include "binaryOutput.h" // writeContainerHeader(), writeChunkHeader()
+#include "readInputFunctions.h" // error check for file open checkIfOpen()
+#include "logFile.h"
+
+/*
+    ECPM file layout (ecpm.bin), same header and chunk structure as dfn.bin (see
+    binaryOutput.cpp), char magic[8] = "DFNECPM\0". Cells are numbered
+    i + nx * j + nx * ny * k, as in pydfnworks.
+
+    GRID  uint64 nx, uint64 ny, uint64 nz, f64 origin[3] (lower corner), f64 cellSize,
+          f64 aperture, f64 fracture permeability, f64 matrixPorosity, f64 matrixPerm
+    PORO  f64 porosity[n]
+    KISO  f64 isotropic permeability[n]
+    KANI  f64 permeability tensor[6n], per cell: xx, yy, zz, xy, xz, yz
+    CFRA  CSR cell -> fractures: uint64 start[n+1], uint32 fracture[start[n]],
+          f64 area[start[n]]. Fracture i is final fracture i + 1, area is the
+          area of the fracture inside the cell
+*/
+
+static const char ecpmMagic[8] = {'D', 'F', 'N', 'E', 'C', 'P', 'M', 0};
+
+/*! Fracture piece inside a cell */
+struct CellFracture {
+    uint32_t cell;
+    uint32_t fracture;
+    double area;
+};
+
+/* clipToPlane() *****************************************************************************/
+/*! Clips a convex polygon to one side of an axis aligned plane
+    Arg 1: Polygon vertices {x1, y1, z1, x2, ...}
+    Arg 2: Number of vertices
+    Arg 3: Axis of the plane normal (0: x, 1: y, 2: z)
+    Arg 4: Position of the plane along the axis
+    Arg 5: 1 to keep the part above the plane, -1 to keep the part below
+    Arg 6: OUTPUT, vertices of the clipped polygon, room for n + 1 vertices
+    Return: Number of vertices of the clipped polygon */
+static int clipToPlane(const double *in, int n, int axis, double bound, double side, double *out) {
+    int m = 0;
+    
+    for (int i = 0; i < n; i++) {
+        const double *a = in + 3 * i;
+        const double *b = in + 3 * ((i + 1) % n);
+        double da = side * (a[axis] - bound);
+        double db = side * (b[axis] - bound);
+        
+        if (da >= 0) {
+            out[3 * m] = a[0];
+            out[3 * m + 1] = a[1];
+            out[3 * m + 2] = a[2];
+            m++;
+        }
+        
+        if ((da < 0 && db > 0) || (da > 0 && db < 0)) {
+            double t = da / (da - db);
+            out[3 * m] = a[0] + t * (b[0] - a[0]);
+            out[3 * m + 1] = a[1] + t * (b[1] - a[1]);
+            out[3 * m + 2] = a[2] + t * (b[2] - a[2]);
+            out[3 * m + axis] = bound;
+            m++;
+        }
+    }
+    
+    return m;
+}
+
+/* clipToSlab() ******************************************************************************/
+/*! Clips a convex polygon to the slab lo <= coordinate <= hi along an axis. A polygon
+    lying in the upper plane of the slab belongs to the next slab, unless there is none.
+    Arg 1: Polygon vertices {x1, y1, z1, x2, ...}
+    Arg 2: Number of vertices
+    Arg 3: Axis (0: x, 1: y, 2: z)
+    Arg 4: Lower bound of the slab
+    Arg 5: Upper bound of the slab
+    Arg 6: True if the slab is the last one along the axis
+    Arg 7: OUTPUT, vertices of the clipped polygon, room for n + 2 vertices
+    Arg 8: Scratch buffer, room for n + 1 vertices
+    Return: Number of vertices of the clipped polygon, less than 3 if it is outside the slab */
+static int clipToSlab(const double *in, int n, int axis, double lo, double hi, bool last, double *out, double *scratch) {
+    int m = clipToPlane(in, n, axis, lo, 1, scratch);
+    m = clipToPlane(scratch, m, axis, hi, -1, out);
+    
+    if (!last && m > 0) {
+        for (int i = 0; i < m; i++) {
+            if (out[3 * i + axis] < hi) {
+                return m;
+            }
+        }
+        
+        return 0;
+    }
+    
+    return m;
+}
+
+/* polygonArea() *****************************************************************************/
+/*! Area of a planar polygon
+    Arg 1: Polygon vertices {x1, y1, z1, x2, ...}
+    Arg 2: Number of vertices
+    Arg 3: Unit normal of the polygon's plane
+    Return: Area */
+static double polygonArea(const double *v, int n, const double *normal) {
+    double sum[3] = {0, 0, 0};
+    
+    for (int i = 1; i < n - 1; i++) {
+        double a[3] = {v[3 * i] - v[0], v[3 * i + 1] - v[1], v[3 * i + 2] - v[2]};
+        double b[3] = {v[3 * i + 3] - v[0], v[3 * i + 4] - v[1], v[3 * i + 5] - v[2]};
+        sum[0] += a[1] * b[2] - a[2] * b[1];
+        sum[1] += a[2] * b[0] - a[0] * b[2];
+        sum[2] += a[0] * b[1] - a[1] * b[0];
+    }
+    
+    return 0.5 * std::fabs(sum[0] * normal[0] + sum[1] * normal[1] + sum[2] * normal[2]);
+}
+
+/* cellRange() *******************************************************************************/
+/*! Range of grid cells along an axis covered by a polygon
+    Arg 1: Polygon vertices {x1, y1, z1, x2, ...}
+    Arg 2: Number of vertices
+    Arg 3: Axis (0: x, 1: y, 2: z)
+    Arg 4: Lower corner of the grid along the axis
+    Arg 5: Cell size
+    Arg 6: Number of cells along the axis
+    Arg 7: OUTPUT, first cell
+    Arg 8: OUTPUT, last cell */
+static void cellRange(const double *v, int n, int axis, double origin, double cellSize, int cells, int &first, int &last) {
+    double min = v[axis];
+    double max = v[axis];
+    
+    for (int i = 1; i < n; i++) {
+        min = std::min(min, v[3 * i + axis]);
+        max = std::max(max, v[3 * i + axis]);
+    }
+    
+    first = std::max(0, std::min(cells - 1, (int) std::floor((min - origin) / cellSize)));
+    last = std::max(0, std::min(cells - 1, (int) std::floor((max - origin) / cellSize)));
+}
+
+/* correctionFactor() ************************************************************************/
+/*! Stair step correction factor of Sweeney et al. (2019), from 1 for a fracture aligned
+    with the grid to 2 * sqrt(2) for a fracture at 45 degrees
+    Arg 1: Deviation from 45 degrees of the angle between the fracture normal and the axis
+    Return: Correction factor */
+static double correctionFactor(double deviation) {
+    double b = 2 * std::sqrt(2.0);
+    return (b - 1) / -45.0 * deviation + b;
+}
+
+/* writeEcpm() *******************************************************************************/
+/*! Upscales the final fractures to an ECPM grid and writes ecpm.bin (see ecpm.h)
+    Must be called before writeIntersectionFiles(), which rotates the final fractures to
+    the x-y plane.
+    Arg 1: std::vector array of indices of fractures left after isolated fracture removal
+    Arg 2: std::vector array of all accepted fractures
+    Arg 3: Path to output folder */
+void writeEcpm(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::string &output) {
+    std::string logString = "Writing ECPM Upscaling File (ecpm.bin)\n";
+    logger.writeLogFile(INFO,  logString);
+    double d = params->ecpmCellSize;
+    double origin[3] = {-params->domainSize[0] * .5, -params->domainSize[1] * .5, -params->domainSize[2] * .5};
+    int cells[3];
+    
+    for (int a = 0; a < 3; a++) {
+        cells[a] = (int) std::floor(params->domainSize[a] / d + 0.5);
+    }
+    
+    int nx = cells[0];
+    int ny = cells[1];
+    int nz = cells[2];
+    size_t n = (size_t) nx * ny * nz;
+    double fracturePerm = params->ecpmAperture * params->ecpmAperture / 12;
+    double cellVolume = d * d * d;
+    // Fractures of each z layer, in fracture order
+    std::vector<uint64_t> layerStart(nz + 1, 0);
+    unsigned int maxNodes = 0;
+    
+    for (unsigned int f = 0; f < finalFractures.size(); f++) {
+        Poly &poly = acceptedPoly[finalFractures[f]];
+        int k0, k1;
+        cellRange(poly.vertices, poly.numberOfNodes, 2, origin[2], d, nz, k0, k1);
+        
+        for (int k = k0; k <= k1; k++) {
+            layerStart[k + 1]++;
+        }
+        
+        maxNodes = std::max(maxNodes, (unsigned int) poly.numberOfNodes);
+    }
+    
+    for (int k = 0; k < nz; k++) {
+        layerStart[k + 1] += layerStart[k];
+    }
+    
+    std::vector<uint32_t> layerFractures(layerStart[nz]);
+    std::vector<uint64_t> next(layerStart.begin(), layerStart.end() - 1);
+    
+    for (unsigned int f = 0; f < finalFractures.size(); f++) {
+        Poly &poly = acceptedPoly[finalFractures[f]];
+        int k0, k1;
+        cellRange(poly.vertices, poly.numberOfNodes, 2, origin[2], d, nz, k0, k1);
+        
+        for (int k = k0; k <= k1; k++) {
+            layerFractures[next[k]++] = f;
+        }
+    }
+    
+    // Sums over the fractures of each cell, replaced by the cell's values once its layer is done
+    std::vector<double> porosity(n, 0);
+    std::vector<double> kIso(n, 0);
+    std::vector<double> kAniso(6 * n, 0);
+    std::vector<std::vector<CellFracture> > layerPieces(nz);
+    std::atomic<int> nextLayer(0);
+    unsigned int nThreads = std::thread::hardware_concurrency();
+    
+    if (nThreads == 0) {
+        nThreads = 1;
+    }
+    
+    if (nThreads > (unsigned int) nz) {
+        nThreads = nz;
+    }
+    
+    auto worker = [&]() {
+        // Thread local clipping buffers, a convex polygon gains at most one vertex per plane
+        std::vector<double> layerPiece(3 * (maxNodes + 2));
+        std::vector<double> rowPiece(3 * (maxNodes + 4));
+        std::vector<double> cellPiece(3 * (maxNodes + 6));
+        std::vector<double> scratch(3 * (maxNodes + 6));
+        // Smallest deviation from 45 degrees of the fracture normals, per cell of the layer and axis
+        std::vector<double> deviation(3 * (size_t) nx * ny);
+        int k;
+        
+        while ((k = nextLayer++) < nz) {
+            std::fill(deviation.begin(), deviation.end(), 45.0);
+            std::vector<CellFracture> &pieces = layerPieces[k];
+            double z0 = origin[2] + k * d;
+            
+            for (uint64_t l = layerStart[k]; l < layerStart[k + 1]; l++) {
+                Poly &poly = acceptedPoly[finalFractures[layerFractures[l]]];
+                const double *normal = poly.normal;
+                int zCount = clipToSlab(poly.vertices, poly.numberOfNodes, 2, z0, z0 + d, k == nz - 1, &layerPiece[0], &scratch[0]);
+                
+                if (zCount < 3) {
+                    continue;
+                }
+                
+                double tensor[6] = {1 - normal[0] * normal[0], 1 - normal[1] * normal[1], 1 - normal[2] * normal[2],
+                                    -normal[0] * normal[1], -normal[0] * normal[2], -normal[1] * normal[2]
+                                   };
+                double fractureDeviation[3];
+                
+                for (int a = 0; a < 3; a++) {
+                    double angle = std::fmod(std::acos(std::max(-1.0, std::min(1.0, normal[a]))) * 180 / M_PI, 90.0);
+                    fractureDeviation[a] = std::fabs(angle - 45);
+                }
+                
+                int j0, j1;
+                cellRange(&layerPiece[0], zCount, 1, origin[1], d, ny, j0, j1);
+                
+                for (int j = j0; j <= j1; j++) {
+                    double y0 = origin[1] + j * d;
+                    int yCount = clipToSlab(&layerPiece[0], zCount, 1, y0, y0 + d, j == ny - 1, &rowPiece[0], &scratch[0]);
+                    
+                    if (yCount < 3) {
+                        continue;
+                    }
+                    
+                    int i0, i1;
+                    cellRange(&rowPiece[0], yCount, 0, origin[0], d, nx, i0, i1);
+                    
+                    for (int i = i0; i <= i1; i++) {
+                        double x0 = origin[0] + i * d;
+                        int xCount = clipToSlab(&rowPiece[0], yCount, 0, x0, x0 + d, i == nx - 1, &cellPiece[0], &scratch[0]);
+                        
+                        if (xCount < 3) {
+                            continue;
+                        }
+                        
+                        double area = polygonArea(&cellPiece[0], xCount, normal);
+                        
+                        if (area <= 0) {
+                            continue;
+                        }
+                        
+                        size_t layerCell = i + (size_t) nx * j;
+                        size_t cell = layerCell + (size_t) nx * ny * k;
+                        double w = params->ecpmAperture * area / cellVolume;
+                        porosity[cell] += w;
+                        kIso[cell] += w * fracturePerm;
+                        
+                        for (int c = 0; c < 6; c++) {
+                            kAniso[6 * cell + c] += w * fracturePerm * tensor[c];
+                        }
+                        
+                        for (int a = 0; a < 3; a++) {
+                            deviation[3 * layerCell + a] = std::min(deviation[3 * layerCell + a], fractureDeviation[a]);
+                        }
+                        
+                        CellFracture piece;
+                        piece.cell = cell;
+                        piece.fracture = layerFractures[l];
+                        piece.area = area;
+                        pieces.push_back(piece);
+                    }
+                }
+            }
+            
+            // Cell values of the layer
+            for (size_t layerCell = 0; layerCell < (size_t) nx * ny; layerCell++) {
+                size_t cell = layerCell + (size_t) nx * ny * k;
+                double *tensor = &kAniso[6 * cell];
+                
+                if (porosity[cell] == 0) {
+                    porosity[cell] = params->ecpmMatrixPorosity;
+                    kIso[cell] = params->ecpmMatrixPerm;
+                    tensor[0] = tensor[1] = tensor[2] = params->ecpmMatrixPerm;
+                    continue;
+                }
+                
+                double phi = std::min(1.0, porosity[cell]);
+                porosity[cell] = phi;
+                kIso[cell] = std::max(params->ecpmMatrixPerm, (1 - phi) * params->ecpmMatrixPerm + phi * kIso[cell]);
+                
+                for (int a = 0; a < 3; a++) {
+                    double factor = params->ecpmCorrectionFactor ? correctionFactor(deviation[3 * layerCell + a]) : 1;
+                    tensor[a] = std::max(params->ecpmMatrixPerm, (1 - phi) * params->ecpmMatrixPerm + phi * factor * tensor[a]);
+                }
+                
+                for (int c = 3; c < 6; c++) {
+                    tensor[c] *= phi;
+                }
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    
+    for (unsigned int t = 1; t < nThreads; t++) {
+        threads.push_back(std::thread(worker));
+    }
+    
+    worker();
+    
+    for (unsigned int t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+    
+    // CSR cell -> fractures, pieces of a cell are in fracture order within its layer
+    std::vector<uint64_t> cellStart(n + 1, 0);
+    
+    for (int k = 0; k < nz; k++) {
+        for (size_t p = 0; p < layerPieces[k].size(); p++) {
+            cellStart[layerPieces[k][p].cell + 1]++;
+        }
+    }
+    
+    for (size_t c = 0; c < n; c++) {
+        cellStart[c + 1] += cellStart[c];
+    }
+    
+    uint64_t pieceCount = cellStart[n];
+    std::vector<uint32_t> cellFractures(pieceCount);
+    std::vector<double> cellAreas(pieceCount);
+    std::vector<uint64_t> nextPiece(cellStart.begin(), cellStart.end() - 1);
+    
+    for (int k = 0; k < nz; k++) {
+        for (size_t p = 0; p < layerPieces[k].size(); p++) {
+            CellFracture &piece = layerPieces[k][p];
+            uint64_t idx = nextPiece[piece.cell]++;
+            cellFractures[idx] = piece.fracture;
+            cellAreas[idx] = piece.area;
+        }
+        
+        std::vector<CellFracture>().swap(layerPieces[k]);
+    }
+    
+    size_t fracturedCells = 0;
+    
+    for (size_t c = 0; c < n; c++) {
+        if (cellStart[c + 1] > cellStart[c]) {
+            fracturedCells++;
+        }
+    }
+    
+    logString = "ECPM grid " + to_string(nx) + " x " + to_string(ny) + " x " + to_string(nz) + " cells, "
+                + to_string(fracturedCells) + " cells intersect fractures\n";
+    logger.writeLogFile(INFO,  logString);
+    std::string fileName = output + "/ecpm.bin";
+    std::ofstream file;
+    file.open(fileName.c_str(), std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+    checkIfOpen(file, fileName);
+    writeContainerHeader(file, ecpmMagic, ECPM_VERSION);
+    // GRID
+    std::string chunk;
+    appendValue(chunk, (uint64_t) nx);
+    appendValue(chunk, (uint64_t) ny);
+    appendValue(chunk, (uint64_t) nz);
+    appendRaw(chunk, origin, 3);
+    appendValue(chunk, d);
+    appendValue(chunk, params->ecpmAperture);
+    appendValue(chunk, fracturePerm);
+    appendValue(chunk, params->ecpmMatrixPorosity);
+    appendValue(chunk, params->ecpmMatrixPerm);
+    writeChunkHeader(file, "GRID", chunk.size());
+    file.write(chunk.data(), chunk.size());
+    // PORO, KISO, KANI
+    writeChunkHeader(file, "PORO", n * sizeof(double));
+    file.write(reinterpret_cast<const char*>(porosity.data()), n * sizeof(double));
+    writeChunkHeader(file, "KISO", n * sizeof(double));
+    file.write(reinterpret_cast<const char*>(kIso.data()), n * sizeof(double));
+    writeChunkHeader(file, "KANI", 6 * n * sizeof(double));
+    file.write(reinterpret_cast<const char*>(kAniso.data()), 6 * n * sizeof(double));
+    // CFRA
+    writeChunkHeader(file, "CFRA", (n + 1) * sizeof(uint64_t) + pieceCount * (sizeof(uint32_t) + sizeof(double)));
+    file.write(reinterpret_cast<const char*>(cellStart.data()), (n + 1) * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char*>(cellFractures.data()), pieceCount * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(cellAreas.data()), pieceCount * sizeof(double));
+    file.close();
+}
+
@@ -0,0 +1,36 @@
+#ifndef _ecpm_h_
+#define _ecpm_h_
+#include <vector>
+#include <string>
+#include "structures.h"
+
+/*! ECPM file format version, see ecpm.cpp */
+#define ECPM_VERSION 1
+
+/*
+    Equivalent continuous porous medium (ECPM) upscaling, the native version of
+    pydfnworks' mapdfn_ecpm. Enabled with the 'ecpmOutput' input option.
+
+    The final fractures are rasterized onto a regular grid of cubic cells with edge
+    'ecpmCellSize' over the domain: each fracture is clipped to the z layers, then
+    the y rows, then the x cells its bounding box covers, and the area of every
+    piece is kept. Layers are processed in parallel, a layer owns its cells, so the
+    result does not depend on the number of threads.
+
+    All fractures have aperture b = 'ecpmAperture' and permeability k = b^2 / 12
+    (cubic law). The fracture volume fraction of a fracture in a cell of edge d is
+    w = b * A / d^3, for the area A of the fracture inside the cell (pydfnworks
+    assumes A = d^2, i.e. each fracture crosses the whole cell). For a cell with
+    fractures, with matrix permeability km:
+        porosity      phi = min(1, sum(w))
+        isotropic     max(km, (1 - phi) * km + phi * sum(w * k))
+        anisotropic   diagonal: max(km, (1 - phi) * km + phi * c_i * sum(w * k * (1 - n_i^2)))
+                      off diagonal: -phi * sum(w * k * n_i * n_j)
+    with n the fracture normal and c_i the stair step correction factor of Sweeney et
+    al. (2019) along axis i, 1 when 'ecpmCorrectionFactor' is off. Cells without
+    fractures get 'ecpmMatrixPorosity' and 'ecpmMatrixPerm'.
+*/
+
+void writeEcpm(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::string &output);
+
+#endif
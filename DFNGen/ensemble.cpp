@@ -0,0 +1,398 @@
+#include "ensemble.h"
+#include <map>
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <sched.h>
+#include "output.h" // makeDIR(), DIR_exists()
+#include "domainBlocks.h" // blockFolder()
+#include "profile.h"
+#include "hotkey.h"
+#include "logFile.h"
+
+extern Logger logger;
+
+/*
+    Ensemble mode (--ensemble <seeds>): one realization of the DFN per seed, each
+    written to <output folder>/realization_<seed>.
+
+    The input file is read once. The process then forks one worker per realization,
+    at most <jobs> at a time. Workers start from the parsed input and shape families
+    of the parent and continue through main() with their own copy of all the
+    generation state (config.input with famProb and p32 status, families' radii
+    lists, the file scope state of the library). A realization is the same network a single run of DFNGen
+    with 'seed: <seed>' in the input file writes.
+
+    Domain decomposition (--blocks <nx,ny,nz>, see domainBlocks.h) runs its block
+    processes the same way, in <output folder>/blocks/block_<b>. With --pin, each
+    worker is pinned to one CPU, in turn, of those the process may run on.
+*/
+
+/*! Set by SIGINT or SIGUSR1 in the parent process of the workers */
+static volatile sig_atomic_t stopEnsemble = 0;
+
+
+/***********************************************/
+/*! Signal handler of the parent process, requests to stop the workers */
+static void stopEnsembleHandler(int) {
+    stopEnsemble = 1;
+}
+
+
+/* parseSeedList() ***************************************************************************/
+/*! Reads the seeds of an ensemble, comma separated seeds and inclusive ranges,
+    e.g. "1-100" or "1,5,9-12". Seeds must be greater than 0 (seed 0 selects a
+    time based seed) and unique (one output folder per seed).
+    Arg 1: Seed list, as given on the command line
+    Return: Seeds in the given order */
+std::vector<unsigned int> parseSeedList(std::string list) {
+    std::vector<unsigned int> seeds;
+    std::stringstream stream(list);
+    std::string item;
+    
+    while (std::getline(stream, item, ',')) {
+        unsigned long first, last;
+        char *end;
+        first = strtoul(item.c_str(), &end, 10);
+        last = first;
+        
+        if (*end == '-') {
+            last = strtoul(end + 1, &end, 10);
+        }
+        
+        if (item.empty() || *end != 0 || item[0] == '-' || first == 0 || last < first || last > 0xFFFFFFFFUL) {
+            std::string logString = "Error: Invalid seed list '" + list + "', expected seeds > 0 and ranges, e.g. 1-100 or 1,5,9-12\n";
+            logger.writeLogFile(ERROR,  logString);
+            exit(1);
+        }
+        
+        for (unsigned long s = first; s <= last; s++) {
+            seeds.push_back(s);
+        }
+    }
+    
+    std::vector<unsigned int> sorted = seeds;
+    std::sort(sorted.begin(), sorted.end());
+    
+    if (seeds.empty() || std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+        std::string logString = "Error: Seed list '" + list + "' is empty or contains a seed twice\n";
+        logger.writeLogFile(ERROR,  logString);
+        exit(1);
+    }
+    
+    return seeds;
+}
+
+
+/* redirect() ********************************************************************************/
+/*! Points a file descriptor of the process at a file
+    Arg 1: File descriptor, e.g. 0 for stdin
+    Arg 2: Path to file
+    Arg 3: open() flags */
+static void redirect(int fd, std::string file, int flags) {
+    int newFd = open(file.c_str(), flags, 0644);
+    
+    if (newFd < 0 || dup2(newFd, fd) < 0) {
+        std::string logString = "Error: Unable to redirect to " + file + ": " + strerror(errno) + "\n";
+        logger.writeLogFile(ERROR,  logString);
+        exit(1);
+    }
+    
+    close(newFd);
+}
+
+
+/* startWorker() *****************************************************************************/
+/*! Sets up a worker process: creates its output folder, sends the log to
+    <folder>/dfngen_logfile.txt and the console output to <folder>/run.log.
+    stdin is /dev/null, the '~' hotkey is not available in workers. SIGINT and
+    SIGUSR1 set the stop flag of the worker from the start (see hotkey.cpp), a
+    stop request is never lost or fatal before main() calls startHotkey().
+    Arg 1: Worker output folder
+    Arg 2: Sub folders to create in the output folder
+    Arg 3: Log asynchronously, as the process did before the workers were started
+    Arg 4: CPU to pin the worker to, -1 for none */
+static void startWorker(std::string folder, std::vector<std::string> &subFolders, bool asyncLog, int cpu) {
+    installStopHandlers();
+    
+    // Caught by the handler of the parent, inherited until now
+    if (stopEnsemble) {
+        stopInsertion = true;
+    }
+    
+    makeDIR(folder.c_str());
+    
+    for (unsigned int i = 0; i < subFolders.size(); i++) {
+        makeDIR((folder + subFolders[i]).c_str());
+    }
+    
+    redirect(0, "/dev/null", O_RDONLY);
+    redirect(1, folder + "/run.log", O_WRONLY | O_CREAT | O_TRUNC);
+    logger.reopen(folder + "/dfngen_logfile.txt");
+    
+    if (asyncLog) {
+        logger.setSynchronous(false);
+    }
+    
+    if (cpu >= 0) {
+        // Memory is allocated on the NUMA node of the CPU the worker first touches it from
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        
+        if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+            std::string logString = "Warning: Unable to pin the process to CPU " + to_string(cpu) + ": " + strerror(errno) + "\n";
+            logger.writeLogFile(WARNING,  logString);
+        }
+    }
+    
+    restartProfiling();
+}
+
+
+/* pinnedCpu() *******************************************************************************/
+/*! CPU a worker is pinned to: the workers go round the CPUs the process may run on
+    Arg 1: Worker index
+    Return: CPU number, -1 if the CPUs are unknown */
+static int pinnedCpu(unsigned int worker) {
+    cpu_set_t allowed;
+    
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0) {
+        return -1;
+    }
+    
+    int n = worker % CPU_COUNT(&allowed);
+    
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &allowed) && n-- == 0) {
+            return cpu;
+        }
+    }
+    
+    return -1;
+}
+
+
+/* runWorkers() ******************************************************************************/
+/*! Runs one worker process per folder, at most 'jobs' at a time, and waits for them.
+    Workers start from the state of the parent process. SIGINT or SIGUSR1 stop the
+    workers: no more workers are started and running ones stop inserting fractures
+    and finish (see hotkey.cpp).
+    Arg 1: Worker names, for the log, e.g. "realization seed 5"
+    Arg 2: Worker output folders
+    Arg 3: Sub folders to create in each output folder
+    Arg 4: Maximum number of workers running at the same time
+    Arg 5: Pin each worker to one CPU
+    Arg 6: OUTPUT, number of workers which failed (parent process)
+    Return: Index of the worker (worker processes), -1 once all workers have finished (parent process) */
+static int runWorkers(std::vector<std::string> &names, std::vector<std::string> &folders, std::vector<std::string> subFolders,
+                      unsigned int jobs, bool pin, unsigned int &failed) {
+    std::string logString;
+    // fork() only copies the calling thread, stop the log writer thread first
+    bool asyncLog = !logger.isSynchronous();
+    logger.setSynchronous(true);
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = stopEnsembleHandler;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGUSR1, &action, NULL);
+    action.sa_flags = SA_RESETHAND;
+    sigaction(SIGINT, &action, NULL);
+    std::map<pid_t, unsigned int> running;
+    unsigned int next = 0;
+    unsigned int finished = 0;
+    bool stopSent = false;
+    failed = 0;
+    
+    while ((next < names.size() && !stopEnsemble) || !running.empty()) {
+        if (stopEnsemble && !stopSent) {
+            logString = "Stopping, " + to_string(names.size() - next) + " not started\n";
+            logger.writeLogFile(WARNING,  logString);
+            
+            for (std::map<pid_t, unsigned int>::iterator it = running.begin(); it != running.end(); ++it) {
+                kill(it->first, SIGUSR1);
+            }
+            
+            stopSent = true;
+            continue;
+        }
+        
+        if (!stopEnsemble && next < names.size() && running.size() < jobs) {
+            unsigned int worker = next++;
+            std::cout.flush();
+            pid_t pid = fork();
+            
+            if (pid == 0) {
+                startWorker(folders[worker], subFolders, asyncLog, pin ? pinnedCpu(worker) : -1);
+                return worker;
+            } else if (pid < 0) {
+                logString = "Error: Unable to start " + names[worker] + ": " + strerror(errno) + "\n";
+                logger.writeLogFile(ERROR,  logString);
+                stopEnsemble = 1;
+                continue;
+            }
+            
+            running[pid] = worker;
+            logString = "Started " + names[worker] + " (" + folders[worker] + ")\n";
+            logger.writeLogFile(INFO,  logString);
+            continue;
+        }
+        
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        
+        if (pid < 0) {
+            // Interrupted by a stop request
+            continue;
+        }
+        
+        unsigned int worker = running[pid];
+        running.erase(pid);
+        finished++;
+        
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+            logString = "Finished " + names[worker] + " (" + to_string(finished) + "/" + to_string(names.size()) + ")\n";
+            logger.writeLogFile(INFO,  logString);
+        } else {
+            failed++;
+            logString = "Error: " + names[worker] + " failed ("
+                        + (WIFEXITED(status) ? "exit status " + to_string(WEXITSTATUS(status)) : "signal " + to_string(WTERMSIG(status)))
+                        + "), see " + folders[worker] + "/dfngen_logfile.txt\n";
+            logger.writeLogFile(ERROR,  logString);
+        }
+    }
+    
+    failed += names.size() - finished;
+    return -1;
+}
+
+
+/* runEnsemble() *****************************************************************************/
+/*! Runs one worker process per seed, at most 'jobs' at a time, and waits for them.
+    Returns only in the worker processes, which continue main() with their seed. The
+    parent process exits when all workers have finished, with status 1 if any failed.
+    SIGINT or SIGUSR1 stop the ensemble: no more realizations are started and running
+    ones stop inserting fractures and write their output (see hotkey.cpp).
+    Arg 1: Seeds, see parseSeedList()
+    Arg 2: Maximum number of realizations generated at the same time
+    Arg 3: Pin each realization to one CPU
+    Arg 4: Path to output folder
+    Arg 5: OUTPUT, output folder of the realization (worker processes)
+    Return: Seed of the realization (worker processes) */
+unsigned int runEnsemble(std::vector<unsigned int> &seeds, unsigned int jobs, bool pin, std::string output, std::string &realizationFolder) {
+    std::string logString;
+    
+    if (!DIR_exists(output.c_str())) {
+        logString = "Error: Output folder " + output + " does not exist\n";
+        logger.writeLogFile(ERROR,  logString);
+        exit(1);
+    }
+    
+    jobs = std::max(jobs, 1u);
+    logString = "Ensemble of " + to_string(seeds.size()) + " realizations, " + to_string(jobs) + " at a time\n";
+    logger.writeLogFile(INFO,  logString);
+    std::vector<std::string> names;
+    std::vector<std::string> folders;
+    
+    for (unsigned int i = 0; i < seeds.size(); i++) {
+        names.push_back("realization seed " + to_string(seeds[i]));
+        folders.push_back(output + "/realization_" + to_string(seeds[i]));
+    }
+    
+    std::string subFolders[5] = {"/dfnGen_output", "/dfnGen_output/radii", "/intersections", "/polys", "/radii"};
+    unsigned int failed;
+    int worker = runWorkers(names, folders, std::vector<std::string>(subFolders, subFolders + 5), jobs, pin, failed);
+    
+    if (worker >= 0) {
+        realizationFolder = folders[worker];
+        return seeds[worker];
+    }
+    
+    logString = "Ensemble complete: " + to_string(seeds.size() - failed) + " of " + to_string(seeds.size()) + " realizations generated\n";
+    logger.writeLogFile(INFO,  logString);
+    exit(failed > 0 ? 1 : 0);
+}
+
+
+/* parseBlocks() *****************************************************************************/
+/*! Reads the number of blocks of a domain decomposition, "nx,ny,nz" or "nx"
+    Arg 1: Blocks, as given on the command line
+    Arg 2: OUTPUT, number of blocks along x, y and z */
+void parseBlocks(std::string list, unsigned int blocks[3]) {
+    std::stringstream stream(list);
+    std::string item;
+    unsigned int axes = 0;
+    blocks[0] = blocks[1] = blocks[2] = 1;
+    
+    while (std::getline(stream, item, ',')) {
+        char *end;
+        unsigned long n = strtoul(item.c_str(), &end, 10);
+        
+        if (axes == 3 || item.empty() || *end != 0 || item[0] == '-' || n == 0 || n > 1000) {
+            std::string logString = "Error: Invalid blocks '" + list + "', expected blocks along x, y and z, e.g. 2,2,1\n";
+            logger.writeLogFile(ERROR,  logString);
+            exit(1);
+        }
+        
+        blocks[axes++] = n;
+    }
+}
+
+
+/* runBlocks() *******************************************************************************/
+/*! Runs one block process per block of a domain decomposition, at most 'jobs' at a
+    time, and waits for them (see domainBlocks.h). Block processes continue main()
+    with their block. The parent process returns once all blocks are generated, it
+    exits with status 1 if a block failed or was not started.
+    Arg 1: Number of blocks along x, y and z
+    Arg 2: Maximum number of blocks generated at the same time
+    Arg 3: Pin each block process to one CPU
+    Arg 4: Path to output folder
+    Arg 5: OUTPUT, folder of the block (block processes)
+    Return: Block (block processes), -1 (parent process) */
+int runBlocks(unsigned int blocks[3], unsigned int jobs, bool pin, std::string output, std::string &folder) {
+    std::string logString;
+    
+    if (!DIR_exists(output.c_str())) {
+        logString = "Error: Output folder " + output + " does not exist\n";
+        logger.writeLogFile(ERROR,  logString);
+        exit(1);
+    }
+    
+    unsigned int count = blocks[0] * blocks[1] * blocks[2];
+    jobs = std::max(jobs, 1u);
+    logString = "Domain decomposition in " + to_string(blocks[0]) + " x " + to_string(blocks[1]) + " x " + to_string(blocks[2])
+                + " blocks, " + to_string(jobs) + " at a time\n";
+    logger.writeLogFile(INFO,  logString);
+    makeDIR((output + "/blocks").c_str());
+    std::vector<std::string> names;
+    std::vector<std::string> folders;
+    
+    for (unsigned int b = 0; b < count; b++) {
+        names.push_back("block " + to_string(b));
+        folders.push_back(blockFolder(output, b));
+    }
+    
+    unsigned int failed;
+    int block = runWorkers(names, folders, std::vector<std::string>(1, "/radii"), jobs, pin, failed);
+    
+    if (block >= 0) {
+        folder = folders[block];
+        return block;
+    }
+    
+    if (failed > 0) {
+        logString = "Error: " + to_string(failed) + " of " + to_string(count) + " blocks were not generated\n";
+        logger.writeLogFile(ERROR,  logString);
+        exit(1);
+    }
+    
+    return -1;
+}
@@ -0,0 +1,11 @@
+#ifndef _ensemble_h_
+#define _ensemble_h_
+#include <vector>
+#include <string>
+
+std::vector<unsigned int> parseSeedList(std::string list);
+unsigned int runEnsemble(std::vector<unsigned int> &seeds, unsigned int jobs, bool pin, std::string output, std::string &realizationFolder);
+void parseBlocks(std::string list, unsigned int blocks[3]);
+int runBlocks(unsigned int blocks[3], unsigned int jobs, bool pin, std::string output, std::string &folder);
+
+#endif
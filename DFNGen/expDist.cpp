@@ -1,5 +1,6 @@
 #include "expDist.h"
 #include "logFile.h"
+#include "input.h" // DFNError
 #include <cmath>
 #include <iostream>
 
@@ -52,7 +53,7 @@ double ExpDist::getValue(double lambda, double rv) {
     if (rv > 1) {
         logString = "Error: Attempted to input random value of greater than 1 to the exponential distribution class's getValue() function. Input must be on [0,1] interval.\n";
         logger.writeLogFile(ERROR,  logString);
-        exit(1);
+        throw DFNError();
     }
     
     // Using inverse CDF
@@ -89,7 +90,7 @@ double ExpDist::getValue(double lambda, double minVal, double maxVal) {
         // Passing 1 into exp. distribution will reuturn inf
         logString = "ERROR: Passed min, or max, input value of greater than 1 to getValue() in expDist.cpp. Input must be in [0,1] interval.\n";
         logger.writeLogFile(ERROR,  logString);
-        exit(1);
+        throw DFNError();
     }
     
     double randVar = unifRandom(minVal, maxVal);
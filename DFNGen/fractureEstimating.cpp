@@ -29,11 +29,11 @@ void sortRadii(std::vector<Shape> &shapeFam) {
     Arg 2: Family probablity array ('famProb' in input file)
     Arg 3: Random number generator, see std <random> library
     Arg 4: Reference to Distributions class (used for exponential distribution) */
-void generateRadiiLists_nPolyOption(std::vector<Shape> &shapeFamilies, float *famProb, std::mt19937_64 &generator, Distributions &distributions) {
+void generateRadiiLists_nPolyOption(std::vector<Shape> &shapeFamilies, std::vector<float> &famProb, std::mt19937_64 &generator, Distributions &distributions) {
     std::string logString = "Building radii lists for nPoly option...\n";
     logger.writeLogFile(INFO,  logString);
     
-    if (forceLargeFractures == true) {
+    if (params->forceLargeFractures == true) {
         for (unsigned int i = 0; i < shapeFamilies.size(); i++) {
             double radius = getLargestFractureRadius(shapeFamilies[i]);
             shapeFamilies[i].radiiList.push_back(radius);
@@ -43,10 +43,10 @@ void generateRadiiLists_nPolyOption(std::vector<Shape> &shapeFamilies, float *fa
     for (unsigned int i = 0; i < shapeFamilies.size(); i++) {
         int amountToAdd;
         
-        if (forceLargeFractures == true) {
-            amountToAdd = std::ceil(famProb[i] * (nPoly - shapeFamilies.size()));
+        if (params->forceLargeFractures == true) {
+            amountToAdd = std::ceil(famProb[i] * (params->nPoly - shapeFamilies.size()));
         } else {
-            amountToAdd = std::ceil(famProb[i] * nPoly);
+            amountToAdd = std::ceil(famProb[i] * params->nPoly);
         }
         
         addRadii(amountToAdd, i, shapeFamilies[i],
@@ -100,7 +100,7 @@ void addRadiiToLists(float percent, std::vector<Shape> &shapeFamilies, std::mt19
 void addRadii(int amountToAdd, int famIdx, Shape &shapeFam, std::mt19937_64 &generator, Distributions &distributions) {
     int count = 0;
     double radius;
-    double minRadius = 3 * h;
+    double minRadius = 3 * params->h;
     std::uniform_real_distribution<double> uniformDist(0, 1);
     
     switch (shapeFam.distributionType) {
@@ -180,17 +180,16 @@ void addRadii(int amountToAdd, int famIdx, Shape &shapeFam, std::mt19937_64 &gen
            (famProb) in input file
     Arg 3: Random number generator (see std <random> library)
     Arg 4: Distributions class (currently only used for exponential dist) */
-void dryRun(std::vector<Shape> &shapeFamilies, float *shapeProb, std::mt19937_64 &generator, Distributions &distributions) {
+void dryRun(std::vector<Shape> &shapeFamilies, std::vector<float> &shapeProb, std::mt19937_64 &generator, Distributions &distributions) {
     std::string logString = "Estimating number of fractures per family for defined fracture intensities (P32)...\n";
     logger.writeLogFile(INFO,  logString);
-    float domVol = domainSize[0] * domainSize[1] * domainSize[2];
+    float domVol = params->domainSize[0] * params->domainSize[1] * params->domainSize[2];
     int totalFamilies = shapeFamilies.size();
     int cdfSize = totalFamilies; // This variable shrinks along with CDF when used with fracture intensity (P32) option
     // Create a copy of the family probablity
     // Algoithms used in this function modify this array,
     // we need to keep the original in its original state
-    float *famProbability = new float[totalFamilies];
-    std::copy(shapeProb, shapeProb + totalFamilies, famProbability);
+    std::vector<float> famProbability = shapeProb;
     // Init uniform dist on [0,1)
     std::uniform_real_distribution<double> uniformDist(0, 1);
     /******  Convert famProb to CDF  *****/
@@ -204,10 +203,10 @@ void dryRun(std::vector<Shape> &shapeFamilies, float *shapeProb, std::mt19937_64
         int rejectCounter = 0;
         Poly newPoly;
         
-        if ((forceLargeFractCount < shapeFamilies.size()) && forceLargeFractures == true) {
+        if ((forceLargeFractCount < shapeFamilies.size()) && params->forceLargeFractures == true) {
             double radius = getLargestFractureRadius(shapeFamilies[forceLargeFractCount]);
             familyIndex = forceLargeFractCount;
-            cdfIdx = cdfIdxFromFamNum(CDF, p32Status, forceLargeFractCount);
+            cdfIdx = cdfIdxFromFamNum(CDF, params->p32Status, forceLargeFractCount);
             newPoly = generatePoly_withRadius(radius, shapeFamilies[forceLargeFractCount], generator, distributions, familyIndex);
             forceLargeFractCount++;
         } else {
@@ -224,13 +223,13 @@ void dryRun(std::vector<Shape> &shapeFamilies, float *shapeProb, std::mt19937_64
         // Vector for storing intersection boundaries
         bool reject = false;
         
-        while (domainTruncation(newPoly, domainSize) == 1) {
+        while (domainTruncation(newPoly, params->domainSize) == 1) {
             // Poly is completely outside domain, or was truncated to
             // less than 3 vertices due to vertices being too close together
             rejectCounter++; // Counter for re-trying a new translation
             
             // Test if newPoly has reached its limit of insertion attempts
-            if (rejectCounter >= rejectsPerFracture) {
+            if (rejectCounter >= params->rejectsPerFracture) {
                 delete[] newPoly.vertices; // Created with new, need to manually deallocate
                 reject = true;
                 break;; // Reject poly, generate new polygon
@@ -252,9 +251,9 @@ void dryRun(std::vector<Shape> &shapeFamilies, float *shapeProb, std::mt19937_64
         if (shapeFamilies[familyIndex].layer == 0 && shapeFamilies[familyIndex].region == 0) { // Whole domain
             shapeFamilies[familyIndex].currentP32 += newPoly.area * 2 / domVol;
         } else if (shapeFamilies[familyIndex].layer > 0 && shapeFamilies[familyIndex].region == 0) { // Layer
-            shapeFamilies[familyIndex].currentP32 += newPoly.area * 2 / layerVol[shapeFamilies[familyIndex].layer - 1];
+            shapeFamilies[familyIndex].currentP32 += newPoly.area * 2 / params->layerVol[shapeFamilies[familyIndex].layer - 1];
         } else if (shapeFamilies[familyIndex].layer == 0 && shapeFamilies[familyIndex].region > 0) { // Region
-            shapeFamilies[familyIndex].currentP32 += newPoly.area * 2 / regionVol[shapeFamilies[familyIndex].region - 1];
+            shapeFamilies[familyIndex].currentP32 += newPoly.area * 2 / params->regionVol[shapeFamilies[familyIndex].region - 1];
         }
 
         // Save radius for real DFN generation
@@ -263,7 +262,7 @@ void dryRun(std::vector<Shape> &shapeFamilies, float *shapeProb, std::mt19937_64
         // If the last inserted polygon met the p32 requirement, set that family to no longer
         // insert any more fractures. adjust the CDF and family probabilities
         if (shapeFamilies[familyIndex].currentP32 >= shapeFamilies[familyIndex].p32Target ) {
-            p32Status[familyIndex] = 1; //mark family as having its p32 requirement met
+            params->p32Status[familyIndex] = 1; //mark family as having its p32 requirement met
             
             // Adjust CDF, PDF, and reduce their size by 1. Keep probabilities proportional.
             // Remove the completed families element in the CDF and famProb[]
@@ -284,7 +283,7 @@ void dryRun(std::vector<Shape> &shapeFamilies, float *shapeProb, std::mt19937_64
     
     // Reset p32 to 0
     for (int i = 0; i < totalFamilies; i++) {
-        p32Status[i] = 0;
+        params->p32Status[i] = 0;
         shapeFamilies[i].currentP32 = 0;
     }
 }
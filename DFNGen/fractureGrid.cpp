@@ -0,0 +1,285 @@
+#include "fractureGrid.h"
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "computationalGeometry.h"
+#include "mathFunctions.h"
+#include "input.h"
+
+/*! Upper limit of the number of cells, the cell size is increased for small
+    fractures in a large domain */
+static const double maxCells = 1 << 21;
+
+/* FractureGrid() ****************************************************************************/
+/*! Arg 1: Domain size, {x, y, z}. The grid is centered on the origin as the domain.
+    Arg 2: Cell size, about the size of the fractures gives short candidate lists */
+FractureGrid::FractureGrid(double *domainSize, double cellSize) {
+    double size = cellSize > 0 ? cellSize : std::max(domainSize[0], std::max(domainSize[1], domainSize[2]));
+    
+    while (true) {
+        double total = 1;
+        
+        for (int i = 0; i < 3; i++) {
+            nCells[i] = std::max(1, (int) std::ceil(domainSize[i] / size));
+            total *= nCells[i];
+        }
+        
+        if (total <= maxCells) {
+            break;
+        }
+        
+        size *= std::cbrt(total / maxCells) * 1.01;
+    }
+    
+    for (int i = 0; i < 3; i++) {
+        origin[i] = -0.5 * domainSize[i];
+        scale[i] = nCells[i] / domainSize[i];
+    }
+    
+    cells.resize((size_t) nCells[0] * nCells[1] * nCells[2]);
+}
+
+/* cellRange() *******************************************************************************/
+/*! Cells overlapped by a fracture's bounding box
+    Arg 1: Fracture, bounding box must be set (createBoundingBox())
+    Arg 2: OUTPUT, lowest cell x, y, z
+    Arg 3: OUTPUT, highest cell x, y, z */
+void FractureGrid::cellRange(Poly &poly, int *lower, int *upper) const {
+    for (int i = 0; i < 3; i++) {
+        // Same rounding for all fractures: boxes which share a coordinate share a cell
+        double low = std::floor((poly.boundingBox[2 * i] - origin[i]) * scale[i]);
+        double high = std::floor((poly.boundingBox[2 * i + 1] - origin[i]) * scale[i]);
+        lower[i] = (int) std::min(std::max(low, 0.0), (double) nCells[i] - 1);
+        upper[i] = (int) std::min(std::max(high, 0.0), (double) nCells[i] - 1);
+    }
+}
+
+/* insert() **********************************************************************************/
+/*! Adds an accepted fracture to the cells its bounding box overlaps.
+    Fractures must be added in order of their index.
+    Arg 1: Fracture, bounding box must be set
+    Arg 2: Index of the fracture in the accepted polygons list */
+void FractureGrid::insert(Poly &poly, unsigned int index) {
+    int lower[3], upper[3];
+    cellRange(poly, lower, upper);
+    
+    for (int z = lower[2]; z <= upper[2]; z++) {
+        for (int y = lower[1]; y <= upper[1]; y++) {
+            for (int x = lower[0]; x <= upper[0]; x++) {
+                cells[((size_t) z * nCells[1] + y) * nCells[0] + x].push_back(index);
+            }
+        }
+    }
+}
+
+/* candidates() ******************************************************************************/
+/*! Fractures whose bounding boxes can overlap the bounding box of a fracture
+    Arg 1: Fracture, bounding box must be set
+    Arg 2: Smallest fracture index returned, e.g. only fractures accepted after
+           a given fracture
+    Arg 3: OUTPUT, fracture indices in ascending order, without duplicates */
+void FractureGrid::candidates(Poly &poly, unsigned int first, std::vector<unsigned int> &out) const {
+    int lower[3], upper[3];
+    cellRange(poly, lower, upper);
+    out.clear();
+    
+    for (int z = lower[2]; z <= upper[2]; z++) {
+        for (int y = lower[1]; y <= upper[1]; y++) {
+            for (int x = lower[0]; x <= upper[0]; x++) {
+                const std::vector<unsigned int> &cell = cells[((size_t) z * nCells[1] + y) * nCells[0] + x];
+                // Indices in a cell are ascending, fractures are inserted in order of acceptance
+                std::vector<unsigned int>::const_iterator it = std::lower_bound(cell.begin(), cell.end(), first);
+                out.insert(out.end(), it, cell.end());
+            }
+        }
+    }
+    
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+
+/* nodeExtent() ******************************************************************************/
+/*! Largest side of the bounding box of a fracture's nodes, the size of user
+    fractures defined by coordinates for insertUserFractures()
+    Arg 1: Nodes, {x1, y1, z1, x2, y2, z2, ...}
+    Arg 2: Number of nodes
+    Return: Largest side of the bounding box */
+double nodeExtent(const double *vertices, unsigned int nNodes) {
+    double lower[3] = {INFINITY, INFINITY, INFINITY};
+    double upper[3] = {-INFINITY, -INFINITY, -INFINITY};
+    
+    for (unsigned int j = 0; j < 3 * nNodes; j += 3) {
+        for (int k = 0; k < 3; k++) {
+            lower[k] = std::min(lower[k], vertices[j + k]);
+            upper[k] = std::max(upper[k], vertices[j + k]);
+        }
+    }
+    
+    return std::max(upper[0] - lower[0], std::max(upper[1] - lower[1], upper[2] - lower[2]));
+}
+
+/* findUserFractureIntersections() ***********************************************************/
+/*! Finds the intersections of a new fracture with the accepted fractures
+    listed in the grid, see intersectionChecking()
+    Arg 1: New fracture
+    Arg 2: Array for all accepted polygons
+    Arg 3: Grid of the accepted polygons
+    Arg 4: Smallest index of accepted polygons to check
+    Arg 5: Scratch array for grid candidates
+    Arg 6: OUTPUT, intersections are appended, in order of the accepted polygons' index */
+static void findUserFractureIntersections(Poly &newPoly, std::vector<Poly> &acceptedPoly, FractureGrid &grid, unsigned int first,
+        std::vector<unsigned int> &candidates, std::vector<FoundIntersection> &found) {
+    grid.candidates(newPoly, first, candidates);
+    
+    for (unsigned int j = 0; j < candidates.size(); j++) {
+        unsigned int ii = candidates[j];
+        
+        if (checkBoundingBox(newPoly, acceptedPoly[ii])) {
+            short flag;
+            IntPoints intersection = findIntersections(flag, newPoly, acceptedPoly[ii]);
+            
+            if (flag != 0) {
+                found.push_back(FoundIntersection());
+                found.back().fracture = ii;
+                found.back().intersection = intersection;
+            }
+        }
+    }
+}
+
+/* insertUserFractures() *********************************************************************/
+/*! Inserts a set of user fractures (rectangles, ellipses or polygons) in batches.
+    The fractures of a batch are created and their intersections with the fractures
+    accepted before the batch are found in parallel, using a grid of the accepted
+    fractures' bounding boxes. FRAM then checks the fractures one by one, in the
+    order of the set, with the intersections found before and the intersections with
+    fractures accepted earlier in the batch. The DFN is the same as inserting the
+    fractures one at a time with intersectionChecking().
+    Arg 1: Number of fractures
+    Arg 2: Size of fracture i, e.g. its diameter. The grid cell size is the mean size.
+    Arg 3: Creates fracture i: vertices, normal, radii, translation and familyNum, then
+           truncates it to the domain and creates its bounding box. Called from several
+           threads at once. Returns true if the fracture is outside the domain.
+    Arg 4: Logs the result for fracture i, in order: 0 if accepted, USER_FRACTURE_OUTSIDE,
+           or the rejection code of intersectionChecking(). Counts pstats.truncated if
+           needed, the other statistics are counted here.
+    Arg 5: Array for all accepted polygons
+    Arg 6: Array for all accepted intersections
+    Arg 7: Program statistics structure
+    Arg 8: Array of all triple intersection points */
+void insertUserFractures(unsigned int n, std::function<double (unsigned int i)> size,
+                         std::function<bool (Poly &newPoly, unsigned int i)> create,
+                         std::function<void (Poly &newPoly, unsigned int i, int rejectCode)> report,
+                         std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intpts, Stats &pstats,
+                         std::vector<Point> &triplePoints) {
+    double maxSize = std::max(params->domainSize[0], std::max(params->domainSize[1], params->domainSize[2]));
+    double sum = 0;
+    
+    for (unsigned int i = 0; i < n; i++) {
+        sum += std::min(maxSize, size(i));
+    }
+    
+    acceptedPoly.reserve(acceptedPoly.size() + n);
+    FractureGrid grid(params->domainSize, n > 0 ? sum / n : 0);
+    
+    for (unsigned int j = 0; j < acceptedPoly.size(); j++) {
+        grid.insert(acceptedPoly[j], j);
+    }
+    
+    unsigned int nThreads = std::thread::hardware_concurrency();
+    
+    if (nThreads == 0) {
+        nThreads = 1;
+    }
+    
+    unsigned int batchSize = 256 * nThreads;
+    std::vector<Poly> batch(batchSize);
+    std::vector<char> outside(batchSize);
+    std::vector<std::vector<FoundIntersection> > found(batchSize);
+    std::vector<unsigned int> candidates;
+    
+    for (unsigned int first = 0; first < n; first += batchSize) {
+        unsigned int count = std::min(batchSize, n - first);
+        // Fractures accepted before this batch
+        unsigned int nAccepted = acceptedPoly.size();
+        std::atomic<unsigned int> next(0);
+        // Set by a worker on an error (already logged), thrown again after the join
+        std::atomic<bool> error(false);
+        auto worker = [&]() {
+            std::vector<unsigned int> workerCandidates;
+            unsigned int k;
+            
+            try {
+                while ((k = next++) < count) {
+                    batch[k] = Poly();
+                    found[k].clear();
+                    outside[k] = create(batch[k], first + k);
+                    
+                    if (!outside[k]) {
+                        findUserFractureIntersections(batch[k], acceptedPoly, grid, 0, workerCandidates, found[k]);
+                    }
+                }
+            } catch (DFNError &) {
+                error = true;
+            }
+        };
+        std::vector<std::thread> threads;
+        
+        for (unsigned int t = 1; t < nThreads && t < count; t++) {
+            threads.push_back(std::thread(worker));
+        }
+        
+        worker();
+        
+        for (unsigned int t = 0; t < threads.size(); t++) {
+            threads[t].join();
+        }
+        
+        if (error) {
+            throw DFNError();
+        }
+        
+        for (unsigned int k = 0; k < count; k++) {
+            unsigned int i = first + k;
+            Poly &newPoly = batch[k];
+            RejectedUserFracture rejectedUserFracture;
+            rejectedUserFracture.id = i + 1;
+            rejectedUserFracture.userFractureType = newPoly.familyNum;
+            
+            if (outside[k]) {
+                // Poly completely outside domain
+                pstats.rejectionReasons.outside++;
+                pstats.rejectedPolyCount++;
+                report(newPoly, i, USER_FRACTURE_OUTSIDE);
+                pstats.rejectedUserFracture.push_back(rejectedUserFracture);
+                delete[] newPoly.vertices;
+                continue; // Go to next poly (go to next iteration of for loop)
+            }
+            
+            // Intersections with fractures accepted earlier in this batch
+            findUserFractureIntersections(newPoly, acceptedPoly, grid, nAccepted, candidates, found[k]);
+            // Line of intersection and FRAM
+            int rejectCode = intersectionChecking(newPoly, acceptedPoly, &found[k], intpts, pstats, triplePoints);
+            
+            if (rejectCode == 0) {
+                // Incriment counter of accepted polys
+                pstats.acceptedPolyCount++;
+                // Calculate poly's area
+                newPoly.area = getArea(newPoly);
+                // Add new rejectsPerAttempt counter
+                pstats.rejectsPerAttempt.push_back(0);
+                report(newPoly, i, rejectCode);
+                acceptedPoly.push_back(newPoly); // Save newPoly to accepted polys list
+                grid.insert(acceptedPoly.back(), acceptedPoly.size() - 1);
+            } else {
+                pstats.rejectsPerAttempt[pstats.acceptedPolyCount]++;
+                pstats.rejectedPolyCount++;
+                report(newPoly, i, rejectCode);
+                pstats.rejectedUserFracture.push_back(rejectedUserFracture);
+                delete[] newPoly.vertices; // Need to delete manually, created with new[]
+            }
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef _fractureGrid_h_
+#define _fractureGrid_h_
+#include <vector>
+#include <functional>
+#include "structures.h"
+
+/*! Uniform grid over the domain which lists, for each cell, the fractures whose
+    bounding boxes overlap the cell. Used to find the accepted fractures whose
+    bounding boxes can overlap a new fracture's bounding box, instead of calling
+    checkBoundingBox() with every accepted fracture.
+
+    Candidates are a superset of the fractures checkBoundingBox() accepts:
+    boxes which touch share a cell, and boxes outside the grid are kept in the
+    border cells. */
+class FractureGrid {
+  public:
+    FractureGrid(double *domainSize, double cellSize);
+    void insert(Poly &poly, unsigned int index);
+    void candidates(Poly &poly, unsigned int first, std::vector<unsigned int> &out) const;
+  
+  private:
+    /*! Lower corner of the grid */
+    double origin[3];
+    /*! 1 / cell size */
+    double scale[3];
+    /*! Number of cells in x, y, z */
+    int nCells[3];
+    /*! Fracture indices per cell, x fastest */
+    std::vector<std::vector<unsigned int> > cells;
+    
+    void cellRange(Poly &poly, int *lower, int *upper) const;
+};
+
+/*! Result passed to the report function of insertUserFractures() for a
+    fracture outside the domain. Rejection codes of intersectionChecking()
+    are negative. */
+#define USER_FRACTURE_OUTSIDE 1
+
+double nodeExtent(const double *vertices, unsigned int nNodes);
+void insertUserFractures(unsigned int n, std::function<double (unsigned int i)> size,
+                         std::function<bool (Poly &newPoly, unsigned int i)> create,
+                         std::function<void (Poly &newPoly, unsigned int i, int rejectCode)> report,
+                         std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intpts, Stats &pstats,
+                         std::vector<Point> &triplePoints);
+
+#endif
@@ -7,6 +7,8 @@
 #include "computationalGeometry.h"
 #include <algorithm>
 #include "insertShape.h"
+#include "streaming.h" // limitToSlab()
+#include "domainBlocks.h" // limitToBlock()
 
 
 /**************************************************************************/
@@ -19,7 +21,7 @@ std::vector<Point> discretizeLineOfIntersection(double *pt1, double *pt2, double
     std::vector<Point> pointsList;
     
     // If reduced mesh, just save endpoints
-    if (visualizationMode == 1) {
+    if (params->visualizationMode == 1) {
         Point pt;
         pt.x = pt1[0];
         pt.y = pt1[1];
@@ -35,7 +37,7 @@ std::vector<Point> discretizeLineOfIntersection(double *pt1, double *pt2, double
     double v[3] = {pt2[0] - pt1[0], pt2[1] - pt1[1], pt2[2] - pt1[2]}; // {x2-x1, y2-y1, z2-z1};
     double p[3] = {pt1[0], pt1[1], pt1[2]}; // {x1, y1, z1};
 //    double dist = magnitude((pt1[0]-pt2[0]), (pt1[1]-pt2[1]), (pt1[2]-pt2[2])); // (x1-x2), (y1-y2), (z1-z2));
-    double nprime = std::ceil(2 * dist / h);
+    double nprime = std::ceil(2 * dist / params->h);
     double hprime = 1 / nprime;
     double *xx = new double[(int)nprime + 1];
     int i;
@@ -89,22 +91,22 @@ double *fisherDistribution(double angleOne, double angleTwo, double kappa, std::
     double ck = (std::exp(kappa) - std::exp(-kappa)) / kappa;
     double v1[3];
     
-    if (orientationOption == 0) {
+    if (params->orientationOption == 0) {
         // Spherical Coordinates
         // angleOne = Theta
         // angleTwo = Phi
         v1[0] = sin(angleOne) * cos(angleTwo);
         v1[1] = sin(angleOne) * sin(angleTwo);
         v1[2] = cos(angleOne);
-    } else if (orientationOption == 1) {
+    } else if (params->orientationOption == 1) {
         // Trend and Plunge
         // angleOne = Trend
         // angleTwo = Plunge
         v1[0] = cos(angleOne) * cos(angleTwo);
         v1[1] = sin(angleOne) * cos(angleTwo);
         v1[2] = sin(angleTwo);
-    } else if (orientationOption == 2) {
-        // Dip and Strike
+    } else {
+        // orientationOption 2, Dip and Strike
         // angleOne = Dip
         // angleTwo = Strike
         v1[0] = sin(angleOne) * sin(angleTwo);
@@ -117,7 +119,7 @@ double *fisherDistribution(double angleOne, double angleTwo, double kappa, std::
     double R[9];
     
     // Get rotation matrix if normal vectors are not the same (if xProd is not zero vector)
-    if (!(std::abs(xProd[0]) <= eps && std::abs(xProd[1]) <= eps && std::abs(xProd[2]) <= eps )) {
+    if (!(std::abs(xProd[0]) <= params->eps && std::abs(xProd[1]) <= params->eps && std::abs(xProd[2]) <= params->eps )) {
         // Since vectors are normalized, sin = magnitude(AxB) and cos = A . B
         double sin = sqrt(xProd[0] * xProd[0] + xProd[1] * xProd[1] + xProd[2] * xProd[2]);
         double cos = dotProduct(u, v1);
@@ -188,6 +190,10 @@ double *fisherDistribution(double angleOne, double angleTwo, double kappa, std::
     Return: Pointer to random ranslation, array of three doubles {x, y, z} */
 double *randomTranslation(std::mt19937_64 &generator, float xMin, float xMax, float yMin, float yMax, float zMin, float zMax) {
     double *t = new double[3];
+    // Streaming generation: only the current slab is filled
+    limitToSlab(xMin, xMax);
+    // Domain decomposition: only the block of this process is filled
+    limitToBlock(xMin, xMax, yMin, yMax, zMin, zMax);
     // Setup for getting random x location
     std::uniform_real_distribution<double> distributionX (xMin, xMax);
     t[0] = distributionX(generator);
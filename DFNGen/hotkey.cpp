@@ -3,8 +3,15 @@
 #include <unistd.h>
 #include <sys/select.h>
 #include <termios.h>
+#include <signal.h>
+#include <poll.h>
+#include <atomic>
+#include <thread>
 #include "hotkey.h"
 
+// DO NOT CHANGE VAR NAME
+struct termios orig_termios; //used for custom console and hotkey
+
 //WARNING: NEEDS ERROR HANDLING
 
 /***********************************************/
@@ -18,7 +25,8 @@ void reset_terminal_mode() {
 /***********************************************/
 /*! Sets custom terminal settings.
     This allows us to listen for a key press
-    without halting execution of program */
+    without halting execution of program.
+    ISIG stays set, so Ctrl-C still raises SIGINT. */
 void set_conio_terminal_mode() {
     struct termios new_termios;
     /* take two copies - one for now, one for later */
@@ -27,7 +35,7 @@ void set_conio_terminal_mode() {
     /* register cleanup handler, and set the new terminal mode */
     new_termios.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON);
     new_termios.c_oflag |= ONLCR;
-    new_termios.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+    new_termios.c_lflag &= ~(ECHO | ECHONL | ICANON | IEXTEN);
     new_termios.c_cflag &= ~(CSIZE | PARENB);
     new_termios.c_cflag |= CS8;
     tcsetattr(0, TCSANOW, &new_termios);
@@ -48,16 +56,108 @@ int kbhit() {
 
 /***********************************************/
 /*! Get char of key press.
-    Returns char as int. */
+    Returns char as int, -1 at end of input or on error. */
 int getch() {
     int r;
     unsigned char c;
     
-    if ((r = read(0, &c, sizeof(c))) < 0) {
-        return r;
+    if ((r = read(0, &c, sizeof(c))) <= 0) {
+        return -1;
     } else {
         return c;
     }
 }
 
 
+/***********************************************/
+/*! Set when the user asks to stop inserting fractures
+    ('~' key, SIGINT or SIGUSR1). DFN generation then
+    continues with output of the fractures accepted so far. */
+std::atomic<bool> stopInsertion(false);
+
+/*! True while the hotkey thread is listening to stdin */
+static std::atomic<bool> hotkeyRunning(false);
+static std::thread hotkeyThread;
+static bool terminalModeSet = false;
+
+
+/***********************************************/
+/*! Signal handler, requests to stop fracture insertion.
+    SIGINT handler is installed with SA_RESETHAND, so a
+    second Ctrl-C terminates the program. */
+static void stopSignalHandler(int) {
+    stopInsertion = true;
+}
+
+
+/***********************************************/
+/*! Hotkey thread. Waits for key presses on stdin,
+    '~' requests to stop fracture insertion. Returns
+    at end of input (terminal closed). */
+static void hotkeyListener() {
+    struct pollfd fds;
+    fds.fd = 0;
+    fds.events = POLLIN;
+    
+    while (hotkeyRunning) {
+        // Time out regularly to check if the listener should stop
+        if (poll(&fds, 1, 200) > 0) {
+            int key = getch();
+            
+            if (key == '~') {
+                stopInsertion = true;
+            } else if (key < 0) {
+                break;
+            }
+        }
+    }
+}
+
+
+/***********************************************/
+/*! Installs the signal handlers which set the stop
+    flag: SIGUSR1, and SIGINT once (SA_RESETHAND). */
+void installStopHandlers() {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = stopSignalHandler;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGUSR1, &action, NULL);
+    action.sa_flags = SA_RESETHAND;
+    sigaction(SIGINT, &action, NULL);
+}
+
+
+/***********************************************/
+/*! Sets up stop requests for fracture insertion.
+    SIGINT and SIGUSR1 always set the stop flag. Only when stdin is a terminal,
+    the terminal is switched to non-canonical mode and a thread listens for
+    the '~' key; in headless runs (stdin redirected, batch jobs) termios
+    is never touched. */
+void startHotkey() {
+    installStopHandlers();
+    
+    if (isatty(0)) {
+        set_conio_terminal_mode();
+        terminalModeSet = true;
+        // exit() must not destroy a running thread, stop it first
+        atexit(stopHotkey);
+        hotkeyRunning = true;
+        hotkeyThread = std::thread(hotkeyListener);
+    }
+}
+
+
+/***********************************************/
+/*! Stops the hotkey thread and restores terminal settings */
+void stopHotkey() {
+    if (hotkeyThread.joinable()) {
+        hotkeyRunning = false;
+        hotkeyThread.join();
+    }
+    
+    if (terminalModeSet) {
+        reset_terminal_mode();
+        terminalModeSet = false;
+    }
+}
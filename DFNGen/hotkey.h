@@ -1,10 +1,15 @@
 #ifndef _hotkey_h_
 #define _hotkey_h_
+#include <atomic>
 
 extern struct termios orig_termios;
 void reset_terminal_mode();
 void set_conio_terminal_mode();
 int kbhit();
 int getch();
+extern std::atomic<bool> stopInsertion;
+void installStopHandlers();
+void startHotkey();
+void stopHotkey();
 
 #endif
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include "indexList.h"
+#include "structures.h"
+
+/*! Entries per chunk of the index pool */
+static const size_t chunkSize = 1 << 16;
+/*! Capacity of a list's first segment. Most fractures have a few intersections,
+    most intersections have no triple points (no segment). */
+static const unsigned int firstCapacity = 4;
+
+/*! Chunks of the index pool, allocated with new[] */
+static std::vector<unsigned int *> chunks;
+/*! Unused part of the last chunk */
+static unsigned int *chunkNext = NULL;
+static size_t chunkLeft = 0;
+
+/* allocateIndices() *************************************************************************/
+/*! Takes a segment from the index pool. A new chunk is started when the last one
+    is full, a segment larger than a chunk gets a chunk of its own.
+    Arg 1: Number of entries
+    Return: Segment of 'size' entries */
+static unsigned int *allocateIndices(size_t size) {
+    if (size > chunkLeft) {
+        if (size > chunkSize) {
+            unsigned int *chunk = new unsigned int[size];
+            chunks.push_back(chunk);
+            return chunk;
+        }
+        
+        chunkNext = new unsigned int[chunkSize];
+        chunkLeft = chunkSize;
+        chunks.push_back(chunkNext);
+    }
+    
+    unsigned int *segment = chunkNext;
+    chunkNext += size;
+    chunkLeft -= size;
+    return segment;
+}
+
+/* grow() ************************************************************************************/
+/*! Moves the list to a larger segment, at least twice its capacity
+    Arg 1: Minimum capacity */
+void IndexList::grow(unsigned int minCapacity) {
+    unsigned int newCapacity = std::max(std::max(firstCapacity, 2 * capacity), minCapacity);
+    unsigned int *segment = allocateIndices(newCapacity);
+    std::copy(items, items + count, segment);
+    items = segment;
+    capacity = newCapacity;
+}
+
+/* resize() **********************************************************************************/
+/*! Changes the number of entries. New entries are 0.
+    Arg 1: Number of entries */
+void IndexList::resize(unsigned int size) {
+    if (size > capacity) {
+        grow(size);
+    }
+    
+    if (size > count) {
+        std::fill(items + count, items + size, 0);
+    }
+    
+    count = size;
+}
+
+/* compactIndexLists() ***********************************************************************/
+/*! Packs the intersection lists of the fractures and the triple point lists of
+    the intersections into one array, and frees the rest of the index pool. Used
+    once no more fractures are added, and by streaming generation after fractures
+    are written to disk. Lists which are not in 'acceptedPoly' or 'intPts' are
+    invalid afterwards. The lists can still be appended to, a list
+    which is appended to is moved out of the array.
+    Arg 1: Accepted fractures
+    Arg 2: Intersections
+    Return: Number of entries of all lists */
+size_t compactIndexLists(std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts) {
+    size_t total = 0;
+    
+    for (unsigned int i = 0; i < acceptedPoly.size(); i++) {
+        total += acceptedPoly[i].intersectionIndex.count;
+    }
+    
+    for (unsigned int i = 0; i < intPts.size(); i++) {
+        total += intPts[i].triplePointsIdx.count;
+    }
+    
+    unsigned int *values = total > 0 ? new unsigned int[total] : NULL;
+    unsigned int *next = values;
+    
+    for (unsigned int i = 0; i < acceptedPoly.size(); i++) {
+        IndexList &list = acceptedPoly[i].intersectionIndex;
+        std::copy(list.items, list.items + list.count, next);
+        list.items = list.count > 0 ? next : NULL;
+        list.capacity = list.count;
+        next += list.count;
+    }
+    
+    for (unsigned int i = 0; i < intPts.size(); i++) {
+        IndexList &list = intPts[i].triplePointsIdx;
+        std::copy(list.items, list.items + list.count, next);
+        list.items = list.count > 0 ? next : NULL;
+        list.capacity = list.count;
+        next += list.count;
+    }
+    
+    releaseIndexLists();
+    
+    if (values != NULL) {
+        chunks.push_back(values);
+    }
+    
+    return total;
+}
+
+/* releaseIndexLists() ***********************************************************************/
+/*! Frees the index pool. All lists are invalid afterwards. */
+void releaseIndexLists() {
+    for (unsigned int i = 0; i < chunks.size(); i++) {
+        delete[] chunks[i];
+    }
+    
+    std::vector<unsigned int *>().swap(chunks);
+    chunkNext = NULL;
+    chunkLeft = 0;
+}
+
@@ -0,0 +1,96 @@
+#ifndef _indexList_h_
+#define _indexList_h_
+#include <vector>
+#include <cstddef>
+
+struct Poly;
+struct IntPoints;
+
+/*! List of indices: the intersections of a fracture (Poly::intersectionIndex)
+    and the triple points of an intersection (IntPoints::triplePointsIdx).
+
+    Lists do not have a heap allocation of their own like a std::vector. Their
+    entries are segments of large chunks of memory shared by all lists (the
+    index pool, see indexList.cpp). A list which is full is moved to a segment
+    twice as large, the old segment is not reused. After generation,
+    compactIndexLists() packs all lists into one array, in order of the
+    fractures then of the intersections (the values array of a CSR layout,
+    each list keeps its position in the array and its length).
+
+    Copies of a list share its entries. clear() detaches a list from its
+    entries: a cleared copy can be appended to without changing the original.
+    Appending to two copies of a list which were not cleared is not allowed.
+
+    Lists are created and appended to by one thread at a time. */
+class IndexList {
+  public:
+    IndexList() : items(NULL), count(0), capacity(0) {}
+    
+    unsigned int size() const {
+        return count;
+    }
+    
+    bool empty() const {
+        return count == 0;
+    }
+    
+    unsigned int &operator[](size_t i) {
+        return items[i];
+    }
+    
+    const unsigned int &operator[](size_t i) const {
+        return items[i];
+    }
+    
+    const unsigned int *begin() const {
+        return items;
+    }
+    
+    const unsigned int *end() const {
+        return items + count;
+    }
+    
+    void push_back(unsigned int value) {
+        if (count == capacity) {
+            grow(count + 1);
+        }
+        
+        items[count++] = value;
+    }
+    
+    void clear() {
+        items = NULL;
+        count = 0;
+        capacity = 0;
+    }
+    
+    void resize(unsigned int size);
+    
+    /*! Replaces the list with the values in [first, last) */
+    template <typename Iterator>
+    void assign(Iterator first, Iterator last) {
+        clear();
+        resize(last - first);
+        
+        for (unsigned int i = 0; i < count; i++, ++first) {
+            items[i] = *first;
+        }
+    }
+  
+  private:
+    /*! Entries, in the index pool */
+    unsigned int *items;
+    /*! Number of entries */
+    unsigned int count;
+    /*! Size of the segment at 'items' */
+    unsigned int capacity;
+    
+    void grow(unsigned int minCapacity);
+    
+    friend size_t compactIndexLists(std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts);
+};
+
+size_t compactIndexLists(std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts);
+void releaseIndexLists();
+
+#endif
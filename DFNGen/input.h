@@ -5,141 +5,628 @@
 #include <vector>
 #include "structures.h"
 #include "logFile.h"
-// Variable prototypes for user input variables
 
-extern short stopCondition;
-extern unsigned int nPoly;
-extern double domainSize[3];
-extern double h;
-extern float radiiListIncrease;
-extern double eps;
-extern bool disableFram;
-extern bool rFram;
-extern bool visualizationMode;
-extern bool tripleIntersections;
-extern bool boundaryFaces[6];
-extern bool keepOnlyLargestCluster;
-extern bool keepIsolatedFractures;
-extern bool printRejectReasons;
-extern bool outputFinalRadiiPerFamily;
-extern bool outputAcceptedRadiiPerFamily;
-extern bool ecpmOutput;
-extern bool polygonBoundaryFlag;
-extern int numOfDomainVertices;
-extern std::vector<Point> domainVertices;
-extern int orientationOption;
-extern bool *ebetaDistribution;
-extern bool *rbetaDistribution;
-extern bool insertUserRectanglesFirst;
-extern bool forceLargeFractures;
-extern unsigned int seed;
-extern float domainSizeIncrease[3];
-extern float removeFracturesSmallerThan;
-extern int nFamRect;
-extern int nUserRect;
-extern int nFamEll;
-extern int nUserEll;
-extern float *famProb;
-extern float *famProbOriginal;
-extern int *edistr;
-extern float *easpect;
-extern unsigned int *enumPoints;
-extern bool  eAngleOption;
-extern float *eAngleOne;
-extern float *eAngleTwo;
-extern float *ebeta;
-extern float *ekappa;
-extern float *eLogMean;
-extern float *eLogMin;
-extern float *eLogMax;
-extern float *eExpMin;
-extern float *eExpMax;
-extern float *esd;
-extern float *eExpMean;
-extern float *econst;
-extern float *emin;
-extern float *emax;
-extern float *ealpha;
-extern unsigned int *rdistr;
-extern float *raspect;
-extern bool rAngleOption;
-extern float *rAngleOne;
-extern float *rAngleTwo;
-extern float *rbeta;
-extern float *rkappa;
-extern float *rLogMean;
-extern float *rLogMin;
-extern float *rLogMax;
-extern float *rExpMin;
-extern float *rExpMax;
-extern float *rsd;
-extern float *rmin;
-extern float *rmax;
-extern float *ralpha;
-extern float *rExpMean;
-extern float *rconst;
-extern bool ueAngleOption;
-extern float *ueRadii;
-extern float *ueBeta;
-extern float *ueaspect;
-extern double *uetranslation;
-extern double *uenormal;
-extern unsigned int *uenumPoints;
-extern bool userRectanglesOnOff;
-extern bool userEllipsesOnOff;
-extern bool outputAllRadii;
-extern float *urRadii;
-extern bool urAngleOption;
-extern float *urBeta;
-extern float *uraspect;
-extern double *urtranslation;
-extern double *urnormal;
-extern bool userRecByCoord;
-extern bool userEllByCoord;
-extern bool userPolygonByCoord;
-extern unsigned int nRectByCoord;
-extern double *userRectCoordVertices;
-extern double *userEllCoordVertices;
-extern unsigned int nEllByCoord;
-extern unsigned int nEllNodes;
+/*! Parameters of a DFN, the variables of the input file. readDFNInput() reads them
+    into DFNConfig::input (see dfngen.h). Generation updates some of them: the seed
+    used, famProb and p32Status as families reach their P32 target. */
+struct DFNInput {
+    /*! DFN generation stop condition. 0 - nPoly option, 1 - P32 option.*/
+    short stopCondition = 0;
+    
+    /*! Number of polygons to place in the DFN when uisng nPoly stopCondition option.*/
+    unsigned int nPoly = 0;
+    
+    /*! Domain size with dimension x*y*z for DFN, centered at the origin. */
+    double domainSize[3] = {};
+    
+    /*! Minimum feature size, FRAM parameter.*/
+    double h = 0;
+    
+    /*! Percent to increase the size of the pre-generated radii lists, per family.
+        Example: 0.2 will increase the size of the list by %20. See example input files
+        for more details. */
+    float radiiListIncrease = 0;
+    
+    /*! This option disables the FRAM algorithm. There will be no
+       fracture rejections or fine mesh. Defaults visualizationMode to 1*/
+    bool disableFram = false;
+    
+    /*! Used during meshing:
+            0 - Creates a fine mesh, according to h parameter;
+            1 - Produce only first round of triangulations. In this case no
+                modeling of flow and transport is possible.*/
+    bool visualizationMode = false;
+    
+    /*! This option uses a relaxed version of the FRAM algorithm. The mesh may not
+    be perfectly conforming*/
+    bool rFram = false;
+    
+    /*! Accept or reject triple intersections
+            False - Off (Reject)
+            True  - On  (Accept)*/
+    bool tripleIntersections = false;
+    
+    /*! DFN will only keep clusters with connections to
+        domain boundaries which are set to 1:
+    
+        boundaryFaces[0] = +X domain boundary
+        boundaryFaces[1] = -X domain boundary
+        boundaryFaces[2] = +Y domain boundary
+        boundaryFaces[3] = -Y domain boundary
+        boundaryFaces[4] = +Z domain boundary
+        boundaryFaces[5] = -Z domain boundary*/
+    bool boundaryFaces[6] = {};
+    
+    /*! 0 - Keep any clusters which connects the specified
+            boundary faces in boundaryFaces option below
+        1 - Keep only the largest cluster which connects
+            the specified boundary faces in boundaryFaces option below.
+    
+        If ignoreBoundaryFaces is also set to 1, DFNGen will keep the largest
+        cluster which connects at least any two sides of the domain.*/
+    bool keepOnlyLargestCluster = false;
+    
+    /*! 0 - remove isolated fractures and clusters
+        1 - Keep isolated fractures and clusters
+        */
+    bool keepIsolatedFractures = false;
+    
+    /*! Useful for debugging,
+        This option will print all fracture rejection reasons as they occur.
+            0 - Disable
+            1 - Print all rejection reasons to screen */
+    bool printRejectReasons = false;
+    
+    /*! Outputs radii files after isolated fracture removal.
+        One file per family.
+            0: Do not create output files of radii per family
+            1: Creates output files per family, containing a list
+               of the family's fracture radii that is in the final DFN*/
+    bool outputFinalRadiiPerFamily = false;
+    
+    /*! Outputs radii files before isolated fracture removal.
+        One file per family.
+            0: Do not create output files of radii per family
+            1: Creates output files per family, containing a list
+               of the family's fracture radii in the domain before isolated
+               fracture removal.*/
+    bool outputAcceptedRadiiPerFamily = false;
+    
+    /*! Optional. Upscale the final DFN to an equivalent continuous porous medium
+        (ECPM) grid, written to ecpm.bin (see ecpm.h)
+            0: No ECPM upscaling (default)
+            1: Write ecpm.bin, requires the ecpm* options below */
+    bool ecpmOutput = false;
+    
+    /*! ECPM option. Edge length of the cubic grid cells, must divide the domain size */
+    double ecpmCellSize = 0;
+    
+    /*! ECPM option. Aperture of all fractures, fracture permeability is
+        given by the cubic law k = (b^2) / 12 */
+    double ecpmAperture = 0;
+    
+    /*! ECPM option. Porosity of the cells without fractures */
+    double ecpmMatrixPorosity = 0;
+    
+    /*! ECPM option. Permeability of the matrix */
+    double ecpmMatrixPerm = 0;
+    
+    /*! Optional ECPM option. Apply the stair step correction factor to the diagonal
+        of the anisotropic permeability
+            0: No correction
+            1: Correction (default) */
+    bool ecpmCorrectionFactor = true;
+    
+    /*! Also write the DFN into the single binary container dfn.bin and the
+        fracture graph into graph.bin (see binaryOutput.cpp). Set with the
+        --binary command line option.
+            0: ASCII output only
+            1: ASCII output, dfn.bin and graph.bin */
+    bool binaryOutput = false;
+    
+    /*! Beta is the rotation around the polygon's normal vector
+            0 - Uniform distribution [0, 2PI)
+            1 - Constant angle (specefied below by 'ebeta')*/
+    std::vector<bool> ebetaDistribution;
+    
+    /*! Beta is the rotation around the polygon's normal vector
+            0: Uniform distribution [0, 2PI)
+            1: Constant angle (specefied below by 'rbeta')*/
+    std::vector<bool> rbetaDistribution;
+    
+    /*! False - User ellipses will be inserted first
+        True  - User rectangles will be inserted first*/
+    bool insertUserRectanglesFirst = false;
+    
+    /*! Inserts the largest possible fracture for each defined fracture family,
+        defined by the user-defined maxium radius
+            0 - Off (Do not force insertion of larest fractures)
+            1 - On  (Force insertion of largest fractures)*/
+    bool forceLargeFractures = false;
+    
+    /*! Seed for random generator.*/
+    unsigned int seed = 0;
+    
+    /*! Size increase for inserting fracture centers outside the domain.
+        Fracture will be truncated based on domainSize above.
+        Increases the entire width by this ammount. So, {1,1,1} will increase
+        the domain by adding .5 to the +x, and subbtracting .5 to the -x, etc*/
+    float domainSizeIncrease[3] = {};
+    
+    /*! Selection of orientation Option
+        0 - spherical coordinates
+        1 - trend / plunge
+        2 - dip / strike .*/
+    int orientationOption = 0;
+    
+    /*! Number of rectangular families defined below.
+        Having this option = 0 will ignore all rectangular family variables.*/
+    int nFamRect = 0;
+    
+    /*! Number of ellipse families defined below.
+        Having this option = 0 will ignore all rectangle family variables.*/
+    int nFamEll = 0;
+    
+    /*! Each element is the probability of chosing a fracture from
+        the element's corresponding family to be inserted into the DFN.
+    
+        The famProb elements should add up to 1.0 (for %100).
+        The probabilities are listed in order of families starting with all
+        stochastic ellipses, and then all stochastic rectangles.
+    
+        For example:
+        If  then there are two ellipse families, each with probabiliy .3,
+        and two rectangle families, each with probabiliy .2, famProb will be:
+        famProb: {.3,.3,.2,.2}, famProb elements must add to 1*/
+    std::vector<float> famProb;
+    
+    /*! Holds a copy of famProb. famProb elements can change as different families
+        hit their P32 requirement when using the P32 stopCondition option.*/
+    std::vector<float> famProbOriginal;
+    
+    /*! Mandatory parameter if using statistically generated ellipses.
+        Statistical distribution options:
+    
+        Holds number of elements equal to the number of shape families.
+    
+            1 - Log-normal distribution
+            2 - Truncated power law distribution
+            3 - Exponential distribution
+            4 - Constant*/
+    std::vector<int> edistr;
+    
+    /*! Aspect ratio array for stochastic ellipses.*/
+    std::vector<float> easpect;
+    
+    /*! Number of vertices used in creating each elliptical
+        fracture family. Number of elements must match number
+        of ellipse families
+    
+        Holds number of elements equal to the number of ellipse families. */
+    std::vector<unsigned int> enumPoints;
+    
+    /*! All angles for ellipses are in:
+            0 - degrees
+            1 - radians (Must use numerical value for PI)*/
+    bool eAngleOption = false;
+    
+    /*! First Ellipse fracture orientation.
+        If orientationOption = 0 (Spherical coordinates)
+        This The angle the normal vector makes with the z-axis
+        If  orientationOption = 1
+        This is the trend of Ellipse fracture orientation.
+        If  orientationOption = 2
+        This is the mean dip of Ellipse fracture orientation.
+        */
+    std::vector<float> eAngleOne;
+    
+    /*! Second Ellipse fracture orientation.
+        If orientationOption = 0 (Spherical coordinates)
+        The angle the projection of the normal
+        onto the x-y plane makes with the x-axis
+        If  orientationOption = 1
+        This is the plunge of Ellipse fracture orientation.
+        If  orientationOption = 2
+        This is the mean strike of Ellipse fracture orientation.*/
+    std::vector<float> eAngleTwo;
+    
+    
+    /*! Rotation around the fractures' normal vector.
+        Ellipse family parameter.*/
+    std::vector<float> ebeta;
+    
+    /*! Parameter for the fisher distribnShaprutions. The
+        bigger, the more similar (less diverging) are the
+        elliptical familiy's normal vectors.*/
+    std::vector<float> ekappa;
+    
+    /*! Log-normal ellipse parameter. Mean of the underlying normal distribution.*/
+    std::vector<float> eLogMean;
+    
+    /*! Log-normal ellipse parameter. Standard deviation of the underlying normal distribution*/
+    std::vector<float> esd;
+    
+    /*! Exponential ellipse parameter. Mean values for exponential distributions, defined per family.*/
+    std::vector<float> eExpMean;
+    
+    /*! Log-normal rectangle parameter. Minimum radius.*/
+    std::vector<float> rLogMin;
+    
+    /*! Log-normal rectangle parameter. Maximum radius.*/
+    std::vector<float> rLogMax;
+    
+    /*! Exponential rectangle parameter. Minimum radius.*/
+    std::vector<float> rExpMin;
+    
+    /*! Exponential rectangle parameter. Maximum radius.*/
+    std::vector<float> rExpMax;
+    
+    /*! Log-normal ellipse parameter. Minimum radius.*/
+    std::vector<float> eLogMin;
+    
+    /*! Log-normal ellipse parameter. Maximum radius.*/
+    std::vector<float> eLogMax;
+    
+    /*! Exponential ellipse parameter. Minimum radius.*/
+    std::vector<float> eExpMin;
+    
+    /*! Exponential ellipse parameter. Maximum radius.*/
+    std::vector<float> eExpMax;
+    
+    /*! Contant ellipse parameter. Constant radius.*/
+    std::vector<float> econst;
+    
+    /*! Truncated power-law ellipse parameter. Minimum radius.*/
+    std::vector<float> emin;
+    
+    /*! Truncated power-law ellipse parameter. Maximum radius.*/
+    std::vector<float> emax;
+    
+    /*! Truncated power-law ellipse distribution parameter.*/
+    std::vector<float> ealpha;
+    
+    /*! Elliptical families target fracture intensities per family
+        when using stopCondition = 1, P32 option.*/
+    std::vector<float> e_p32Targets;
+    
+    /*! Mandatory parameter if using statistically generated rectangles.
+    
+        Holds number of elements equal to the number of shape families.\
+    
+        Rectangle statistical distribution options:
+            1 - log-normal distribution
+            2 - truncated power law distribution
+            3 - exponential distribution
+            4 - constant*/
+    std::vector<unsigned int> rdistr;
+    
+    /*! Aspect ratio for stochasic rectangles.*/
+    std::vector<float> raspect;
+    
+    /*! All angles from input file for stochastic rectangles are in:
+            True  - Degrees
+            False - Radians */
+    bool rAngleOption = false;
+    
+    /*! 0 - Ignore this option, keep all fractures.
+    
+       >0 - Size of minimum fracture radius. Fractures smaller than
+            defined radius will be removed AFTER DFN generation.
+    
+            Minimum and maximum size options under fracture family
+            distributions will still be used while generating the DFN.*/
+    float removeFracturesLessThan = 0;
+    
+    
+    /*! First Rectangle fracture orientation.
+        If orientationOption = 0 (Spherical coordinates)
+        This The angle the normal vector makes with the z-axis
+        If orientationOption = 1
+        This is the trend of Rectangle fracture orientation.
+        If orientationOption = 2
+        This is the mean dip of Rectangle fracture orientation.
+        */
+    std::vector<float> rAngleOne;
+    
+    /*! Second Rectangle fracture orientation.
+        If orientationOption = 0 (Spherical coordinates)
+        The angle the projection of the normal
+        onto the x-y plane makes with the x-axis
+        If  orientationOption = 1
+        This is the plunge of Rectangle fracture orientation.
+        If orientationOption = 2
+        This is the mean strike of Rectangle fracture orientation. */
+    std::vector<float> rAngleTwo;
+    
+    /*! Rotation around the normal vector.*/
+    std::vector<float> rbeta;
+    
+    /*! Parameter for the fisher distribnShaprutions. The
+        bigger, the more similar (less diverging) are the
+        rectangle family's normal vectors.*/
+    std::vector<float> rkappa;
+    
+    /*! Log-normal rectangle parameter. Standard deviation of the underlying normal distribution*/
+    std::vector<float> rLogMean;
+    
+    /*! Log-normal rectangle parameter. Standard deviation of the underlying normal distribution*/
+    std::vector<float> rsd;
+    
+    /*! Truncated power-law rectangle parameter. Minimum radius.*/
+    std::vector<float> rmin;
+    
+    /*! Truncated power-law rectangle parameter. Maximum radius.*/
+    std::vector<float> rmax;
+    
+    /*! Truncated power-law rectangle distribution parameter.*/
+    std::vector<float> ralpha;
+    
+    /*! Rectangular families target fracture intensities per family
+        when using stopCondition = 1, P32 option.*/
+    std::vector<float> r_p32Targets;
+    
+    /*! Exponential rectangle parameter. Maximum radius.*/
+    std::vector<float> rExpMean;
+    
+    /*! Constant rectangle parameter. Constant radius.*/
+    std::vector<float> rconst;
+    
+    /*! True  - The user is using user defined ellipses.
+        False - No user defined ellipses are being used. */
+    bool userEllipsesOnOff = false;
+    
+    /*! Number of defined, user defined ellipses.*/
+    int nUserEll = 0;
+    
+    /*! All angles from input file for stochastic ellipses are in:
+            True  - Degrees
+            False - Radians */
+    bool ueAngleOption = false;
+    
+    /*! User ellipses radii array. */
+    std::vector<float> ueRadii;
+    
+    /*! User ellipses beta array. */
+    std::vector<float> ueBeta;
+    
+    /*! User ellipses aspect ratio array. */
+    std::vector<float> ueaspect;
+    
+    /*! User ellipses translation array.*/
+    std::vector<double> uetranslation;
+    
+    /*! User Orientation Option for ellipses
+        0 = normal vector
+        1 = trend / plunge
+        2 = dip / strike
+    */
+    int userEllOrientationOption = 0;
+    
+    /*! User ellipses normal vector array. */
+    std::vector<double> uenormal;
+    
+    /*! User ellipses trend and plunge array.*/
+    std::vector<double> ueTrendPlunge;
+    
+    /*! User ellipses dip and strike array.*/
+    std::vector<double> ueDipStrike;
+    
+    /*! User ellipses number of points per ellipse array. */
+    std::vector<unsigned int> uenumPoints;
+    
+    /*! True  - The user is using user defined rectangles.
+        False - No user defined rectangles are being used. */
+    bool userRectanglesOnOff = false;
+    
+    /*! True  - User rectangles defined by coordinates are being used.
+        False - No rectangles defined by coordinates are being used.*/
+    bool userRecByCoord = false;
+    
+    /*! True  - User ellipses defined by coordinates are being used.
+        False - No ellpsies defined by coordinates are being used.*/
+    bool userEllByCoord = false;
+    
+    /*! True  - User polygons defined by coordinates are being used.
+        False - No polygons defined by coordinates are being used.*/
+    bool userPolygonByCoord = false;
+    
+    /*! False - Permeability of each fracture is a function of fracture aperture,
+                given by k=(b^2)/12, where b is an aperture and k is permeability
+        True  - Constant permeabilty for all fractures*/
+    // bool permOption;
+    
+    /*! Caution: Can create very large files.
+        Outputs all fractures which were generated during
+        DFN generation (Accepted + Rejected).
+            False: Do not output all radii file.
+            True:  Include file of all raddii, acepted + rejected fractures,
+                   in output files (radii_All.dat). */
+    bool outputAllRadii = false;
+    
+    /*! Number of user defined rectangles.*/
+    int nUserRect = 0;
+    
+    /*! User rectangles radii array.*/
+    std::vector<float> urRadii;
+    
+    /*! All angles from input file for stochastic rectangles are in:
+            True  - Degrees
+            False - Radians */
+    bool urAngleOption = false;
+    
+    /*! User rectangles beta array.*/
+    std::vector<float> urBeta;
+    
+    /*! User rectangles aspect ratio array.*/
+    std::vector<float> uraspect;
+    
+    /*! User rectangles translation array. */
+    std::vector<double> urtranslation;
+    
+    /*! User Orientation Option for rectangles
+        0 = normal vector
+        1 = trend / plunge
+        2 = dip / strike
+        */
+    int userRectOrientationOption = 0;
+    
+    /*! User rectangles normal vector array.*/
+    std::vector<double> urnormal;
+    
+    /*! User rectangles trend and plunge array.*/
+    std::vector<double> urTrendPlunge;
+    
+    /*! User rectangles dip and strike array.*/
+    std::vector<double> urDipStrike;
+    
+    /*! Number of user rectangles defined by coordinates.*/
+    unsigned int nRectByCoord = 0;
+    
+    /*! Number of user ellipses defined by coordinates.*/
+    unsigned int nEllByCoord = 0;
+    
+    /*! Number of nodes for user defined ellipses by coordinates */
+    unsigned int nEllNodes = 0;
+    
+    /*! Array of rectangle coordiates.
+        Number of elements = 4 * 3 * nRectByCoord*/
+    std::vector<double> userRectCoordVertices;
+    
+    /*! Array of ellipse coordiates.
+        Number of elements =  3 * nEllNodes * nEllByCoord*/
+    std::vector<double> userEllCoordVertices;
+    
+    /*! Name of userPolygon File */
+    std::string polygonFile;
+    
+    /*! Log-normal aperture option.
+        Mean of underlying normal distribution. */
+    // float meanAperture;
+    
+    /*! Log-normal aperture option.
+        Standard deviation of underlying normal distribution. */
+    // float stdAperture;
+    
+    /*! 1 - Log-normal distribution
+        2 - Aperture from transmissivity, first transmissivity is defined,
+            and then, using a cubic law, the aperture is calculated.
+        3 - Constant aperture (same aperture for all fractures)
+        4 - Length Correlated Aperture
+            Apertures are defined as a function of fracture size.*/
+    //int aperture;
+    
+    /*! Transmissivity is calculated as transmissivity = F*R^k,
+        where F is a first element in aperturefromTransmissivity,
+        k is a second element and R is a mean radius of a polygon.
+        Aperture is calculated according to cubic law as
+        b = (transmissivity*12)^(1/3)*/
+    // float apertureFromTransmissivity[2];
+    
+    /*! Sets all fracture apertures to constantAperture.*/
+    // double constantAperture;
+    
+    /*! Length Correlated Aperture Option:
+        Aperture is calculated by: b=F*R^k,
+        where F is a first element in lengthCorrelatedAperture,
+        k is a second element and R is a mean radius of a polygon.*/
+    // double lengthCorrelatedAperture[2];
+    
+    /*! Permeability for all fractures*/
+    // double constantPermeability;
+    
+    /*! If a fracture is rejected, it will be re-translated
+        to a new position this number of times.
+    
+        This helps hit distribution targets for stochastic families
+        families (Set to 1 to ignore this feature)*/
+    int rejectsPerFracture = 0;
+    
+    
+    // Z - layers in the DFN
+    /*! Number of layers defined. */
+    int numOfLayers = 0;
+    
+    /*! Array of layers:
+        e.g. {+z1, -z1, +z2, -z2, ... , +zn, -zn}*/
+    std::vector<float> layers;
+    
+    /*! Array of volumes for each defined layer, in the same order
+        which layers were listed.*/
+    std::vector<float> layerVol;
+    
+    /*  Defines which domain, or layer, the family belongs to.
+        Layer 0 is the entire domain ('domainSize').
+        Layers numbered > 0 correspond to layers defined above (see 'Layers:').
+        1 correspond to the first layer listed, 2 is the next layer listed, etc*/
+    std::vector<int> rLayer;
+    
+    /*! Defines which domain, or layer, the family belongs to.
+        Layer 0 is the entire domain ('domainSize').
+        Layers numbered > 0 correspond to layers defined above (see 'Layers:').
+        1 correspond to the first layer listed, 2 is the next layer listed, etc*/
+    std::vector<int> eLayer;
+    
+    // Regions in the DFN
+    
+    /*! Number of regions defined. */
+    int numOfRegions = 0;
+    
+    /*! Array of regions:
+        e.g. {+z1, -z1, +z2, -z2, ... , +zn, -zn}*/
+    std::vector<float> regions;
+    
+    /*! Array of volumes for each defined layer, in the same order
+        which regions were listed.*/
+    std::vector<float> regionVol;
+    
+    /*  Defines which domain, or regions, the family belongs to.
+        Regions 0 is the entire domain ('domainSize').
+        regions numbered > 0 correspond to regions defined above (see 'regions:').
+        1 correspond to the first layer listed, 2 is the next layer listed, etc*/
+    std::vector<int> rRegion;
+    
+    /*! Defines which domain, or regions, the family belongs to.
+        Layer 0 is the entire domain ('domainSize').
+        regions numbered > 0 correspond to regions defined above (see 'regions:').
+        1 correspond to the first layer listed, 2 is the next layer listed, etc*/
+    std::vector<int> eRegion;
+    
+    /*! flag if the domain is pruned down to a final domain size*/
+    bool polygonBoundaryFlag = false;
+    
+    /*! Number of points on the 2D boundary of the polygon domain */
+    int numOfDomainVertices = 0;
+    
+    /*! Vector of points defining the 2D boundary of the domain polygon */
+    std::vector<Point> domainVertices;
+    
+    /*! Boolean array. Used with stopCondition = 1, P32 option.
+        Number of elements is equal to the number of stochastic shape families.
+        Elements correspond to families in the same order of the famProb array.
+        Elements are initialized to false, and are set to true once the families p32
+        requirement is met.
+        Once all elements have values all set to true, all families have had their
+        P32 requirement */
+    std::vector<bool> p32Status;
+    
+    /*! False - Use boundaryFaces option.
+        True  - Ignore boundaryFaces option, keep all clusters
+                and remove fractures with no intersections */
+    bool ignoreBoundaryFaces = false;
+    
+    /*! Epsilon, h * 1e-8. Set by readDFNInput().*/
+    double eps = 0;
+};
 
-/*
-extern int aperture;
-extern float meanAperture;
-extern float stdAperture;
-extern float apertureFromTransmissivity[2];
-extern double constantAperture;
-extern double lengthCorrelatedAperture[2];
-extern bool permOption;
-extern double constantPermeability;
-*/
+/*! Parameters of the DFN being generated or written. The library reads them through
+    this pointer, readDFNInput() and generateDFN() point it to the DFNConfig::input
+    they are called with. */
+extern DFNInput *params;
 
-extern float *econst;
-extern float *rconst;
-extern float *layers;
-extern float *layerVol;
-extern int *rLayer;
-extern int *eLayer;
-extern float *regions;
-extern float *regionVol;
-extern int *rRegion;
-extern int *eRegion;
-extern bool *p32Status;
-extern bool ignoreBoundaryFaces;
-extern int numOfLayers;
-extern int rejectsPerFracture;
-extern float *e_p32Targets;
-extern float *r_p32Targets;
-extern float removeFracturesLessThan;
-extern std::string polygonFile;
-extern std::vector<Point> vertices;
+/*! Thrown by library functions on an error, once it is written to the log.
+    readDFNInput() and generateDFN() catch it and return 1, programs calling other
+    library functions (output.h) catch it in main(). */
+struct DFNError {};
 extern Logger logger;
 
 #endif
-
-
-
-
-
-
-
@@ -0,0 +1,182 @@
+#include "inputReader.h"
+#include <fstream>
+#include <cctype>
+
+/* open() ************************************************************************************/
+/*! Reads a file into memory and indexes its variable names in one pass over the file.
+    Only the first occurrence of a name is indexed, find() goes to the same position
+    as a search from the start of the file would.
+    Arg 1: Path to file
+    Return: False if the file can not be read */
+bool InputReader::open(const std::string &fileName) {
+    close();
+    std::ifstream file(fileName.c_str(), std::ifstream::in | std::ifstream::binary);
+    
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    file.seekg(0, std::ifstream::end);
+    std::streamoff size = file.tellg();
+    file.seekg(0, std::ifstream::beg);
+    text.resize(size > 0 ? size : 0);
+    
+    if (size > 0 && !file.read(&text[0], size)) {
+        text.clear();
+        return false;
+    }
+    
+    size_t length = text.size();
+    size_t i = 0;
+    
+    while (i < length) {
+        while (i < length && isspace((unsigned char) text[i])) {
+            i++;
+        }
+        
+        size_t start = i;
+        
+        while (i < length && !isspace((unsigned char) text[i])) {
+            i++;
+        }
+        
+        // Variable names end with ':', e.g. "nPoly:". Numbers and coordinates are skipped
+        // without building a string for them.
+        if (i > start && text[i - 1] == ':') {
+            index.insert(std::make_pair(text.substr(start, i - start), i));
+        }
+    }
+    
+    pos = 0;
+    failed = false;
+    opened = true;
+    return true;
+}
+
+/* close() ***********************************************************************************/
+/*! Frees the file contents and the index */
+void InputReader::close() {
+    std::string().swap(text);
+    index.clear();
+    pos = 0;
+    failed = true;
+    opened = false;
+}
+
+/* find() ************************************************************************************/
+/*! Moves the read position after the first occurrence of a variable name
+    Arg 1: Variable name, including the ':'
+    Return: True if the variable was found. If not, reads fail until the next find() */
+bool InputReader::find(const std::string &name) {
+    std::unordered_map<std::string, size_t>::const_iterator it = index.find(name);
+    
+    if (it == index.end()) {
+        pos = text.size();
+        failed = true;
+        return false;
+    }
+    
+    pos = it->second;
+    failed = false;
+    return true;
+}
+
+/* skipSpace() *******************************************************************************/
+/*! Moves the read position to the next non white space character
+    Return: False if a read failed before or the end of the file is reached, reading fails */
+bool InputReader::skipSpace() {
+    if (failed) {
+        return false;
+    }
+    
+    while (pos < text.size() && isspace((unsigned char) text[pos])) {
+        pos++;
+    }
+    
+    failed = pos >= text.size();
+    return !failed;
+}
+
+/* operator>>() ******************************************************************************/
+/*! Reads the next non white space character
+    Arg 1: OUTPUT, character */
+InputReader &InputReader::operator>>(char &ch) {
+    if (skipSpace()) {
+        ch = text[pos++];
+    }
+    
+    return *this;
+}
+
+/*! Reads the next word
+    Arg 1: OUTPUT, word */
+InputReader &InputReader::operator>>(std::string &word) {
+    if (skipSpace()) {
+        size_t start = pos;
+        
+        while (pos < text.size() && !isspace((unsigned char) text[pos])) {
+            pos++;
+        }
+        
+        word.assign(text, start, pos - start);
+    }
+    
+    return *this;
+}
+
+/*! Reads a bool, written as 0 or 1
+    Arg 1: OUTPUT, value */
+InputReader &InputReader::operator>>(bool &value) {
+    long number;
+    *this >> number;
+    
+    if (!failed && number != 0 && number != 1) {
+        failed = true;
+    }
+    
+    value = number != 0;
+    return *this;
+}
+
+/*! Reads a float, same rounding as std::ifstream (strtof)
+    Arg 1: OUTPUT, value */
+InputReader &InputReader::operator>>(float &value) {
+    value = 0;
+    
+    if (skipSpace()) {
+        const char *start = text.c_str() + pos;
+        char *end;
+        float number = strtof(start, &end);
+        
+        if (end == start) {
+            failed = true;
+        } else {
+            value = number;
+            pos += end - start;
+        }
+    }
+    
+    return *this;
+}
+
+/*! Reads a double, same rounding as std::ifstream (strtod)
+    Arg 1: OUTPUT, value */
+InputReader &InputReader::operator>>(double &value) {
+    value = 0;
+    
+    if (skipSpace()) {
+        const char *start = text.c_str() + pos;
+        char *end;
+        double number = strtod(start, &end);
+        
+        if (end == start) {
+            failed = true;
+        } else {
+            value = number;
+            pos += end - start;
+        }
+    }
+    
+    return *this;
+}
+
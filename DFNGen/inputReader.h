@@ -0,0 +1,77 @@
+#ifndef _inputReader_h_
+#define _inputReader_h_
+#include <string>
+#include <unordered_map>
+#include <type_traits>
+#include <cstdlib>
+#include <cerrno>
+
+/*! DFNGen input file held in memory. The file is read and split into words
+    once, when it is opened, and the position of every variable name (word
+    ending with ':') is kept in an index. find() is a lookup in the index,
+    instead of reading the file from the start for every variable.
+
+    Values are read with operator>> like from a std::ifstream: leading white
+    space is skipped, numbers are read up to the first character which is not
+    part of the number (e.g. the ',' in "{1,2}"), a char reads one non white
+    space character and a std::string reads one word. A failed read sets the
+    value to 0 and makes all reads fail until the next find(). */
+class InputReader {
+  public:
+    InputReader() : pos(0), failed(true), opened(false) {}
+    
+    bool open(const std::string &fileName);
+    void close();
+    bool find(const std::string &name);
+    
+    bool is_open() const {
+        return opened;
+    }
+    
+    /*! True if no read failed since the last find() */
+    bool good() const {
+        return !failed;
+    }
+    
+    InputReader &operator>>(char &ch);
+    InputReader &operator>>(std::string &word);
+    InputReader &operator>>(bool &value);
+    InputReader &operator>>(float &value);
+    InputReader &operator>>(double &value);
+    
+    /*! Reads an integer (short, int, unsigned int, ...) */
+    template <typename T>
+    InputReader &operator>>(T &value) {
+        value = 0;
+        
+        if (skipSpace()) {
+            const char *start = text.c_str() + pos;
+            char *end;
+            errno = 0;
+            long long number = std::is_signed<T>::value ? strtoll(start, &end, 10) : (long long) strtoull(start, &end, 10);
+            
+            if (end == start || errno == ERANGE) {
+                failed = true;
+            } else {
+                value = (T) number;
+                pos += end - start;
+            }
+        }
+        
+        return *this;
+    }
+  
+  private:
+    /*! File contents */
+    std::string text;
+    /*! Read position in text */
+    size_t pos;
+    bool failed;
+    bool opened;
+    /*! Variable name -> position after its first occurrence */
+    std::unordered_map<std::string, size_t> index;
+    
+    bool skipSpace();
+};
+
+#endif
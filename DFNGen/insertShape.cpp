@@ -1,5 +1,7 @@
 #include <iostream>
 #include <random>
+#include <algorithm>
+#include <cmath>
 #include "structures.h"
 #include "insertShape.h"
 #include "generatingPoints.h"
@@ -59,7 +61,7 @@ struct Poly generatePoly(struct Shape &shapeFam, std::mt19937_64 &generator, Dis
                 }
                 
                 count++;
-            } while (radius < h || radius < shapeFam.logMin || radius > shapeFam.logMax);
+            } while (radius < params->h || radius < shapeFam.logMin || radius > shapeFam.logMax);
         } else { // Insert radius from list
             radius = shapeFam.radiiList[shapeFam.radiiIdx];
             shapeFam.radiiIdx++;
@@ -114,7 +116,7 @@ struct Poly generatePoly(struct Shape &shapeFam, std::mt19937_64 &generator, Dis
                 }
                 
                 count++;
-            } while (radius < h || radius < shapeFam.expMin || radius > shapeFam.expMax);
+            } while (radius < params->h || radius < shapeFam.expMin || radius > shapeFam.expMax);
         } else { // Insert radius from list
             radius = shapeFam.radiiList[shapeFam.radiiIdx];
             shapeFam.radiiIdx++;
@@ -160,7 +162,7 @@ struct Poly generatePoly(struct Shape &shapeFam, std::mt19937_64 &generator, Dis
     double *norm = fisherDistribution(shapeFam.angleOne, shapeFam.angleTwo, shapeFam.kappa, generator);
     double mag = magnitude(norm[0], norm[1], norm[2]);
     
-    if (mag < 1 - eps || mag > 1 + eps) {
+    if (mag < 1 - params->eps || mag > 1 + params->eps) {
         normalize(norm); // Ensure norm is normalized
     }
     
@@ -174,30 +176,30 @@ struct Poly generatePoly(struct Shape &shapeFam, std::mt19937_64 &generator, Dis
     
     // HERE
     if (shapeFam.layer == 0 && shapeFam.region == 0) { // The family layer is the whole domain
-        t = randomTranslation(generator, (-domainSize[0] - domainSizeIncrease[0]) / 2,
-                              (domainSize[0] + domainSizeIncrease[0]) / 2, (-domainSize[1] - domainSizeIncrease[1]) / 2,
-                              (domainSize[1] + domainSizeIncrease[1]) / 2, (-domainSize[2] - domainSizeIncrease[2]) / 2,
-                              (domainSize[2] + domainSizeIncrease[2]) / 2);
+        t = randomTranslation(generator, (-params->domainSize[0] - params->domainSizeIncrease[0]) / 2,
+                              (params->domainSize[0] + params->domainSizeIncrease[0]) / 2, (-params->domainSize[1] - params->domainSizeIncrease[1]) / 2,
+                              (params->domainSize[1] + params->domainSizeIncrease[1]) / 2, (-params->domainSize[2] - params->domainSizeIncrease[2]) / 2,
+                              (params->domainSize[2] + params->domainSizeIncrease[2]) / 2);
     } else if (shapeFam.layer > 0 && shapeFam.region == 0) { // Family belongs to a certain layer, shapeFam.layer is > zero
         // Layers start at 1, but the array of layers start at 0, hence
         // the subtraction by 1
         // Layer 0 is reservered to be the entire domain
         int layerIdx = (shapeFam.layer - 1) * 2;
         // Layers only apply to z coordinates
-        t = randomTranslation(generator, (-domainSize[0] - domainSizeIncrease[0]) / 2,
-                              (domainSize[0] + domainSizeIncrease[0]) / 2, (-domainSize[1] - domainSizeIncrease[1]) / 2,
-                              (domainSize[1] + domainSizeIncrease[1]) / 2, layers[layerIdx], layers[layerIdx + 1]);
+        t = randomTranslation(generator, (-params->domainSize[0] - params->domainSizeIncrease[0]) / 2,
+                              (params->domainSize[0] + params->domainSizeIncrease[0]) / 2, (-params->domainSize[1] - params->domainSizeIncrease[1]) / 2,
+                              (params->domainSize[1] + params->domainSizeIncrease[1]) / 2, params->layers[layerIdx], params->layers[layerIdx + 1]);
     } else if (shapeFam.layer == 0 && shapeFam.region > 0) {
         int regionIdx = (shapeFam.region - 1) * 6;
         // Layers only apply to z coordinates
-        t = randomTranslation(generator, regions[regionIdx], regions[regionIdx + 1], regions[regionIdx + 2], regions[regionIdx + 3], regions[regionIdx + 4], regions[regionIdx + 5]);
+        t = randomTranslation(generator, params->regions[regionIdx], params->regions[regionIdx + 1], params->regions[regionIdx + 2], params->regions[regionIdx + 3], params->regions[regionIdx + 4], params->regions[regionIdx + 5]);
         //logString = "Translation "+ t[0] + " " + t[1] + " " + t[2]+"\n";
         //logger.writeLogFile(INFO,  logString);
     } else {
         t = randomTranslation(generator, -1, 1, -1, 1, -1, 1);
         std::string logString = "ERROR!!!\nLayer and Region both defined for this Family.\nExiting Program\n";
         logger.writeLogFile(ERROR,  logString);
-        exit(1);
+        throw DFNError();
     }
     
     // Translate - will also set translation vector in poly structure
@@ -261,7 +263,7 @@ struct Poly generatePoly_withRadius(double radius, struct Shape &shapeFam, std::
     double *norm = fisherDistribution(shapeFam.angleOne, shapeFam.angleTwo, shapeFam.kappa, generator);
     double mag = magnitude(norm[0], norm[1], norm[2]);
     
-    if (mag < 1 - eps || mag > 1 + eps) {
+    if (mag < 1 - params->eps || mag > 1 + params->eps) {
         normalize(norm); //ensure norm is normalized
     }
     
@@ -274,27 +276,27 @@ struct Poly generatePoly_withRadius(double radius, struct Shape &shapeFam, std::
     double *t;
     
     if (shapeFam.layer == 0 && shapeFam.region == 0) { // The family layer is the whole domain
-        t = randomTranslation(generator, (-domainSize[0] - domainSizeIncrease[0]) / 2,
-                              (domainSize[0] + domainSizeIncrease[0]) / 2, (-domainSize[1] - domainSizeIncrease[1]) / 2,
-                              (domainSize[1] + domainSizeIncrease[1]) / 2, (-domainSize[2] - domainSizeIncrease[2]) / 2,
-                              (domainSize[2] + domainSizeIncrease[2]) / 2);
+        t = randomTranslation(generator, (-params->domainSize[0] - params->domainSizeIncrease[0]) / 2,
+                              (params->domainSize[0] + params->domainSizeIncrease[0]) / 2, (-params->domainSize[1] - params->domainSizeIncrease[1]) / 2,
+                              (params->domainSize[1] + params->domainSizeIncrease[1]) / 2, (-params->domainSize[2] - params->domainSizeIncrease[2]) / 2,
+                              (params->domainSize[2] + params->domainSizeIncrease[2]) / 2);
     } else if (shapeFam.layer > 0 && shapeFam.region == 0) { // Family belongs to a certain layer, shapeFam.layer is > zero
         // Layers start at 1, but the array of layers start at 0, hence
         // the subtraction by 1
         // Layer 0 is reservered to be the entire domain
         int layerIdx = (shapeFam.layer - 1) * 2;
         // Layers only apply to z coordinates
-        t = randomTranslation(generator, (-domainSize[0] - domainSizeIncrease[0]) / 2,
-                              (domainSize[0] + domainSizeIncrease[0]) / 2, (-domainSize[1] - domainSizeIncrease[1]) / 2,
-                              (domainSize[1] + domainSizeIncrease[1]) / 2, layers[layerIdx], layers[layerIdx + 1]);
+        t = randomTranslation(generator, (-params->domainSize[0] - params->domainSizeIncrease[0]) / 2,
+                              (params->domainSize[0] + params->domainSizeIncrease[0]) / 2, (-params->domainSize[1] - params->domainSizeIncrease[1]) / 2,
+                              (params->domainSize[1] + params->domainSizeIncrease[1]) / 2, params->layers[layerIdx], params->layers[layerIdx + 1]);
     } else if (shapeFam.layer == 0 && shapeFam.region > 0) {
         int regionIdx = (shapeFam.region - 1) * 6;
         // Layers only apply to z coordinates
-        t = randomTranslation(generator, regions[regionIdx], regions[regionIdx + 1], regions[regionIdx + 2], regions[regionIdx + 3], regions[regionIdx + 4], regions[regionIdx + 5]);
+        t = randomTranslation(generator, params->regions[regionIdx], params->regions[regionIdx + 1], params->regions[regionIdx + 2], params->regions[regionIdx + 3], params->regions[regionIdx + 4], params->regions[regionIdx + 5]);
     } else {
         std::string logString = "ERROR!!!\nLayer and Region both defined for this Family.\nExiting Program\n";
         logger.writeLogFile(ERROR,  logString);
-        exit(1);
+        throw DFNError();
     }
     
     // Translate - will also set translation vector in poly structure
@@ -462,29 +464,29 @@ void reTranslatePoly(struct Poly &newPoly, struct Shape &shapeFam, std::mt19937_
         double *t;
         
         if (shapeFam.layer == 0 && shapeFam.region == 0) { // The family layer is the whole domain
-            t = randomTranslation(generator, (-domainSize[0] - domainSizeIncrease[0]) / 2,
-                                  (domainSize[0] + domainSizeIncrease[0]) / 2, (-domainSize[1] - domainSizeIncrease[1]) / 2,
-                                  (domainSize[1] + domainSizeIncrease[1]) / 2, (-domainSize[2] - domainSizeIncrease[2]) / 2,
-                                  (domainSize[2] + domainSizeIncrease[2]) / 2);
+            t = randomTranslation(generator, (-params->domainSize[0] - params->domainSizeIncrease[0]) / 2,
+                                  (params->domainSize[0] + params->domainSizeIncrease[0]) / 2, (-params->domainSize[1] - params->domainSizeIncrease[1]) / 2,
+                                  (params->domainSize[1] + params->domainSizeIncrease[1]) / 2, (-params->domainSize[2] - params->domainSizeIncrease[2]) / 2,
+                                  (params->domainSize[2] + params->domainSizeIncrease[2]) / 2);
         } else if (shapeFam.layer > 0 && shapeFam.region == 0) { // Family belongs to a certain layer, shapeFam.layer is > zero
             // Layers start at 1, but the array of layers start at 0, hence
             // the subtraction by 1
             // Layer 0 is reservered to be the entire domain
             int layerIdx = (shapeFam.layer - 1) * 2;
             // Layers only apply to z coordinates
-            t = randomTranslation(generator, (-domainSize[0] - domainSizeIncrease[0]) / 2,
-                                  (domainSize[0] + domainSizeIncrease[0]) / 2, (-domainSize[1] - domainSizeIncrease[1]) / 2,
-                                  (domainSize[1] + domainSizeIncrease[1]) / 2, layers[layerIdx], layers[layerIdx + 1]);
+            t = randomTranslation(generator, (-params->domainSize[0] - params->domainSizeIncrease[0]) / 2,
+                                  (params->domainSize[0] + params->domainSizeIncrease[0]) / 2, (-params->domainSize[1] - params->domainSizeIncrease[1]) / 2,
+                                  (params->domainSize[1] + params->domainSizeIncrease[1]) / 2, params->layers[layerIdx], params->layers[layerIdx + 1]);
         } else if (shapeFam.layer == 0 && shapeFam.region > 0) {
             int regionIdx = (shapeFam.region - 1) * 6;
             // Layers only apply to z coordinates
-            t = randomTranslation(generator, regions[regionIdx], regions[regionIdx + 1], regions[regionIdx + 2], regions[regionIdx + 3], regions[regionIdx + 4], regions[regionIdx + 5]);
+            t = randomTranslation(generator, params->regions[regionIdx], params->regions[regionIdx + 1], params->regions[regionIdx + 2], params->regions[regionIdx + 3], params->regions[regionIdx + 4], params->regions[regionIdx + 5]);
         } else {
             // you should never get here
             t = randomTranslation(generator, -1, 1, -1, 1, -1, 1);
             std::string logString = "ERROR!!!\nLayer and Region both defined for this Family.\nExiting Program\n";
             logger.writeLogFile(ERROR,  logString);
-            exit(1);
+            throw DFNError();
         }
         
         // Translate - will also set translation vector in poly structure
@@ -553,28 +555,28 @@ void reTranslatePoly(struct Poly &newPoly, struct Shape &shapeFam, std::mt19937_
         double *t;
         
         if (shapeFam.layer == 0 && shapeFam.region == 0) { // The family layer is the whole domain
-            t = randomTranslation(generator, (-domainSize[0] - domainSizeIncrease[0]) / 2,
-                                  (domainSize[0] + domainSizeIncrease[0]) / 2, (-domainSize[1] - domainSizeIncrease[1]) / 2,
-                                  (domainSize[1] + domainSizeIncrease[1]) / 2, (-domainSize[2] - domainSizeIncrease[2]) / 2,
-                                  (domainSize[2] + domainSizeIncrease[2]) / 2);
+            t = randomTranslation(generator, (-params->domainSize[0] - params->domainSizeIncrease[0]) / 2,
+                                  (params->domainSize[0] + params->domainSizeIncrease[0]) / 2, (-params->domainSize[1] - params->domainSizeIncrease[1]) / 2,
+                                  (params->domainSize[1] + params->domainSizeIncrease[1]) / 2, (-params->domainSize[2] - params->domainSizeIncrease[2]) / 2,
+                                  (params->domainSize[2] + params->domainSizeIncrease[2]) / 2);
         } else if (shapeFam.layer > 0 && shapeFam.region == 0) { // Family belongs to a certain layer, shapeFam.layer is > zero
             // Layers start at 1, but the array of layers start at 0, hence
             // the subtraction by 1
             // Layer 0 is reservered to be the entire domain
             int layerIdx = (shapeFam.layer - 1) * 2;
             // Layers only apply to z coordinates
-            t = randomTranslation(generator, (-domainSize[0] - domainSizeIncrease[0]) / 2,
-                                  (domainSize[0] + domainSizeIncrease[0]) / 2, (-domainSize[1] - domainSizeIncrease[1]) / 2,
-                                  (domainSize[1] + domainSizeIncrease[1]) / 2, layers[layerIdx], layers[layerIdx + 1]);
+            t = randomTranslation(generator, (-params->domainSize[0] - params->domainSizeIncrease[0]) / 2,
+                                  (params->domainSize[0] + params->domainSizeIncrease[0]) / 2, (-params->domainSize[1] - params->domainSizeIncrease[1]) / 2,
+                                  (params->domainSize[1] + params->domainSizeIncrease[1]) / 2, params->layers[layerIdx], params->layers[layerIdx + 1]);
         } else if (shapeFam.layer == 0 && shapeFam.region > 0) {
             int regionIdx = (shapeFam.region - 1) * 6;
             // Layers only apply to z coordinates
-            t = randomTranslation(generator, regions[regionIdx], regions[regionIdx + 1], regions[regionIdx + 2], regions[regionIdx + 3], regions[regionIdx + 4], regions[regionIdx + 5]);
+            t = randomTranslation(generator, params->regions[regionIdx], params->regions[regionIdx + 1], params->regions[regionIdx + 2], params->regions[regionIdx + 3], params->regions[regionIdx + 4], params->regions[regionIdx + 5]);
         } else {
             t = randomTranslation(generator, -1, 1, -1, 1, -1, 1);
             std::string logString = "ERROR!!!\nLayer and Region both defined for this Family.\nExiting Program\n";
             logger.writeLogFile(ERROR,  logString);
-            exit(1);
+            throw DFNError();
         }
         
         translate(newPoly, t);
@@ -600,7 +602,7 @@ void reTranslatePoly(struct Poly &newPoly, struct Shape &shapeFam, std::mt19937_
 bool p32Complete(int size) {
     // Check if p32Status array is all 1's, if not return 0
     for (int i = 0; i < size; i++) {
-        if (p32Status[i] == 0) {
+        if (params->p32Status[i] == 0) {
             return 0;
         }
     }
@@ -619,6 +621,10 @@ bool p32Complete(int size) {
 void printRejectReason(int rejectCode, struct Poly newPoly) {
     std::string logString;
     
+    if (!logger.enabled(ERROR)) {
+        return;
+    }
+    
     if (newPoly.familyNum >= 0 ) {
         logString = "Attempted fracture from family " +  to_string(newPoly.familyNum) + " was rejected:\n";
         logger.writeLogFile(ERROR,  logString);
@@ -695,7 +701,7 @@ void printRejectReason(int rejectCode, struct Poly newPoly) {
            1 - Rectangle */
 int getFamilyNumber(int familyIndex, int familyShape) {
     if (familyShape != 0) { // if not ellipse family
-        return familyIndex - nFamEll + 1;
+        return familyIndex - params->nFamEll + 1;
     } else {
         return familyIndex + 1;
     }
@@ -742,4 +748,27 @@ double getLargestFractureRadius(Shape &shapeFam) {
     }
 }
 
+/* fractureReach() ***************************************************************************/
+/*! Largest distance from a stochastic fracture's translation to its vertices: the
+    family's maximum radius, or a larger radius in its radii list, over the corners
+    of the xradius by yradius rectangle
+    Arg 1: Shape families
+    Return: Reach of the largest fracture of all families */
+double fractureReach(std::vector<Shape> &shapeFamilies) {
+    double reach = 0;
+    
+    for (unsigned int i = 0; i < shapeFamilies.size(); i++) {
+        Shape &shapeFam = shapeFamilies[i];
+        double radius = getLargestFractureRadius(shapeFam);
+        
+        for (unsigned int j = 0; j < shapeFam.radiiList.size(); j++) {
+            radius = std::max(radius, shapeFam.radiiList[j]);
+        }
+        
+        reach = std::max(reach, radius * std::sqrt(1 + shapeFam.aspectRatio * shapeFam.aspectRatio));
+    }
+    
+    return reach;
+}
+
 
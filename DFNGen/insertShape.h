@@ -23,6 +23,7 @@ void printRejectReason(int rejectCode, struct Poly newPoly);
 int getFamilyNumber(int familyIndex, int family);
 std::string shapeType(struct Shape &shapeFam);
 double getLargestFractureRadius(Shape &shapeFam);
+double fractureReach(std::vector<Shape> &shapeFamilies);
 struct Poly generatePoly_withRadius(double radius, struct Shape &shapeFam, std::mt19937_64 &generator, Distributions &distributions, int familyIndex);
 
 #endif
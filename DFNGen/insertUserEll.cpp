@@ -7,6 +7,7 @@
 #include "input.h"
 #include "generatingPoints.h"
 #include "domain.h"
+#include "fractureGrid.h"
 #include "testing.h"
 #include "logFile.h"
 
@@ -14,40 +15,41 @@
 /*********************  Insert User Ellipse  ***************************/
 /*! Inserts a user defined ellipse into the domain.
     Intersection checking, FRAM, and rejection/accptance are all called
-    within this function.
+    within this function, see insertUserFractures().
     Arg 1: Array for all accepted polygons
     Arg 2: Array for all accepted intersections
     Arg 3: Program statistics structure
     Arg 4: Array of all triple intersection points */
 void insertUserEll(std::vector<Poly>& acceptedPoly, std::vector<IntPoints> &intpts, struct Stats &pstats, std::vector<Point> &triplePoints) {
-    std::string logString = to_string(nUserEll) + " User Ellipses Defined\n\n";
+    std::string logString = to_string(params->nUserEll) + " User Ellipses Defined\n\n";
     logger.writeLogFile(INFO,  logString);
     
-    for (int i = 0; i < nUserEll; i++) {
+    auto size = [&](unsigned int i) {
+        return 2 * params->ueRadii[i] * std::max(1.0f, params->ueaspect[i]);
+    };
+    auto create = [&](Poly &newPoly, unsigned int i) {
         int index = i * 3; // Index to start of vertices/nodes
-        Poly newPoly; // New poly/fracture to be tested
-        RejectedUserFracture rejectedUserFracture;
         newPoly.familyNum = -1; // Using -1 for all user specified ellipses
-        newPoly.vertices = new double[uenumPoints[i] * 3];
+        newPoly.vertices = new double[params->uenumPoints[i] * 3];
         // Set number of nodes  - needed for rotations
-        newPoly.numberOfNodes = uenumPoints[i];
+        newPoly.numberOfNodes = params->uenumPoints[i];
         // Initialize translation data
-        newPoly.translation[0] = uetranslation[index];
-        newPoly.translation[1] = uetranslation[index + 1];
-        newPoly.translation[2] = uetranslation[index + 2];
+        newPoly.translation[0] = params->uetranslation[index];
+        newPoly.translation[1] = params->uetranslation[index + 1];
+        newPoly.translation[2] = params->uetranslation[index + 2];
         // Generate theta array used to place vertices
         float *thetaAry;
-        generateTheta(thetaAry, ueaspect[i], uenumPoints[i]);
+        generateTheta(thetaAry, params->ueaspect[i], params->uenumPoints[i]);
         // Initialize vertices on x-y plane
-        initializeEllVertices(newPoly, ueRadii[i], ueaspect[i], thetaAry, uenumPoints[i]);
+        initializeEllVertices(newPoly, params->ueRadii[i], params->ueaspect[i], thetaAry, params->uenumPoints[i]);
         delete[] thetaAry;
         // Convert angle to rad if necessary
-        float angle = ueBeta[i];
+        float angle = params->ueBeta[i];
         
-        if (ueAngleOption == 1 ) {
-            angle = ueBeta[i] * M_PI / 180;
+        if (params->ueAngleOption == 1 ) {
+            angle = params->ueBeta[i] * M_PI / 180;
         } else {
-            angle = ueBeta[i];
+            angle = params->ueBeta[i];
         }
         
         // Initialize normal to {0,0,1}. need initialized for 3D rotation
@@ -59,72 +61,55 @@ void insertUserEll(std::vector<Poly>& acceptedPoly, std::vector<IntPoints> &intp
         // Angle must be in rad
         applyRotation2D(newPoly, angle);
         // Normalize user denined normal vector
-        normalize(&uenormal[index]);
+        normalize(&params->uenormal[index]);
         // Rotate vertices to uenormal[index] (new normal)
-        applyRotation3D(newPoly, &uenormal[index]);
+        applyRotation3D(newPoly, &params->uenormal[index]);
         // Save newPoly's new normal vector
-        newPoly.normal[0] = uenormal[index];
-        newPoly.normal[1] = uenormal[index + 1];
-        newPoly.normal[2] = uenormal[index + 2];
+        newPoly.normal[0] = params->uenormal[index];
+        newPoly.normal[1] = params->uenormal[index + 1];
+        newPoly.normal[2] = params->uenormal[index + 2];
         // Translate newPoly to uetranslation
-        translate(newPoly, &uetranslation[index]);
+        translate(newPoly, &params->uetranslation[index]);
         
-        if (domainTruncation(newPoly, domainSize) == 1) {
+        if (domainTruncation(newPoly, params->domainSize) == 1) {
             // Poly completely outside domain
-            delete[] newPoly.vertices;
-            pstats.rejectionReasons.outside++;
-            pstats.rejectedPolyCount++;
-            logString = "User Ellipse " + to_string(i + 1) + " was rejected for being outside the defined domain.\n";
-            logger.writeLogFile(ERROR,  logString);
-            rejectedUserFracture.id = i + 1;
-            rejectedUserFracture.userFractureType  = -1;
-            pstats.rejectedUserFracture.push_back(rejectedUserFracture);
-            continue; // Go to next poly (go to next iteration of for loop)
+            return true;
         }
         
         createBoundingBox(newPoly);
-        // Line of intersection and FRAM
-        int rejectCode = intersectionChecking(newPoly, acceptedPoly, intpts, pstats, triplePoints);
+        return false;
+    };
+    auto report = [&](Poly &newPoly, unsigned int i, int rejectCode) {
+        if (rejectCode == USER_FRACTURE_OUTSIDE) {
+            logString = "User Ellipse " + to_string(i + 1) + " was rejected for being outside the defined domain.\n";
+            logger.writeLogFile(ERROR,  logString);
+            return;
+        }
         
-        if(rejectCode == 0) {//if intersection is ok
+        if (rejectCode == 0) {//if intersection is ok
             if (newPoly.truncated == 1) {
                 pstats.truncated++;
             }
             
-            // Incriment counter of accepted polys
-            pstats.acceptedPolyCount++;
-            // Calculate poly's area
-            newPoly.area = getArea(newPoly);
-            // Add new rejectsPerAttempt counter
-            pstats.rejectsPerAttempt.push_back(0);
-            logString = "User Defined Elliptical Fracture " + to_string((i + 1)) + " Accepted\n";
-            logger.writeLogFile(INFO,  logString);
-            acceptedPoly.push_back(newPoly); // Save newPoly to accepted polys list
+            if (logger.enabled(INFO)) {
+                logString = "User Defined Elliptical Fracture " + to_string((i + 1)) + " Accepted\n";
+                logger.writeLogFile(INFO,  logString);
+            }
         } else {
-            delete[] newPoly.vertices; // Need to delete manually, created with new[]
-            pstats.rejectsPerAttempt[pstats.acceptedPolyCount]++;
-            pstats.rejectedPolyCount++;
             logString = "Rejected User Defined Elliptical Fracture " + to_string(i + 1) + "\n";
             logger.writeLogFile(ERROR,  logString);
             printRejectReason(rejectCode, newPoly);
-            rejectedUserFracture.id = i + 1;
-            rejectedUserFracture.userFractureType  = -1;
-            pstats.rejectedUserFracture.push_back(rejectedUserFracture);
 #ifdef TESTING
-            exit(1);
+            throw DFNError();
 #endif
         }
         
-        logString = "\n\n";
-        logger.writeLogFile(INFO,  logString);
-    } // End loops
-    
-    delete[] ueRadii;
-    delete[] ueaspect;
-    delete[] ueBeta;
-    delete[] uetranslation;
-    delete[] uenormal;
-    delete[] uenumPoints;
+        if (logger.enabled(INFO)) {
+            logString = "\n\n";
+            logger.writeLogFile(INFO,  logString);
+        }
+    };
+    insertUserFractures(params->nUserEll, size, create, report, acceptedPoly, intpts, pstats, triplePoints);
 }
 
 
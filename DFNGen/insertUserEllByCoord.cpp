@@ -7,6 +7,7 @@
 #include "structures.h"
 #include "input.h"
 #include "domain.h"
+#include "fractureGrid.h"
 #include "logFile.h"
 
 /****************************************************************/
@@ -14,35 +15,36 @@
 /*! Inserts user ellipses using defined coordinates
     provided by the user (see input file).
     Intersection checking, FRAM, and rejection/accptance are all contained
-    within this function.
+    within this function, see insertUserFractures().
     Arg 1: Array for all accepted polygons
     Arg 2: Array for all accepted intersections
     Arg 3: Program statistics structure
     Arg 4: Array of all triple intersection points */
 void insertUserEllByCoord(std::vector<Poly>& acceptedPoly, std::vector<IntPoints> &intpts, struct Stats &pstats, std::vector<Point> &triplePoints) {
-    std::string logString = to_string(nEllByCoord) + " User Ellipses By Coordinates Defined\n\n";
+    std::string logString = to_string(params->nEllByCoord) + " User Ellipses By Coordinates Defined\n\n";
     logger.writeLogFile(INFO,  logString);
     
-    for (unsigned int i = 0; i < nEllByCoord; i++) {
-        Poly newPoly;
-        RejectedUserFracture rejectedUserFracture;
+    auto size = [&](unsigned int i) {
+        return nodeExtent(&params->userEllCoordVertices[i * 3 * params->nEllNodes], params->nEllNodes);
+    };
+    auto create = [&](Poly &newPoly, unsigned int i) {
         newPoly.familyNum = -1; // Using -1 for all user specified ellipses
-        newPoly.vertices = new double[3 * nEllNodes]; // 3 * number of nodes
+        newPoly.vertices = new double[3 * params->nEllNodes]; // 3 * number of nodes
         // Set number of nodes  - needed for rotations
-        newPoly.numberOfNodes = nEllNodes;
-        int polyVertIdx = i * 3 * nEllNodes; // Each polygon has nEllNodes * 3 vertices
+        newPoly.numberOfNodes = params->nEllNodes;
+        int polyVertIdx = i * 3 * params->nEllNodes; // Each polygon has nEllNodes * 3 vertices
         
         // Initialize vertices
-        for (unsigned int j = 0; j < nEllNodes; j++) {
+        for (unsigned int j = 0; j < params->nEllNodes; j++) {
             int vIdx = j * 3;
-            newPoly.vertices[vIdx] = userEllCoordVertices[polyVertIdx + vIdx];
-            newPoly.vertices[vIdx + 1] = userEllCoordVertices[polyVertIdx + 1 + vIdx];
-            newPoly.vertices[vIdx + 2] = userEllCoordVertices[polyVertIdx + 2 + vIdx];
+            newPoly.vertices[vIdx] = params->userEllCoordVertices[polyVertIdx + vIdx];
+            newPoly.vertices[vIdx + 1] = params->userEllCoordVertices[polyVertIdx + 1 + vIdx];
+            newPoly.vertices[vIdx + 2] = params->userEllCoordVertices[polyVertIdx + 2 + vIdx];
         }
         
         // Get a normal vector
         // Vector from fist node to node accross middle of polygon
-        int midPtIdx = 3 * (int) (nEllNodes / 2);
+        int midPtIdx = 3 * (int) (params->nEllNodes / 2);
         double v1[3] = {newPoly.vertices[midPtIdx] - newPoly.vertices[0],
                         newPoly.vertices[midPtIdx + 1] - newPoly.vertices[1],
                         newPoly.vertices[midPtIdx + 2] - newPoly.vertices[2]
@@ -61,8 +63,8 @@ void insertUserEllByCoord(std::vector<Poly>& acceptedPoly, std::vector<IntPoints
         delete[] xProd1;
         // Estimate radius
         newPoly.xradius = .5 * magnitude(v2[0], v2[1], v2[2]); // across middle if even number of nodes
-        int tempIdx1 = 3 * (int) (midPtIdx / 2) ; // Get idx for node 1/4 around polygon
-        int tempIdx2 = 3 * (tempIdx1 + midPtIdx);  // Get idx for node 3/4 around polygon
+        int tempIdx1 = 3 * (int) (params->nEllNodes / 4) ; // Get idx for node 1/4 around polygon
+        int tempIdx2 = 3 * (int) (3 * params->nEllNodes / 4);  // Get idx for node 3/4 around polygon
         // across middle close to perpendicular to xradius magnitude calculation
         newPoly.yradius = .5 * euclideanDistance(&newPoly.vertices[tempIdx1], &newPoly.vertices[tempIdx2]);
         newPoly.aspectRatio = newPoly.yradius / newPoly.xradius;
@@ -75,51 +77,34 @@ void insertUserEllByCoord(std::vector<Poly>& acceptedPoly, std::vector<IntPoints
         newPoly.translation[1] = .5 * (newPoly.vertices[1] + newPoly.vertices[midPtIdx + 1]);
         newPoly.translation[2] = .5 * (newPoly.vertices[2] + newPoly.vertices[midPtIdx + 2]);
         
-        if (domainTruncation(newPoly, domainSize) == 1) {
+        if (domainTruncation(newPoly, params->domainSize) == 1) {
             // Poly completely outside domain
-            delete[] newPoly.vertices;
-            pstats.rejectionReasons.outside++;
-            pstats.rejectedPolyCount++;
-            logString = "User Ellipse (defined by coordinates) " + to_string(i + 1) + " was rejected for being outside the defined domain.\n";
-            logger.writeLogFile(ERROR,  logString);
-            rejectedUserFracture.id = i + 1;
-            rejectedUserFracture.userFractureType  = -1;
-            pstats.rejectedUserFracture.push_back(rejectedUserFracture);
-            continue; // Go to next poly (go to next iteration of for loop)
+            return true;
         }
         
         createBoundingBox(newPoly);
-        // Line of intersection and FRAM
-        int rejectCode = intersectionChecking(newPoly, acceptedPoly, intpts, pstats, triplePoints);
-        
-        if(rejectCode == 0) {
+        return false;
+    };
+    auto report = [&](Poly &newPoly, unsigned int i, int rejectCode) {
+        if (rejectCode == USER_FRACTURE_OUTSIDE) {
+            logString = "User Ellipse (defined by coordinates) " + to_string(i + 1) + " was rejected for being outside the defined domain.\n";
+            logger.writeLogFile(ERROR,  logString);
+        } else if (rejectCode == 0) {
             // If intersection is ok (FRAM passed all tests)
             if (newPoly.truncated == 1) {
                 pstats.truncated++;
             }
             
-            // Incriment counter of accepted polys
-            pstats.acceptedPolyCount++;
-            // Calculate poly's area
-            newPoly.area = getArea(newPoly);
-            // Add new rejectsPerAttempt counter
-            pstats.rejectsPerAttempt.push_back(0);
-            logString = "User Defined Elliptical Fracture (Defined By Coordinates) " + to_string((i + 1)) + " Accepted\n";
-            logger.writeLogFile(INFO,  logString);
-            acceptedPoly.push_back(newPoly); // Save newPoly to accepted polys list
+            if (logger.enabled(INFO)) {
+                logString = "User Defined Elliptical Fracture (Defined By Coordinates) " + to_string((i + 1)) + " Accepted\n";
+                logger.writeLogFile(INFO,  logString);
+            }
         } else {
-            delete[] newPoly.vertices; // Need to delete manually, created with new[]
-            pstats.rejectsPerAttempt[pstats.acceptedPolyCount]++;
-            pstats.rejectedPolyCount++;
             logString = "Rejected Eser Defined Elliptical Fracture (Defined By Coordinates) " + to_string(i + 1 ) + "\n";
             logger.writeLogFile(ERROR,  logString);
             printRejectReason(rejectCode, newPoly);
-            rejectedUserFracture.id = i + 1;
-            rejectedUserFracture.userFractureType  = -1;
-            pstats.rejectedUserFracture.push_back(rejectedUserFracture);
         }
-    } // End loop
-    
-    delete[] userEllCoordVertices;
+    };
+    insertUserFractures(params->nEllByCoord, size, create, report, acceptedPoly, intpts, pstats, triplePoints);
 }
 
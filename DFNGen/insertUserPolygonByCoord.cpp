@@ -1,6 +1,13 @@
 #include <cmath>
 #include <iostream>
 #include <random>
+#include <cstring>
+#include <cerrno>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "insertShape.h"
 #include "vectorFunctions.h"
 #include "mathFunctions.h"
@@ -9,21 +16,60 @@
 #include "input.h"
 #include "domain.h"
 #include "readInputFunctions.h"
+#include "fractureGrid.h"
 #include "logFile.h"
 
 using std::cout;
 using std::endl;
 using std::string;
 
+/*
+    User polygon files (PolygonByCoord_Input_File_Path) are ASCII:
+
+        nPolygons: <n>
+        <number of nodes> {x1, y1, z1} {x2, y2, z2} ...     (one line per polygon)
+
+    or binary, for large sets of polygons mapped from site data. Binary files are
+    mapped into memory (mmap) and used without parsing:
+
+        char magic[8] = "DFNPOLY\0\0", uint32 version = 1, uint32 reserved,
+        uint64 n, uint64 vertexStart[n + 1], f64 vertices[3 * vertexStart[n]]
+
+    Polygon i has the nodes vertexStart[i] to vertexStart[i + 1] - 1 (x, y, z of each
+    node), vertexStart[0] = 0. Values are in native byte order, as in dfn.bin (see
+    binaryOutput.cpp). With numpy, given an array of node counts and the nodes:
+        open(file, "wb").write(b"DFNPOLY\0\0" + np.array([1, 0], "<u4").tobytes()
+            + np.array([n], "<u8").tobytes() + np.concatenate(([0], np.cumsum(counts))).astype("<u8").tobytes()
+            + nodes.astype("<f8").tobytes())
+
+    Both formats are inserted the same way, see insertUserPolygonByCoord().
+*/
+
+static const char polygonMagic[8] = {'D', 'F', 'N', 'P', 'O', 'L', 'Y', 0};
+
+/*! Polygons read from a user polygon file. The nodes of polygon i are
+    vertices[3 * start[i]] to vertices[3 * start[i + 1] - 1]. */
+struct UserPolygons {
+    uint64_t n;
+    const uint64_t *start;
+    const double *vertices;
+    /*! Storage of ASCII files */
+    std::vector<uint64_t> startData;
+    std::vector<double> vertexData;
+    /*! Mapped binary file, NULL for ASCII files */
+    void *map;
+    size_t mapSize;
+};
+
 /**********************************************************************/
 /**********************************************************************/
 /*! Used to read in ellipse coordinates when the user is using
     user ellipses defined by coordinates option.
-    Arg 1: ifstream file object
+    Arg 1: Input file
     Arg 2: OUTPUT. Pointer to array to store the coordinates
     Arg 3: Number of ellipses
     Arg 4: Number of points per ellipse */
-void getPolyCoords(std::ifstream & stream, double *outAry, int nVertices) {
+void getPolyCoords(InputReader &stream, double *outAry, int nVertices) {
     char ch;
     
     for (int i = 0; i < nVertices; i++) {
@@ -33,140 +79,250 @@ void getPolyCoords(std::ifstream & stream, double *outAry, int nVertices) {
 }
 
 
+/**********************************************************************/
+/**********************************************************************/
+/*! Reads an ASCII user polygon file
+    Arg 1: Path to file
+    Arg 2: OUTPUT, polygons */
+static void readAsciiPolygons(std::string fileName, UserPolygons &polygons) {
+    unsigned int nPolygonByCoord;
+    unsigned int nPolyNodes;
+    InputReader file;
+    file.open(fileName.c_str());
+    checkIfOpen(file, fileName);
+    searchVar(file, "nPolygons:");
+    file >> nPolygonByCoord;
+    polygons.startData.assign(1, 0);
+    
+    for (unsigned int i = 0; i < nPolygonByCoord; i++) {
+        file >> nPolyNodes;
+        size_t first = polygons.vertexData.size();
+        polygons.vertexData.resize(first + 3 * nPolyNodes);
+        
+        if (nPolyNodes > 0) {
+            getPolyCoords(file, &polygons.vertexData[first], nPolyNodes);
+        }
+        
+        polygons.startData.push_back(polygons.startData.back() + nPolyNodes);
+    }
+    
+    file.close();
+    polygons.n = nPolygonByCoord;
+    polygons.start = polygons.startData.data();
+    polygons.vertices = polygons.vertexData.data();
+    polygons.map = NULL;
+    polygons.mapSize = 0;
+}
+
+
+/**********************************************************************/
+/**********************************************************************/
+/*! Logs an error in a binary user polygon file and throws DFNError
+    Arg 1: Path to file
+    Arg 2: Error message */
+static void binaryPolygonError(std::string fileName, std::string message) {
+    std::string logString = "ERROR: binary user polygon file " + fileName + ": " + message + "\n";
+    logger.writeLogFile(ERROR,  logString);
+    throw DFNError();
+}
+
+
+/**********************************************************************/
+/**********************************************************************/
+/*! Maps a binary user polygon file into memory
+    Arg 1: Path to file
+    Arg 2: OUTPUT, polygons
+    Return: False if the file is not a binary polygon file */
+static bool mapBinaryPolygons(std::string fileName, UserPolygons &polygons) {
+    int fd = open(fileName.c_str(), O_RDONLY);
+    
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat info;
+    char magic[8];
+    
+    if (fstat(fd, &info) != 0 || read(fd, magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, polygonMagic, sizeof(magic)) != 0) {
+        close(fd);
+        return false;
+    }
+    
+    uint64_t size = info.st_size;
+    
+    if (size < 24) {
+        close(fd);
+        binaryPolygonError(fileName, "file is truncated");
+    }
+    
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    
+    if (map == MAP_FAILED) {
+        binaryPolygonError(fileName, std::string("unable to map file: ") + strerror(errno));
+    }
+    
+    const char *data = (const char*) map;
+    uint32_t version;
+    uint64_t n;
+    memcpy(&version, data + 8, sizeof(version));
+    memcpy(&n, data + 16, sizeof(n));
+    
+    if (version != 1) {
+        binaryPolygonError(fileName, "unsupported version " + to_string(version));
+    }
+    
+    if (n > 0xFFFFFFFFULL || n + 1 > (size - 24) / sizeof(uint64_t)) {
+        binaryPolygonError(fileName, "file is truncated or has too many polygons");
+    }
+    
+    const uint64_t *start = (const uint64_t*) (data + 24);
+    uint64_t offset = 24 + (n + 1) * sizeof(uint64_t);
+    
+    if (start[0] != 0) {
+        binaryPolygonError(fileName, "vertexStart[0] must be 0");
+    }
+    
+    for (uint64_t i = 0; i < n; i++) {
+        if (start[i + 1] < start[i] || start[i + 1] - start[i] < 3) {
+            binaryPolygonError(fileName, "polygon " + to_string(i + 1) + " has less than 3 nodes");
+        }
+    }
+    
+    if (start[n] > (size - offset) / (3 * sizeof(double))) {
+        binaryPolygonError(fileName, "file is truncated");
+    }
+    
+    polygons.n = n;
+    polygons.start = start;
+    polygons.vertices = (const double*) (data + offset);
+    polygons.map = map;
+    polygons.mapSize = size;
+    return true;
+}
+
+
+/**********************************************************************/
+/**********************************************************************/
+/*! Creates a fracture from a user polygon: normal vector, radii and translation
+    estimated from the nodes, truncated to the domain.
+    Arg 1: OUTPUT, fracture
+    Arg 2: User polygons
+    Arg 3: Index of polygon
+    Return: True if the polygon is outside the domain */
+static bool createUserPolygon(Poly &newPoly, UserPolygons &polygons, uint64_t i) {
+    unsigned int nPolyNodes = polygons.start[i + 1] - polygons.start[i];
+    // file >> familyNum;
+    newPoly.familyNum = -3;
+    newPoly.numberOfNodes = nPolyNodes;
+    newPoly.vertices = new double[3 * nPolyNodes ]; // 3 * number of nodes
+    std::copy(polygons.vertices + 3 * polygons.start[i], polygons.vertices + 3 * polygons.start[i + 1], newPoly.vertices);
+    // Get a normal vector
+    // Vector from fist node to node across middle of polygon
+    int midPtIdx = 3 * (int) (nPolyNodes / 2);
+    
+    if (nPolyNodes == 3) {
+        midPtIdx = 8;
+    }
+    
+    double v1[3] = {newPoly.vertices[midPtIdx] - newPoly.vertices[0],
+                    newPoly.vertices[midPtIdx + 1] - newPoly.vertices[1],
+                    newPoly.vertices[midPtIdx + 2] - newPoly.vertices[2]
+                   };
+    // Vector from first node to 2nd node
+    double v2[3] = {newPoly.vertices[3] - newPoly.vertices[0],
+                    newPoly.vertices[4] - newPoly.vertices[1],
+                    newPoly.vertices[5] - newPoly.vertices[2]
+                   };
+    double *xProd1 = crossProduct(v2, v1);
+    // Set normal vector
+    newPoly.normal[0] = xProd1[0]; //x
+    newPoly.normal[1] = xProd1[1]; //y
+    newPoly.normal[2] = xProd1[2]; //z
+    normalize(newPoly.normal);
+    delete[] xProd1;
+    // Estimate radius
+    newPoly.xradius = 0.5 * magnitude(v2[0], v2[1], v2[2]); // across middle if even number of nodes
+    // across middle close to perpendicular to xradius magnitude calculation
+    int tempIdx1 = 3 * (int) (nPolyNodes / 4) ; // Get idx for node 1/4 around polygon
+    int tempIdx2 = 3 * (int) (3 * nPolyNodes / 4) ; // Get idx for node 1/4 around polygon
+    newPoly.yradius = 0.5 * euclideanDistance(&newPoly.vertices[tempIdx1], &newPoly.vertices[tempIdx2]);
+    newPoly.aspectRatio = newPoly.yradius / newPoly.xradius;
+    // Estimate translation (middle of poly)
+    // Use midpoint between 1st and and half way around polygon
+    // Note: For polygons defined by coordinates, the coordinates
+    // themselves provide the translation. We need to estimate the center
+    // of the polygon and init. the translation array
+    newPoly.translation[0] = .5 * (newPoly.vertices[0] + newPoly.vertices[midPtIdx]);
+    newPoly.translation[1] = .5 * (newPoly.vertices[1] + newPoly.vertices[midPtIdx + 1]);
+    newPoly.translation[2] = .5 * (newPoly.vertices[2] + newPoly.vertices[midPtIdx + 2]);
+    
+    if (domainTruncation(newPoly, params->domainSize) == 1) {
+        return true;
+    }
+    
+    createBoundingBox(newPoly);
+    return false;
+}
+
+
 /****************************************************************/
 /***********  Insert User Polygon By Coord  ********************/
 /*! Inserts user polygon using defined coordinates
-    provided by the user (see input file).
+    provided by the user (see input file and the file formats above).
     Intersection checking, FRAM, and rejection/acceptance are all contained
-    within this function.
+    within this function, see insertUserFractures().
     Arg 1: Array for all accepted polygons
     Arg 2: Array for all accepted intersections
     Arg 3: Program statistics structure
     Arg 4: Array of all triple intersection points */
 void insertUserPolygonByCoord(std::vector<Poly>& acceptedPoly, std::vector<IntPoints> &intpts, struct Stats &pstats, std::vector<Point> &triplePoints) {
-    unsigned int nPolygonByCoord;
-    unsigned int nPolyNodes;
-    //int familyNum;
-    std::string logString = "Domain Size " + to_string(domainSize[0]) + " " + to_string(domainSize[1]) + " " + to_string(domainSize[2]);
+    std::string logString = "Domain Size " + to_string(params->domainSize[0]) + " " + to_string(params->domainSize[1]) + " " + to_string(params->domainSize[2]);
     logger.writeLogFile(INFO,  logString);
-    logString = "Reading User Defined Polygons from " + polygonFile;
+    logString = "Reading User Defined Polygons from " + params->polygonFile;
     logger.writeLogFile(INFO,  logString);
-    std::ifstream file;
-    file.open(polygonFile.c_str(), std::ifstream::in);
-    checkIfOpen(file, polygonFile);
-    searchVar(file, "nPolygons:");
-    file >> nPolygonByCoord;
+    UserPolygons polygons;
+    
+    if (!mapBinaryPolygons(params->polygonFile, polygons)) {
+        readAsciiPolygons(params->polygonFile, polygons);
+    }
+    
+    unsigned int nPolygonByCoord = polygons.n;
     logString = "There are " + to_string(nPolygonByCoord) + " polygons\n";
     logger.writeLogFile(INFO,  logString);
-    acceptedPoly.reserve(nPolygonByCoord);
-    
-    for (unsigned int i = 0; i < nPolygonByCoord; i++) {
-        Poly newPoly;
-        RejectedUserFracture rejectedUserFracture;
-        // file >> familyNum;
-        newPoly.familyNum = -3;
-        file >> nPolyNodes;
-        //std::cout << "There are " << nPolyNodes <<" nodes in this polygon\n";
-        newPoly.numberOfNodes = nPolyNodes;
-        newPoly.vertices = new double[3 * nPolyNodes ]; // 3 * number of nodes
-        getPolyCoords(file, newPoly.vertices, nPolyNodes);
-        /*
-        int idx = 0;
-        for(unsigned int j = 0; j < nPolyNodes; j++){
-           idx = j*3;
-           std::cout << newPoly.vertices[idx] << " " << newPoly.vertices[idx+1] << " " << newPoly.vertices[idx+2] << "\n";
-        }
-        */
-        // Get a normal vector
-        // Vector from fist node to node across middle of polygon
-        int midPtIdx = 3 * (int) (nPolyNodes / 2);
-        
-        if (nPolyNodes == 3) {
-            midPtIdx = 8;
-        }
-        
-        double v1[3] = {newPoly.vertices[midPtIdx] - newPoly.vertices[0],
-                        newPoly.vertices[midPtIdx + 1] - newPoly.vertices[1],
-                        newPoly.vertices[midPtIdx + 2] - newPoly.vertices[2]
-                       };
-        // Vector from first node to 2nd node
-        double v2[3] = {newPoly.vertices[3] - newPoly.vertices[0],
-                        newPoly.vertices[4] - newPoly.vertices[1],
-                        newPoly.vertices[5] - newPoly.vertices[2]
-                       };
-        double *xProd1 = crossProduct(v2, v1);
-        // Set normal vector
-        newPoly.normal[0] = xProd1[0]; //x
-        newPoly.normal[1] = xProd1[1]; //y
-        newPoly.normal[2] = xProd1[2]; //z
-        normalize(newPoly.normal);
-        //std::cout << "Normal Vector " << newPoly.normal[0]<<" "<< newPoly.normal[1] << "  " << newPoly.normal[2] << "\n";
-        delete[] xProd1;
-        // Estimate radius
-        // std::cout << "estimating radius" << endl;
-        newPoly.xradius = 0.5 * magnitude(v2[0], v2[1], v2[2]); // across middle if even number of nodes
-        // across middle close to perpendicular to xradius magnitude calculation
-        int tempIdx1 = 3 * (int) (nPolyNodes / 4) ; // Get idx for node 1/4 around polygon
-        int tempIdx2 = 3 * (int) (3 * nPolyNodes / 4) ; // Get idx for node 1/4 around polygon
-        newPoly.yradius = 0.5 * euclideanDistance(&newPoly.vertices[tempIdx1], &newPoly.vertices[tempIdx2]);
-        newPoly.aspectRatio = newPoly.yradius / newPoly.xradius;
-        // Estimate translation (middle of poly)
-        // Use midpoint between 1st and and half way around polygon
-        // Note: For polygons defined by coordinates, the coordinates
-        // themselves provide the translation. We need to estimate the center
-        // of the polygon and init. the translation array
-        newPoly.translation[0] = .5 * (newPoly.vertices[0] + newPoly.vertices[midPtIdx]);
-        newPoly.translation[1] = .5 * (newPoly.vertices[1] + newPoly.vertices[midPtIdx + 1]);
-        newPoly.translation[2] = .5 * (newPoly.vertices[2] + newPoly.vertices[midPtIdx + 2]);
-        
-        if (domainTruncation(newPoly, domainSize) == 1) {
-            // Poly completely outside domain
-            pstats.rejectionReasons.outside++;
-            pstats.rejectedPolyCount++;
+    auto size = [&](unsigned int i) {
+        return nodeExtent(polygons.vertices + 3 * polygons.start[i], polygons.start[i + 1] - polygons.start[i]);
+    };
+    auto create = [&](Poly &newPoly, unsigned int i) {
+        return createUserPolygon(newPoly, polygons, i);
+    };
+    auto report = [&](Poly &newPoly, unsigned int i, int rejectCode) {
+        if (rejectCode == USER_FRACTURE_OUTSIDE) {
             logString = "User Polygon (defined by coordinates) " + to_string(i + 1) + " was rejected for being outside the defined domain.\n";
             logger.writeLogFile(ERROR,  logString);
+            unsigned int nPolyNodes = polygons.start[i + 1] - polygons.start[i];
             int idx = 0;
             
-            for(unsigned int j = 0; j < nPolyNodes; j++) {
+            for(unsigned int j = 0; j < nPolyNodes && logger.enabled(INFO); j++) {
                 idx = j * 3;
                 logString = to_string(newPoly.vertices[idx]) + " " + to_string(newPoly.vertices[idx + 1]) + " " + to_string(newPoly.vertices[idx + 2]) + "\n";
                 logger.writeLogFile(INFO,  logString);
             }
-            
-            rejectedUserFracture.id = i + 1;
-            rejectedUserFracture.userFractureType  = -3;
-            pstats.rejectedUserFracture.push_back(rejectedUserFracture);
-            delete[] newPoly.vertices;
-            continue; // Go to next poly (go to next iteration of for loop)
-        }
-        
-        createBoundingBox(newPoly);
-        // Line of intersection and FRAM
-        int rejectCode = intersectionChecking(newPoly, acceptedPoly, intpts, pstats, triplePoints);
-        
-        if(rejectCode == 0) {
-            // Incriment counter of accepted polys
-            pstats.acceptedPolyCount++;
-            // Calculate poly's area
-            newPoly.area = getArea(newPoly);
-            // Add new rejectsPerAttempt counter
-            pstats.rejectsPerAttempt.push_back(0);
-            logString = "User Defined Polygon Fracture (Defined By Coordinates) " + to_string((i + 1)) + " Accepted\n";
-            logger.writeLogFile(INFO,  logString);
-            acceptedPoly.push_back(newPoly); // Save newPoly to accepted polys list
-            //std::cout << "size of accepted Poly " << acceptedPoly.size() << std::endl;
-        } else  {
-            delete[] newPoly.vertices; // Need to delete manually, created with new[]
-            pstats.rejectsPerAttempt[pstats.acceptedPolyCount]++;
-            pstats.rejectedPolyCount++;
+        } else if (rejectCode == 0) {
+            if (logger.enabled(INFO)) {
+                logString = "User Defined Polygon Fracture (Defined By Coordinates) " + to_string((i + 1)) + " Accepted\n";
+                logger.writeLogFile(INFO,  logString);
+            }
+        } else {
             logString = "Rejected User Defined Polygon Fracture (Defined By Coordinates) " + to_string(i + 1) + "\n";
             logger.writeLogFile(INFO,  logString);
             printRejectReason(rejectCode, newPoly);
-            rejectedUserFracture.id = i + 1;
-            rejectedUserFracture.userFractureType  = -3;
-            pstats.rejectedUserFracture.push_back(rejectedUserFracture);
         }
-    }
+    };
+    insertUserFractures(nPolygonByCoord, size, create, report, acceptedPoly, intpts, pstats, triplePoints);
     
-    file.close();
+    if (polygons.map != NULL) {
+        munmap(polygons.map, polygons.mapSize);
+    }
 }
+
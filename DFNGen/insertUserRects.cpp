@@ -7,6 +7,7 @@
 #include "structures.h"
 #include "input.h"
 #include "domain.h"
+#include "fractureGrid.h"
 #include "testing.h"
 #include "logFile.h"
 
@@ -15,32 +16,33 @@
 /********************  Insert User Rectangles  *************************/
 /*! Inserts a user defined rectangle into the domain
     Intersection checking, FRAM, and rejection/accptance is all contained
-    within this function.
+    within this function, see insertUserFractures().
     Arg 1: Array for all accepted polygons
     Arg 2: Array for all accepted intersections
     Arg 3: Program statistics structure
     Arg 4: Array of all triple intersection points */
 void insertUserRects(std::vector<Poly>& acceptedPoly, std::vector<IntPoints> &intpts, struct Stats &pstats, std::vector<Point> &triplePoints)  {
-    std::string logString = to_string(nUserRect) + " User Rectangles Defined\n";
+    std::string logString = to_string(params->nUserRect) + " User Rectangles Defined\n";
     logger.writeLogFile(INFO,  logString);
     
-    for (int i = 0; i < nUserRect; i++) {
-        Poly newPoly;
-        RejectedUserFracture rejectedUserFracture;
+    auto size = [&](unsigned int i) {
+        return 2 * params->urRadii[i] * std::sqrt(1 + params->uraspect[i] * params->uraspect[i]);
+    };
+    auto create = [&](Poly &newPoly, unsigned int i) {
         newPoly.familyNum = -2; // Using -2 for all user specified rectangles
         newPoly.vertices = new double[12]; // 4*{x,y,z}
         // Set number of nodes. Needed for rotations.
         newPoly.numberOfNodes = 4;
         int index = i * 3; // Index to start of vertices/nodes
         // initializeRectVertices() sets newpoly.xradius, newpoly.yradius, newpoly.aperture
-        initializeRectVertices(newPoly, urRadii[i], uraspect[i]);
+        initializeRectVertices(newPoly, params->urRadii[i], params->uraspect[i]);
         // Convert angle to rad if necessary
-        float angle = urBeta[i];
+        float angle = params->urBeta[i];
         
-        if (urAngleOption == 1 ) {
-            angle = urBeta[i] * M_PI / 180;
+        if (params->urAngleOption == 1 ) {
+            angle = params->urBeta[i] * M_PI / 180;
         } else {
-            angle = urBeta[i];
+            angle = params->urBeta[i];
         }
         
         // Initialize normal to {0,0,1}. need initialized for 3D rotation
@@ -52,69 +54,48 @@ void insertUserRects(std::vector<Poly>& acceptedPoly, std::vector<IntPoints> &in
         // Angle must be in rad
         applyRotation2D(newPoly, angle);
         // Rotate into 3D from poly.normal to "urnormal", new normal
-        normalize(&urnormal[index]);
+        normalize(&params->urnormal[index]);
         // Rotate vertices to urnormal[index] (new normal)
-        applyRotation3D(newPoly, &urnormal[index]);
+        applyRotation3D(newPoly, &params->urnormal[index]);
         // Save newPoly's new normal vector
-        newPoly.normal[0] = urnormal[index];
-        newPoly.normal[1] = urnormal[index + 1];
-        newPoly.normal[2] = urnormal[index + 2];
+        newPoly.normal[0] = params->urnormal[index];
+        newPoly.normal[1] = params->urnormal[index + 1];
+        newPoly.normal[2] = params->urnormal[index + 2];
         // Translate newPoly to urtranslation
-        translate(newPoly, &urtranslation[index]);
+        translate(newPoly, &params->urtranslation[index]);
         
-        if (domainTruncation(newPoly, domainSize) == 1) {
+        if (domainTruncation(newPoly, params->domainSize) == 1) {
             //poly completely outside domain
-            delete[] newPoly.vertices;
-            pstats.rejectionReasons.outside++;
-            pstats.rejectedPolyCount++;
-            logString = "User Rectangle " + to_string( i + 1) + " was rejected for being outside the defined domain.\n";
-            logger.writeLogFile(ERROR,  logString);
-            rejectedUserFracture.id = i + 1;
-            rejectedUserFracture.userFractureType  = -2;
-            pstats.rejectedUserFracture.push_back(rejectedUserFracture);
-            continue; // Go to next poly (go to next iteration of for loop)
+            return true;
         }
         
         createBoundingBox(newPoly);
-        // Line of intersection and FRAM
-        int rejectCode = intersectionChecking(newPoly, acceptedPoly, intpts, pstats, triplePoints);
-        
-        if(rejectCode == 0) {
+        return false;
+    };
+    auto report = [&](Poly &newPoly, unsigned int i, int rejectCode) {
+        if (rejectCode == USER_FRACTURE_OUTSIDE) {
+            logString = "User Rectangle " + to_string( i + 1) + " was rejected for being outside the defined domain.\n";
+            logger.writeLogFile(ERROR,  logString);
+        } else if (rejectCode == 0) {
             // If intersection is ok
             if (newPoly.truncated == 1) {
                 pstats.truncated++;
             }
             
-            // Incriment counter of accepted polys
-            pstats.acceptedPolyCount++;
-            // Calculate poly's area
-            newPoly.area = getArea(newPoly);
-            // Add new rejectsPerAttempt counter
-            pstats.rejectsPerAttempt.push_back(0);
-            logString = "User Defined Rectangular Fracture " + to_string(i + 1) + " Accepted\n";
-            logger.writeLogFile(INFO,  logString);
-            acceptedPoly.push_back(newPoly); // Save newPoly to accepted polys list
+            if (logger.enabled(INFO)) {
+                logString = "User Defined Rectangular Fracture " + to_string(i + 1) + " Accepted\n";
+                logger.writeLogFile(INFO,  logString);
+            }
         } else {
-            delete[] newPoly.vertices; // Delete manually, created with new[]
-            pstats.rejectedPolyCount++;
-            pstats.rejectsPerAttempt[pstats.acceptedPolyCount]++;
             logString = "Rejected user defined rectangular fracture " + to_string(i + 1) + "\n";
             logger.writeLogFile(ERROR,  logString);
             printRejectReason(rejectCode, newPoly);
-            rejectedUserFracture.id = i + 1;
-            rejectedUserFracture.userFractureType  = -2;
-            pstats.rejectedUserFracture.push_back(rejectedUserFracture);
 #ifdef TESTING
-            exit(1);
+            throw DFNError();
 #endif
         }
-    }//end loop
-    
-    delete[] urRadii;
-    delete[] uraspect;
-    delete[] urBeta;
-    delete[] urtranslation;
-    delete[] urnormal;
+    };
+    insertUserFractures(params->nUserRect, size, create, report, acceptedPoly, intpts, pstats, triplePoints);
 }
 
 
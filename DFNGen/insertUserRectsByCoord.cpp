@@ -8,6 +8,7 @@
 #include "structures.h"
 #include "input.h"
 #include "domain.h"
+#include "fractureGrid.h"
 #include "logFile.h"
 
 /*************************************************************/
@@ -15,18 +16,19 @@
 /*! Inserts user rectangles using defined coordinates
     provided by the user (see input file).
     Intersection checking, FRAM, and rejection/accptance are all contained
-    within this function.
+    within this function, see insertUserFractures().
     Arg 1: Array for all accepted polygons
     Arg 2: Array for all accepted intersections
     Arg 3: Program statistics structure
     Arg 4: Array of all triple intersection points */
 void insertUserRectsByCoord(std::vector<Poly>& acceptedPoly, std::vector<IntPoints> &intpts, struct Stats &pstats, std::vector<Point> &triplePoints) {
-    std::string logString = to_string(nRectByCoord) + " User Rectangles By Coordinates Defined\n\n";
+    std::string logString = to_string(params->nRectByCoord) + " User Rectangles By Coordinates Defined\n\n";
     logger.writeLogFile(INFO,  logString);
     
-    for (unsigned int i = 0; i < nRectByCoord; i++) {
-        Poly newPoly;
-        RejectedUserFracture rejectedUserFracture;
+    auto size = [&](unsigned int i) {
+        return nodeExtent(&params->userRectCoordVertices[i * 12], 4);
+    };
+    auto create = [&](Poly &newPoly, unsigned int i) {
         newPoly.familyNum = -2; // Using -2 for all user specified rectangles
         newPoly.vertices = new double[12]; // 4 * {x,y,z}
         // Set number of nodes  - needed for rotations
@@ -36,9 +38,9 @@ void insertUserRectsByCoord(std::vector<Poly>& acceptedPoly, std::vector<IntPoin
         // Initialize vertices
         for (int j = 0; j < 4; j++) {
             int vIdx = j * 3;
-            newPoly.vertices[vIdx] = userRectCoordVertices[polyVertIdx + vIdx];
-            newPoly.vertices[vIdx + 1] = userRectCoordVertices[polyVertIdx + 1 + vIdx];
-            newPoly.vertices[vIdx + 2] = userRectCoordVertices[polyVertIdx + 2 + vIdx];
+            newPoly.vertices[vIdx] = params->userRectCoordVertices[polyVertIdx + vIdx];
+            newPoly.vertices[vIdx + 1] = params->userRectCoordVertices[polyVertIdx + 1 + vIdx];
+            newPoly.vertices[vIdx + 2] = params->userRectCoordVertices[polyVertIdx + 2 + vIdx];
         }
         
         // Check that rectangle lays one a single plane:
@@ -98,51 +100,34 @@ void insertUserRectsByCoord(std::vector<Poly>& acceptedPoly, std::vector<IntPoin
         newPoly.translation[1] = .5 * (newPoly.vertices[1] + newPoly.vertices[7]);
         newPoly.translation[2] = .5 * (newPoly.vertices[2] + newPoly.vertices[8]);
         
-        if (domainTruncation(newPoly, domainSize) == 1) {
+        if (domainTruncation(newPoly, params->domainSize) == 1) {
             // Poly completely outside domain
-            delete[] newPoly.vertices;
-            pstats.rejectionReasons.outside++;
-            pstats.rejectedPolyCount++;
-            logString = "User Rectangle (defined by coordinates) " + to_string(i + 1) + " was rejected for being outside the defined domain.\n";
-            logger.writeLogFile(ERROR,  logString);
-            rejectedUserFracture.id = i + 1;
-            rejectedUserFracture.userFractureType  = -2;
-            pstats.rejectedUserFracture.push_back(rejectedUserFracture);
-            continue; // Go to next poly (go to next iteration of for loop)
+            return true;
         }
         
         createBoundingBox(newPoly);
-        // Line of intersection and FRAM
-        int rejectCode = intersectionChecking(newPoly, acceptedPoly, intpts, pstats, triplePoints);
-        
-        if(rejectCode == 0) {
+        return false;
+    };
+    auto report = [&](Poly &newPoly, unsigned int i, int rejectCode) {
+        if (rejectCode == USER_FRACTURE_OUTSIDE) {
+            logString = "User Rectangle (defined by coordinates) " + to_string(i + 1) + " was rejected for being outside the defined domain.\n";
+            logger.writeLogFile(ERROR,  logString);
+        } else if (rejectCode == 0) {
             // If intersection is ok (FRAM passed all tests)
             if (newPoly.truncated == 1) {
                 pstats.truncated++;
             }
             
-            // Incriment counter of accepted polys
-            pstats.acceptedPolyCount++;
-            // Calculate poly's area
-            newPoly.area = getArea(newPoly);
-            // Add new rejectsPerAttempt counter
-            pstats.rejectsPerAttempt.push_back(0);
-            logString = "User Defined Rectangular Fracture (Defined By Coordinates) " + to_string(i + 1) + " Accepted\n";
-            logger.writeLogFile(INFO,  logString);
-            acceptedPoly.push_back(newPoly); // Save newPoly to accepted polys list
+            if (logger.enabled(INFO)) {
+                logString = "User Defined Rectangular Fracture (Defined By Coordinates) " + to_string(i + 1) + " Accepted\n";
+                logger.writeLogFile(INFO,  logString);
+            }
         } else {
-            delete[] newPoly.vertices; // Need to delete manually, created with new[]
-            pstats.rejectsPerAttempt[pstats.acceptedPolyCount]++;
-            pstats.rejectedPolyCount++;
             logString = "Rejected User Defined Rectangular Fracture (Defined By Coordinates) " + to_string(i + 1) + "\n";
             logger.writeLogFile(ERROR,  logString);
             printRejectReason(rejectCode, newPoly);
-            rejectedUserFracture.id = i + 1;
-            rejectedUserFracture.userFractureType  = -2;
-            pstats.rejectedUserFracture.push_back(rejectedUserFracture);
         }
-    } // End loop
-    
-    delete[] userRectCoordVertices;
+    };
+    insertUserFractures(params->nRectByCoord, size, create, report, acceptedPoly, intpts, pstats, triplePoints);
 }
 
@@ -5,17 +5,32 @@
 #include <iostream>
 #include <sstream>
 #include <stdio.h>
+#include <stdlib.h>
 #include <cstring>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
 using namespace std;
 
 // Enum to represent log levels
 enum LogLevel { DEBUG, INFO, WARNING, ERROR, CRITICAL };
 
+// Messages are queued by the calling thread and written to the console and the log
+// file by a background thread, which flushes the file once per batch. Shared by DFNGen
+// and CPP_correct_volumes.
+// Messages below the level threshold are dropped by writeLogFile(). On hot paths, check
+// enabled() first so that the message is not built when it would be dropped.
+// Runtime settings (environment variables, or setLevel() / setSynchronous()):
+//     DFN_LOG_LEVEL=DEBUG|INFO|WARNING|ERROR|CRITICAL  drop messages below this level
+//     DFN_LOG_SYNC=1  write and flush every message in the calling thread (crash debugging)
 class Logger {
   public:
-    // Constructor: Opens the log file in append mode
-    Logger(const string& filename) {
+    // Constructor: Opens the log file in append mode. Log file lines start with a
+    // timestamp unless timestamps is false.
+    Logger(const string& filename, bool timestamps = true) : head(&stub), tail(&stub), pending(0), running(false), lastTime(0) {
         ifstream f(filename.c_str());
         
         if (f.good() == 1) {
@@ -29,61 +44,277 @@ class Logger {
         if (!logFile.is_open()) {
             cerr << "Error opening log file." << endl;
         }
+        
+        stub.next.store(NULL);
+        writeTimestamps = timestamps;
+        threshold = DEBUG;
+        synchronous = false;
+        const char *env = getenv("DFN_LOG_LEVEL");
+        
+        if (env != NULL) {
+            threshold = stringToLevel(env);
+        }
+        
+        env = getenv("DFN_LOG_SYNC");
+        
+        if (env == NULL || atoi(env) == 0) {
+            startWriter();
+        } else {
+            synchronous = true;
+        }
     }
     
-    // Destructor: Closes the log file
+    // Destructor: Writes queued messages and closes the log file
     ~Logger() {
+        stopWriter();
         logFile.close();
     }
     
+    // True if messages of level are written, i.e. not below the threshold
+    bool enabled(LogLevel level) const {
+        return level >= threshold;
+    }
+    
     // Logs a message with a given log level
     void writeLogFile(LogLevel level, const string& message) {
-        // Get current timestamp
-        time_t now = time(0);
-        tm* timeinfo = localtime(&now);
-        char timestamp[20];
-        strftime(timestamp, sizeof(timestamp),
-                 "%Y-%m-%d %H:%M:%S", timeinfo);
-        // Create log entry
-        ostringstream logEntry;
-        logEntry << "[" << timestamp << "] "
-                 << levelToString(level) << ": " << message;
-        // << endl;
+        if (level < threshold) {
+            return;
+        }
+        
+        if (synchronous) {
+            lock_guard<mutex> lock(drainMutex);
+            writeEntry(level, time(0), message);
+            cout.flush();
+            logFile.flush(); // Ensure immediate write to file
+            return;
+        }
+        
+        Entry *entry = new Entry;
+        entry->level = level;
+        entry->time = time(0);
+        entry->message = message;
+        unsigned int queued = ++pending;
+        push(entry);
+        
+        if (level == CRITICAL) {
+            flush();
+        } else if (queued >= batchSize) {
+            wake.notify_one();
+        }
+    }
+    
+    // Messages below level are dropped
+    void setLevel(LogLevel level) {
+        threshold = level;
+    }
+    
+    // Synchronous mode writes every message before writeLogFile() returns
+    void setSynchronous(bool sync) {
+        if (sync && !synchronous) {
+            stopWriter();
+            synchronous = true;
+        } else if (!sync && synchronous) {
+            synchronous = false;
+            startWriter();
+        }
+    }
+    
+    // True if messages are written in the calling thread
+    bool isSynchronous() {
+        return synchronous;
+    }
+    
+    // Writes all queued messages
+    void flush() {
+        drain();
+    }
+    
+    // Writes all queued messages, then continues logging to a new file (replaced if it exists)
+    void reopen(const string& filename) {
+        drain();
+        lock_guard<mutex> lock(drainMutex);
+        logFile.close();
+        logFile.open(filename, ios::out | ios::trunc);
+        
+        if (!logFile.is_open()) {
+            cerr << "Error opening log file." << endl;
+        }
+    }
+  
+  private:
+    // Queued message, node of the multiple producer single consumer queue
+    struct Entry {
+        atomic<Entry*> next;
+        LogLevel level;
+        time_t time;
+        string message;
+    };
+    
+    static const unsigned int batchSize = 4096;
+    
+    ofstream logFile; // File stream for the log file
+    LogLevel threshold;
+    bool synchronous;
+    bool writeTimestamps;
+    // Lock-free queue: producers exchange head, the single consumer (under drainMutex) walks from tail
+    Entry stub;
+    atomic<Entry*> head;
+    Entry *tail;
+    atomic<unsigned int> pending;
+    // Background writer
+    thread writer;
+    bool running;
+    mutex wakeMutex;
+    condition_variable wake;
+    mutex drainMutex;
+    // Formatted timestamp of lastTime, entries logged within the same second reuse it
+    time_t lastTime;
+    char timestamp[20];
+    
+    void push(Entry *entry) {
+        entry->next.store(NULL, memory_order_relaxed);
+        Entry *prev = head.exchange(entry, memory_order_acq_rel);
+        prev->next.store(entry, memory_order_release);
+    }
+    
+    // Returns the oldest queued entry, NULL if the queue is empty or a push is in progress
+    Entry *pop() {
+        Entry *t = tail;
+        Entry *next = t->next.load(memory_order_acquire);
+        
+        if (t == &stub) {
+            if (next == NULL) {
+                return NULL;
+            }
+            
+            tail = next;
+            t = next;
+            next = next->next.load(memory_order_acquire);
+        }
+        
+        if (next != NULL) {
+            tail = next;
+            return t;
+        }
+        
+        if (t != head.load(memory_order_acquire)) {
+            return NULL;
+        }
+        
+        push(&stub);
+        next = t->next.load(memory_order_acquire);
+        
+        if (next != NULL) {
+            tail = next;
+            return t;
+        }
+        
+        return NULL;
+    }
+    
+    void drain() {
+        lock_guard<mutex> lock(drainMutex);
+        Entry *entry;
+        bool written = false;
+        
+        while ((entry = pop()) != NULL) {
+            writeEntry(entry->level, entry->time, entry->message);
+            delete entry;
+            pending--;
+            written = true;
+        }
+        
+        if (written) {
+            cout.flush();
+            logFile.flush();
+        }
+    }
+    
+    void writeEntry(LogLevel level, time_t now, const string& message) {
+        if (writeTimestamps && now != lastTime) {
+            tm* timeinfo = localtime(&now);
+            strftime(timestamp, sizeof(timestamp),
+                     "%Y-%m-%d %H:%M:%S", timeinfo);
+            lastTime = now;
+        }
+        
         // Output to console
-        // cout << logEntry.str();
-        cout << message; // << endl;
+        cout << message;
         
         // Output to log file
         if (logFile.is_open()) {
-            logFile << logEntry.str();
-            logFile
-            .flush(); // Ensure immediate write to file
+            if (writeTimestamps) {
+                logFile << "[" << timestamp << "] ";
+            }
+            
+            logFile << levelToString(level) << ": " << message;
         }
     }
     
-  private:
-    ofstream logFile; // File stream for the log file
+    void startWriter() {
+        running = true;
+        writer = thread(&Logger::writerLoop, this);
+    }
+    
+    void stopWriter() {
+        if (writer.joinable()) {
+            {
+                lock_guard<mutex> lock(wakeMutex);
+                running = false;
+            }
+            wake.notify_one();
+            writer.join();
+        }
+        
+        drain();
+    }
+    
+    void writerLoop() {
+        unique_lock<mutex> lock(wakeMutex);
+        
+        while (running) {
+            wake.wait_for(lock, chrono::milliseconds(100));
+            lock.unlock();
+            drain();
+            lock.lock();
+        }
+    }
     
     // Converts log level to a string for output
     string levelToString(LogLevel level) {
         switch (level) {
         case DEBUG:
             return "DEBUG";
-            
+        
         case INFO:
             return "INFO";
-            
+        
         case WARNING:
             return "WARNING";
-            
+        
         case ERROR:
             return "ERROR";
-            
+        
         case CRITICAL:
             return "CRITICAL";
-            
+        
         default:
             return "UNKNOWN";
         }
     }
+    
+    // Converts level name to log level, unknown names keep all messages
+    LogLevel stringToLevel(const char *name) {
+        if (strcmp(name, "INFO") == 0) {
+            return INFO;
+        } else if (strcmp(name, "WARNING") == 0) {
+            return WARNING;
+        } else if (strcmp(name, "ERROR") == 0) {
+            return ERROR;
+        } else if (strcmp(name, "CRITICAL") == 0) {
+            return CRITICAL;
+        }
+        
+        return DEBUG;
+    }
 };
@@ -101,6 +101,55 @@ int* sortedIndex(const double *v, int n) {
     return idx;
 }
 
+/******************************************************************/
+/*! Area of the triangle 'insidePt', vertex a, vertex b of a polygon,
+    .5 * magnitude of the cross product of the vectors from 'insidePt'
+    Arg 1: Polygon vertices
+    Arg 2: Point inside the polygon
+    Arg 3: Index of first vertex (vertex number * 3)
+    Arg 4: Index of second vertex (vertex number * 3)
+    Return: Area of triangle */
+static inline double triangleArea(const double *vertices, const double *insidePt, int a, int b) {
+    double v1[3] = {vertices[a] - insidePt[0], vertices[a + 1] - insidePt[1], vertices[a + 2] - insidePt[2]};
+    double v2[3] = {vertices[b] - insidePt[0], vertices[b + 1] - insidePt[1], vertices[b + 2] - insidePt[2]};
+    // Cross product, as crossProduct() without allocating the result
+    double xProd[3] = {v1[1] * v2[2] - v1[2] * v2[1], v1[2] * v2[0] - v1[0] * v2[2], v1[0] * v2[1] - v1[1] * v2[0]};
+    return .5 * magnitude(xProd[0], xProd[1], xProd[2]);
+}
+
+
+/******************************************************************/
+/*! getArea() for a polygon with N vertices, 0 for any number. With
+    a fixed number the loop over the triangles is unrolled. */
+template <int N>
+static double getAreaKernel(const Poly &poly) {
+    const int nNodes = N > 0 ? N : poly.numberOfNodes;
+    const double *vertices = poly.vertices;
+    
+    if (nNodes == 3) { //area = 1/2 mag of xProd
+        return triangleArea(vertices, vertices, 3, 6);
+    }
+    
+    // More than 3 vertices
+    double polyArea = 0; // For summing area over trianlges of polygon
+    // Get coordinate within polygon
+    double insidePt[3];
+    int idxAcross = nNodes / 2 * 3;
+    insidePt[0] = vertices[0] + (.5 * (vertices[idxAcross] - vertices[0])); //x
+    insidePt[1] = vertices[1] + (.5 * (vertices[idxAcross + 1] - vertices[1])); //y
+    insidePt[2] = vertices[2] + (.5 * (vertices[idxAcross + 2] - vertices[2])); //z
+    
+    for (int i = 0; i < nNodes - 1; i++) {
+        int idx = i * 3;
+        polyArea += triangleArea(vertices, insidePt, idx, idx + 3); // Accumulate area
+    }
+    
+    // Last portion of polygon, insidePt to first vertice and insidePt to last vertice
+    polyArea += triangleArea(vertices, insidePt, 0, 3 * (nNodes - 1));
+    return polyArea;
+}
+
+
 /******************************************************************/
 /********************  Get Poly's Area  ***************************/
 /*! Calculate exact area of polygon (after truncation)
@@ -112,41 +161,21 @@ int* sortedIndex(const double *v, int n) {
     Arg 1: Polygon
     Return: Area of polygon */
 double getArea(struct Poly &poly) {
-    if (poly.numberOfNodes == 3) { //area = 1/2 mag of xProd
-        double v1[3] = {poly.vertices[3] - poly.vertices[0], poly.vertices[4] - poly.vertices[1], poly.vertices[5] - poly.vertices[2]};
-        double v2[3] = {poly.vertices[6] - poly.vertices[0], poly.vertices[7] - poly.vertices[1], poly.vertices[8] - poly.vertices[2]};
-        double *xProd = crossProduct(v1, v2);
-        double area = .5 * magnitude(xProd[0], xProd[1], xProd[2]);
-        delete[] xProd;
-        return area;
-    } else { // More than 3 vertices
-        double polyArea = 0; // For summing area over trianlges of polygon
-        // Get coordinate within polygon
-        double insidePt[3];
-        int idxAcross = poly.numberOfNodes / 2 * 3;
-        insidePt[0] = poly.vertices[0] + (.5 * (poly.vertices[idxAcross] - poly.vertices[0])); //x
-        insidePt[1] = poly.vertices[1] + (.5 * (poly.vertices[idxAcross + 1] - poly.vertices[1])); //y
-        insidePt[2] = poly.vertices[2] + (.5 * (poly.vertices[idxAcross + 2] - poly.vertices[2])); //z
-        
-        for (int i = 0; i < poly.numberOfNodes - 1; i++) {
-            int idx = i * 3;
-            double v1[3] = {poly.vertices[idx] - insidePt[0], poly.vertices[idx + 1] - insidePt[1], poly.vertices[idx + 2] - insidePt[2]};
-            double v2[3] = {poly.vertices[idx + 3] - insidePt[0], poly.vertices[idx + 4] - insidePt[1], poly.vertices[idx + 5] - insidePt[2]};
-            double *xProd = crossProduct(v1, v2);
-            double area = .5 * magnitude(xProd[0], xProd[1], xProd[2]);
-            delete[] xProd;
-            polyArea += area; // Accumulate area
-        }
-        
-        // Last portion of polygon, insidePt to first vertice and insidePt to last vertice
-        int last = 3 * (poly.numberOfNodes - 1);
-        double v1[3] = {poly.vertices[0] - insidePt[0], poly.vertices[1] - insidePt[1], poly.vertices[2] - insidePt[2]};
-        double v2[3] = {poly.vertices[last] - insidePt[0], poly.vertices[last + 1] - insidePt[1], poly.vertices[last + 2] - insidePt[2]};
-        double *xProd = crossProduct(v1, v2);
-        double area = .5 * magnitude(xProd[0], xProd[1], xProd[2]);
-        delete[] xProd;
-        polyArea += area; // Accumulate area
-        return polyArea;
+    switch (poly.numberOfNodes) {
+    case 4:
+        return getAreaKernel<4>(poly);
+    
+    case 8:
+        return getAreaKernel<8>(poly);
+    
+    case 12:
+        return getAreaKernel<12>(poly);
+    
+    case 16:
+        return getAreaKernel<16>(poly);
+    
+    default:
+        return getAreaKernel<0>(poly);
     }
 }
 
@@ -194,9 +223,9 @@ int indexFromProb_and_P32Status(float *CDF, double roll, int famSize, int cdfSiz
     int count = 0; // Count of families encountered with p32Status = 0
     
     for (int i = 0; i < famSize; i++) {
-        if (cdfIdx == count && p32Status[i] == 0) {
+        if (cdfIdx == count && params->p32Status[i] == 0) {
             return i; // Returns family index we need to build poly with.
-        } else if (p32Status[i] == 0) {
+        } else if (params->p32Status[i] == 0) {
             count++; // Count number of 0's ( number of families not having met their p32 req. )
         }
     }
@@ -214,7 +243,7 @@ int indexFromProb_and_P32Status(float *CDF, double roll, int famSize, int cdfSiz
     Arg 2: p32Status array
     Arg 3: Family index of family whos CDF index to return
     Return: Index of CDF which belongs to shapeFamily[famIdx] */
-int cdfIdxFromFamNum(float *CDF, bool *p32Status, int famIdx) {
+int cdfIdxFromFamNum(float *CDF, std::vector<bool> &p32Status, int famIdx) {
     int idx = -1;
     // The CDF array only contains elements for families who have not
     // met their P32 requirenment (p32 option)
@@ -237,7 +266,7 @@ int cdfIdxFromFamNum(float *CDF, bool *p32Status, int famIdx) {
 /*! Creates CDF from famProb[]
     Arg 1: Pointer to famProb array (see input file, and readInput())
     Arg 2: Size of array */
-float *createCDF(float *famProb, int size) {
+float *createCDF(std::vector<float> &famProb, int size) {
     // Convert famProb to CDF
     float *CDF = new float[size];
     CDF[0] = famProb[0];
@@ -263,9 +292,9 @@ float *createCDF(float *famProb, int size) {
     Arg 2: Pointer to famProb array
     Arg 3: Number of elements in CDF array
     Arg 4: Index to the element in the famProb array which is being removed */
-void adjustCDF_and_famProb(float *&CDF, float *&famProbability, int &cdfSize, int idx2Remove) {
+void adjustCDF_and_famProb(float *&CDF, std::vector<float> &famProbability, int &cdfSize, int idx2Remove) {
     cdfSize--;
-    float *newProbs = new float[cdfSize];
+    std::vector<float> newProbs(cdfSize);
     // Adjust probabilities, remove element while keeping the rest of probabilities in proportion
     // Take probability of the familiy being removed, and divide it equally among remaining probabilities
     float addToRemainingElmts = famProbability[idx2Remove] / cdfSize; // Distribute removed probability among leftore famillies probabilities
@@ -281,7 +310,6 @@ void adjustCDF_and_famProb(float *&CDF, float *&famProbability, int &cdfSize, in
         }
     }
     
-    delete[] famProbability; // Delete old prob array
     famProbability = newProbs; // Assign famProbability array to new probabilities array
     delete[] CDF; // Delete old CDF array
     CDF = createCDF(famProbability, cdfSize); // Create new CDF array
@@ -1,5 +1,6 @@
 #ifndef _MATHFUNCTIONS_H_
 #define _MATHFUNCTIONS_H_
+#include <vector>
 
 double sumDeviation(const double *data, int n);
 double *sumDevAry3(double *data);
@@ -8,10 +9,10 @@ int *sortedIndex(const double *arr, int n);
 double getArea(struct Poly &poly);
 int indexFromProb(float *CDF, double roll, int size);
 int indexFromProb_and_P32Status(float *CDF, double roll, int famSize, int cdfSize, int &cdfIdx);
-void adjustCDF_and_famProb(float *&CDF, float *&famProbability, int &cdfSize, int idx2Remove);
-float *createCDF(float *famProb, int size);
+void adjustCDF_and_famProb(float *&CDF, std::vector<float> &famProbability, int &cdfSize, int idx2Remove);
+float *createCDF(std::vector<float> &famProb, int size);
 float truncatedPowerLaw(float randomNum, float emin, float emax, float alpha);
-int cdfIdxFromFamNum(float *CDF, bool *p32Status, int famIdx);
+int cdfIdxFromFamNum(float *CDF, std::vector<bool> &p32Status, int famIdx);
 
 /****************************************************/
 /*! Used for ORing arrays of bool for boundary face codes
@@ -13,9 +13,15 @@
 #include <cmath>
 #include <sys/stat.h> // Checking if output directory exists DIR_exists(dir)
 #include <iomanip> // std::setprecision()
+#include <cstdio> // snprintf()
+#include <thread>
+#include <atomic>
 #include <sys/stat.h> // mkdir system call 
 #include "readInputFunctions.h" // error check for file open checkIfOpen()
 #include "logFile.h"
+#include "binaryOutput.h"
+#include "ecpm.h"
+#include "profile.h"
 
 //NOTE: do not use std::endl for new lines when writing to files. This will flush the output buffer. Use '\n'
 
@@ -29,7 +35,7 @@
     Arg 6: std::vector of unsigned int - indices into the Poly array of accepted polgons
            which remain after isolated fractures (polys) were removed
     Arg 7: std::vector Shape - Family structure array  of all stocastic families defined by user input */
-void writeOutput(char* outputFolder, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints, struct Stats &pstats, std::vector<unsigned int> &finalFractures, std::vector<Shape> &shapeFamilies) {
+void writeOutput(const char *outputFolder, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints, struct Stats &pstats, std::vector<unsigned int> &finalFractures, std::vector<Shape> &shapeFamilies) {
     std::string output = outputFolder;
     std::string dfnGenExtension = "/dfnGen_output";
     output += dfnGenExtension;
@@ -43,45 +49,57 @@ void writeOutput(char* outputFolder, std::vector<Poly> &acceptedPoly, std::vecto
     // Adjust Fracture numbering
     adjustIntFractIDs(finalFractures, acceptedPoly, intPts);
     // Write out graph information
-    writeGraphData(finalFractures, acceptedPoly, intPts);
+    PROFILE_CALL(PROF_WRITE_GRAPH, writeGraphData(finalFractures, acceptedPoly, intPts, output));
     // Write polygon.dat file
-    writePolys(finalFractures, acceptedPoly, output);
+    PROFILE_CALL(PROF_WRITE_POLYS, writePolys(finalFractures, acceptedPoly, output));
+    
+    // Write dfn.bin (must be before writeIntersectionFiles(), polys are not rotated yet)
+    if (params->binaryOutput) {
+        PROFILE_CALL(PROF_WRITE_BINARY, writeBinaryOutput(finalFractures, acceptedPoly, intPts, triplePoints, shapeFamilies, output));
+    }
+    
+    // Write ecpm.bin (must be before writeIntersectionFiles(), polys are not rotated yet)
+    if (params->ecpmOutput) {
+        PROFILE_CALL(PROF_WRITE_ECPM, writeEcpm(finalFractures, acceptedPoly, output));
+    }
+    
     // Write intersection files (must be first file written, rotates polys to x-y plane)
-    writeIntersectionFiles(finalFractures, acceptedPoly, intPts, triplePoints, intersectionFolder, pstats);
+    PROFILE_CALL(PROF_WRITE_INTERSECTIONS, writeIntersectionFiles(finalFractures, acceptedPoly, intPts, triplePoints, intersectionFolder, pstats));
     // Write polys.inp
-    writePolysInp(finalFractures, acceptedPoly, output);
+    PROFILE_CALL(PROF_WRITE_POLYS_INP, writePolysInp(finalFractures, acceptedPoly, output));
     // Write params.txt
-    writeParamsFile(finalFractures, acceptedPoly, shapeFamilies, pstats, triplePoints, output);
+    PROFILE_CALL(PROF_WRITE_PARAMS, writeParamsFile(finalFractures, acceptedPoly, shapeFamilies, pstats, triplePoints, output));
     // Write aperture file
     // writeApertureFile(finalFractures, acceptedPoly, output);
     // Write permability file
     // writePermFile(finalFractures, acceptedPoly, output);
     // Write radii file
-    writeRadiiFile(finalFractures, acceptedPoly, output);
+    PROFILE_CALL(PROF_WRITE_RADII, writeRadiiFile(finalFractures, acceptedPoly, output));
     // Write rejection stats file
-    writeRejectionStats(pstats, output);
+    PROFILE_CALL(PROF_WRITE_REJECTION_STATS, writeRejectionStats(pstats, output));
     // write out userRejetedFracture information
-    writeUserRejectedFractureInformation(pstats, output);
+    PROFILE_CALL(PROF_WRITE_USER_REJECTIONS, writeUserRejectedFractureInformation(pstats, output));
     // Write families to output Files
-    writeShapeFams(shapeFamilies, output);
+    PROFILE_CALL(PROF_WRITE_SHAPE_FAMS, writeShapeFams(shapeFamilies, output));
     // Write fracture translations file
-    writeFractureTranslations(finalFractures, acceptedPoly, output);
+    PROFILE_CALL(PROF_WRITE_TRANSLATIONS, writeFractureTranslations(finalFractures, acceptedPoly, output));
     // Write fracture connectivity (edge graph) file
-    writeConnectivity(finalFractures, acceptedPoly, intPts, output);
+    PROFILE_CALL(PROF_WRITE_CONNECTIVITY, writeConnectivity(finalFractures, acceptedPoly, intPts, output));
     // Write rotation data
-    writeRotationData(acceptedPoly, finalFractures, shapeFamilies, output);
+    PROFILE_CALL(PROF_WRITE_ROTATION, writeRotationData(acceptedPoly, finalFractures, shapeFamilies, output));
     // Write normal vectors
-    writeNormalVectors(acceptedPoly, finalFractures, shapeFamilies, output);
+    PROFILE_CALL(PROF_WRITE_NORMALS, writeNormalVectors(acceptedPoly, finalFractures, shapeFamilies, output));
     // Write rejects per fracture insertion attempt data
-    writeRejectsPerAttempt(pstats, output);
+    PROFILE_CALL(PROF_WRITE_REJECTS_PER_ATTEMPT, writeRejectsPerAttempt(pstats, output));
     // Write all accepted radii
-    writeFinalPolyRadii(finalFractures, acceptedPoly, output);
+    PROFILE_CALL(PROF_WRITE_FINAL_RADII, writeFinalPolyRadii(finalFractures, acceptedPoly, output));
     // Write all accepted Surface Area
-    writeFinalPolyArea(finalFractures, acceptedPoly, output);
+    PROFILE_CALL(PROF_WRITE_FINAL_AREA, writeFinalPolyArea(finalFractures, acceptedPoly, output));
     // Write out which fractures touch which boundaries
-    writeBoundaryFiles(finalFractures, acceptedPoly);
+    PROFILE_CALL(PROF_WRITE_BOUNDARY, writeBoundaryFiles(finalFractures, acceptedPoly, output));
     
-    if (outputAcceptedRadiiPerFamily) {
+    if (params->outputAcceptedRadiiPerFamily) {
+        ProfileTimer timer(PROF_WRITE_RADII_PER_FAMILY);
         logString = "Writing Accepted Radii Files Per Family\n";
         logger.writeLogFile(INFO,  logString);
         // Creates radii files per family, before isolated fracture removal.
@@ -91,23 +109,24 @@ void writeOutput(char* outputFolder, std::vector<Poly> &acceptedPoly, std::vecto
             writeAllAcceptedRadii_OfFamily(i, acceptedPoly, radiiFolder);
         }
         
-        if (userRectanglesOnOff) {
+        if (params->userRectanglesOnOff) {
             // Fractures are marked -2 for user rects
             writeAllAcceptedRadii_OfFamily(-2, acceptedPoly, radiiFolder);
         }
         
-        if (userEllipsesOnOff) {
+        if (params->userEllipsesOnOff) {
             // Fractures are marked -1 for user ellipses
             writeAllAcceptedRadii_OfFamily(-1, acceptedPoly, radiiFolder);
         }
         
-        if (userPolygonByCoord) {
+        if (params->userPolygonByCoord) {
             // Fractures are marked -3 for user user polygons
             writeAllAcceptedRadii_OfFamily(-3, acceptedPoly, radiiFolder);
         }
     }
     
-    if (outputFinalRadiiPerFamily) {
+    if (params->outputFinalRadiiPerFamily) {
+        ProfileTimer timer(PROF_WRITE_RADII_PER_FAMILY);
         logString = "Writing Final Radii Files Per Family\n";
         logger.writeLogFile(INFO,  logString);
         int size = shapeFamilies.size();
@@ -116,36 +135,62 @@ void writeOutput(char* outputFolder, std::vector<Poly> &acceptedPoly, std::vecto
             writeFinalRadii_OfFamily(finalFractures, i, acceptedPoly, radiiFolder);
         }
         
-        if (userRectanglesOnOff) {
+        if (params->userRectanglesOnOff) {
             writeFinalRadii_OfFamily(finalFractures, -1, acceptedPoly, radiiFolder);
         }
         
-        if (userEllipsesOnOff) {
+        if (params->userEllipsesOnOff) {
             writeFinalRadii_OfFamily(finalFractures, -2, acceptedPoly, radiiFolder);
         }
         
-        if (userPolygonByCoord) {
+        if (params->userPolygonByCoord) {
             writeFinalRadii_OfFamily(finalFractures, -3, acceptedPoly, radiiFolder);
         }
     }
     
     // If triple intersections are on, write triple intersection points file
-    if (tripleIntersections) {
+    if (params->tripleIntersections) {
         logString = "Writing Triple Intersection Points File\n";
         logger.writeLogFile(INFO,  logString);
-        writeTriplePts(triplePoints, finalFractures, acceptedPoly, intPts, output);
+        PROFILE_CALL(PROF_WRITE_TRIPLE_POINTS, writeTriplePts(triplePoints, finalFractures, acceptedPoly, intPts, output));
     }
 } // End writeOutput()
 
 
+/* writeStreamedOutput() *********************************************************************/
+/*! Writes the output of streaming generation (see streaming.h). The DFN itself is in
+    dfnGen_output/dfn.bin, written at the end of generation, DFNBinaryToAscii converts it
+    to the fracture and intersection files. Only the files which depend on generation
+    statistics are written here.
+    Arg 1: c syle string (char array) path to output folder
+    Arg 2: Stats strcuture, running program statistucs (see definition in structures.h)
+    Arg 3: std::vector Shape - Family structure array  of all stocastic families defined by user input */
+void writeStreamedOutput(const char *outputFolder, struct Stats &pstats, std::vector<Shape> &shapeFamilies) {
+    std::string output = std::string(outputFolder) + "/dfnGen_output";
+    std::string logString = output + "\n";
+    logger.writeLogFile(INFO,  logString);
+    PROFILE_CALL(PROF_WRITE_REJECTION_STATS, writeRejectionStats(pstats, output));
+    PROFILE_CALL(PROF_WRITE_USER_REJECTIONS, writeUserRejectedFractureInformation(pstats, output));
+    PROFILE_CALL(PROF_WRITE_SHAPE_FAMS, writeShapeFams(shapeFamilies, output));
+    PROFILE_CALL(PROF_WRITE_REJECTS_PER_ATTEMPT, writeRejectsPerAttempt(pstats, output));
+    logString = "Convert " + output + "/dfn.bin with DFNBinaryToAscii for the fracture and intersection files\n";
+    logger.writeLogFile(INFO,  logString);
+    
+    if (params->ecpmOutput) {
+        logString = "ecpmOutput is not supported with streaming generation, ecpm.bin was not written\n";
+        logger.writeLogFile(WARNING,  logString);
+    }
+}
+
+
 /*=================================   OUTPUT.CPP FUNCTIONS   ================================*/
 /*===========================================================================================*/
 
 
 /* void writePoints() ************************************************************************/
 /*! Helper function for writing discretized intersections
-    Function writes n points to file
-    Arg 1: Output file stream object (file we are writing to)
+    Function appends n points to an intersection file buffer
+    Arg 1: Buffer holding the contents of the intersection file being written
     Arg 2: std::vector Point array (discretized points)
     Arg 3: Index to point to start output to file.
            ARG 3 USAGE EAMPLE: When discretizing points, the program can discretize from an end
@@ -154,30 +199,34 @@ void writeOutput(char* outputFolder, std::vector<Poly> &acceptedPoly, std::vecto
            array will be the same as the first point in the second array. In this situation, you
            would set start = 1 while writing the second array to avoid duplicate points in the output
     Arg 4: Counter of poitns written. Used to rember at which node a new intersection starts */
-void writePoints(std::ostream &output, std::vector<Point> &points, int start, unsigned int &count) {
+void writePoints(std::string &output, std::vector<Point> &points, int start, unsigned int &count) {
     int n = points.size();
+    char line[128];
     
     for (int i = start; i < n; i++) {
-        output << std::setprecision(12) << count << " " << points[i].x
-               << " " << points[i].y << " " << points[i].z << "\n";
+        // %.12g matches std::setprecision(12) used by the stream based writers
+        int len = snprintf(line, sizeof(line), "%u %.12g %.12g %.12g\n", count, points[i].x, points[i].y, points[i].z);
+        output.append(line, len);
         count++;
     }
 }
 
 /* finishWritingIntFile() ********************************************************************/
 /*! Helper function for writing discretized intersection points
-    Writes header and line connections after points have been written
-    Arg 1: Output file stream object (intersection file)
+    Appends line connections after points have been written and fills in the header
+    Arg 1: Buffer holding the contents of the intersection file being written
     Arg 2: Number, or index, of fracture whos intersection is being written
     Arg 3: Number of intersection points on fracture
     Arg 4: Number of intersections on fracture
     Arg 5: std:vector array of node numbers which start an intersection. Used to generate "line"
            connections in intersection inp files
     Arg 6: std::vector array of fracture id's (indices) who intersect fract1 (arg 2) */
-void finishWritingIntFile(std::ostream &fractIntFile, int fract1, int numPoints, int numIntersections,
+void finishWritingIntFile(std::string &fractIntFile, int fract1, int numPoints, int numIntersections,
                           std::vector<unsigned int> &intStart, std::vector<unsigned int> &intersectingFractures) {
     unsigned int count = 1;
     int idx = 0;
+    char line[128];
+    int len;
     
     // Lines
     for (int i = 0; i < numPoints - numIntersections; i++) {
@@ -186,13 +235,14 @@ void finishWritingIntFile(std::ostream &fractIntFile, int fract1, int numPoints,
             idx++;
         }
         
-        fractIntFile << i + 1 << " " << fract1 << " line " << count << " " << count + 1 << "\n";
+        len = snprintf(line, sizeof(line), "%d %d line %u %u\n", i + 1, fract1, count, count + 1);
+        fractIntFile.append(line, len);
         count++;
     }
     
-    fractIntFile << "2 1 1\n";
-    fractIntFile << "a_b, integer\n";
-    fractIntFile << "b_a, integer\n";
+    fractIntFile += "2 1 1\n";
+    fractIntFile += "a_b, integer\n";
+    fractIntFile += "b_a, integer\n";
     idx = 0;
     
     for (int i = 0; i < numPoints; i++) {
@@ -200,12 +250,13 @@ void finishWritingIntFile(std::ostream &fractIntFile, int fract1, int numPoints,
             idx++;
         }
         
-        fractIntFile << i + 1 << " " << fract1 << " " << intersectingFractures[idx] << "\n";
+        len = snprintf(line, sizeof(line), "%d %d %u\n", i + 1, fract1, intersectingFractures[idx]);
+        fractIntFile.append(line, len);
     }
     
-    // Move to header postion
-    fractIntFile.seekp(0);
-    fractIntFile << numPoints << " " << numPoints - numIntersections << " " << 2 << " " << "0 0";
+    // Header goes over the blank first line
+    len = snprintf(line, sizeof(line), "%d %d 2 0 0", numPoints, numPoints - numIntersections);
+    fractIntFile.replace(0, len, line, len);
 }
 
 
@@ -260,11 +311,184 @@ void adjustIntFractIDs(std::vector<unsigned int> &finalFractures, std::vector<Po
 }
 
 
+/* writeFractureIntersections() *************************************************************/
+/*! Builds the contents of one fracture's intersection inp file
+    Rotates the fracture, its intersections, and triple intersection points to x-y plane
+    and discretizes the intersections. Only fracture finalFractures[i] is modified, so
+    several fractures can be processed at the same time
+    Arg 1: Index into finalFractures of the fracture to write
+    Arg 2: std::vector array of indices to fractures (Arg 3) remaining after isolated
+           fracture removal
+    Arg 3: std::vector array of all accepted fractures (before isolated fracture removal)
+    Arg 4: std::vector array of all intersections
+    Arg 5: std::vector array all triple intersection points
+    Arg 6: OUTPUT, buffer which receives the intersection file contents
+    Arg 7: OUTPUT, number of intersection nodes on the fracture
+    Arg 8: OUTPUT, number of triple points on the fracture's intersections (duplicates included) */
+void writeFractureIntersections(unsigned int i, std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints, std::string &fractIntFile, unsigned int &intersectionNodeCount, unsigned int &tripleNodeCount) {
+    Point tempPoint1, tempPoint2; // Keeps track of current un-rotated points we are working with
+    tripleNodeCount = 0;
+    // Starting positions for each intersection. Lets us know how to make the line connections
+    std::vector<unsigned int> intStart;
+    unsigned int count = 1;
+    // Counter for intersection header  number of points
+    unsigned int numIntPts = 0;
+    // Used in writing which nodes belong to which two fractures in finishWritingOutput()
+    std::vector<unsigned int> intersectingFractures;
+    // Buffer first line to leave space to write header
+    fractIntFile.assign("                                                               \n");
+    // Go through each final fracture's intersections and write to output
+    unsigned int size = acceptedPoly[finalFractures[i]].intersectionIndex.size();
+    
+    if (size > 0 || params->keepIsolatedFractures == 0) {
+        for (unsigned int j = 0; j < size; j++) {
+            // tempTripPts holds rotated triple points for an intersection. Triple pts must be rotated 3 different
+            // ways so we cannot change the original data
+            std::vector<Point> tempTripPts;
+            // Used to measure current length before rotation (used to calculate number of points
+            // to discretize) based on original intersection. This fixes any precision errors we
+            // when calculating length after rotation, both rotations for the same intersection will
+            // always have the same step size and same number of discretized points.
+            double curLength = 0;
+            unsigned int polyIntIdx = acceptedPoly[finalFractures[i]].intersectionIndex[j];
+            // Similarly to above, the intersection must be rotated two different ways,
+            // one for each intersecting poly. We can't change the original data so we must use temp data
+            IntPoints tempIntersection = polyAndIntersection_RotationToXY(intPts[polyIntIdx],
+                                         acceptedPoly[finalFractures[i]], triplePoints, tempTripPts);
+            // poly and intersection now rotated
+            int triplePtsSize = tempTripPts.size();
+            // fracture 1 is i
+            // fracture 2 is the other intersecting fracture
+            unsigned int fract2;
+            
+            if (-intPts[polyIntIdx].fract1 == i + 1) {
+                fract2 = -intPts[polyIntIdx].fract2;
+                intersectingFractures.push_back(fract2);
+            } else {
+                fract2 = -intPts[polyIntIdx].fract1;
+                intersectingFractures.push_back(fract2);
+            }
+            
+            // If triple points exist on intersection, discretize from endpoint to closest triple point,
+            // from triple to next triple point, and finally to other end point
+            if (triplePtsSize != 0) {
+                // Keep track of number of triple points which will be in the
+                // DFN (this is after isolated fracture removal)
+                // NOTE: This will need to be divided by six to get correct value.
+                // Division by six was determined through testing.
+                tripleNodeCount += triplePtsSize;
+                // Order the triple points by distances to know to discretize from point to next closest point
+                double *distances = new double[triplePtsSize];
+                double pt1[3] = {tempIntersection.x1, tempIntersection.y1, tempIntersection.z1};
+                tempPoint1.x = intPts[polyIntIdx].x1;
+                tempPoint1.y = intPts[polyIntIdx].y1;
+                tempPoint1.z = intPts[polyIntIdx].z1;
+                
+                // Create array of distances first end point to triple points
+                for (int k = 0; k < triplePtsSize; k++) { //loop through triple points on  intersection i
+                    double point[3] = {tempTripPts[k].x, tempTripPts[k].y, tempTripPts[k].z};//triple pt
+                    distances[k] = euclideanDistance(pt1, point);//create array of distances
+                }
+                
+                // Order the indices of the distances array shortest to largest distance
+                // this lets us know which point to discritize to next
+                int *s = sortedIndex(distances, triplePtsSize);
+                // Discretize from end point1 to first triple pt
+                // pt1 already = enpoint1
+                double pt2[3] = {tempTripPts[s[0]].x, tempTripPts[s[0]].y, tempTripPts[s[0]].z};
+                tempPoint2 = triplePoints[intPts[polyIntIdx].triplePointsIdx[s[0]]];
+                curLength = euclideanDistance(tempPoint1, tempPoint2);
+                std::vector<Point> points = discretizeLineOfIntersection(pt1, pt2, curLength);
+                // Write points to file
+                numIntPts += points.size();
+                writePoints(fractIntFile, points, 0, count);
+                
+                // If one trip pt, set up points to discretize from only triple pt to other end point
+                if (triplePtsSize == 1) {
+                    pt1[0] = pt2[0];
+                    pt1[1] = pt2[1];
+                    pt1[2] = pt2[2];
+                    pt2[0] = tempIntersection.x2;
+                    pt2[1] = tempIntersection.y2;
+                    pt2[2] = tempIntersection.z2;
+                    tempPoint1 = tempPoint2;
+                    tempPoint2.x = intPts[polyIntIdx].x2;
+                    tempPoint2.y = intPts[polyIntIdx].y2;
+                    tempPoint2.z = intPts[polyIntIdx].z2;
+                } else { // More than 1 triple point
+                    for (int jj = 0; jj < (triplePtsSize - 1); jj++) {
+                        pt1[0] = tempTripPts[s[jj]].x;
+                        pt1[1] = tempTripPts[s[jj]].y;
+                        pt1[2] = tempTripPts[s[jj]].z;
+                        pt2[0] = tempTripPts[s[jj + 1]].x;
+                        pt2[1] = tempTripPts[s[jj + 1]].y;
+                        pt2[2] = tempTripPts[s[jj + 1]].z;
+                        tempPoint1 = triplePoints[intPts[polyIntIdx].triplePointsIdx[s[jj]]];
+                        tempPoint2 = triplePoints[intPts[polyIntIdx].triplePointsIdx[s[jj + 1]]];
+                        curLength = euclideanDistance(tempPoint1, tempPoint2);
+                        points = discretizeLineOfIntersection(pt1, pt2, curLength);
+                        // Write points for first fracture to file, save second set of points to temp
+                        numIntPts += points.size() - 1;
+                        writePoints(fractIntFile, points, 1, count);
+                    }
+                    
+                    // Set up points to go from last triple point to last endpoint
+                    pt1[0] = pt2[0];
+                    pt1[1] = pt2[1];
+                    pt1[2] = pt2[2];
+                    pt2[0] = tempIntersection.x2;
+                    pt2[1] = tempIntersection.y2;
+                    pt2[2] = tempIntersection.z2;
+                    tempPoint1 = tempPoint2;
+                    tempPoint2.x = intPts[polyIntIdx].x2;
+                    tempPoint2.y = intPts[polyIntIdx].y2;
+                    tempPoint2.z = intPts[polyIntIdx].z2;
+                }
+                
+                curLength = euclideanDistance(tempPoint1, tempPoint2);
+                points = discretizeLineOfIntersection(pt1, pt2, curLength);
+                numIntPts += points.size() - 1;
+                writePoints(fractIntFile, points, 1, count);
+                delete[] s; // Need to delete these manually. created with new[]
+                delete[] distances;
+            } else { // No triple intersection points on intersection line
+                double pt1[3] = {tempIntersection.x1, tempIntersection.y1, tempIntersection.z1};
+                double pt2[3] = {tempIntersection.x2, tempIntersection.y2, tempIntersection.z2};
+                tempPoint1.x = intPts[polyIntIdx].x1;
+                tempPoint1.y = intPts[polyIntIdx].y1;
+                tempPoint1.z = intPts[polyIntIdx].z1;
+                tempPoint2.x = intPts[polyIntIdx].x2;
+                tempPoint2.y = intPts[polyIntIdx].y2;
+                tempPoint2.z = intPts[polyIntIdx].z2;
+                curLength = euclideanDistance(tempPoint1, tempPoint2);
+                std::vector<Point> points = discretizeLineOfIntersection(pt1, pt2, curLength);
+                numIntPts += points.size();
+                writePoints(fractIntFile, points, 0, count);
+            }
+            
+            intStart.push_back(count);
+        }
+    } else {
+        // Fracture without intersections, only rotate it to the x-y plane
+        std::vector<Point> tempTripPts;
+        polyAndIntersection_RotationToXY(intPts[0], acceptedPoly[finalFractures[i]], triplePoints, tempTripPts);
+    }
+    
+    // Done with fracture and intersections
+    intersectionNodeCount = numIntPts;
+    // Write line connectivity and header
+    finishWritingIntFile(fractIntFile, i + 1, numIntPts, size, intStart, intersectingFractures);
+}
+
+
 /* writeIntersectionFiles() ******************************************************************/
 /*! Writes intersection inp files to output folder
     Rotates intersections, and triple intersection points to x-y plane
     Also rotates polygons to x-y plane to save on computation during writePolysInp()
     Rotating polygons here increases performance as we do not need to recalculate rotation matricies
+    Fractures are processed in parallel. Every thread builds whole files in its own buffer and
+    writes each of them with a single call; node counts are kept per fracture and summed in
+    fracture order afterwards, so the stats do not depend on the number of threads
     Arg 1: std::vector array of indices to fractures (Arg 2) remaining after isolated
            fracture removal
     Arg 2: std::vector array of all accepted fractures (before isolated fracture removal)
@@ -273,172 +497,74 @@ void adjustIntFractIDs(std::vector<unsigned int> &finalFractures, std::vector<Po
     Arg 5: Path to intersections folder
     Arg 6: Stats strcture. DFNGen running program stats (keeps track of total intersecion node count) */
 void writeIntersectionFiles(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints, std::string intersectionFolder, struct Stats &pstats) {
-    Point tempPoint1, tempPoint2; // Keeps track of current un-rotated points we are working with
     std::string logString = "Writing Intersection Files\n";
     logger.writeLogFile(INFO,  logString);
-    std::ofstream fractIntFile;
-    //int keepIsolated = 1;
+    unsigned int nFractures = finalFractures.size();
+    std::vector<unsigned int> intNodes(nFractures, 0);
+    std::vector<unsigned int> tripleNodes(nFractures, 0);
+    // Files which could not be opened, reported after all threads finish
+    std::vector<char> failed(nFractures, 0);
+    std::atomic<unsigned int> next(0);
+    // Set by a worker on an error (already logged), thrown again after the join
+    std::atomic<bool> error(false);
+    unsigned int nThreads = std::thread::hardware_concurrency();
+    
+    if (nThreads == 0) {
+        nThreads = 1;
+    }
     
-    // Go through finalFractures. Rotate poly, intersections, and triple intersection points
-    // to XY plane. Discretize and write to file
-    for (unsigned int i = 0; i < finalFractures.size(); i++) {
-        // Starting positions for each intersection. Lets us know how to make the line connections
-        std::vector<unsigned int> intStart;
-        unsigned int count = 1;
-        // Counter for intersection header  number of points
-        unsigned int numIntPts = 0;
-        // Used in writing which nodes belong to which two fractures in finishWritingOutput()
-        std::vector<unsigned int> intersectingFractures;
-        // Make new intersection file in intersections folder
-        std::string file = intersectionFolder + "/intersections_" + std::to_string(i + 1) + ".inp";
-        fractIntFile.open(file.c_str(), std::ofstream::out | std::ofstream::trunc);
-        checkIfOpen(fractIntFile, file);
-        // Buffer first line to leave space to write header
-        fractIntFile << "                                                               \n";
-        // Go through each final fracture's intersections and write to output
-        unsigned int size = acceptedPoly[finalFractures[i]].intersectionIndex.size();
+    if (nThreads > nFractures) {
+        nThreads = nFractures;
+    }
+    
+    auto worker = [&]() {
+        // Thread local scratch, reused for every file this thread writes
+        std::string buffer;
+        buffer.reserve(1 << 20);
+        unsigned int i;
         
-        if (size > 0 || keepIsolatedFractures == 0) {
-            for (unsigned int j = 0; j < size; j++) {
-                // tempTripPts holds rotated triple points for an intersection. Triple pts must be rotated 3 different
-                // ways so we cannot change the original data
-                std::vector<Point> tempTripPts;
-                // Used to measure current length before rotation (used to calculate number of points
-                // to discretize) based on original intersection. This fixes any precision errors we
-                // when calculating length after rotation, both rotations for the same intersection will
-                // always have the same step size and same number of discretized points.
-                double curLength = 0;
-                unsigned int polyIntIdx = acceptedPoly[finalFractures[i]].intersectionIndex[j];
-                // Similarly to above, the intersection must be rotated two different ways,
-                // one for each intersecting poly. We can't change the original data so we must use temp data
-                IntPoints tempIntersection = polyAndIntersection_RotationToXY(intPts[polyIntIdx],
-                                             acceptedPoly[finalFractures[i]], triplePoints, tempTripPts);
-                // poly and intersection now rotated
-                int triplePtsSize = tempTripPts.size();
-                // fracture 1 is i
-                // fracture 2 is the other intersecting fracture
-                unsigned int fract2;
+        try {
+            while ((i = next++) < nFractures) {
+                writeFractureIntersections(i, finalFractures, acceptedPoly, intPts, triplePoints, buffer, intNodes[i], tripleNodes[i]);
+                std::string file = intersectionFolder + "/intersections_" + std::to_string(i + 1) + ".inp";
+                std::ofstream fractIntFile(file.c_str(), std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
                 
-                if (-intPts[polyIntIdx].fract1 == i + 1) {
-                    fract2 = -intPts[polyIntIdx].fract2;
-                    intersectingFractures.push_back(fract2);
-                } else {
-                    fract2 = -intPts[polyIntIdx].fract1;
-                    intersectingFractures.push_back(fract2);
-                }
-                
-                // If triple points exist on intersection, discretize from endpoint to closest triple point,
-                // from triple to next triple point, and finally to other end point
-                if (triplePtsSize != 0) {
-                    // Keep track of number of triple points which will be in the
-                    // DFN (this is after isolated fracture removal)
-                    // NOTE: This will need to be divided by six to get correct value.
-                    // Division by six was determined through testing.
-                    pstats.tripleNodeCount += triplePtsSize;
-                    // Order the triple points by distances to know to discretize from point to next closest point
-                    double *distances = new double[triplePtsSize];
-                    double pt1[3] = {tempIntersection.x1, tempIntersection.y1, tempIntersection.z1};
-                    tempPoint1.x = intPts[polyIntIdx].x1;
-                    tempPoint1.y = intPts[polyIntIdx].y1;
-                    tempPoint1.z = intPts[polyIntIdx].z1;
-                    
-                    // Create array of distances first end point to triple points
-                    for (int k = 0; k < triplePtsSize; k++) { //loop through triple points on  intersection i
-                        double point[3] = {tempTripPts[k].x, tempTripPts[k].y, tempTripPts[k].z};//triple pt
-                        distances[k] = euclideanDistance(pt1, point);//create array of distances
-                    }
-                    
-                    // Order the indices of the distances array shortest to largest distance
-                    // this lets us know which point to discritize to next
-                    int *s = sortedIndex(distances, triplePtsSize);
-                    // Discretize from end point1 to first triple pt
-                    // pt1 already = enpoint1
-                    double pt2[3] = {tempTripPts[s[0]].x, tempTripPts[s[0]].y, tempTripPts[s[0]].z};
-                    tempPoint2 = triplePoints[intPts[polyIntIdx].triplePointsIdx[s[0]]];
-                    curLength = euclideanDistance(tempPoint1, tempPoint2);
-                    std::vector<Point> points = discretizeLineOfIntersection(pt1, pt2, curLength);
-                    // Write points to file
-                    numIntPts += points.size();
-                    writePoints(fractIntFile, points, 0, count);
-                    
-                    // If one trip pt, set up points to discretize from only triple pt to other end point
-                    if (triplePtsSize == 1) {
-                        pt1[0] = pt2[0];
-                        pt1[1] = pt2[1];
-                        pt1[2] = pt2[2];
-                        pt2[0] = tempIntersection.x2;
-                        pt2[1] = tempIntersection.y2;
-                        pt2[2] = tempIntersection.z2;
-                        tempPoint1 = tempPoint2;
-                        tempPoint2.x = intPts[polyIntIdx].x2;
-                        tempPoint2.y = intPts[polyIntIdx].y2;
-                        tempPoint2.z = intPts[polyIntIdx].z2;
-                    } else { // More than 1 triple point
-                        for (int jj = 0; jj < (triplePtsSize - 1); jj++) {
-                            pt1[0] = tempTripPts[s[jj]].x;
-                            pt1[1] = tempTripPts[s[jj]].y;
-                            pt1[2] = tempTripPts[s[jj]].z;
-                            pt2[0] = tempTripPts[s[jj + 1]].x;
-                            pt2[1] = tempTripPts[s[jj + 1]].y;
-                            pt2[2] = tempTripPts[s[jj + 1]].z;
-                            tempPoint1 = triplePoints[intPts[polyIntIdx].triplePointsIdx[s[jj]]];
-                            tempPoint2 = triplePoints[intPts[polyIntIdx].triplePointsIdx[s[jj + 1]]];
-                            curLength = euclideanDistance(tempPoint1, tempPoint2);
-                            points = discretizeLineOfIntersection(pt1, pt2, curLength);
-                            // Write points for first fracture to file, save second set of points to temp
-                            numIntPts += points.size() - 1;
-                            writePoints(fractIntFile, points, 1, count);
-                        }
-                        
-                        // Set up points to go from last triple point to last endpoint
-                        pt1[0] = pt2[0];
-                        pt1[1] = pt2[1];
-                        pt1[2] = pt2[2];
-                        pt2[0] = tempIntersection.x2;
-                        pt2[1] = tempIntersection.y2;
-                        pt2[2] = tempIntersection.z2;
-                        tempPoint1 = tempPoint2;
-                        tempPoint2.x = intPts[polyIntIdx].x2;
-                        tempPoint2.y = intPts[polyIntIdx].y2;
-                        tempPoint2.z = intPts[polyIntIdx].z2;
-                    }
-                    
-                    curLength = euclideanDistance(tempPoint1, tempPoint2);
-                    points = discretizeLineOfIntersection(pt1, pt2, curLength);
-                    numIntPts += points.size() - 1;
-                    writePoints(fractIntFile, points, 1, count);
-                    delete[] s; // Need to delete these manually. created with new[]
-                    delete[] distances;
-                } else { // No triple intersection points on intersection line
-                    double pt1[3] = {tempIntersection.x1, tempIntersection.y1, tempIntersection.z1};
-                    double pt2[3] = {tempIntersection.x2, tempIntersection.y2, tempIntersection.z2};
-                    tempPoint1.x = intPts[polyIntIdx].x1;
-                    tempPoint1.y = intPts[polyIntIdx].y1;
-                    tempPoint1.z = intPts[polyIntIdx].z1;
-                    tempPoint2.x = intPts[polyIntIdx].x2;
-                    tempPoint2.y = intPts[polyIntIdx].y2;
-                    tempPoint2.z = intPts[polyIntIdx].z2;
-                    curLength = euclideanDistance(tempPoint1, tempPoint2);
-                    std::vector<Point> points = discretizeLineOfIntersection(pt1, pt2, curLength);
-                    numIntPts += points.size();
-                    writePoints(fractIntFile, points, 0, count);
+                if (!fractIntFile.is_open()) {
+                    failed[i] = 1;
+                    continue;
                 }
                 
-                intStart.push_back(count);
+                fractIntFile.write(buffer.data(), buffer.size());
             }
-        } else {
-            std::vector<Point> tempTripPts;
-            IntPoints tempIntersection = polyAndIntersection_RotationToXY(intPts[0],
-                                         acceptedPoly[finalFractures[i]], triplePoints, tempTripPts);
+        } catch (DFNError &) {
+            error = true;
+        }
+    };
+    std::vector<std::thread> threads;
+    
+    for (unsigned int t = 1; t < nThreads; t++) {
+        threads.push_back(std::thread(worker));
+    }
+    
+    worker();
+    
+    for (unsigned int t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+    
+    if (error) {
+        throw DFNError();
+    }
+    
+    for (unsigned int i = 0; i < nFractures; i++) {
+        if (failed[i]) {
+            logString = "ERROR: unable to open file " + intersectionFolder + "/intersections_" + std::to_string(i + 1) + ".inp";
+            logger.writeLogFile(ERROR,  logString);
+            throw DFNError();
         }
         
-        // Done with fracture and intersections
-        pstats.intersectionNodeCount += numIntPts;
-        // Write line connectivity and header
-        finishWritingIntFile(fractIntFile, i + 1, numIntPts, size, intStart, intersectingFractures);
-        intersectingFractures.clear();
-        intStart.clear();
-        fractIntFile.close();
+        pstats.intersectionNodeCount += intNodes[i];
+        pstats.tripleNodeCount += tripleNodes[i];
     }
     
     //Divide by 6 to remove the duplicate counts
@@ -594,20 +720,20 @@ void writePolysInp(std::vector<unsigned int> &finalFractures, std::vector<Poly>
     Arg 3: std::vector array of fracture families
     Arg 4: Path to output folder */
 void writeParamsFile(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::vector<Shape> &shapeFamilies, Stats &pstats, std::vector<Point> &triplePoints, std::string &output) {
-    std::ofstream params;
+    std::ofstream paramsFile;
     std::string paramsOutputFile = output + "/../params.txt";
-    params.open(paramsOutputFile.c_str(), std::ofstream::out | std::ofstream::trunc);
-    checkIfOpen(params, paramsOutputFile);
+    paramsFile.open(paramsOutputFile.c_str(), std::ofstream::out | std::ofstream::trunc);
+    checkIfOpen(paramsFile, paramsOutputFile);
     std::string logString = "Writing " + paramsOutputFile + "\n";
     logger.writeLogFile(INFO,  logString);
-    params << finalFractures.size() << "\n";
-    params << h << "\n";
-    params << visualizationMode << "\n"; // Production mode
-    params << pstats.intersectionNodeCount / 2 - pstats.tripleNodeCount << "\n";
-    params << domainSize[0]  << "\n";
-    params << domainSize[1]  << "\n";
-    params << domainSize[2]  << "\n";
-    params.close();
+    paramsFile << finalFractures.size() << "\n";
+    paramsFile << params->h << "\n";
+    paramsFile << params->visualizationMode << "\n"; // Production mode
+    paramsFile << pstats.intersectionNodeCount / 2 - pstats.tripleNodeCount << "\n";
+    paramsFile << params->domainSize[0]  << "\n";
+    paramsFile << params->domainSize[1]  << "\n";
+    paramsFile << params->domainSize[2]  << "\n";
+    paramsFile.close();
 }
 
 
@@ -984,15 +1110,15 @@ void writeShapeFams(std::vector<Shape> &shapeFamilies, std::string &output) {
     
     //TODO: add stub code in families.dat for userDefined fractures, IF there are user defined fractures
     
-    if (userEllipsesOnOff) {
+    if (params->userEllipsesOnOff) {
         file << "UserDefined Ellipse Family: 0\n\n";
     }
     
-    if (userRectanglesOnOff) {
+    if (params->userRectanglesOnOff) {
         file << "UserDefined Rectangle Family: -1\n\n";
     }
     
-    if (userPolygonByCoord) {
+    if (params->userPolygonByCoord) {
         file << "UserDefined Polygon Family: -2\n\n";
     }
     
@@ -1013,7 +1139,7 @@ void writeShapeFams(std::vector<Shape> &shapeFamilies, std::string &output) {
         file << "Aspect Ratio: " << shapeFamilies[i].aspectRatio << endl;
         
         // p32 target
-        if (stopCondition == 1) {
+        if (params->stopCondition == 1) {
             file << "P32 (Fracture Intensity) Target: "
                  << shapeFamilies[i].p32Target << endl;
         }
@@ -1026,20 +1152,20 @@ void writeShapeFams(std::vector<Shape> &shapeFamilies, std::string &output) {
             file << "Beta (Rotation Around Normal Vector)-deg: " << shapeFamilies[i].beta * radToDeg << endl;
         }
         
-        if (orientationOption == 0) {
+        if (params->orientationOption == 0) {
             // Theta (angle normal makes with z axis
             file << "Theta-rad: " << shapeFamilies[i].angleOne << endl;
             file << "Theta-deg: " << shapeFamilies[i].angleOne * radToDeg << endl;
             // Phi (angle the projection of normal onto x-y plane  makes with +x axis
             file << "Phi-rad: " << shapeFamilies[i].angleTwo << endl;
             file << "Phi-deg: " << shapeFamilies[i].angleTwo * radToDeg << endl;
-        } else if (orientationOption == 1) {
+        } else if (params->orientationOption == 1) {
             file << "Trend-rad: " << shapeFamilies[i].angleOne << endl;
             file << "Trend-deg: " << shapeFamilies[i].angleOne * radToDeg << endl;
             // Phi (angle the projection of normal onto x-y plane  makes with +x axis
             file << "Plunge-rad: " << shapeFamilies[i].angleTwo << endl;
             file << "Plunge-deg: " << shapeFamilies[i].angleTwo * radToDeg << endl;
-        } else if (orientationOption == 2) {
+        } else if (params->orientationOption == 2) {
             file << "Dip-rad: " << shapeFamilies[i].angleOne << endl;
             file << "Dip-deg: " << shapeFamilies[i].angleOne * radToDeg << endl;
             // Phi (angle the projection of normal onto x-y plane  makes with +x axis
@@ -1056,7 +1182,7 @@ void writeShapeFams(std::vector<Shape> &shapeFamilies, std::string &output) {
         } else {
             int idx = (shapeFamilies[i].layer - 1) * 2;
             file << "Layer Number: " << shapeFamilies[i].layer << "\n";
-            file << "Layer: {" << layers[idx] << "," << layers[idx + 1] << "}" << endl;
+            file << "Layer: {" << params->layers[idx] << "," << params->layers[idx + 1] << "}" << endl;
         }
         
         // Print layer family belongs to
@@ -1065,7 +1191,7 @@ void writeShapeFams(std::vector<Shape> &shapeFamilies, std::string &output) {
         } else {
             int idx = (shapeFamilies[i].region - 1) * 6;
             file << "Region Number: " << shapeFamilies[i].region << "\n";
-            file << "Region: {" << regions[idx] << "," << regions[idx + 1] << "," << regions[idx + 2]  << "," << regions[idx + 3] << "," << regions[idx + 4] << "," << regions[idx + 5] << "}\n";
+            file << "Region: {" << params->regions[idx] << "," << params->regions[idx + 1] << "," << params->regions[idx + 2]  << "," << params->regions[idx + 3] << "," << params->regions[idx + 4] << "," << params->regions[idx + 5] << "}\n";
         }
         
         // Print distribution data
@@ -1098,7 +1224,7 @@ void writeShapeFams(std::vector<Shape> &shapeFamilies, std::string &output) {
             file << "Radius (m): " << shapeFamilies[i].constRadi << endl;
         }
         
-        file << "Family Insertion Probability: " << famProbOriginal[i] << "\n\n";
+        file << "Family Insertion Probability: " << params->famProbOriginal[i] << "\n\n";
     }
     
     file.close();
@@ -1120,7 +1246,7 @@ void makeDIR(const char *dir) {
         if (system(tempStr.c_str())) {
             logString = "ERROR: Problem executing system command: " + tempStr;
             logger.writeLogFile(ERROR,  logString);
-            exit(1);
+            throw DFNError();
         }
     }
     
@@ -1131,7 +1257,7 @@ void makeDIR(const char *dir) {
         if (-1 == dir_err)  {
             logString = "Error creating directory " + std::string(dir);
             logger.writeLogFile(ERROR,  logString);
-            exit(1);
+            throw DFNError();
         }
     }
 }
@@ -1197,14 +1323,14 @@ void writeRotationData(std::vector<Poly> &acceptedPoly, std::vector<unsigned int
     checkIfOpen(file, fileOutputFile);
     std::string logString = "Writing Rotation Data File (poly_info.dat)\n";
     logger.writeLogFile(INFO,  logString);
-    double maxDomainSize = domainSize[0];
+    double maxDomainSize = params->domainSize[0];
     
-    if (maxDomainSize < domainSize[1]) {
-        maxDomainSize = domainSize[1];
+    if (maxDomainSize < params->domainSize[1]) {
+        maxDomainSize = params->domainSize[1];
     }
     
-    if (maxDomainSize < domainSize[2]) {
-        maxDomainSize = domainSize[2];
+    if (maxDomainSize < params->domainSize[2]) {
+        maxDomainSize = params->domainSize[2];
     }
     
     maxDomainSize *= 10;
@@ -1220,7 +1346,7 @@ void writeRotationData(std::vector<Poly> &acceptedPoly, std::vector<unsigned int
         // Rotation into xy plane
         double *v = crossProduct(e3, normal);
         
-        if (!(std::abs(v[0]) < eps && std::abs(v[1]) < eps && std::abs(v[2]) < eps)) { //if not zero vector
+        if (!(std::abs(v[0]) < params->eps && std::abs(v[1]) < params->eps && std::abs(v[2]) < params->eps)) { //if not zero vector
             normalize(v);
         }
         
@@ -1305,29 +1431,68 @@ void writeRejectsPerAttempt(Stats &pstats, std::string &output) {
     file.close();
 }
 
+/* addGraphEdge() ****************************************************************************/
+/*! Adds an edge to the fracture graph, with the mid point and length of its line, computed
+    as in writeMidPoint()
+    Arg 1: std::vector array of graph edges
+    Arg 2: Fracture number (from 1)
+    Arg 3: Fracture number, or boundary number (negative, FEHM format)
+    Arg 4: First end point of the line, {x, y, z}
+    Arg 5: Second end point of the line, {x, y, z} */
+static void addGraphEdge(std::vector<GraphEdge> &edges, int fract1, int fract2, const double *p1, const double *p2) {
+    Point point1, point2;
+    point1.x = p1[0];
+    point1.y = p1[1];
+    point1.z = p1[2];
+    point2.x = p2[0];
+    point2.y = p2[1];
+    point2.z = p2[2];
+    GraphEdge edge;
+    edge.fract1 = fract1;
+    edge.fract2 = fract2;
+    edge.midPoint[0] = 0.5 * (point1.x + point2.x);
+    edge.midPoint[1] = 0.5 * (point1.y + point2.y);
+    edge.midPoint[2] = 0.5 * (point1.z + point2.z);
+    edge.length = euclideanDistance(point1, point2);
+    edges.push_back(edge);
+}
+
 /* writeGraphData() ******************************************************************/
-/*! Writes graph data files to intersections_list.dat and fracture_info.dat
+/*! Writes graph data files to intersections_list.dat and fracture_info.dat, and with
+    --binary the same graph in binary CSR format to graph.bin (see writeBinaryGraph())
     Arg 1: std::vector array of indices to fractures (Arg 2) remaining after isolated
            fracture removal
     Arg 2: std::vector array of all accepted fractures (before isolated fracture removal)
-    Arg 3: std::vector array of all intersections*/
-void writeGraphData(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts) {
-    double domainX = domainSize[0] * .5;
-    double domainY = domainSize[1] * .5;
-    double domainZ = domainSize[2] * .5;
-    Point tempPoint1, tempPoint2, tempPoint3; // Keeps track of current un-rotated points we are working with
+    Arg 3: std::vector array of all intersections
+    Arg 4: Path to output folder */
+void writeGraphData(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::string &output) {
+    double domainHalf[3] = {params->domainSize[0] * .5, params->domainSize[1] * .5, params->domainSize[2] * .5};
+    // Boundary node of each face (Poly::faces order), FEHM format
+    // top / Z+ / 1
+    // bottom / Z- / 2
+    // left / X- / 3
+    // front / Y+ / 4
+    // right / X+ / 5
+    // back / Y- / 6
+    const int faceNode[6] = {-5, -3, -4, -6, -1, -2};
+    std::vector<GraphEdge> edges;
+    
+    if (params->binaryOutput) {
+        edges.reserve(intPts.size() + finalFractures.size());
+    }
+    
     std::string logString = "Writing Graph Data Files\n";
     logger.writeLogFile(INFO,  logString);
     //adjustIntFractIDs(finalFractures,acceptedPoly, intPts);
     // Make new intersection file in intersections folder
     std::ofstream intFile;
-    std::string file = "dfnGen_output/intersection_list.dat";
+    std::string file = output + "/intersection_list.dat";
     intFile.open(file.c_str(), std::ofstream::out | std::ofstream::trunc);
     checkIfOpen(intFile, file);
     intFile << "f1 f2 x y z length\n";
     // Make new intersection file in intersections folder
     std::ofstream fractFile;
-    std::string file2 = "dfnGen_output/fracture_info.dat";
+    std::string file2 = output + "/fracture_info.dat";
     fractFile.open(file2.c_str(), std::ofstream::out | std::ofstream::trunc);
     checkIfOpen(fractFile, file2);
     fractFile << "num_connections perm aperture\n";
@@ -1359,109 +1524,75 @@ void writeGraphData(std::vector<unsigned int> &finalFractures, std::vector<Poly>
             if(fract1 < fract2) {
                 writeMidPoint(intFile, fract1, fract2, intPts[polyIntIdx].x1,  intPts[polyIntIdx].y1, intPts[polyIntIdx].z1,
                               intPts[polyIntIdx].x2, intPts[polyIntIdx].y2, intPts[polyIntIdx].z2);
+                
+                if (params->binaryOutput) {
+                    double p1[3] = {intPts[polyIntIdx].x1, intPts[polyIntIdx].y1, intPts[polyIntIdx].z1};
+                    double p2[3] = {intPts[polyIntIdx].x2, intPts[polyIntIdx].y2, intPts[polyIntIdx].z2};
+                    addGraphEdge(edges, fract1, fract2, p1, p2);
+                }
+                
                 num_conn++;
             }
         }
         
-        // Find intersections with domain boundaries
-        // bools are so that lines of intersection are only found and written to file once
-        // once an intersection with a domain boundary is found the bool = true
-        bool right = false;
-        bool left = false;
-        bool top = false;
-        bool bottom = false;
-        bool front = false;
-        bool back = false;
-        int temp = acceptedPoly[finalFractures[i]].numberOfNodes;
+        // Find intersections with domain boundaries, faces[] is set by domainTruncation()
+        // with the same test, only fractures touching a boundary are searched. The line
+        // written for a boundary goes from the first to the second vertex on it, lines are
+        // written in the order of their first vertex.
+        Poly &poly = acceptedPoly[finalFractures[i]];
         
-        // fracture 2 index are based on FEHM format
-        // top / Z+ / 1
-        // bottom / Z- / 2
-        // left / X- / 3
-        // front / Y+ / 4
-        // right / X- / 5
-        // back / Y- / 6
-        for (int k = 0; k < temp; k++) {
-            // Check boundary faces
-            // Update which boundaries newPoly touches
-            int idx = k * 3;
+        if (poly.faces[0] || poly.faces[1] || poly.faces[2] || poly.faces[3] || poly.faces[4] || poly.faces[5]) {
+            int first[6] = {-1, -1, -1, -1, -1, -1};
+            int second[6] = {-1, -1, -1, -1, -1, -1};
             
-            // if fracture if on right boundary
-            if (acceptedPoly[finalFractures[i]].vertices[idx] >= domainX - eps) {
-                for (int kk = 0; kk < temp; kk++) {
-                    int iidx = kk * 3;
+            for (int k = 0; k < poly.numberOfNodes; k++) {
+                for (int axis = 0; axis < 3; axis++) {
+                    double value = poly.vertices[k * 3 + axis];
+                    int face;
                     
-                    if (acceptedPoly[finalFractures[i]].vertices[iidx] >= domainX - eps && idx != iidx && !right) {
-                        writeMidPoint(intFile, i + 1, -5, acceptedPoly[finalFractures[i]].vertices[idx], acceptedPoly[finalFractures[i]].vertices[idx + 1], acceptedPoly[finalFractures[i]].vertices[idx + 2], acceptedPoly[finalFractures[i]].vertices[iidx], acceptedPoly[finalFractures[i]].vertices[iidx + 1], acceptedPoly[finalFractures[i]].vertices[iidx + 2]);
-                        right = true;
-                        num_conn++;
-                        break;
+                    if (value >= domainHalf[axis] - params->eps) {
+                        face = 2 * axis;
+                    } else if (value <= -domainHalf[axis] + params->eps) {
+                        face = 2 * axis + 1;
+                    } else {
+                        continue;
                     }
-                }
-            }
-            // if fracture if on left boundary
-            else if (acceptedPoly[finalFractures[i]].vertices[idx] <= -domainX + eps) {
-                for (int kk = 0; kk < temp; kk++) {
-                    int iidx = kk * 3;
                     
-                    if (acceptedPoly[finalFractures[i]].vertices[iidx] <= -domainX + eps && idx != iidx && !left) {
-                        writeMidPoint(intFile, i + 1, -3, acceptedPoly[finalFractures[i]].vertices[idx], acceptedPoly[finalFractures[i]].vertices[idx + 1], acceptedPoly[finalFractures[i]].vertices[idx + 2], acceptedPoly[finalFractures[i]].vertices[iidx], acceptedPoly[finalFractures[i]].vertices[iidx + 1], acceptedPoly[finalFractures[i]].vertices[iidx + 2]);
-                        left = true;
-                        num_conn++;
-                        break;
+                    if (first[face] < 0) {
+                        first[face] = k;
+                    } else if (second[face] < 0) {
+                        second[face] = k;
                     }
                 }
             }
             
-            // if fracture if on front boundary
-            if (acceptedPoly[finalFractures[i]].vertices[idx + 1] >= domainY - eps) {
-                for (int kk = 0; kk < temp; kk++) {
-                    int iidx = kk * 3;
+            // Boundary lines sorted by first vertex, then by face
+            int lines[6];
+            int lineCount = 0;
+            
+            for (int face = 0; face < 6; face++) {
+                if (second[face] >= 0) {
+                    int pos = lineCount++;
                     
-                    if (acceptedPoly[finalFractures[i]].vertices[iidx + 1] >= domainY - eps && idx != iidx && !front) {
-                        writeMidPoint(intFile, i + 1, -4, acceptedPoly[finalFractures[i]].vertices[idx], acceptedPoly[finalFractures[i]].vertices[idx + 1], acceptedPoly[finalFractures[i]].vertices[idx + 2], acceptedPoly[finalFractures[i]].vertices[iidx], acceptedPoly[finalFractures[i]].vertices[iidx + 1], acceptedPoly[finalFractures[i]].vertices[iidx + 2]);
-                        front = true;
-                        num_conn++;
-                        break;
+                    while (pos > 0 && first[lines[pos - 1]] > first[face]) {
+                        lines[pos] = lines[pos - 1];
+                        pos--;
                     }
-                }
-            }
-            // if fracture if on back boundary
-            else if (acceptedPoly[finalFractures[i]].vertices[idx + 1] <= -domainY + eps) {
-                for (int kk = 0; kk < temp; kk++) {
-                    int iidx = kk * 3;
                     
-                    if (acceptedPoly[finalFractures[i]].vertices[iidx + 1] <= -domainY + eps && idx != iidx && !back) {
-                        writeMidPoint(intFile, i + 1, -6, acceptedPoly[finalFractures[i]].vertices[idx], acceptedPoly[finalFractures[i]].vertices[idx + 1], acceptedPoly[finalFractures[i]].vertices[idx + 2], acceptedPoly[finalFractures[i]].vertices[iidx], acceptedPoly[finalFractures[i]].vertices[iidx + 1], acceptedPoly[finalFractures[i]].vertices[iidx + 2]);
-                        back = true;
-                        num_conn++;
-                        break;
-                    }
+                    lines[pos] = face;
                 }
             }
             
-            if (acceptedPoly[finalFractures[i]].vertices[idx + 2] >= domainZ - eps) {
-                for (int kk = 0; kk < temp; kk++) {
-                    int iidx = kk * 3;
-                    
-                    if (acceptedPoly[finalFractures[i]].vertices[iidx + 2] >= domainZ - eps && idx != iidx && !top) {
-                        writeMidPoint(intFile, i + 1, -1, acceptedPoly[finalFractures[i]].vertices[idx], acceptedPoly[finalFractures[i]].vertices[idx + 1], acceptedPoly[finalFractures[i]].vertices[idx + 2], acceptedPoly[finalFractures[i]].vertices[iidx], acceptedPoly[finalFractures[i]].vertices[iidx + 1], acceptedPoly[finalFractures[i]].vertices[iidx + 2]);
-                        top = true;
-                        num_conn++;
-                        break;
-                    }
-                }
-            } else if (acceptedPoly[finalFractures[i]].vertices[idx + 2] <= -domainZ + eps) {
-                for (int kk = 0; kk < temp; kk++) {
-                    int iidx = kk * 3;
-                    
-                    if (acceptedPoly[finalFractures[i]].vertices[iidx + 2] <= -domainZ + eps && idx != iidx && !bottom) {
-                        writeMidPoint(intFile, i + 1, -2, acceptedPoly[finalFractures[i]].vertices[idx], acceptedPoly[finalFractures[i]].vertices[idx + 1], acceptedPoly[finalFractures[i]].vertices[idx + 2], acceptedPoly[finalFractures[i]].vertices[iidx], acceptedPoly[finalFractures[i]].vertices[iidx + 1], acceptedPoly[finalFractures[i]].vertices[iidx + 2]);
-                        bottom = true;
-                        num_conn++;
-                        break;
-                    }
+            for (int l = 0; l < lineCount; l++) {
+                double *p1 = &poly.vertices[first[lines[l]] * 3];
+                double *p2 = &poly.vertices[second[lines[l]] * 3];
+                writeMidPoint(intFile, i + 1, faceNode[lines[l]], p1[0], p1[1], p1[2], p2[0], p2[1], p2[2]);
+                
+                if (params->binaryOutput) {
+                    addGraphEdge(edges, i + 1, faceNode[lines[l]], p1, p2);
                 }
+                
+                num_conn++;
             }
         }
         
@@ -1472,6 +1603,10 @@ void writeGraphData(std::vector<unsigned int> &finalFractures, std::vector<Poly>
     // Done with fracture and intersections
     intFile.close();
     fractFile.close();
+    
+    if (params->binaryOutput) {
+        writeBinaryGraph(finalFractures.size(), edges, output);
+    }
 }
 
 /* writeMidPoint() ******************************************************************/
@@ -1506,32 +1641,33 @@ void writeMidPoint(std::ofstream &fp, int fract1, int fract2, double x1, double
 /*! Writes fracture numbers into ASCII files corresponding to which boundary they touch
     Arg 1: std::vector array of indices to fractures (Arg 2) remaining after isolated
            fracture removal
-    Arg 2: std::vector array of all accepted fractures (before isolated fracture removal)*/
-void writeBoundaryFiles(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly) {
+    Arg 2: std::vector array of all accepted fractures (before isolated fracture removal)
+    Arg 3: Path to output folder */
+void writeBoundaryFiles(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::string &output) {
     std::string logString = "Writing Boundary Files\n";
     logger.writeLogFile(INFO,  logString);
     std::ofstream leftFile;
-    std::string leftFileName = "dfnGen_output/left.dat";
+    std::string leftFileName = output + "/left.dat";
     leftFile.open(leftFileName.c_str(), std::ofstream::out | std::ofstream::trunc);
     checkIfOpen(leftFile, leftFileName);
     std::ofstream rightFile;
-    std::string rightFileName = "dfnGen_output/right.dat";
+    std::string rightFileName = output + "/right.dat";
     rightFile.open(rightFileName.c_str(), std::ofstream::out | std::ofstream::trunc);
     checkIfOpen(rightFile, rightFileName);
     std::ofstream frontFile;
-    std::string frontFileName = "dfnGen_output/front.dat";
+    std::string frontFileName = output + "/front.dat";
     frontFile.open(frontFileName.c_str(), std::ofstream::out | std::ofstream::trunc);
     checkIfOpen(frontFile, frontFileName);
     std::ofstream backFile;
-    std::string backFileName = "dfnGen_output/back.dat";
+    std::string backFileName = output + "/back.dat";
     backFile.open(backFileName.c_str(), std::ofstream::out | std::ofstream::trunc);
     checkIfOpen(backFile, backFileName);
     std::ofstream topFile;
-    std::string topFileName = "dfnGen_output/top.dat";
+    std::string topFileName = output + "/top.dat";
     topFile.open(topFileName.c_str(), std::ofstream::out | std::ofstream::trunc);
     checkIfOpen(topFile, topFileName);
     std::ofstream bottomFile;
-    std::string bottomFileName = "dfnGen_output/bottom.dat";
+    std::string bottomFileName = output + "/bottom.dat";
     bottomFile.open(bottomFileName.c_str(), std::ofstream::out | std::ofstream::trunc);
     checkIfOpen(bottomFile, bottomFileName);
     
@@ -7,11 +7,12 @@
 
 void writeRotationData(std::vector<Poly> &acceptedPoly, std::vector<unsigned int> &finalFractures, std::vector<Shape> &shapeFamilies, std::string output);
 void writeNormalVectors(std::vector<Poly> &acceptedPoly, std::vector<unsigned int> &finalFractures, std::vector<Shape> &shapeFamilies, std::string output);
-void writeOutput(char* outputFolder, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts,
+void writeOutput(const char *outputFolder, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts,
                  std::vector<Point> &triplePoints, struct Stats &pstats,
                  std::vector<unsigned int> &finalFractures, std::vector<Shape> &shapeFamilies);
+void writeStreamedOutput(const char *outputFolder, struct Stats &pstats, std::vector<Shape> &shapeFamilies);
 
-void writePoints(std::ostream &output, std::vector<Point> &points, int start, unsigned int &count);
+void writePoints(std::string &output, std::vector<Point> &points, int start, unsigned int &count);
 
 bool DIR_exists(const char *path);
 
@@ -26,10 +27,13 @@ void rotateFractures(std::vector<unsigned int> &finalFractures, std::vector<Poly
 
 void debugINP(std::vector<Poly> &allPolys, Stats &pstats, std::string &outputFolder);
 
-void finishWritingIntFile(std::ostream &fractIntFile, int fract1, int numPoints, int numIntersections,
+void finishWritingIntFile(std::string &fractIntFile, int fract1, int numPoints, int numIntersections,
                           std::vector<unsigned int> &intStart, std::vector<unsigned int> &intersectingFractures);
 
 void writeRadiiAcceptedFile();
+void writeFractureIntersections(unsigned int i, std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly,
+                                std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints, std::string &fractIntFile,
+                                unsigned int &intersectionNodeCount, unsigned int &tripleNodeCount);
 void writeIntersectionFiles(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly,
                             std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints, std::string intersectionFolder, struct Stats &pstats);
 void writePolysInp(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::string &output);
@@ -54,8 +58,8 @@ void writeFractureTranslations(std::vector<unsigned int> &finalFractures, std::v
 void writeConnectivity(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::string &output);
 void writeRejectsPerAttempt(Stats &pstats, std::string &output);
 
-void writeGraphData(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts);
+void writeGraphData(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::string &output);
 void writeMidPoint(std::ofstream &fp, int fract1, int fract2, double x1, double y1, double z1, double x2, double y2, double z2);
-void writeBoundaryFiles(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly);
+void writeBoundaryFiles(std::vector<unsigned int> &finalFractures, std::vector<Poly> &acceptedPoly, std::string &output);
 
 #endif
@@ -50,8 +50,8 @@ bool inPolygonBoundary(double x, double y) {
     int i, j;
     int c = 0;
     
-    for (i = 0, j = numOfDomainVertices - 1; i < numOfDomainVertices; j = i++) {
-        if ( ((domainVertices[i].y > y) != (domainVertices[j].y > y)) && (x < (domainVertices[j].x - domainVertices[i].x) * (y - domainVertices[i].y) / (domainVertices[j].y - domainVertices[i].y) + domainVertices[i].x) ) {
+    for (i = 0, j = params->numOfDomainVertices - 1; i < params->numOfDomainVertices; j = i++) {
+        if ( ((params->domainVertices[i].y > y) != (params->domainVertices[j].y > y)) && (x < (params->domainVertices[j].x - params->domainVertices[i].x) * (y - params->domainVertices[i].y) / (params->domainVertices[j].y - params->domainVertices[i].y) + params->domainVertices[i].x) ) {
             // flips back and forth between 0 and 1
             // will be 0 for no crossings or an even number of them
             // will be 1 for odd number of crossings
@@ -122,7 +122,7 @@ void polygonBoundary(std::vector<Poly> &acceptedPolys, std::vector<IntPoints> &i
         // Find line of intersection and FRAM check
         int rejectCode;
         
-        if (disableFram) {
+        if (params->disableFram) {
             rejectCode = 0;
         } else {
             rejectCode = intersectionChecking(newPoly, finalPolyList, intPts, pstats, triplePoints);
@@ -0,0 +1,285 @@
+#include "profile.h"
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <sys/resource.h>
+#include "logFile.h"
+
+extern Logger logger;
+
+/*
+    Low overhead instrumentation of DFNGen. Instrumented functions create a
+    ProfileTimer (see profile.h) which counts calls and ticks. The totals, and
+    optionally a time series of them taken every 200 accepted fractures, are
+    written to profile.json at the end of the run.
+*/
+
+/*! Turns the instrumentation on. Set with the --profile or
+    --profile-series command line options. Only the thread which calls
+    startProfiling() is profiled, worker threads (e.g. the bulk insertion of
+    user polygons) do not update the counters. */
+thread_local bool profiling = false;
+
+/*! Calls and ticks per instrumented function, indexed by ProfileCounter */
+ProfileEntry profileEntries[PROF_COUNT];
+
+/*! Ticks of reading the tick counter, subtracted from every timed call */
+unsigned long long profileOverhead = 0;
+
+/*! Names used in profile.json, same order as enum ProfileCounter */
+static const char *profileNames[PROF_COUNT] = {
+    "checkBoundingBox",
+    "findIntersections",
+    "intersectionChecking",
+    "FRAM",
+    "checkCloseEdge",
+    "shrinkIntersection",
+    "checkDistToOldIntersections",
+    "checkDistToNewIntersections",
+    "checkForTripleIntersections",
+    "domainTruncation",
+    "clusterGroups",
+    "writeGraphData",
+    "writePolys",
+    "writeBinaryOutput",
+    "writeEcpm",
+    "writeIntersectionFiles",
+    "writePolysInp",
+    "writeParamsFile",
+    "writeRadiiFile",
+    "writeRejectionStats",
+    "writeUserRejectedFractureInformation",
+    "writeShapeFams",
+    "writeFractureTranslations",
+    "writeConnectivity",
+    "writeRotationData",
+    "writeNormalVectors",
+    "writeRejectsPerAttempt",
+    "writeFinalPolyRadii",
+    "writeFinalPolyArea",
+    "writeBoundaryFiles",
+    "writeRadiiPerFamily",
+    "writeTriplePts",
+    "input",
+    "userFractures",
+    "insertion",
+    "postProcessing",
+    "output"
+};
+
+/*! Snapshot of the hot path counters, taken at the 200 fracture progress interval */
+struct ProfileSnapshot {
+    unsigned int accepted;
+    unsigned long long rejected;
+    double seconds;
+    ProfileEntry entries[PROF_WRITE_GRAPH];
+};
+
+static bool recordTimeSeries = false;
+static std::vector<ProfileSnapshot> timeSeries;
+static std::chrono::steady_clock::time_point startTime;
+static unsigned long long startTicks;
+static ProfileCounter currentPhase = PROF_COUNT;
+static unsigned long long phaseStart;
+
+/* startProfiling() **************************************************************************/
+/*! Turns on the instrumentation and starts the clock used to convert ticks to seconds
+    Arg 1: True to record the counters every 200 accepted fractures */
+void startProfiling(bool timeSeriesOn) {
+    profiling = true;
+    recordTimeSeries = timeSeriesOn;
+    
+    for (int i = 0; i < PROF_COUNT; i++) {
+        profileEntries[i].calls = 0;
+        profileEntries[i].ticks = 0;
+    }
+    
+    // Cheapest of a few back to back reads of the tick counter
+    profileOverhead = ~0ULL;
+    
+    for (int i = 0; i < 1000; i++) {
+        unsigned long long start = profileTicks();
+        profileOverhead = std::min(profileOverhead, profileTicks() - start);
+    }
+    
+    startTime = std::chrono::steady_clock::now();
+    startTicks = profileTicks();
+}
+
+/* restartProfiling() **********************************************************************/
+/*! Clears the counters and restarts the clock, keeping the current phase. Used by ensemble
+    realizations (see ensemble.cpp), which start from the state of the parent process. */
+void restartProfiling() {
+    if (!profiling) {
+        return;
+    }
+    
+    ProfileCounter phase = currentPhase;
+    startProfiling(recordTimeSeries);
+    timeSeries.clear();
+    currentPhase = phase;
+    phaseStart = startTicks;
+}
+
+/* profilePhase() ***************************************************************************/
+/*! Ends the current phase of main() and starts the next one
+    Arg 1: Next phase, PROF_COUNT to end the last phase */
+void profilePhase(ProfileCounter phase) {
+    if (!profiling) {
+        return;
+    }
+    
+    unsigned long long ticks = profileTicks();
+    
+    if (currentPhase != PROF_COUNT) {
+        profileEntries[currentPhase].calls++;
+        profileEntries[currentPhase].ticks += ticks - phaseStart;
+    }
+    
+    currentPhase = phase;
+    phaseStart = ticks;
+}
+
+/* profileSnapshot() *************************************************************************/
+/*! Records the hot path counters for the time series, if turned on
+    Arg 1: Number of accepted fractures
+    Arg 2: Number of rejected fractures */
+void profileSnapshot(unsigned int acceptedCount, unsigned long long rejectedCount) {
+    if (!profiling || !recordTimeSeries) {
+        return;
+    }
+    
+    ProfileSnapshot snapshot;
+    snapshot.accepted = acceptedCount;
+    snapshot.rejected = rejectedCount;
+    snapshot.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    
+    for (int i = 0; i < PROF_WRITE_GRAPH; i++) {
+        snapshot.entries[i] = profileEntries[i];
+    }
+    
+    timeSeries.push_back(snapshot);
+}
+
+/* peakRss() *******************************************************************************/
+/*! Peak resident set size of DFNGen. Uses VmHWM of /proc/self/status where available,
+    getrusage() reports the peak of the parent process as well if DFNGen was started
+    with vfork().
+    Return: Peak RSS in kilobytes */
+static long peakRss() {
+    std::ifstream status("/proc/self/status");
+    std::string word;
+    
+    while (status >> word) {
+        if (word == "VmHWM:") {
+            long kb;
+            status >> kb;
+            return kb;
+        }
+    }
+    
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/* writeEntries() ****************************************************************************/
+/*! Writes counters as JSON members "name": {"calls": , "ticks": , "seconds": }
+    Arg 1: Output stream
+    Arg 2: First counter
+    Arg 3: Last counter + 1
+    Arg 4: Ticks per second
+    Arg 5: Indentation */
+static void writeEntries(std::ofstream &file, int first, int last, double ticksPerSecond, std::string indent) {
+    for (int i = first; i < last; i++) {
+        file << indent << "\"" << profileNames[i] << "\": {\"calls\": " << profileEntries[i].calls
+             << ", \"ticks\": " << profileEntries[i].ticks
+             << ", \"seconds\": " << profileEntries[i].ticks / ticksPerSecond << "}"
+             << (i + 1 < last ? ",\n" : "\n");
+    }
+}
+
+/* writeProfile() ****************************************************************************/
+/*! Writes profile.json with the calls, ticks and seconds of every instrumented
+    function and phase, and the time series if it was recorded.
+    Arg 1: Path to output folder
+    Arg 2: Number of accepted fractures
+    Arg 3: Number of rejected fractures */
+void writeProfile(std::string output, unsigned int acceptedCount, unsigned long long rejectedCount) {
+    if (!profiling) {
+        return;
+    }
+    
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+#if defined(__x86_64__) || defined(__i386__)
+    std::string tickUnit = "cycles";
+    double ticksPerSecond = seconds > 0 ? (profileTicks() - startTicks) / seconds : 1;
+#else
+    std::string tickUnit = "nanoseconds";
+    double ticksPerSecond = 1e9;
+#endif
+    std::string fileName = output + "/profile.json";
+    std::ofstream file(fileName.c_str(), std::ofstream::out | std::ofstream::trunc);
+    
+    if (!file.is_open()) {
+        std::string logString = "WARNING: Unable to write " + fileName + "\n";
+        logger.writeLogFile(WARNING,  logString);
+        return;
+    }
+    
+    file << std::setprecision(9);
+    file << "{\n";
+    file << "  \"tickUnit\": \"" << tickUnit << "\",\n";
+    file << "  \"ticksPerSecond\": " << ticksPerSecond << ",\n";
+    file << "  \"timerOverheadTicks\": " << profileOverhead << ",\n";
+    file << "  \"sampleRate\": {\"" << profileNames[PROF_CHECK_BOUNDING_BOX] << "\": " << PROFILE_SAMPLE_RATE << "},\n";
+    file << "  \"wallSeconds\": " << seconds << ",\n";
+    file << "  \"peakRssKB\": " << peakRss() << ",\n";
+    file << "  \"accepted\": " << acceptedCount << ",\n";
+    file << "  \"rejected\": " << rejectedCount << ",\n";
+    file << "  \"phases\": {\n";
+    writeEntries(file, PROF_PHASE_INPUT, PROF_COUNT, ticksPerSecond, "    ");
+    file << "  },\n";
+    file << "  \"generation\": {\n";
+    writeEntries(file, 0, PROF_WRITE_GRAPH, ticksPerSecond, "    ");
+    file << "  },\n";
+    file << "  \"output\": {\n";
+    writeEntries(file, PROF_WRITE_GRAPH, PROF_PHASE_INPUT, ticksPerSecond, "    ");
+    file << "  }";
+    
+    if (recordTimeSeries) {
+        // Column names of the "calls" and "ticks" arrays
+        file << ",\n  \"timeSeriesCounters\": [";
+        
+        for (int i = 0; i < PROF_WRITE_GRAPH; i++) {
+            file << "\"" << profileNames[i] << "\"" << (i + 1 < PROF_WRITE_GRAPH ? ", " : "");
+        }
+        
+        file << "],\n  \"timeSeries\": [\n";
+        
+        for (unsigned int s = 0; s < timeSeries.size(); s++) {
+            file << "    {\"accepted\": " << timeSeries[s].accepted << ", \"rejected\": " << timeSeries[s].rejected
+                 << ", \"seconds\": " << timeSeries[s].seconds << ", \"calls\": [";
+            
+            for (int i = 0; i < PROF_WRITE_GRAPH; i++) {
+                file << timeSeries[s].entries[i].calls << (i + 1 < PROF_WRITE_GRAPH ? ", " : "");
+            }
+            
+            file << "], \"ticks\": [";
+            
+            for (int i = 0; i < PROF_WRITE_GRAPH; i++) {
+                file << timeSeries[s].entries[i].ticks << (i + 1 < PROF_WRITE_GRAPH ? ", " : "");
+            }
+            
+            file << "]}" << (s + 1 < timeSeries.size() ? ",\n" : "\n");
+        }
+        
+        file << "  ]";
+    }
+    
+    file << "\n}\n";
+    file.close();
+    std::string logString = "Profile written to " + fileName + "\n";
+    logger.writeLogFile(INFO,  logString);
+}
+
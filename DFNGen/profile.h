@@ -0,0 +1,142 @@
+#ifndef _profile_h_
+#define _profile_h_
+#include <string>
+#include <vector>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*! Instrumented functions and phases of DFNGen. Times are inclusive: the time
+    of a function contains the time of the instrumented functions it calls
+    (e.g. checkCloseEdge() contains shrinkIntersection()). Names are in
+    profile.cpp, keep both in the same order. */
+enum ProfileCounter {
+    // Generation hot path
+    PROF_CHECK_BOUNDING_BOX,
+    PROF_FIND_INTERSECTIONS,
+    PROF_INTERSECTION_CHECKING,
+    PROF_FRAM,
+    PROF_CHECK_CLOSE_EDGE,
+    PROF_SHRINK_INTERSECTION,
+    PROF_DIST_TO_OLD_INTERSECTIONS,
+    PROF_DIST_TO_NEW_INTERSECTIONS,
+    PROF_TRIPLE_INTERSECTIONS,
+    PROF_DOMAIN_TRUNCATION,
+    PROF_CLUSTER_GROUPS,
+    // Output writers
+    PROF_WRITE_GRAPH,
+    PROF_WRITE_POLYS,
+    PROF_WRITE_BINARY,
+    PROF_WRITE_ECPM,
+    PROF_WRITE_INTERSECTIONS,
+    PROF_WRITE_POLYS_INP,
+    PROF_WRITE_PARAMS,
+    PROF_WRITE_RADII,
+    PROF_WRITE_REJECTION_STATS,
+    PROF_WRITE_USER_REJECTIONS,
+    PROF_WRITE_SHAPE_FAMS,
+    PROF_WRITE_TRANSLATIONS,
+    PROF_WRITE_CONNECTIVITY,
+    PROF_WRITE_ROTATION,
+    PROF_WRITE_NORMALS,
+    PROF_WRITE_REJECTS_PER_ATTEMPT,
+    PROF_WRITE_FINAL_RADII,
+    PROF_WRITE_FINAL_AREA,
+    PROF_WRITE_BOUNDARY,
+    PROF_WRITE_RADII_PER_FAMILY,
+    PROF_WRITE_TRIPLE_POINTS,
+    // Phases of main()
+    PROF_PHASE_INPUT,
+    PROF_PHASE_USER_FRACTURES,
+    PROF_PHASE_INSERTION,
+    PROF_PHASE_POST_PROCESSING,
+    PROF_PHASE_OUTPUT,
+    PROF_COUNT
+};
+
+/*! ProfileSampledTimer times one call in PROFILE_SAMPLE_RATE */
+#define PROFILE_SAMPLE_RATE 64
+
+/*! Number of calls and cumulative ticks of an instrumented function */
+struct ProfileEntry {
+    unsigned long long calls;
+    unsigned long long ticks;
+};
+
+/*! Set with the --profile command line option, per thread (see profile.cpp) */
+extern thread_local bool profiling;
+extern ProfileEntry profileEntries[PROF_COUNT];
+extern unsigned long long profileOverhead;
+
+/*! Tick counter used by the profiler. CPU time stamp counter (cycles) on x86,
+    nanoseconds elsewhere. Converted to seconds in the report. */
+inline unsigned long long profileTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/*! Ticks of a timed call without the cost of reading the tick counter
+    Arg 1: Ticks at the start of the call
+    Return: Elapsed ticks */
+inline unsigned long long profileElapsed(unsigned long long start) {
+    unsigned long long ticks = profileTicks() - start;
+    return ticks > profileOverhead ? ticks - profileOverhead : 0;
+}
+
+/*! Scoped timer, adds the lifetime of the object to a counter.
+    Does nothing when profiling is off. */
+class ProfileTimer {
+  public:
+    explicit ProfileTimer(ProfileCounter counter) : counter(counter), start(profiling ? profileTicks() : 0) {}
+    ~ProfileTimer() {
+        if (profiling) {
+            profileEntries[counter].calls++;
+            profileEntries[counter].ticks += profileElapsed(start);
+        }
+    }
+  
+  private:
+    ProfileCounter counter;
+    unsigned long long start;
+};
+
+/*! Scoped timer for tiny functions called for every pair of fractures
+    (checkBoundingBox()). Counts every call, but only times one call in
+    PROFILE_SAMPLE_RATE and scales its ticks, reading the tick counter on every
+    call would double the run time. */
+class ProfileSampledTimer {
+  public:
+    explicit ProfileSampledTimer(ProfileCounter counter) : counter(counter), start(0) {
+        sampled = profiling && ++profileEntries[counter].calls % PROFILE_SAMPLE_RATE == 0;
+        
+        if (sampled) {
+            start = profileTicks();
+        }
+    }
+    ~ProfileSampledTimer() {
+        if (sampled) {
+            profileEntries[counter].ticks += profileElapsed(start) * PROFILE_SAMPLE_RATE;
+        }
+    }
+    
+  private:
+    ProfileCounter counter;
+    bool sampled;
+    unsigned long long start;
+};
+
+/*! Times a single call, e.g. PROFILE_CALL(PROF_WRITE_POLYS, writePolys(...)) */
+#define PROFILE_CALL(counter, call) do { ProfileTimer profileTimer(counter); call; } while (0)
+
+void startProfiling(bool timeSeriesOn);
+void restartProfiling();
+void profilePhase(ProfileCounter phase);
+void profileSnapshot(unsigned int acceptedCount, unsigned long long rejectedCount);
+void writeProfile(std::string output, unsigned int acceptedCount, unsigned long long rejectedCount);
+
+#endif
+
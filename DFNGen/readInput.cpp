@@ -14,583 +14,7 @@ using std::cout;
 using std::endl;
 using std::string;
 
-/*! DFN generation stop condition. 0 - nPoly option, 1 - P32 option.*/
-short stopCondition;
-
-/*! Number of polygons to place in the DFN when uisng nPoly stopCondition option.*/
-unsigned int nPoly;
-
-/*! Domain size with dimension x*y*z for DFN, centered at the origin. */
-double domainSize[3];
-
-/*! Minimum feature size, FRAM parameter.*/
-double h;
-
-/*! Percent to increase the size of the pre-generated radii lists, per family.
-    Example: 0.2 will increase the size of the list by %20. See example input files
-    for more details. */
-float radiiListIncrease;
-
-/*! This option disables the FRAM algorithm. There will be no
-   fracture rejections or fine mesh. Defaults visualizationMode to 1*/
-bool disableFram;
-
-/*! Used during meshing:
-        0 - Creates a fine mesh, according to h parameter;
-        1 - Produce only first round of triangulations. In this case no
-            modeling of flow and transport is possible.*/
-bool visualizationMode;
-
-/*! This option uses a relaxed version of the FRAM algorithm. The mesh may not
-be perfectly conforming*/
-bool rFram;
-
-/*! Accept or reject triple intersections
-        False - Off (Reject)
-        True  - On  (Accept)*/
-bool tripleIntersections;
-
-/*! DFN will only keep clusters with connections to
-    domain boundaries which are set to 1:
-
-    boundaryFaces[0] = +X domain boundary
-    boundaryFaces[1] = -X domain boundary
-    boundaryFaces[2] = +Y domain boundary
-    boundaryFaces[3] = -Y domain boundary
-    boundaryFaces[4] = +Z domain boundary
-    boundaryFaces[5] = -Z domain boundary*/
-bool boundaryFaces[6];
-
-/*! 0 - Keep any clusters which connects the specified
-        boundary faces in boundaryFaces option below
-    1 - Keep only the largest cluster which connects
-        the specified boundary faces in boundaryFaces option below.
-
-    If ignoreBoundaryFaces is also set to 1, DFNGen will keep the largest
-    cluster which connects at least any two sides of the domain.*/
-bool keepOnlyLargestCluster;
-
-/*! 0 - remove isolated fractures and clusters
-    1 - Keep isolated fractures and clusters
-    */
-bool keepIsolatedFractures;
-
-/*! Useful for debugging,
-    This option will print all fracture rejection reasons as they occur.
-        0 - Disable
-        1 - Print all rejection reasons to screen */
-bool printRejectReasons;
-
-/*! Outputs radii files after isolated fracture removal.
-    One file per family.
-        0: Do not create output files of radii per family
-        1: Creates output files per family, containing a list
-           of the family's fracture radii that is in the final DFN*/
-bool outputFinalRadiiPerFamily;
-
-/*! Outputs radii files before isolated fracture removal.
-    One file per family.
-        0: Do not create output files of radii per family
-        1: Creates output files per family, containing a list
-           of the family's fracture radii in the domain before isolated
-           fracture removal.*/
-bool outputAcceptedRadiiPerFamily;
-
-/*! Only output select files for ECPM upscaling
-        0: Output all files
-        1: Only output files required for ECPM upscaling.
-        polygon.dat, radii_final.dat */
-bool ecpmOutput = false;
-
-/*! Beta is the rotation around the polygon's normal vector
-        0 - Uniform distribution [0, 2PI)
-        1 - Constant angle (specefied below by 'ebeta')*/
-bool *ebetaDistribution;
-
-/*! Beta is the rotation around the polygon's normal vector
-        0: Uniform distribution [0, 2PI)
-        1: Constant angle (specefied below by 'rbeta')*/
-bool *rbetaDistribution;
-
-/*! False - User ellipses will be inserted first
-    True  - User rectangles will be inserted first*/
-bool insertUserRectanglesFirst;
-
-/*! Inserts the largest possible fracture for each defined fracture family,
-    defined by the user-defined maxium radius
-        0 - Off (Do not force insertion of larest fractures)
-        1 - On  (Force insertion of largest fractures)*/
-bool forceLargeFractures;
-
-/*! Seed for random generator.*/
-unsigned int seed;
-
-/*! Size increase for inserting fracture centers outside the domain.
-    Fracture will be truncated based on domainSize above.
-    Increases the entire width by this ammount. So, {1,1,1} will increase
-    the domain by adding .5 to the +x, and subbtracting .5 to the -x, etc*/
-float domainSizeIncrease[3];
-
-/*! Selection of orientation Option
-    0 - spherical coordinates
-    1 - trend / plunge
-    2 - dip / strike .*/
-int orientationOption;
-
-/*! Number of rectangular families defined below.
-    Having this option = 0 will ignore all rectangular family variables.*/
-int nFamRect;
-
-/*! Number of ellipse families defined below.
-    Having this option = 0 will ignore all rectangle family variables.*/
-int nFamEll;
-
-/*! Each element is the probability of chosing a fracture from
-    the element's corresponding family to be inserted into the DFN.
-
-    The famProb elements should add up to 1.0 (for %100).
-    The probabilities are listed in order of families starting with all
-    stochastic ellipses, and then all stochastic rectangles.
-
-    For example:
-    If  then there are two ellipse families, each with probabiliy .3,
-    and two rectangle families, each with probabiliy .2, famProb will be:
-    famProb: {.3,.3,.2,.2}, famProb elements must add to 1*/
-float *famProb;
-
-/*! Holds a copy of famProb. famProb elements can change as different families
-    hit their P32 requirement when using the P32 stopCondition option.*/
-float *famProbOriginal;
-
-/*! Mandatory parameter if using statistically generated ellipses.
-    Statistical distribution options:
-
-    Holds number of elements equal to the number of shape families.
-
-        1 - Log-normal distribution
-        2 - Truncated power law distribution
-        3 - Exponential distribution
-        4 - Constant*/
-int *edistr;
-
-/*! Aspect ratio array for stochastic ellipses.*/
-float *easpect;
-
-/*! Number of vertices used in creating each elliptical
-    fracture family. Number of elements must match number
-    of ellipse families
-
-    Holds number of elements equal to the number of ellipse families. */
-unsigned int *enumPoints;
-
-/*! All angles for ellipses are in:
-        0 - degrees
-        1 - radians (Must use numerical value for PI)*/
-bool  eAngleOption;
-
-/*! First Ellipse fracture orientation.
-    If orientationOption = 0 (Spherical coordinates)
-    This The angle the normal vector makes with the z-axis
-    If  orientationOption = 1
-    This is the trend of Ellipse fracture orientation.
-    If  orientationOption = 2
-    This is the mean dip of Ellipse fracture orientation.
-    */
-float *eAngleOne;
-
-/*! Second Ellipse fracture orientation.
-    If orientationOption = 0 (Spherical coordinates)
-    The angle the projection of the normal
-    onto the x-y plane makes with the x-axis
-    If  orientationOption = 1
-    This is the plunge of Ellipse fracture orientation.
-    If  orientationOption = 2
-    This is the mean strike of Ellipse fracture orientation.*/
-float *eAngleTwo;
-
-
-/*! Rotation around the fractures' normal vector.
-    Ellipse family parameter.*/
-float *ebeta;
-
-/*! Parameter for the fisher distribnShaprutions. The
-    bigger, the more similar (less diverging) are the
-    elliptical familiy's normal vectors.*/
-float *ekappa;
-
-/*! Log-normal ellipse parameter. Mean of the underlying normal distribution.*/
-float *eLogMean;
-
-/*! Log-normal ellipse parameter. Standard deviation of the underlying normal distribution*/
-float *esd;
-
-/*! Exponential ellipse parameter. Mean values for exponential distributions, defined per family.*/
-float *eExpMean;
-
-/*! Log-normal rectangle parameter. Minimum radius.*/
-float *rLogMin;
-
-/*! Log-normal rectangle parameter. Maximum radius.*/
-float *rLogMax;
-
-/*! Exponential rectangle parameter. Minimum radius.*/
-float *rExpMin;
-
-/*! Exponential rectangle parameter. Maximum radius.*/
-float *rExpMax;
-
-/*! Log-normal ellipse parameter. Minimum radius.*/
-float *eLogMin;
-
-/*! Log-normal ellipse parameter. Maximum radius.*/
-float *eLogMax;
-
-/*! Exponential ellipse parameter. Minimum radius.*/
-float *eExpMin;
-
-/*! Exponential ellipse parameter. Maximum radius.*/
-float *eExpMax;
-
-/*! Contant ellipse parameter. Constant radius.*/
-float *econst;
-
-/*! Truncated power-law ellipse parameter. Minimum radius.*/
-float *emin;
-
-/*! Truncated power-law ellipse parameter. Maximum radius.*/
-float *emax;
-
-/*! Truncated power-law ellipse distribution parameter.*/
-float *ealpha;
-
-/*! Elliptical families target fracture intensities per family
-    when using stopCondition = 1, P32 option.*/
-float *e_p32Targets;
-
-/*! Mandatory parameter if using statistically generated rectangles.
-
-    Holds number of elements equal to the number of shape families.\
-
-    Rectangle statistical distribution options:
-        1 - log-normal distribution
-        2 - truncated power law distribution
-        3 - exponential distribution
-        4 - constant*/
-unsigned int *rdistr;
-
-/*! Aspect ratio for stochasic rectangles.*/
-float *raspect;
-
-/*! All angles from input file for stochastic rectangles are in:
-        True  - Degrees
-        False - Radians */
-bool rAngleOption;
-
-/*! 0 - Ignore this option, keep all fractures.
-
-   >0 - Size of minimum fracture radius. Fractures smaller than
-        defined radius will be removed AFTER DFN generation.
-
-        Minimum and maximum size options under fracture family
-        distributions will still be used while generating the DFN.*/
-float removeFracturesLessThan;
-
-
-/*! First Rectangle fracture orientation.
-    If orientationOption = 0 (Spherical coordinates)
-    This The angle the normal vector makes with the z-axis
-    If orientationOption = 1
-    This is the trend of Rectangle fracture orientation.
-    If orientationOption = 2
-    This is the mean dip of Rectangle fracture orientation.
-    */
-float *rAngleOne;
-
-/*! Second Rectangle fracture orientation.
-    If orientationOption = 0 (Spherical coordinates)
-    The angle the projection of the normal
-    onto the x-y plane makes with the x-axis
-    If  orientationOption = 1
-    This is the plunge of Rectangle fracture orientation.
-    If orientationOption = 2
-    This is the mean strike of Rectangle fracture orientation. */
-float *rAngleTwo;
-
-/*! Rotation around the normal vector.*/
-float *rbeta;
-
-/*! Parameter for the fisher distribnShaprutions. The
-    bigger, the more similar (less diverging) are the
-    rectangle family's normal vectors.*/
-float *rkappa;
-
-/*! Log-normal rectangle parameter. Standard deviation of the underlying normal distribution*/
-float *rLogMean;
-
-/*! Log-normal rectangle parameter. Standard deviation of the underlying normal distribution*/
-float *rsd;
-
-/*! Truncated power-law rectangle parameter. Minimum radius.*/
-float *rmin;
-
-/*! Truncated power-law rectangle parameter. Maximum radius.*/
-float *rmax;
-
-/*! Truncated power-law rectangle distribution parameter.*/
-float *ralpha;
-
-/*! Rectangular families target fracture intensities per family
-    when using stopCondition = 1, P32 option.*/
-float *r_p32Targets;
-
-/*! Exponential rectangle parameter. Maximum radius.*/
-float *rExpMean;
-
-/*! Constant rectangle parameter. Constant radius.*/
-float *rconst;
-
-/*! True  - The user is using user defined ellipses.
-    False - No user defined ellipses are being used. */
-bool userEllipsesOnOff;
-
-/*! Number of defined, user defined ellipses.*/
-int nUserEll;
-
-/*! All angles from input file for stochastic ellipses are in:
-        True  - Degrees
-        False - Radians */
-bool ueAngleOption;
-
-/*! User ellipses radii array. */
-float *ueRadii;
-
-/*! User ellipses beta array. */
-float *ueBeta;
-
-/*! User ellipses aspect ratio array. */
-float *ueaspect;
-
-/*! User ellipses translation array.*/
-double *uetranslation;
-
-/*! User Orientation Option for ellipses
-    0 = normal vector
-    1 = trend / plunge
-    2 = dip / strike
-*/
-int userEllOrientationOption;
-
-/*! User ellipses normal vector array. */
-double *uenormal;
-
-/*! User ellipses trend and plunge array.*/
-double *ueTrendPlunge;
-
-/*! User ellipses dip and strike array.*/
-double *ueDipStrike;
-
-/*! User ellipses number of points per ellipse array. */
-unsigned int *uenumPoints;
-
-/*! True  - The user is using user defined rectangles.
-    False - No user defined rectangles are being used. */
-bool userRectanglesOnOff;
-
-/*! True  - User rectangles defined by coordinates are being used.
-    False - No rectangles defined by coordinates are being used.*/
-bool userRecByCoord;
-
-/*! True  - User ellipses defined by coordinates are being used.
-    False - No ellpsies defined by coordinates are being used.*/
-bool userEllByCoord;
-
-/*! True  - User polygons defined by coordinates are being used.
-    False - No polygons defined by coordinates are being used.*/
-bool userPolygonByCoord;
-
-/*! False - Permeability of each fracture is a function of fracture aperture,
-            given by k=(b^2)/12, where b is an aperture and k is permeability
-    True  - Constant permeabilty for all fractures*/
-// bool permOption;
-
-/*! Caution: Can create very large files.
-    Outputs all fractures which were generated during
-    DFN generation (Accepted + Rejected).
-        False: Do not output all radii file.
-        True:  Include file of all raddii, acepted + rejected fractures,
-               in output files (radii_All.dat). */
-bool outputAllRadii;
-
-/*! Number of user defined rectangles.*/
-int nUserRect;
-
-/*! User rectangles radii array.*/
-float *urRadii;
-
-/*! All angles from input file for stochastic rectangles are in:
-        True  - Degrees
-        False - Radians */
-bool urAngleOption;
-
-/*! User rectangles beta array.*/
-float *urBeta;
-
-/*! User rectangles aspect ratio array.*/
-float *uraspect;
-
-/*! User rectangles translation array. */
-double *urtranslation;
-
-/*! User Orientation Option for rectangles
-    0 = normal vector
-    1 = trend / plunge
-    2 = dip / strike
-    */
-int userRectOrientationOption;
-
-/*! User rectangles normal vector array.*/
-double *urnormal;
-
-/*! User rectangles trend and plunge array.*/
-double *urTrendPlunge;
-
-/*! User rectangles dip and strike array.*/
-double *urDipStrike;
-
-/*! Number of user rectangles defined by coordinates.*/
-unsigned int nRectByCoord;
-
-/*! Number of user ellipses defined by coordinates.*/
-unsigned int nEllByCoord;
-
-/*! Number of nodes for user defined ellipses by coordinates */
-unsigned int nEllNodes;
-
-/*! Array of rectangle coordiates.
-    Number of elements = 4 * 3 * nRectByCoord*/
-double *userRectCoordVertices;
-
-/*! Array of ellipse coordiates.
-    Number of elements =  3 * nEllNodes * nEllByCoord*/
-double *userEllCoordVertices;
-
-/*! Name of userPolygon File */
-std::string polygonFile;
-
-/*! Log-normal aperture option.
-    Mean of underlying normal distribution. */
-// float meanAperture;
-
-/*! Log-normal aperture option.
-    Standard deviation of underlying normal distribution. */
-// float stdAperture;
-
-/*! 1 - Log-normal distribution
-    2 - Aperture from transmissivity, first transmissivity is defined,
-        and then, using a cubic law, the aperture is calculated.
-    3 - Constant aperture (same aperture for all fractures)
-    4 - Length Correlated Aperture
-        Apertures are defined as a function of fracture size.*/
-//int aperture;
-
-/*! Transmissivity is calculated as transmissivity = F*R^k,
-    where F is a first element in aperturefromTransmissivity,
-    k is a second element and R is a mean radius of a polygon.
-    Aperture is calculated according to cubic law as
-    b = (transmissivity*12)^(1/3)*/
-// float apertureFromTransmissivity[2];
-
-/*! Sets all fracture apertures to constantAperture.*/
-// double constantAperture;
-
-/*! Length Correlated Aperture Option:
-    Aperture is calculated by: b=F*R^k,
-    where F is a first element in lengthCorrelatedAperture,
-    k is a second element and R is a mean radius of a polygon.*/
-// double lengthCorrelatedAperture[2];
-
-/*! Permeability for all fractures*/
-// double constantPermeability;
-
-/*! If a fracture is rejected, it will be re-translated
-    to a new position this number of times.
-
-    This helps hit distribution targets for stochastic families
-    families (Set to 1 to ignore this feature)*/
-int rejectsPerFracture;
-
-
-// Z - layers in the DFN
-/*! Number of layers defined. */
-int numOfLayers;
-
-/*! Array of layers:
-    e.g. {+z1, -z1, +z2, -z2, ... , +zn, -zn}*/
-float *layers;
-
-/*! Array of volumes for each defined layer, in the same order
-    which layers were listed.*/
-float *layerVol;
-
-/*  Defines which domain, or layer, the family belongs to.
-    Layer 0 is the entire domain ('domainSize').
-    Layers numbered > 0 correspond to layers defined above (see 'Layers:').
-    1 correspond to the first layer listed, 2 is the next layer listed, etc*/
-int *rLayer;
-
-/*! Defines which domain, or layer, the family belongs to.
-    Layer 0 is the entire domain ('domainSize').
-    Layers numbered > 0 correspond to layers defined above (see 'Layers:').
-    1 correspond to the first layer listed, 2 is the next layer listed, etc*/
-int *eLayer;
-
-// Regions in the DFN
-
-/*! Number of regions defined. */
-int numOfRegions;
-
-/*! Array of regions:
-    e.g. {+z1, -z1, +z2, -z2, ... , +zn, -zn}*/
-float *regions;
-
-/*! Array of volumes for each defined layer, in the same order
-    which regions were listed.*/
-float *regionVol;
-
-/*  Defines which domain, or regions, the family belongs to.
-    Regions 0 is the entire domain ('domainSize').
-    regions numbered > 0 correspond to regions defined above (see 'regions:').
-    1 correspond to the first layer listed, 2 is the next layer listed, etc*/
-int *rRegion;
-
-/*! Defines which domain, or regions, the family belongs to.
-    Layer 0 is the entire domain ('domainSize').
-    regions numbered > 0 correspond to regions defined above (see 'regions:').
-    1 correspond to the first layer listed, 2 is the next layer listed, etc*/
-int *eRegion;
-
-/*! flag if the domain is pruned down to a final domain size*/
-bool polygonBoundaryFlag = false;
-
-/*! Number of points on the 2D boundary of the polygon domain */
-int numOfDomainVertices;
-
-/*! Vector of points defining the 2D boundary of the domain polygon */
-std::vector<Point> domainVertices;
-
-/*! Global boolean array. Used with stopCondition = 1, P32 option.
-    Number of elements is equal to the number of stochastic shape families.
-    Elements correspond to families in the same order of the famProb array.
-    Elements are initialized to false, and are set to true once the families p32
-    requirement is met.
-    Once all elements have values all set to true, all families have had their
-    P32 requirement */
-bool *p32Status;
-
-/*! False - Use boundaryFaces option.
-    True  - Ignore boundaryFaces option, keep all clusters
-            and remove fractures with no intersections */
-bool ignoreBoundaryFaces;
+DFNInput *params = NULL;
 
 /******************************************************************/
 /*! Reads in all input variables.
@@ -599,38 +23,38 @@ bool ignoreBoundaryFaces;
 
     Arg 1: Path to input file
     Arg 2: OUTPUT, Shape array to store stochastic families*/
-void getInput(char* input, std::vector<Shape> &shapeFamily) {
+void getInput(const char *input, std::vector<Shape> &shapeFamily) {
     std::string tempstring;
     char ch;
-    std::ifstream inputFile;
+    InputReader inputFile;
     std::string logString = "DFN Generator Input File: " + std::string(input) + "\n\n";
     logger.writeLogFile(INFO,  logString);
     // Open input file and initialize variables
-    inputFile.open(input, std::ifstream::in);
-    checkIfOpen(inputFile, tempstring.c_str());
+    inputFile.open(input);
+    checkIfOpen(inputFile, input);
     searchVar(inputFile, "stopCondition:");
-    inputFile >> stopCondition;
+    inputFile >> params->stopCondition;
     searchVar(inputFile, "printRejectReasons:");
-    inputFile >> printRejectReasons;
+    inputFile >> params->printRejectReasons;
     searchVar(inputFile, "domainSize:");
-    inputFile >> ch >> domainSize[0] >> ch >> domainSize[1] >> ch >> domainSize[2];
+    inputFile >> ch >> params->domainSize[0] >> ch >> params->domainSize[1] >> ch >> params->domainSize[2];
     searchVar(inputFile, "numOfLayers:");
-    inputFile >> numOfLayers;
+    inputFile >> params->numOfLayers;
     
-    if (numOfLayers > 0 ) {
-        layers = new float[numOfLayers * 2]; // Multiply by 2 for +z and -z for each layer
-        layerVol = new float[numOfLayers];
+    if (params->numOfLayers > 0 ) {
+        params->layers.resize(params->numOfLayers * 2); // Multiply by 2 for +z and -z for each layer
+        params->layerVol.resize(params->numOfLayers);
         searchVar(inputFile, "layers:");
-        logString = "Number of Layers: " + to_string(numOfLayers);
+        logString = "Number of Layers: " + to_string(params->numOfLayers);
         logger.writeLogFile(INFO,  logString);
         
-        for (int i = 0; i < numOfLayers; i++) {
+        for (int i = 0; i < params->numOfLayers; i++) {
             int idx = i * 2;
-            inputFile >> ch >> layers[idx] >> ch >> layers[idx + 1] >> ch;
-            logString = "    Layer " + to_string(i + 1) + "{-z,+z}: {" + to_string(layers[idx]) + "," + to_string(layers[idx + 1]) + "}, Volume: ";
+            inputFile >> ch >> params->layers[idx] >> ch >> params->layers[idx + 1] >> ch;
+            logString = "    Layer " + to_string(i + 1) + "{-z,+z}: {" + to_string(params->layers[idx]) + "," + to_string(params->layers[idx + 1]) + "}, Volume: ";
             logger.writeLogFile(INFO,  logString);
-            layerVol[i] = domainSize[0] * domainSize[1] * (std::abs(layers[idx + 1] - layers[idx]));
-            logString = to_string(layerVol[i]) + "m^3\n";
+            params->layerVol[i] = params->domainSize[0] * params->domainSize[1] * (std::abs(params->layers[idx + 1] - params->layers[idx]));
+            logString = to_string(params->layerVol[i]) + "m^3\n";
             logger.writeLogFile(INFO,  logString);
         }
         
@@ -639,22 +63,22 @@ void getInput(char* input, std::vector<Shape> &shapeFamily) {
     }
     
     searchVar(inputFile, "numOfRegions:");
-    inputFile >> numOfRegions;
+    inputFile >> params->numOfRegions;
     
-    if (numOfRegions > 0 ) {
-        regions = new float[numOfRegions * 6]; // Multiply by 6 xmin, xmax, ymin, ymax, zmin, zmax
-        regionVol = new float[numOfRegions];
+    if (params->numOfRegions > 0 ) {
+        params->regions.resize(params->numOfRegions * 6); // Multiply by 6 xmin, xmax, ymin, ymax, zmin, zmax
+        params->regionVol.resize(params->numOfRegions);
         searchVar(inputFile, "regions:");
-        logString = "Number of Regions: " + to_string(numOfRegions) + "\n";
+        logString = "Number of Regions: " + to_string(params->numOfRegions) + "\n";
         logger.writeLogFile(INFO,  logString);
         
-        for (int i = 0; i < numOfRegions; i++) {
+        for (int i = 0; i < params->numOfRegions; i++) {
             int idx = i * 6;
-            inputFile >> ch >> regions[idx] >> ch >> regions[idx + 1] >> ch >> regions[idx + 2] >> ch >> regions[idx + 3] >> ch >> regions[idx + 4] >> ch >> regions[idx + 5] >> ch;
-            logString = " Region " + to_string(i + 1) + ": {-x,+x,-y,+y,-z,+z}: {" + to_string(regions[idx]) + "," + to_string(regions[idx + 1]) + "," + to_string(regions[idx + 2]) + "," + to_string(regions[idx + 3]) + "," + to_string(regions[idx + 4]) + "," + to_string(regions[idx + 5]) + "}\n";
+            inputFile >> ch >> params->regions[idx] >> ch >> params->regions[idx + 1] >> ch >> params->regions[idx + 2] >> ch >> params->regions[idx + 3] >> ch >> params->regions[idx + 4] >> ch >> params->regions[idx + 5] >> ch;
+            logString = " Region " + to_string(i + 1) + ": {-x,+x,-y,+y,-z,+z}: {" + to_string(params->regions[idx]) + "," + to_string(params->regions[idx + 1]) + "," + to_string(params->regions[idx + 2]) + "," + to_string(params->regions[idx + 3]) + "," + to_string(params->regions[idx + 4]) + "," + to_string(params->regions[idx + 5]) + "}\n";
             logger.writeLogFile(INFO,  logString);
-            regionVol[i] = (std::abs(regions[idx + 1] - regions[idx])) * (std::abs(regions[idx + 3] - regions[idx + 2])) * (std::abs(regions[idx + 5] - regions[idx + 4])) ;
-            logString = " Volume: " + to_string(regionVol[i]) + "m^3\n";
+            params->regionVol[i] = (std::abs(params->regions[idx + 1] - params->regions[idx])) * (std::abs(params->regions[idx + 3] - params->regions[idx + 2])) * (std::abs(params->regions[idx + 5] - params->regions[idx + 4])) ;
+            logString = " Volume: " + to_string(params->regionVol[i]) + "m^3\n";
             logger.writeLogFile(INFO,  logString);
         }
         
@@ -663,80 +87,114 @@ void getInput(char* input, std::vector<Shape> &shapeFamily) {
     }
     
     searchVar(inputFile, "h:");
-    inputFile >> h;
+    inputFile >> params->h;
     searchVar(inputFile, "disableFram:");
-    inputFile >> disableFram;
+    inputFile >> params->disableFram;
     
-    if (disableFram == true) {
+    if (params->disableFram == true) {
         logString = "\nFRAM IS DISABLED\n";
         logger.writeLogFile(INFO,  logString);
     }
     
     searchVar(inputFile, "rFram:");
-    inputFile >> rFram;
+    inputFile >> params->rFram;
     
-    if (rFram == true) {
+    if (params->rFram == true) {
         logString = "Running with relaxed FRAM. Mesh may not be fully conforming\n";
         logger.writeLogFile(INFO,  logString);
     }
     
     searchVar(inputFile, "tripleIntersections:");
-    inputFile >> tripleIntersections;
+    inputFile >> params->tripleIntersections;
     searchVar(inputFile, "forceLargeFractures:");
-    inputFile >> forceLargeFractures;
+    inputFile >> params->forceLargeFractures;
     searchVar(inputFile, "visualizationMode:");
-    inputFile >> visualizationMode;
+    inputFile >> params->visualizationMode;
     
-    if (disableFram == true) {
-        visualizationMode = 1;
+    if (params->disableFram == true) {
+        params->visualizationMode = 1;
     }
     
     searchVar(inputFile, "outputAllRadii:");
-    inputFile >> outputAllRadii;
+    inputFile >> params->outputAllRadii;
     searchVar(inputFile, "outputFinalRadiiPerFamily:");
-    inputFile >> outputFinalRadiiPerFamily;
+    inputFile >> params->outputFinalRadiiPerFamily;
     searchVar(inputFile, "outputAcceptedRadiiPerFamily:");
-    inputFile >> outputAcceptedRadiiPerFamily;
-    // searchVar(inputFile, "ecpmOutput:");
-    // inputFile >> ecpmOutput;
+    inputFile >> params->outputAcceptedRadiiPerFamily;
+    
+    if (findVar(inputFile, "ecpmOutput:")) {
+        inputFile >> params->ecpmOutput;
+    }
+    
+    if (params->ecpmOutput) {
+        searchVar(inputFile, "ecpmCellSize:");
+        inputFile >> params->ecpmCellSize;
+        searchVar(inputFile, "ecpmAperture:");
+        inputFile >> params->ecpmAperture;
+        searchVar(inputFile, "ecpmMatrixPorosity:");
+        inputFile >> params->ecpmMatrixPorosity;
+        searchVar(inputFile, "ecpmMatrixPerm:");
+        inputFile >> params->ecpmMatrixPerm;
+        
+        if (findVar(inputFile, "ecpmCorrectionFactor:")) {
+            inputFile >> params->ecpmCorrectionFactor;
+        }
+        
+        if (params->ecpmCellSize <= 0 || params->ecpmAperture <= 0 || params->ecpmMatrixPerm < 0 || params->ecpmMatrixPorosity < 0 || params->ecpmMatrixPorosity > 1) {
+            logString = "ERROR: ecpmCellSize and ecpmAperture must be positive, ecpmMatrixPerm must not be negative and ecpmMatrixPorosity must be between 0 and 1\n";
+            logger.writeLogFile(ERROR,  logString);
+            throw DFNError();
+        }
+        
+        for (int i = 0; i < 3; i++) {
+            double cells = std::floor(params->domainSize[i] / params->ecpmCellSize + 0.5);
+            
+            if (cells < 1 || std::fabs(cells * params->ecpmCellSize - params->domainSize[i]) > 1e-8 * params->domainSize[i]) {
+                logString = "ERROR: ecpmCellSize " + to_string(params->ecpmCellSize) + " does not evenly divide the domain size\n";
+                logger.writeLogFile(ERROR,  logString);
+                throw DFNError();
+            }
+        }
+    }
+    
     searchVar(inputFile, "seed:");
-    inputFile >> seed;
+    inputFile >> params->seed;
     searchVar(inputFile, "domainSizeIncrease:");
-    inputFile >> ch >> domainSizeIncrease[0] >> ch >> domainSizeIncrease[1] >> ch >> domainSizeIncrease[2];
+    inputFile >> ch >> params->domainSizeIncrease[0] >> ch >> params->domainSizeIncrease[1] >> ch >> params->domainSizeIncrease[2];
     searchVar(inputFile, "keepOnlyLargestCluster:");
-    inputFile >> keepOnlyLargestCluster;
+    inputFile >> params->keepOnlyLargestCluster;
     searchVar(inputFile, "keepIsolatedFractures:");
-    inputFile >> keepIsolatedFractures;
+    inputFile >> params->keepIsolatedFractures;
     searchVar(inputFile, "ignoreBoundaryFaces:");
-    inputFile >> ignoreBoundaryFaces;
+    inputFile >> params->ignoreBoundaryFaces;
     searchVar(inputFile, "boundaryFaces:");
-    inputFile >> ch >> boundaryFaces[0] >> ch >> boundaryFaces[1] >> ch >> boundaryFaces[2] >> ch >> boundaryFaces[3] >> ch >> boundaryFaces[4] >> ch >> boundaryFaces[5];
+    inputFile >> ch >> params->boundaryFaces[0] >> ch >> params->boundaryFaces[1] >> ch >> params->boundaryFaces[2] >> ch >> params->boundaryFaces[3] >> ch >> params->boundaryFaces[4] >> ch >> params->boundaryFaces[5];
     searchVar(inputFile, "rejectsPerFracture:");
-    inputFile >> rejectsPerFracture;
+    inputFile >> params->rejectsPerFracture;
     searchVar(inputFile, "nFamRect:");
-    inputFile >> nFamRect;
+    inputFile >> params->nFamRect;
     searchVar(inputFile, "nFamEll:");
-    inputFile >> nFamEll;
+    inputFile >> params->nFamEll;
     searchVar(inputFile, "removeFracturesLessThan:");
-    inputFile >> removeFracturesLessThan;
+    inputFile >> params->removeFracturesLessThan;
     searchVar(inputFile, "orientationOption:");
-    inputFile >> orientationOption;
+    inputFile >> params->orientationOption;
     
-    if (orientationOption == 0) {
+    if (params->orientationOption == 0) {
         logString = "Expecting Theta and phi for orientations\n";
         logger.writeLogFile(INFO,  logString);
-    } else if  (orientationOption == 1) {
+    } else if  (params->orientationOption == 1) {
         logString = "Expecting Trend and Plunge for orientations\n";
         logger.writeLogFile(INFO,  logString);
-    } else if (orientationOption == 2) {
+    } else if (params->orientationOption == 2) {
         logString = "Expecting Dip and Strike (RHR) for orientations\n";
         logger.writeLogFile(INFO,  logString);
     }
     
     searchVar(inputFile, "polygonBoundaryFlag:");
-    inputFile >> polygonBoundaryFlag;
+    inputFile >> params->polygonBoundaryFlag;
     
-    if (polygonBoundaryFlag) {
+    if (params->polygonBoundaryFlag) {
         logString = "Expecting Polygon Boundary for domain edges";
         logger.writeLogFile(INFO,  logString);
         searchVar(inputFile, "polygonBoundaryFile:");
@@ -744,11 +202,11 @@ void getInput(char* input, std::vector<Shape> &shapeFamily) {
         logString = "Polygon Boundary File: " + tempstring;
         logger.writeLogFile(INFO,  logString);
         readDomainVertices(tempstring);
-        logString = "There are " + to_string(numOfDomainVertices) + " Vertices on the boundary";
+        logString = "There are " + to_string(params->numOfDomainVertices) + " Vertices on the boundary";
         logger.writeLogFile(INFO,  logString);
         
-        for (int i = 0; i < numOfDomainVertices; i++) {
-            logString = "Vertex " + to_string(i + 1) + ": {" + to_string(domainVertices[i].x) + "," + to_string(domainVertices[i].y) + "}";
+        for (int i = 0; i < params->numOfDomainVertices; i++) {
+            logString = "Vertex " + to_string(i + 1) + ": {" + to_string(params->domainVertices[i].x) + "," + to_string(params->domainVertices[i].y) + "}";
             logger.writeLogFile(INFO,  logString);
         }
         
@@ -756,108 +214,108 @@ void getInput(char* input, std::vector<Shape> &shapeFamily) {
         logger.writeLogFile(INFO,  logString);
     }
     
-    if (nFamEll > 0 || nFamRect > 0) {
+    if (params->nFamEll > 0 || params->nFamRect > 0) {
         searchVar(inputFile, "famProb:");
-        famProb = new float[(nFamEll + nFamRect)];
-        getInputAry(inputFile, famProb, (nFamEll + nFamRect));
+        params->famProb.resize((params->nFamEll + params->nFamRect));
+        getInputAry(inputFile, params->famProb, (params->nFamEll + params->nFamRect));
         searchVar(inputFile, "famProb:");
-        famProbOriginal = new float[(nFamEll + nFamRect)];
-        getInputAry(inputFile, famProbOriginal, (nFamEll + nFamRect));
+        params->famProbOriginal.resize((params->nFamEll + params->nFamRect));
+        getInputAry(inputFile, params->famProbOriginal, (params->nFamEll + params->nFamRect));
         searchVar(inputFile, "radiiListIncrease:");
-        inputFile >> radiiListIncrease;
+        inputFile >> params->radiiListIncrease;
     }
     
-    if (nFamEll > 0) {
+    if (params->nFamEll > 0) {
         searchVar(inputFile, "ebetaDistribution:");
-        ebetaDistribution = new bool[nFamEll];
-        getInputAry(inputFile, ebetaDistribution, nFamEll);
+        params->ebetaDistribution.resize(params->nFamEll);
+        getInputAry(inputFile, params->ebetaDistribution, params->nFamEll);
         searchVar(inputFile, "eLayer:");
-        eLayer = new int[nFamEll];
-        getInputAry(inputFile, eLayer, nFamEll);
+        params->eLayer.resize(params->nFamEll);
+        getInputAry(inputFile, params->eLayer, params->nFamEll);
         searchVar(inputFile, "eRegion:");
-        eRegion = new int[nFamEll];
-        getInputAry(inputFile, eRegion, nFamEll);
+        params->eRegion.resize(params->nFamEll);
+        getInputAry(inputFile, params->eRegion, params->nFamEll);
         searchVar(inputFile, "edistr:");
-        edistr = new int[nFamEll];
-        getInputAry(inputFile, edistr, nFamEll);
+        params->edistr.resize(params->nFamEll);
+        getInputAry(inputFile, params->edistr, params->nFamEll);
         searchVar(inputFile, "easpect:");
-        easpect = new float[nFamEll];
-        getInputAry(inputFile, easpect, nFamEll);
+        params->easpect.resize(params->nFamEll);
+        getInputAry(inputFile, params->easpect, params->nFamEll);
         searchVar(inputFile, "enumPoints:");
-        enumPoints = new unsigned int[nFamEll];
-        getInputAry(inputFile, enumPoints, nFamEll);
+        params->enumPoints.resize(params->nFamEll);
+        getInputAry(inputFile, params->enumPoints, params->nFamEll);
         searchVar(inputFile, "angleOption:"); // eAngleOption
-        inputFile >> eAngleOption;
+        inputFile >> params->eAngleOption;
         
-        if (orientationOption == 0) {
+        if (params->orientationOption == 0) {
             searchVar(inputFile, "etheta:");
-            eAngleOne = new float[nFamEll];
-            getInputAry(inputFile, eAngleOne, nFamEll);
+            params->eAngleOne.resize(params->nFamEll);
+            getInputAry(inputFile, params->eAngleOne, params->nFamEll);
             searchVar(inputFile, "ephi:");
-            eAngleTwo = new float[nFamEll];
-            getInputAry(inputFile, eAngleTwo, nFamEll);
-        } else if (orientationOption == 1) {
+            params->eAngleTwo.resize(params->nFamEll);
+            getInputAry(inputFile, params->eAngleTwo, params->nFamEll);
+        } else if (params->orientationOption == 1) {
             searchVar(inputFile, "etrend:");
-            eAngleOne = new float[nFamEll];
-            getInputAry(inputFile, eAngleOne, nFamEll);
+            params->eAngleOne.resize(params->nFamEll);
+            getInputAry(inputFile, params->eAngleOne, params->nFamEll);
             searchVar(inputFile, "eplunge:");
-            eAngleTwo = new float[nFamEll];
-            getInputAry(inputFile, eAngleTwo, nFamEll);
-        } else if (orientationOption == 2) {
+            params->eAngleTwo.resize(params->nFamEll);
+            getInputAry(inputFile, params->eAngleTwo, params->nFamEll);
+        } else if (params->orientationOption == 2) {
             searchVar(inputFile, "edip:");
-            eAngleOne = new float[nFamEll];
-            getInputAry(inputFile, eAngleOne, nFamEll);
+            params->eAngleOne.resize(params->nFamEll);
+            getInputAry(inputFile, params->eAngleOne, params->nFamEll);
             searchVar(inputFile, "estrike:");
-            eAngleTwo = new float[nFamEll];
-            getInputAry(inputFile, eAngleTwo, nFamEll);
+            params->eAngleTwo.resize(params->nFamEll);
+            getInputAry(inputFile, params->eAngleTwo, params->nFamEll);
         }
         
         searchVar(inputFile, "ebeta:");
-        ebeta = new float[nFamEll];
-        getInputAry(inputFile, ebeta, nFamEll);
+        params->ebeta.resize(params->nFamEll);
+        getInputAry(inputFile, params->ebeta, params->nFamEll);
         searchVar(inputFile, "ekappa:");
-        ekappa = new float[nFamEll];
-        getInputAry(inputFile, ekappa, nFamEll);
+        params->ekappa.resize(params->nFamEll);
+        getInputAry(inputFile, params->ekappa, params->nFamEll);
         searchVar(inputFile, "eLogMean:");
-        eLogMean = new float[nFamEll];
-        getInputAry(inputFile, eLogMean, nFamEll);
+        params->eLogMean.resize(params->nFamEll);
+        getInputAry(inputFile, params->eLogMean, params->nFamEll);
         searchVar(inputFile, "esd:");
-        esd = new float[nFamEll];
-        getInputAry(inputFile, esd, nFamEll);
+        params->esd.resize(params->nFamEll);
+        getInputAry(inputFile, params->esd, params->nFamEll);
         searchVar(inputFile, "eExpMean:");
-        eExpMean = new float[nFamEll];
-        getInputAry(inputFile, eExpMean, nFamEll);
+        params->eExpMean.resize(params->nFamEll);
+        getInputAry(inputFile, params->eExpMean, params->nFamEll);
         searchVar(inputFile, "emin:");
-        emin = new float[nFamEll];
-        getInputAry(inputFile, emin, nFamEll);
+        params->emin.resize(params->nFamEll);
+        getInputAry(inputFile, params->emin, params->nFamEll);
         searchVar(inputFile, "emax:");
-        emax = new float[nFamEll];
-        getInputAry(inputFile, emax, nFamEll);
+        params->emax.resize(params->nFamEll);
+        getInputAry(inputFile, params->emax, params->nFamEll);
         searchVar(inputFile, "ealpha:");
-        ealpha = new float[nFamEll];
-        getInputAry(inputFile, ealpha, nFamEll);
+        params->ealpha.resize(params->nFamEll);
+        getInputAry(inputFile, params->ealpha, params->nFamEll);
         searchVar(inputFile, "econst:");
-        econst = new float[nFamEll];
-        getInputAry(inputFile, econst, nFamEll);
+        params->econst.resize(params->nFamEll);
+        getInputAry(inputFile, params->econst, params->nFamEll);
         searchVar(inputFile, "eLogMin:");
-        eLogMin = new float[nFamEll];
-        getInputAry(inputFile, eLogMin, nFamEll);
+        params->eLogMin.resize(params->nFamEll);
+        getInputAry(inputFile, params->eLogMin, params->nFamEll);
         searchVar(inputFile, "eLogMax:");
-        eLogMax = new float[nFamEll];
-        getInputAry(inputFile, eLogMax, nFamEll);
+        params->eLogMax.resize(params->nFamEll);
+        getInputAry(inputFile, params->eLogMax, params->nFamEll);
         searchVar(inputFile, "eExpMin:");
-        eExpMin = new float[nFamEll];
-        getInputAry(inputFile, eExpMin, nFamEll);
+        params->eExpMin.resize(params->nFamEll);
+        getInputAry(inputFile, params->eExpMin, params->nFamEll);
         searchVar(inputFile, "eExpMax:");
-        eExpMax = new float[nFamEll];
-        getInputAry(inputFile, eExpMax, nFamEll);
+        params->eExpMax.resize(params->nFamEll);
+        getInputAry(inputFile, params->eExpMax, params->nFamEll);
         
-        if (stopCondition == 1) {
+        if (params->stopCondition == 1) {
             // Get temp array for ellipse p32 targets
             // Used to simplify initialization of shape family structures below
             searchVar(inputFile, "e_p32Targets:");
-            e_p32Targets = new float[nFamEll];
-            getInputAry(inputFile, e_p32Targets, nFamEll);
+            params->e_p32Targets.resize(params->nFamEll);
+            getInputAry(inputFile, params->e_p32Targets, params->nFamEll);
         }
     }
     
@@ -869,198 +327,169 @@ void getInput(char* input, std::vector<Shape> &shapeFamily) {
     int betaCount = 0;
     
     // Create shape structures from data gathered above
-    for (int i = 0; i < nFamEll; i++) {
+    for (int i = 0; i < params->nFamEll; i++) {
         struct Shape newShapeFam;
         newShapeFam.shapeFamily = 0; // shapFam = 0 = ellipse, 1 = rect
-        newShapeFam.distributionType = edistr[i];
-        newShapeFam.numPoints = enumPoints[i];
-        newShapeFam.aspectRatio = easpect[i];
-        newShapeFam.angleOne = eAngleOne[i];
-        newShapeFam.angleTwo = eAngleTwo[i];
-        newShapeFam.kappa = ekappa[i];
-        newShapeFam.angleOption = eAngleOption;
-        newShapeFam.layer = eLayer[i];
-        newShapeFam.region = eRegion[i];
+        newShapeFam.distributionType = params->edistr[i];
+        newShapeFam.numPoints = params->enumPoints[i];
+        newShapeFam.aspectRatio = params->easpect[i];
+        newShapeFam.angleOne = params->eAngleOne[i];
+        newShapeFam.angleTwo = params->eAngleTwo[i];
+        newShapeFam.kappa = params->ekappa[i];
+        newShapeFam.angleOption = params->eAngleOption;
+        newShapeFam.layer = params->eLayer[i];
+        newShapeFam.region = params->eRegion[i];
         generateTheta(newShapeFam.thetaList, newShapeFam.aspectRatio, newShapeFam.numPoints);
         
-        if (ebetaDistribution[i] == 1 ) { // If constant user defined beta option
+        if (params->ebetaDistribution[i] == 1 ) { // If constant user defined beta option
             newShapeFam.betaDistribution = 1;
-            newShapeFam.beta = ebeta[betaCount];
+            newShapeFam.beta = params->ebeta[betaCount];
             betaCount++;
         } else {
             newShapeFam.betaDistribution = 0;
         }
         
         // dist options:1 = lognormal, 2= truncated power-law, 3= exponential, 4=constant
-        switch (edistr[i]) {
+        switch (params->edistr[i]) {
         case 1: // Lognormal
-            newShapeFam.mean = eLogMean[shape1];
-            newShapeFam.sd = esd[shape1];
-            newShapeFam.logMin = eLogMin[shape1];
-            newShapeFam.logMax = eLogMax[shape1];
+            newShapeFam.mean = params->eLogMean[shape1];
+            newShapeFam.sd = params->esd[shape1];
+            newShapeFam.logMin = params->eLogMin[shape1];
+            newShapeFam.logMax = params->eLogMax[shape1];
             shape1++;
             break;
             
         case 2: // Truncated power-law
-            newShapeFam.min = emin[shape2];
-            newShapeFam.max = emax[shape2];
-            newShapeFam.alpha = ealpha[shape2];
+            newShapeFam.min = params->emin[shape2];
+            newShapeFam.max = params->emax[shape2];
+            newShapeFam.alpha = params->ealpha[shape2];
             shape2++;
             break;
             
         case 3:
-            newShapeFam.expMean = eExpMean[shape3];
-            newShapeFam.expLambda = 1 / eExpMean[shape3];
-            newShapeFam.expMin = eExpMin[shape3];
-            newShapeFam.expMax = eExpMax[shape3];
+            newShapeFam.expMean = params->eExpMean[shape3];
+            newShapeFam.expLambda = 1 / params->eExpMean[shape3];
+            newShapeFam.expMin = params->eExpMin[shape3];
+            newShapeFam.expMax = params->eExpMax[shape3];
             shape3++;
             break;
             
         case 4:
-            newShapeFam.constRadi = econst[shape4];
+            newShapeFam.constRadi = params->econst[shape4];
             shape4++;
             break;
         }
         
-        if (stopCondition == 1) {
-            newShapeFam.p32Target = e_p32Targets[i];
+        if (params->stopCondition == 1) {
+            newShapeFam.p32Target = params->e_p32Targets[i];
         }
         
         // Save shape family to perminant array
         shapeFamily.push_back(newShapeFam);
     }
     
-    if (nFamEll > 0 ) {
-        // Can now delete/free the memory for these arrays
-        delete[] ebetaDistribution;
-        delete[] edistr;
-        delete[] easpect;
-        delete[] enumPoints;
-        delete[] eAngleOne;
-        delete[] eAngleTwo;
-        delete[] ebeta;
-        delete[] ekappa;
-        delete[] eLogMean;
-        delete[] esd;
-        delete[] eExpMean;
-        delete[] emin;
-        delete[] emax;
-        delete[] ealpha;
-        delete[] econst;
-        delete[] eLayer;
-        delete[] eRegion;
-        delete[] eLogMin;
-        delete[] eLogMax;
-        delete[] eExpMin;
-        delete[] eExpMax;
-        
-        if (stopCondition == 1) {
-            delete[] e_p32Targets;
-        }
-    }
-    
-    if (nFamRect > 0) {
+    if (params->nFamRect > 0) {
         searchVar(inputFile, "rbetaDistribution:");
-        rbetaDistribution = new bool[nFamRect];
-        getInputAry(inputFile, rbetaDistribution, nFamRect);
+        params->rbetaDistribution.resize(params->nFamRect);
+        getInputAry(inputFile, params->rbetaDistribution, params->nFamRect);
         searchVar(inputFile, "rdistr:");
-        rdistr = new unsigned int[nFamRect];
-        getInputAry(inputFile, rdistr, nFamRect);
+        params->rdistr.resize(params->nFamRect);
+        getInputAry(inputFile, params->rdistr, params->nFamRect);
         searchVar(inputFile, "rLayer:");
-        rLayer = new int[nFamRect];
-        getInputAry(inputFile, rLayer, nFamRect);
+        params->rLayer.resize(params->nFamRect);
+        getInputAry(inputFile, params->rLayer, params->nFamRect);
         searchVar(inputFile, "rRegion:");
-        rRegion = new int[nFamRect];
-        getInputAry(inputFile, rRegion, nFamRect);
+        params->rRegion.resize(params->nFamRect);
+        getInputAry(inputFile, params->rRegion, params->nFamRect);
         searchVar(inputFile, "raspect:");
-        raspect = new float[nFamRect];
-        getInputAry(inputFile, raspect, nFamRect);
+        params->raspect.resize(params->nFamRect);
+        getInputAry(inputFile, params->raspect, params->nFamRect);
         searchVar(inputFile, "angleOption:");//rAngleOption
-        inputFile >> rAngleOption;
+        inputFile >> params->rAngleOption;
         
-        if (orientationOption == 0) {
+        if (params->orientationOption == 0) {
             searchVar(inputFile, "rtheta:");
-            rAngleOne = new float[nFamRect];
-            getInputAry(inputFile, rAngleOne, nFamRect);
+            params->rAngleOne.resize(params->nFamRect);
+            getInputAry(inputFile, params->rAngleOne, params->nFamRect);
             searchVar(inputFile, "rphi:");
-            rAngleTwo = new float[nFamRect];
-            getInputAry(inputFile, rAngleTwo, nFamRect);
-        } else if (orientationOption == 1) {
+            params->rAngleTwo.resize(params->nFamRect);
+            getInputAry(inputFile, params->rAngleTwo, params->nFamRect);
+        } else if (params->orientationOption == 1) {
             searchVar(inputFile, "rtrend:");
-            rAngleOne = new float[nFamRect];
-            getInputAry(inputFile, rAngleOne, nFamRect);
+            params->rAngleOne.resize(params->nFamRect);
+            getInputAry(inputFile, params->rAngleOne, params->nFamRect);
             searchVar(inputFile, "rplunge:");
-            rAngleTwo = new float[nFamRect];
-            getInputAry(inputFile, rAngleTwo, nFamRect);
-        } else if (orientationOption == 2) {
+            params->rAngleTwo.resize(params->nFamRect);
+            getInputAry(inputFile, params->rAngleTwo, params->nFamRect);
+        } else if (params->orientationOption == 2) {
             searchVar(inputFile, "rdip:");
-            rAngleOne = new float[nFamRect];
-            getInputAry(inputFile, rAngleOne, nFamRect);
+            params->rAngleOne.resize(params->nFamRect);
+            getInputAry(inputFile, params->rAngleOne, params->nFamRect);
             searchVar(inputFile, "rstrike:");
-            rAngleTwo = new float[nFamRect];
-            getInputAry(inputFile, rAngleTwo, nFamRect);
+            params->rAngleTwo.resize(params->nFamRect);
+            getInputAry(inputFile, params->rAngleTwo, params->nFamRect);
         }
         
         searchVar(inputFile, "rbeta:");
-        rbeta = new float[nFamRect];
-        getInputAry(inputFile, rbeta, nFamRect);
+        params->rbeta.resize(params->nFamRect);
+        getInputAry(inputFile, params->rbeta, params->nFamRect);
         searchVar(inputFile, "rkappa:");
-        rkappa = new float[nFamRect];
-        getInputAry(inputFile, rkappa, nFamRect);
+        params->rkappa.resize(params->nFamRect);
+        getInputAry(inputFile, params->rkappa, params->nFamRect);
         searchVar(inputFile, "rLogMean:");
-        rLogMean = new float[nFamRect];
-        getInputAry(inputFile, rLogMean, nFamRect);
+        params->rLogMean.resize(params->nFamRect);
+        getInputAry(inputFile, params->rLogMean, params->nFamRect);
         searchVar(inputFile, "rsd:");
-        rsd = new float[nFamRect];
-        getInputAry(inputFile, rsd, nFamRect);
+        params->rsd.resize(params->nFamRect);
+        getInputAry(inputFile, params->rsd, params->nFamRect);
         searchVar(inputFile, "rmin:");
-        rmin = new float[nFamRect];
-        getInputAry(inputFile, rmin, nFamRect);
+        params->rmin.resize(params->nFamRect);
+        getInputAry(inputFile, params->rmin, params->nFamRect);
         searchVar(inputFile, "rmax:");
-        rmax = new float[nFamRect];
-        getInputAry(inputFile, rmax, nFamRect);
+        params->rmax.resize(params->nFamRect);
+        getInputAry(inputFile, params->rmax, params->nFamRect);
         searchVar(inputFile, "ralpha:");
-        ralpha = new float[nFamRect];
-        getInputAry(inputFile, ralpha, nFamRect);
+        params->ralpha.resize(params->nFamRect);
+        getInputAry(inputFile, params->ralpha, params->nFamRect);
         searchVar(inputFile, "rExpMean:");
-        rExpMean = new float[nFamRect];
-        getInputAry(inputFile, rExpMean, nFamRect);
+        params->rExpMean.resize(params->nFamRect);
+        getInputAry(inputFile, params->rExpMean, params->nFamRect);
         searchVar(inputFile, "rconst:");
-        rconst = new float[nFamRect];
-        getInputAry(inputFile, rconst, nFamRect);
+        params->rconst.resize(params->nFamRect);
+        getInputAry(inputFile, params->rconst, params->nFamRect);
         searchVar(inputFile, "rLogMin:");
-        rLogMin = new float[nFamRect];
-        getInputAry(inputFile, rLogMin, nFamRect);
+        params->rLogMin.resize(params->nFamRect);
+        getInputAry(inputFile, params->rLogMin, params->nFamRect);
         searchVar(inputFile, "rLogMax:");
-        rLogMax = new float[nFamRect];
-        getInputAry(inputFile, rLogMax, nFamRect);
+        params->rLogMax.resize(params->nFamRect);
+        getInputAry(inputFile, params->rLogMax, params->nFamRect);
         searchVar(inputFile, "rExpMin:");
-        rExpMin = new float[nFamRect];
-        getInputAry(inputFile, rExpMin, nFamRect);
+        params->rExpMin.resize(params->nFamRect);
+        getInputAry(inputFile, params->rExpMin, params->nFamRect);
         searchVar(inputFile, "rExpMax:");
-        rExpMax = new float[nFamRect];
-        getInputAry(inputFile, rExpMax, nFamRect);
+        params->rExpMax.resize(params->nFamRect);
+        getInputAry(inputFile, params->rExpMax, params->nFamRect);
         
-        if (stopCondition == 1) {
+        if (params->stopCondition == 1) {
             // Get temp array for rectangle p32 targets,
             // Used to simplify initialization of shape family structures below
             searchVar(inputFile, "r_p32Targets:");
-            r_p32Targets = new float[nFamRect];
-            getInputAry(inputFile, r_p32Targets, nFamRect);
+            params->r_p32Targets.resize(params->nFamRect);
+            getInputAry(inputFile, params->r_p32Targets, params->nFamRect);
         }
     }
     
     // Set stop condition variables
-    if (nFamRect > 0 || nFamEll > 0) {
-        if (stopCondition == 0) { // npoly option
+    if (params->nFamRect > 0 || params->nFamEll > 0) {
+        if (params->stopCondition == 0) { // npoly option
             searchVar(inputFile, "nPoly:");
-            inputFile >> nPoly;
-        } else if (stopCondition == 1) { // Stop program when p32 conditions per fracture family are met
-            p32Status = new bool [nFamRect + nFamEll]; // Staus array for whether or not the family has reached its p32 requirement
+            inputFile >> params->nPoly;
+        } else if (params->stopCondition == 1) { // Stop program when p32 conditions per fracture family are met
+            params->p32Status.resize(params->nFamRect + params->nFamEll); // Staus array for whether or not the family has reached its p32 requirement
             
-            for (int i = 0; i < (nFamRect + nFamEll); i++) {
+            for (int i = 0; i < (params->nFamRect + params->nFamEll); i++) {
                 // Zero the status flags
-                p32Status[i] = 0;
+                params->p32Status[i] = 0;
             }
         }
     }
@@ -1074,261 +503,233 @@ void getInput(char* input, std::vector<Shape> &shapeFamily) {
     betaCount = 0;
     
     // Create shape strucutres from data gathered above
-    for (int i = 0; i < nFamRect; i++) {
+    for (int i = 0; i < params->nFamRect; i++) {
         struct Shape newShapeFam;
         newShapeFam.shapeFamily = 1; // shapFam = 0 = ellipse, 1 = rect
-        newShapeFam.distributionType = rdistr[i];
+        newShapeFam.distributionType = params->rdistr[i];
         newShapeFam.numPoints = 4; // Rectangle
-        newShapeFam.aspectRatio = raspect[i];
-        newShapeFam.angleOne = rAngleOne[i];
-        newShapeFam.angleTwo = rAngleTwo[i];
-        newShapeFam.kappa = rkappa[i];
-        newShapeFam.angleOption = rAngleOption;
-        newShapeFam.layer = rLayer[i];
-        newShapeFam.region = rRegion[i];
-        
-        if (rbetaDistribution[i] == 1 ) { // If constant beta option
+        newShapeFam.aspectRatio = params->raspect[i];
+        newShapeFam.angleOne = params->rAngleOne[i];
+        newShapeFam.angleTwo = params->rAngleTwo[i];
+        newShapeFam.kappa = params->rkappa[i];
+        newShapeFam.angleOption = params->rAngleOption;
+        newShapeFam.layer = params->rLayer[i];
+        newShapeFam.region = params->rRegion[i];
+        
+        if (params->rbetaDistribution[i] == 1 ) { // If constant beta option
             newShapeFam.betaDistribution = 1;
-            newShapeFam.beta = rbeta[betaCount];
+            newShapeFam.beta = params->rbeta[betaCount];
             betaCount++;
         } else {
             newShapeFam.betaDistribution = 0;
         }
         
         // dist options:1 = lognormal, 2= truncated power-law, 3= exponential, 4=constant
-        switch (rdistr[i]) {
+        switch (params->rdistr[i]) {
         case 1: // Lognormal
-            newShapeFam.mean = rLogMean[shape1];
-            newShapeFam.sd = rsd[shape1];
-            newShapeFam.logMin = rLogMin[shape1];
-            newShapeFam.logMax = rLogMax[shape1];
+            newShapeFam.mean = params->rLogMean[shape1];
+            newShapeFam.sd = params->rsd[shape1];
+            newShapeFam.logMin = params->rLogMin[shape1];
+            newShapeFam.logMax = params->rLogMax[shape1];
             shape1++;
             break;
             
         case 2: // Truncated power-law
-            newShapeFam.min = rmin[shape2];
-            newShapeFam.max = rmax[shape2];
-            newShapeFam.alpha = ralpha[shape2];
+            newShapeFam.min = params->rmin[shape2];
+            newShapeFam.max = params->rmax[shape2];
+            newShapeFam.alpha = params->ralpha[shape2];
             shape2++;
             break;
             
         case 3:
-            newShapeFam.expMean = rExpMean[shape3];
-            newShapeFam.expLambda = 1 / rExpMean[shape3];
-            newShapeFam.expMin = rExpMin[shape3];
-            newShapeFam.expMax = rExpMax[shape3];
+            newShapeFam.expMean = params->rExpMean[shape3];
+            newShapeFam.expLambda = 1 / params->rExpMean[shape3];
+            newShapeFam.expMin = params->rExpMin[shape3];
+            newShapeFam.expMax = params->rExpMax[shape3];
             shape3++;
             break;
             
         case 4:
-            newShapeFam.constRadi = rconst[shape4];
+            newShapeFam.constRadi = params->rconst[shape4];
             shape4++;
             break;
         }
         
-        if (stopCondition == 1) {
-            newShapeFam.p32Target = r_p32Targets[i];
+        if (params->stopCondition == 1) {
+            newShapeFam.p32Target = params->r_p32Targets[i];
         }
         
         // Save family to perminant array
         shapeFamily.push_back(newShapeFam);
     }
     
-    if (nFamRect > 0 ) {
-        // Can now delete/free the memory for these arrays
-        delete[] rbetaDistribution;
-        delete[] rdistr;
-        delete[] raspect;
-        delete[] rAngleOne;
-        delete[] rAngleTwo;
-        delete[] rbeta;
-        delete[] rkappa;
-        delete[] rLogMean;
-        delete[] rsd;
-        delete[] rExpMean;
-        delete[] rmin;
-        delete[] rmax;
-        delete[] ralpha;
-        delete[] rconst;
-        delete[] rLayer;
-        delete[] rRegion;
-        delete[] rLogMin;
-        delete[] rLogMax;
-        delete[] rExpMin;
-        delete[] rExpMax;
-        
-        if (stopCondition == 1) {
-            delete[] r_p32Targets;
-        }
-    }
-    
     searchVar(inputFile, "userEllipsesOnOff:");
-    inputFile >> userEllipsesOnOff;
+    inputFile >> params->userEllipsesOnOff;
     
-    if (userEllipsesOnOff != 0) {
+    if (params->userEllipsesOnOff != 0) {
         searchVar(inputFile, "UserEll_Input_File_Path:");
         inputFile >> tempstring;
-        std::ifstream uEllFile;
-        uEllFile.open(tempstring.c_str(), std::ifstream::in);
+        InputReader uEllFile;
+        uEllFile.open(tempstring.c_str());
         checkIfOpen(uEllFile, tempstring);
         logString = "User Defined Ellipses File: " + tempstring;
         logger.writeLogFile(INFO,  logString);
         searchVar(uEllFile, "nUserEll:");
-        uEllFile >> nUserEll;
+        uEllFile >> params->nUserEll;
         searchVar(uEllFile, "Radii:");
-        ueRadii = new float[nUserEll];
-        getElements(uEllFile, ueRadii, nUserEll);
+        params->ueRadii.resize(params->nUserEll);
+        getElements(uEllFile, params->ueRadii, params->nUserEll);
         searchVar(uEllFile, "Aspect_Ratio:");
-        ueaspect = new float[nUserEll];
-        getElements(uEllFile, ueaspect, nUserEll);
+        params->ueaspect.resize(params->nUserEll);
+        getElements(uEllFile, params->ueaspect, params->nUserEll);
         searchVar(uEllFile, "AngleOption:");
-        uEllFile >> ueAngleOption;
+        uEllFile >> params->ueAngleOption;
         searchVar(uEllFile, "Beta:");
-        ueBeta = new float[nUserEll];
-        getElements(uEllFile, ueBeta, nUserEll);
+        params->ueBeta.resize(params->nUserEll);
+        getElements(uEllFile, params->ueBeta, params->nUserEll);
         searchVar(uEllFile, "Translation:");
-        uetranslation = new double[3 * nUserEll];
-        get2dAry(uEllFile, uetranslation, nUserEll);
+        params->uetranslation.resize(3 * params->nUserEll);
+        get2dAry(uEllFile, params->uetranslation, params->nUserEll);
         //
         searchVar(uEllFile, "userOrientationOption:");
-        uEllFile >> userEllOrientationOption;
-        logString = "userOrientationOption " + to_string(userEllOrientationOption);
+        uEllFile >> params->userEllOrientationOption;
+        logString = "userOrientationOption " + to_string(params->userEllOrientationOption);
         logger.writeLogFile(INFO,  logString);
         
-        if (userEllOrientationOption == 0) {
+        if (params->userEllOrientationOption == 0) {
             searchVar(uEllFile, "Normal:");
-            uenormal = new double[3 * nUserEll];
-            get2dAry(uEllFile, uenormal, nUserEll);
-        } else if (userEllOrientationOption == 1) {
+            params->uenormal.resize(3 * params->nUserEll);
+            get2dAry(uEllFile, params->uenormal, params->nUserEll);
+        } else if (params->userEllOrientationOption == 1) {
             searchVar(uEllFile, "Trend_Plunge:");
-            ueTrendPlunge = new double[2 * nUserEll];
-            get2dAry2(uEllFile, ueTrendPlunge, nUserEll);
-            uenormal = new double[3 * nUserEll];
+            params->ueTrendPlunge.resize(2 * params->nUserEll);
+            get2dAry2(uEllFile, params->ueTrendPlunge, params->nUserEll);
+            params->uenormal.resize(3 * params->nUserEll);
             // Convert Trend and Plunge into Dip and Strike
             double temp = M_PI / 180;
             
-            for (int i = 0; i < nUserEll; i++) {
+            for (int i = 0; i < params->nUserEll; i++) {
                 int index1 = i * 2;
                 int index2 = i * 3;
                 // Trend and Plunge
                 // ueTrendPlunge[index1] = Trend
                 // ueTrendPlunge[index1+1] = Plunge
-                double trend = ueTrendPlunge[index1] * temp;
-                double plunge = ueTrendPlunge[index1 + 1] * temp;
+                double trend = params->ueTrendPlunge[index1] * temp;
+                double plunge = params->ueTrendPlunge[index1 + 1] * temp;
                 //std::cout << "trend & plunge: " << trend/temp << " " << plunge/temp << "\n";
-                uenormal[index2] = cos(trend) * cos(plunge);
-                uenormal[index2 + 1] = sin(trend) * cos(plunge);
-                uenormal[index2 + 2] = sin(plunge);
+                params->uenormal[index2] = cos(trend) * cos(plunge);
+                params->uenormal[index2 + 1] = sin(trend) * cos(plunge);
+                params->uenormal[index2 + 2] = sin(plunge);
             }
-        } else if (userEllOrientationOption == 2) {
+        } else if (params->userEllOrientationOption == 2) {
             searchVar(uEllFile, "Dip_Strike:");
-            ueDipStrike = new double[2 * nUserEll];
-            get2dAry2(uEllFile, ueDipStrike, nUserEll);
-            uenormal = new double[3 * nUserEll];
+            params->ueDipStrike.resize(2 * params->nUserEll);
+            get2dAry2(uEllFile, params->ueDipStrike, params->nUserEll);
+            params->uenormal.resize(3 * params->nUserEll);
             // Convert Trend and Plunge into Dip and Strike
             double temp = M_PI / 180;
             
-            for (int i = 0; i < nUserEll; i++) {
+            for (int i = 0; i < params->nUserEll; i++) {
                 int index1 = i * 2;
                 int index2 = i * 3;
                 // Trend and Plunge
                 // angleOne = Trend
                 // angleTwo = Plunge
-                double dip = ueDipStrike[index1] * temp;
-                double strike = ueDipStrike[index1 + 1] * temp;
+                double dip = params->ueDipStrike[index1] * temp;
+                double strike = params->ueDipStrike[index1 + 1] * temp;
                 //std::cout << "dip & strike: " << dip/temp << " " << strike/temp << "\n";
-                uenormal[index2] = sin(dip) * sin(strike);
-                uenormal[index2 + 1] = -sin(dip) * cos(strike);
-                uenormal[index2 + 2] = cos(dip);
+                params->uenormal[index2] = sin(dip) * sin(strike);
+                params->uenormal[index2 + 1] = -sin(dip) * cos(strike);
+                params->uenormal[index2 + 2] = cos(dip);
             }
         }
         
         searchVar(uEllFile, "Number_of_Vertices:");
-        uenumPoints = new unsigned int[nUserEll];
-        getElements(uEllFile, uenumPoints, nUserEll);
+        params->uenumPoints.resize(params->nUserEll);
+        getElements(uEllFile, params->uenumPoints, params->nUserEll);
         uEllFile.close();
     }
     
     searchVar(inputFile, "userRectanglesOnOff:");
-    inputFile >> userRectanglesOnOff;
+    inputFile >> params->userRectanglesOnOff;
     
-    if (userRectanglesOnOff != 0) {
+    if (params->userRectanglesOnOff != 0) {
         searchVar(inputFile, "UserRect_Input_File_Path:");
         inputFile >> tempstring;
-        std::ifstream uRectFile;
-        uRectFile.open(tempstring.c_str(), std::ifstream::in);
+        InputReader uRectFile;
+        uRectFile.open(tempstring.c_str());
         checkIfOpen(uRectFile, tempstring);
         logString = "User Defined Rectangles File: " + tempstring + "\n";
         logger.writeLogFile(INFO,  logString);
         searchVar(uRectFile, "nUserRect:");
-        uRectFile >> nUserRect;
+        uRectFile >> params->nUserRect;
         searchVar(uRectFile, "Radii:");
-        urRadii = new float[nUserRect];
-        getElements(uRectFile, urRadii, nUserRect);
+        params->urRadii.resize(params->nUserRect);
+        getElements(uRectFile, params->urRadii, params->nUserRect);
         searchVar(uRectFile, "AngleOption:");
-        uRectFile >> urAngleOption;
+        uRectFile >> params->urAngleOption;
         searchVar(uRectFile, "Beta:");
-        urBeta = new float[nUserRect];
-        getElements(uRectFile, urBeta, nUserRect);
+        params->urBeta.resize(params->nUserRect);
+        getElements(uRectFile, params->urBeta, params->nUserRect);
         searchVar(uRectFile, "Aspect_Ratio:");
-        uraspect = new float[nUserRect];
-        getElements(uRectFile, uraspect, nUserRect);
+        params->uraspect.resize(params->nUserRect);
+        getElements(uRectFile, params->uraspect, params->nUserRect);
         searchVar(uRectFile, "Translation:");
-        urtranslation = new double[3 * nUserRect];
-        get2dAry(uRectFile, urtranslation, nUserRect);
+        params->urtranslation.resize(3 * params->nUserRect);
+        get2dAry(uRectFile, params->urtranslation, params->nUserRect);
         searchVar(uRectFile, "userOrientationOption:");
-        uRectFile >> userRectOrientationOption;
+        uRectFile >> params->userRectOrientationOption;
         
         // std::cout << "userRectOrientationOption: " << userRectOrientationOption << " \n";
-        if (userRectOrientationOption == 0) {
+        if (params->userRectOrientationOption == 0) {
             searchVar(uRectFile, "Normal:");
-            urnormal = new double[3 * nUserRect];
-            get2dAry(uRectFile, urnormal, nUserRect);
-        } else if (userRectOrientationOption == 1) {
+            params->urnormal.resize(3 * params->nUserRect);
+            get2dAry(uRectFile, params->urnormal, params->nUserRect);
+        } else if (params->userRectOrientationOption == 1) {
             searchVar(uRectFile, "Trend_Plunge:");
-            urTrendPlunge = new double[2 * nUserRect];
-            get2dAry2(uRectFile, urTrendPlunge, nUserRect);
-            urnormal = new double[3 * nUserRect];
+            params->urTrendPlunge.resize(2 * params->nUserRect);
+            get2dAry2(uRectFile, params->urTrendPlunge, params->nUserRect);
+            params->urnormal.resize(3 * params->nUserRect);
             double temp = M_PI / 180;
             
             // Convert Trend and Plunge into Dip and Strike
-            for (int i = 0; i < nUserRect; i++) {
+            for (int i = 0; i < params->nUserRect; i++) {
                 int index1 = i * 2;
                 int index2 = i * 3;
                 // Trend and Plunge
                 // urTrendPlunge[index1] = Trend
                 // urTrendPlunge[index1+1] = Plunge
                 // convert to radians
-                double trend = urTrendPlunge[index1] * temp;
-                double plunge = urTrendPlunge[index1 + 1] * temp;
+                double trend = params->urTrendPlunge[index1] * temp;
+                double plunge = params->urTrendPlunge[index1 + 1] * temp;
                 //std::cout << "normal: " << urnormal[index2] << " " << urnormal[index2+1] << " " << urnormal[index2+2] << "\n";
                 //std::cout << "trend & plunge: " << trend/temp << " " << plunge/temp << "\n";
-                urnormal[index2] = cos(trend) * cos(plunge);
-                urnormal[index2 + 1] = sin(trend) * cos(plunge);
-                urnormal[index2 + 2] = sin(plunge);
+                params->urnormal[index2] = cos(trend) * cos(plunge);
+                params->urnormal[index2 + 1] = sin(trend) * cos(plunge);
+                params->urnormal[index2 + 2] = sin(plunge);
                 //std::cout << "normal: " << urnormal[index2] << " " << urnormal[index2+1] << " " << urnormal[index2+2] << "\n";
             }
-        } else if (userRectOrientationOption == 2) {
+        } else if (params->userRectOrientationOption == 2) {
             searchVar(uRectFile, "Dip_Strike:");
-            urDipStrike = new double[2 * nUserRect];
-            get2dAry2(uRectFile, urDipStrike, nUserRect);
-            urnormal = new double[3 * nUserRect];
+            params->urDipStrike.resize(2 * params->nUserRect);
+            get2dAry2(uRectFile, params->urDipStrike, params->nUserRect);
+            params->urnormal.resize(3 * params->nUserRect);
             // Convert Dip and Strike into normal vectors
             double temp = M_PI / 180;
             
-            for (int i = 0; i < nUserRect; i++) {
+            for (int i = 0; i < params->nUserRect; i++) {
                 int index1 = i * 2;
                 int index2 = i * 3;
                 // dip and strike
                 // urDipStrike[index1] = dip
                 // urDipStrike[index1+1] = strike
                 // convert to radians
-                double dip = urDipStrike[index1] * temp;
-                double strike = urDipStrike[index1 + 1] * temp;
+                double dip = params->urDipStrike[index1] * temp;
+                double strike = params->urDipStrike[index1 + 1] * temp;
                 //std::cout << "dip & strike: " << dip/temp << " " << strike/temp << "\n";
-                urnormal[index2] = sin(dip) * sin(strike);
-                urnormal[index2 + 1] = -sin(dip) * cos(strike);
-                urnormal[index2 + 2] = cos(dip);
+                params->urnormal[index2] = sin(dip) * sin(strike);
+                params->urnormal[index2 + 1] = -sin(dip) * cos(strike);
+                params->urnormal[index2 + 2] = cos(dip);
             }
         }
         
@@ -1336,56 +737,56 @@ void getInput(char* input, std::vector<Shape> &shapeFamily) {
     }
     
     searchVar(inputFile, "userEllByCoord:");
-    inputFile >> userEllByCoord;
+    inputFile >> params->userEllByCoord;
     searchVar(inputFile, "userRecByCoord:");
-    inputFile >> userRecByCoord;
+    inputFile >> params->userRecByCoord;
     searchVar(inputFile, "userPolygonByCoord:");
-    inputFile >> userPolygonByCoord;
+    inputFile >> params->userPolygonByCoord;
     
-    if ((userRectanglesOnOff == 1 || userRecByCoord == 1) && (userEllipsesOnOff == 1 || userEllByCoord == 1)) {
+    if ((params->userRectanglesOnOff == 1 || params->userRecByCoord == 1) && (params->userEllipsesOnOff == 1 || params->userEllByCoord == 1)) {
         searchVar(inputFile, "insertUserRectanglesFirst:");
-        inputFile >> insertUserRectanglesFirst;
+        inputFile >> params->insertUserRectanglesFirst;
     } else {
-        insertUserRectanglesFirst = 0;
+        params->insertUserRectanglesFirst = 0;
     }
     
-    if (userPolygonByCoord != 0) {
+    if (params->userPolygonByCoord != 0) {
         searchVar(inputFile, "PolygonByCoord_Input_File_Path:");
-        inputFile >> polygonFile;
+        inputFile >> params->polygonFile;
     }
     
-    if (userEllByCoord != 0) {
+    if (params->userEllByCoord != 0) {
         searchVar(inputFile, "EllByCoord_Input_File_Path:");
         inputFile >> tempstring;
-        std::ifstream file;
-        file.open(tempstring.c_str(), std::ifstream::in);
+        InputReader file;
+        file.open(tempstring.c_str());
         checkIfOpen(file, tempstring);
         logString = "User Defined Ellipses by Coordinates File: " + tempstring + "\n";
         logger.writeLogFile(INFO,  logString);
         searchVar(file, "nEllipses:");
-        file >> nEllByCoord;
+        file >> params->nEllByCoord;
         searchVar(file, "nNodes:");
-        file >> nEllNodes;
-        userEllCoordVertices = new double[3 * nEllNodes * nEllByCoord];
+        file >> params->nEllNodes;
+        params->userEllCoordVertices.resize(3 * params->nEllNodes * params->nEllByCoord);
         searchVar(file, "Coordinates:");
-        getCords(file, userEllCoordVertices, nEllByCoord, nEllNodes);
+        getCords(file, params->userEllCoordVertices, params->nEllByCoord, params->nEllNodes);
         file.close();
     }
     
-    if (userRecByCoord != 0) {
+    if (params->userRecByCoord != 0) {
         searchVar(inputFile, "RectByCoord_Input_File_Path:");
         inputFile >> tempstring;
-        std::ifstream uCoordFile;
-        uCoordFile.open(tempstring.c_str(), std::ifstream::in);
+        InputReader uCoordFile;
+        uCoordFile.open(tempstring.c_str());
         checkIfOpen(uCoordFile, tempstring);
         logString = "User Defined Rectangles by Coordinates File: " + tempstring + "\n";
         logger.writeLogFile(INFO,  logString);
         searchVar(uCoordFile, "nRectangles:");
-        uCoordFile >> nRectByCoord;
+        uCoordFile >> params->nRectByCoord;
         searchVar(uCoordFile, "Coordinates:");
         //4 vertices, 12 elements x,y,z per rectangle:
-        userRectCoordVertices = new double[12 * nRectByCoord];
-        getRectCoords(uCoordFile, userRectCoordVertices, nRectByCoord);
+        params->userRectCoordVertices.resize(12 * params->nRectByCoord);
+        getRectCoords(uCoordFile, params->userRectCoordVertices, params->nRectByCoord);
         uCoordFile.close();
     }
     
@@ -1408,7 +809,7 @@ void getInput(char* input, std::vector<Shape> &shapeFamily) {
     //     getInputAry(inputFile, lengthCorrelatedAperture, 2);
     // } else {
     //     std::cerr << "\nERROR: Aperture option not recognised\n";
-    //     exit(1);
+    //     throw DFNError();
     // }
     
     // searchVar(inputFile, "permOption:");
@@ -1420,33 +821,33 @@ void getInput(char* input, std::vector<Shape> &shapeFamily) {
     // }
     
     // Error check on stopping parameter
-    if (nFamEll + nFamRect == 0 && stopCondition != 0) { // If no stochastic shapes, use nPoly option with npoly = number of user polygons
+    if (params->nFamEll + params->nFamRect == 0 && params->stopCondition != 0) { // If no stochastic shapes, use nPoly option with npoly = number of user polygons
         logString = "Warning: You have defined stopCondition = 1 (P32 program stopping condition) but have no stochastic shape families defined. Automatically setting stopCondition to 0 for use with user defined polygons and nPoly.\n\n";
         logger.writeLogFile(WARNING,  logString);
-        stopCondition = 0;
+        params->stopCondition = 0;
         
-        if (userEllipsesOnOff == 0 && userRectanglesOnOff == 0 && userRecByCoord == 0 ) {
+        if (params->userEllipsesOnOff == 0 && params->userRectanglesOnOff == 0 && params->userRecByCoord == 0 ) {
             logString = "Error: All polygon generating options are off or undefined, please check input file for errors.\n\n";
             logger.writeLogFile(ERROR,  logString);
-            exit(1);
+            throw DFNError();
         }
         
         int count = 0; // Count of user defined polygons
         
-        if (userEllipsesOnOff == 1) {
-            count += nUserEll;
+        if (params->userEllipsesOnOff == 1) {
+            count += params->nUserEll;
         }
         
-        if (userRectanglesOnOff == 1) {
-            count += nUserRect;
+        if (params->userRectanglesOnOff == 1) {
+            count += params->nUserRect;
         }
         
-        if (userRecByCoord == 1) {
-            count += nRectByCoord;
+        if (params->userRecByCoord == 1) {
+            count += params->nRectByCoord;
         }
         
         // Set nPoly to the amount of user defined polygons
-        nPoly = count;
+        params->nPoly = count;
     }
     
     inputFile.close();
@@ -1468,119 +869,119 @@ void getInput(char* input, std::vector<Shape> &shapeFamily) {
 // Prints all input variables, useful for debugging.
 // NOTE: Needs to be updated. There bave been changes to input variables
 void printInputVars() {
-    std::string logString = "npoly = " + to_string(nPoly);
+    std::string logString = "npoly = " + to_string(params->nPoly);
     logger.writeLogFile(INFO,  logString);
-    logString = "tripleIntersections = " + to_string(tripleIntersections) + "\n";
+    logString = "tripleIntersections = " + to_string(params->tripleIntersections) + "\n";
     logger.writeLogFile(INFO,  logString);
-    logString = "domainsize = {" + to_string(domainSize[0]) + ", " + to_string(domainSize[1]) + ", " + to_string(domainSize[2]) + "}\n";
+    logString = "domainsize = {" + to_string(params->domainSize[0]) + ", " + to_string(params->domainSize[1]) + ", " + to_string(params->domainSize[2]) + "}\n";
     logger.writeLogFile(INFO,  logString);
-    logString = "h = " + to_string(h);
+    logString = "h = " + to_string(params->h);
     logger.writeLogFile(INFO,  logString);
-    logString = "visualizationMode = " + to_string(visualizationMode) + "\n";
+    logString = "visualizationMode = " + to_string(params->visualizationMode) + "\n";
     logger.writeLogFile(INFO,  logString);
-    logString = "seed = " + to_string(seed);
+    logString = "seed = " + to_string(params->seed);
     logger.writeLogFile(INFO,  logString);
-    logString = "keepOnlyLargestCluster = " + to_string(keepOnlyLargestCluster);
+    logString = "keepOnlyLargestCluster = " + to_string(params->keepOnlyLargestCluster);
     logger.writeLogFile(INFO,  logString);
-    logString = "domainSizeIncrease = {" + to_string(domainSizeIncrease[0]) + "," + to_string(domainSizeIncrease[1]) + "," + to_string(domainSizeIncrease[2]) + "}\n";
+    logString = "domainSizeIncrease = {" + to_string(params->domainSizeIncrease[0]) + "," + to_string(params->domainSizeIncrease[1]) + "," + to_string(params->domainSizeIncrease[2]) + "}\n";
     logger.writeLogFile(INFO,  logString);
-    logString = "boundaryFaces = {" + to_string(boundaryFaces[0]) + "," + to_string(boundaryFaces[1]) + "," + to_string(boundaryFaces[2]) + "," + to_string(boundaryFaces[3]) + "," + to_string(boundaryFaces[4]) + "," + to_string(boundaryFaces[5]) + "}\n";
+    logString = "boundaryFaces = {" + to_string(params->boundaryFaces[0]) + "," + to_string(params->boundaryFaces[1]) + "," + to_string(params->boundaryFaces[2]) + "," + to_string(params->boundaryFaces[3]) + "," + to_string(params->boundaryFaces[4]) + "," + to_string(params->boundaryFaces[5]) + "}\n";
     logger.writeLogFile(INFO,  logString);
-    logString = "nFamRect = " + to_string(nFamRect) + "\n";
+    logString = "nFamRect = " + to_string(params->nFamRect) + "\n";
     logger.writeLogFile(INFO,  logString);
-    logString = "nFamEll = " + to_string(nFamEll) + "\n";
+    logString = "nFamEll = " + to_string(params->nFamEll) + "\n";
     logger.writeLogFile(INFO,  logString);
-    printAry(famProb, "famProb", (nFamEll + nFamRect));
-    printAry(edistr, "edistr", nFamEll);
-    printAry(enumPoints, "enumPoints", nFamEll);
-    logString = "eAngleOption = " + to_string(eAngleOption) + "\n";
+    printAry(params->famProb, "famProb", (params->nFamEll + params->nFamRect));
+    printAry(params->edistr, "edistr", params->nFamEll);
+    printAry(params->enumPoints, "enumPoints", params->nFamEll);
+    logString = "eAngleOption = " + to_string(params->eAngleOption) + "\n";
     logger.writeLogFile(INFO,  logString);
-    printAry(easpect, "easpect", nFamEll);
-    
-    if (orientationOption == 0) {
-        printAry(eAngleOne, "etheta", nFamEll);
-        printAry(eAngleTwo, "ephi", nFamEll);
-    } else if (orientationOption == 1) {
-        printAry(eAngleOne, "etrend", nFamEll);
-        printAry(eAngleTwo, "eplunge", nFamEll);
-    } else if (orientationOption == 2) {
-        printAry(eAngleOne, "edip", nFamEll);
-        printAry(eAngleTwo, "estrike", nFamEll);
+    printAry(params->easpect, "easpect", params->nFamEll);
+    
+    if (params->orientationOption == 0) {
+        printAry(params->eAngleOne, "etheta", params->nFamEll);
+        printAry(params->eAngleTwo, "ephi", params->nFamEll);
+    } else if (params->orientationOption == 1) {
+        printAry(params->eAngleOne, "etrend", params->nFamEll);
+        printAry(params->eAngleTwo, "eplunge", params->nFamEll);
+    } else if (params->orientationOption == 2) {
+        printAry(params->eAngleOne, "edip", params->nFamEll);
+        printAry(params->eAngleTwo, "estrike", params->nFamEll);
     }
     
-    printAry(ebeta, "ebeta", nFamEll);
-    printAry(ekappa, "ekappa", nFamEll);
-    printAry(eLogMean, "eLogMean", nFamEll);
-    printAry(esd, "esd", nFamEll);
-    printAry(eExpMean, "eExpMean", nFamEll);
-    printAry(econst, "econst", nFamEll);
-    printAry(emin, "emin", nFamEll);
-    printAry(emax, "emax", nFamEll);
-    printAry(ealpha, "ealpha", nFamEll);
-    printAry(rdistr, "rdistr", nFamRect);
-    printAry(raspect, "raspect", nFamRect);
-    logString = "rAngleOption = " + to_string(rAngleOption);
+    printAry(params->ebeta, "ebeta", params->nFamEll);
+    printAry(params->ekappa, "ekappa", params->nFamEll);
+    printAry(params->eLogMean, "eLogMean", params->nFamEll);
+    printAry(params->esd, "esd", params->nFamEll);
+    printAry(params->eExpMean, "eExpMean", params->nFamEll);
+    printAry(params->econst, "econst", params->nFamEll);
+    printAry(params->emin, "emin", params->nFamEll);
+    printAry(params->emax, "emax", params->nFamEll);
+    printAry(params->ealpha, "ealpha", params->nFamEll);
+    printAry(params->rdistr, "rdistr", params->nFamRect);
+    printAry(params->raspect, "raspect", params->nFamRect);
+    logString = "rAngleOption = " + to_string(params->rAngleOption);
     logger.writeLogFile(INFO,  logString);
     
-    if (orientationOption == 0) {
-        printAry(rAngleOne, "rtheta", nFamRect);
-        printAry(rAngleTwo, "rphi", nFamRect);
-    } else if (orientationOption == 1) {
-        printAry(rAngleOne, "rtrend", nFamRect);
-        printAry(rAngleTwo, "rplunge", nFamRect);
-    } else if (orientationOption == 2) {
-        printAry(rAngleOne, "rdip", nFamRect);
-        printAry(rAngleTwo, "rstrike", nFamRect);
+    if (params->orientationOption == 0) {
+        printAry(params->rAngleOne, "rtheta", params->nFamRect);
+        printAry(params->rAngleTwo, "rphi", params->nFamRect);
+    } else if (params->orientationOption == 1) {
+        printAry(params->rAngleOne, "rtrend", params->nFamRect);
+        printAry(params->rAngleTwo, "rplunge", params->nFamRect);
+    } else if (params->orientationOption == 2) {
+        printAry(params->rAngleOne, "rdip", params->nFamRect);
+        printAry(params->rAngleTwo, "rstrike", params->nFamRect);
     }
     
-    printAry(rbeta, "rbeta", nFamRect);
-    printAry(rLogMean, "rLogMean", nFamRect);
-    printAry(rsd, "rsd", nFamRect);
-    printAry(rmin, "rmin", nFamRect);
-    printAry(rmax, "rmax", nFamRect);
-    printAry(ralpha, "ralpha", nFamRect);
-    printAry(rkappa, "rkappa", nFamRect);
-    printAry(rExpMean, "rExpMean", nFamRect);
-    printAry(rconst, "rconst", nFamRect);
-    logString = "userEllipsesOnOff = " + to_string(userEllipsesOnOff);
+    printAry(params->rbeta, "rbeta", params->nFamRect);
+    printAry(params->rLogMean, "rLogMean", params->nFamRect);
+    printAry(params->rsd, "rsd", params->nFamRect);
+    printAry(params->rmin, "rmin", params->nFamRect);
+    printAry(params->rmax, "rmax", params->nFamRect);
+    printAry(params->ralpha, "ralpha", params->nFamRect);
+    printAry(params->rkappa, "rkappa", params->nFamRect);
+    printAry(params->rExpMean, "rExpMean", params->nFamRect);
+    printAry(params->rconst, "rconst", params->nFamRect);
+    logString = "userEllipsesOnOff = " + to_string(params->userEllipsesOnOff);
     logger.writeLogFile(INFO,  logString);
     
-    if (userEllipsesOnOff != 0) {
-        logString = "nUserEll = " + to_string(nUserEll) + "\n";
+    if (params->userEllipsesOnOff != 0) {
+        logString = "nUserEll = " + to_string(params->nUserEll) + "\n";
         logger.writeLogFile(INFO,  logString);
-        printAry(ueRadii, "ueRadii", nUserEll);
-        logString = "urAngleOption = " + to_string(ueAngleOption);
+        printAry(params->ueRadii, "ueRadii", params->nUserEll);
+        logString = "urAngleOption = " + to_string(params->ueAngleOption);
         logger.writeLogFile(INFO,  logString);
-        printAry(ueBeta, "ueBeta", nUserEll);
-        printAry(ueaspect, "ueaspect", nUserEll);
-        print2dAry(uetranslation, "uetranslation", nUserEll);
-        print2dAry(uenormal, "uenormal", nUserEll);
-        printAry(uenumPoints, "uenumPoints", nUserEll);
+        printAry(params->ueBeta, "ueBeta", params->nUserEll);
+        printAry(params->ueaspect, "ueaspect", params->nUserEll);
+        print2dAry(params->uetranslation, "uetranslation", params->nUserEll);
+        print2dAry(params->uenormal, "uenormal", params->nUserEll);
+        printAry(params->uenumPoints, "uenumPoints", params->nUserEll);
     }
     
-    logString = "userRectanglesOnOff = " + to_string(userRectanglesOnOff);
+    logString = "userRectanglesOnOff = " + to_string(params->userRectanglesOnOff);
     logger.writeLogFile(INFO,  logString);
     
-    if (userRectanglesOnOff != 0) {
-        logString = "nUserRect = " + to_string(nUserRect) + "\n";
+    if (params->userRectanglesOnOff != 0) {
+        logString = "nUserRect = " + to_string(params->nUserRect) + "\n";
         logger.writeLogFile(INFO,  logString);
-        printAry(urRadii, "urRadii", nUserRect);
-        logString = "urAngleOption = " + to_string(urAngleOption);
+        printAry(params->urRadii, "urRadii", params->nUserRect);
+        logString = "urAngleOption = " + to_string(params->urAngleOption);
         logger.writeLogFile(INFO,  logString);
-        printAry(urBeta, "urBeta", nUserRect);
-        printAry(urRadii, "urRadii", nUserRect);
-        printAry(uraspect, "uraspect", nUserRect);
-        print2dAry(urtranslation, "urtranslation", nUserRect);
-        print2dAry(urnormal, "urnormal", nUserRect);
+        printAry(params->urBeta, "urBeta", params->nUserRect);
+        printAry(params->urRadii, "urRadii", params->nUserRect);
+        printAry(params->uraspect, "uraspect", params->nUserRect);
+        print2dAry(params->urtranslation, "urtranslation", params->nUserRect);
+        print2dAry(params->urnormal, "urnormal", params->nUserRect);
     }
     
-    logString = "userRecByCoord = " + to_string(userRecByCoord);
+    logString = "userRecByCoord = " + to_string(params->userRecByCoord);
     logger.writeLogFile(INFO,  logString);
     
-    if (userRecByCoord != 0) {
-        logString = "nRectByCoord = " + to_string(nRectByCoord);
+    if (params->userRecByCoord != 0) {
+        logString = "nRectByCoord = " + to_string(params->nRectByCoord);
         logger.writeLogFile(INFO,  logString);
-        printRectCoords(userRectCoordVertices, "userRectCoordVertices", nRectByCoord);
+        printRectCoords(params->userRectCoordVertices, "userRectCoordVertices", params->nRectByCoord);
     }
     
     // std::cout << "aperture option: " << aperture << std::endl;
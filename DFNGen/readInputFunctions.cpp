@@ -18,37 +18,46 @@ using std::string;
 /*******************************************************************/
 /*! Searches for variable in files, moves file pointer to position
     after word. Used to read in varlable values
-    Arg 1: ifstream file object
+    Arg 1: Input file
     Arg 2: Word to search for */
-void searchVar(std::ifstream &stream, std::string search) {
-    std::string word;
-    stream.clear(); // Reset file pointer in case of eof encountered
-    // Reset file position pointer to beginning, allows access to variables in any order
-    stream.seekg(0);
-    
-    while (stream >> word) {
-        if (word == search) {
-            break;
-        }
-    }
-    
-    if ((int) stream.tellg() == -1) {
+void searchVar(InputReader &stream, std::string search) {
+    if (!findVar(stream, search)) {
         std::string logString = "Variable not found: \"" + search + "\"\n";
         logger.writeLogFile(INFO,  logString);
-        exit(1);
+        throw DFNError();
     }
 }
 
+/*******************************************************************/
+/*******************************************************************/
+/*! Same as searchVar() for optional variables, no error when the
+    variable is missing. Variables can be read in any order, the position
+    of each variable is indexed when the file is opened (see inputReader.h).
+    Arg 1: Input file
+    Arg 2: Name of variable to search for
+    Return: True if the variable was found, stream points after it */
+bool findVar(InputReader &stream, std::string search) {
+    return stream.find(search);
+}
+
 /*******************************************************************/
 /*******************************************************************/
 /*! Checks file for being opened correectly with error msg
-    Arg 1: ifstream file object
+    Arg 1: Input file
     Arg 2: Filename. Used for error print if there is an error*/
+void checkIfOpen(InputReader &stream, std::string fileName) {
+    if (!stream.is_open()) {
+        std::string logString = "ERROR: unable to open file " + fileName;
+        logger.writeLogFile(ERROR,  logString);
+        throw DFNError();
+    }
+}
+
 void checkIfOpen(std::ifstream &stream, std::string fileName) {
     if (!stream.is_open()) {
         std::string logString = "ERROR: unable to open file " + fileName;
         logger.writeLogFile(ERROR,  logString);
-        exit(1);
+        throw DFNError();
     }
 }
 
@@ -56,7 +65,7 @@ void checkIfOpen(std::ofstream &stream, std::string fileName) {
     if (!stream.is_open()) {
         std::string logString = "ERROR: unable to open file " + fileName;
         logger.writeLogFile(ERROR,  logString);
-        exit(1);
+        throw DFNError();
     }
 }
 
@@ -64,10 +73,10 @@ void checkIfOpen(std::ofstream &stream, std::string fileName) {
 /**********************************************************************/
 /*! Used to read in rectangualr coordinates when the user is using
     user rectangles defined by coordinates option.
-    Arg 1: ifstream file object
+    Arg 1: Input file
     Arg 2: OUTPUT. Pointer to array to store the coordinates
     Arg 3: Number of rectangles */
-void getRectCoords(std::ifstream &stream, double *var, int nRectangles) {
+void getRectCoords(InputReader &stream, std::vector<double> &var, int nRectangles) {
     int i;
     char ch;
     
@@ -85,11 +94,11 @@ void getRectCoords(std::ifstream &stream, double *var, int nRectangles) {
 /**********************************************************************/
 /*! Used to read in ellipse coordinates when the user is using
     user ellipses defined by coordinates option.
-    Arg 1: ifstream file object
+    Arg 1: Input file
     Arg 2: OUTPUT. Pointer to array to store the coordinates
     Arg 3: Number of ellipses
     Arg 4: Number of points per ellipse */
-void getCords(std::ifstream & stream, double *outAry, int nPoly, int nVertices) {
+void getCords(InputReader &stream, std::vector<double> &outAry, int nPoly, int nVertices) {
     char ch;
     int size = nPoly * nVertices;
     
@@ -106,7 +115,7 @@ void getCords(std::ifstream & stream, double *outAry, int nPoly, int nVertices)
     Arg 1: Array that stored all rectangular coordinates.
     Arg 2: Variable name
     Arg 3: Number of rectangles */
-void printRectCoords(double *var, std::string varName, int nRectangles) {
+void printRectCoords(const std::vector<double> &var, std::string varName, int nRectangles) {
     int i;
     std::string logString = varName + ": \n";
     logger.writeLogFile(INFO,  logString);
@@ -139,7 +148,7 @@ void checkLineLength(std::vector<std::string> &parsedLine, std::string line, lon
         logger.writeLogFile(ERROR,  logString);
         logString = "Line\n" + line + "\nhas a length of " + to_string(parsedLine.size()) + ". Expected length of " + to_string(length) + ".\nExiting";
         logger.writeLogFile(ERROR,  logString);
-        exit(1);
+        throw DFNError();
     }
 }
 
@@ -169,18 +178,18 @@ void readDomainVertices(std::string filename) {
     getline(verticesFile, line);
     parsedLine = splitOnWhiteSpace(line);
     // get number of cells in x and y
-    numOfDomainVertices = std::stoi(parsedLine[0]);
-    logString = "There are " + to_string(numOfDomainVertices) + " Vertices on the boundary";
+    params->numOfDomainVertices = std::stoi(parsedLine[0]);
+    logString = "There are " + to_string(params->numOfDomainVertices) + " Vertices on the boundary";
     logger.writeLogFile(INFO,  logString);
-    domainVertices.reserve(numOfDomainVertices);
+    params->domainVertices.reserve(params->numOfDomainVertices);
     Point tmpPoint;
     
-    for (int i = 0; i < numOfDomainVertices; i++) {
+    for (int i = 0; i < params->numOfDomainVertices; i++) {
         getline(verticesFile, line);
         parsedLine = splitOnWhiteSpace(line);
         tmpPoint.x = std::stod(parsedLine[0]);
         tmpPoint.y = std::stod(parsedLine[1]);
-        domainVertices.push_back(tmpPoint);
+        params->domainVertices.push_back(tmpPoint);
     }
     
     verticesFile.close();
@@ -7,26 +7,29 @@
 #include "structures.h"
 #include "input.h"
 #include "logFile.h"
+#include "inputReader.h"
 
 //Note, Template functions (type t) are coded inside .h files
 
 // Function forward declarations/prototypes
 // See readInputFunctions.cpp for descriptions and code
-void searchVar(std::ifstream &stream, std::string search);
+void searchVar(InputReader &stream, std::string search);
+bool findVar(InputReader &stream, std::string search);
+void checkIfOpen(InputReader &stream, std::string fileName);
 void checkIfOpen(std::ifstream &stream, std::string fileName);
 void checkIfOpen(std::ofstream &stream, std::string fileName);
-void getCords(std::ifstream & stream, double *outAry, int nPoly, int nVertices);
+void getCords(InputReader &stream, std::vector<double> &outAry, int nPoly, int nVertices);
 std::vector<std::string> splitOnWhiteSpace(std::string line);
 void readDomainVertices(std::string filename);
 
 /*****************************************************************/
 /*! Gets multiple arrays from input/ Assumes arrays are format: {x,y,z}
     Reads a 2D array in a 1D format.
-    Arg 1: if stream object
+    Arg 1: Input file
     Arg 2: OUTPUT, array to place read values into
     Arg 3: Number of rows of array we are reading */
 template <typename T>
-void get2dAry(std::ifstream &stream, T *var, int rowSize) {
+void get2dAry(InputReader &stream, std::vector<T> &var, int rowSize) {
     int i;
     char ch;
     
@@ -39,11 +42,11 @@ void get2dAry(std::ifstream &stream, T *var, int rowSize) {
 /*****************************************************************/
 /*! Gets multiple arrays from input/ Assumes arrays are format: {x,y}
     Reads a 2D array in a 1D format.
-    Arg 1: if stream object
+    Arg 1: Input file
     Arg 2: OUTPUT, array to place read values into
     Arg 3: Number of rows of array we are reading */
 template <typename T>
-void get2dAry2(std::ifstream &stream, T *var, int rowSize) {
+void get2dAry2(InputReader &stream, std::vector<T> &var, int rowSize) {
     int i;
     char ch;
     
@@ -57,16 +60,19 @@ void get2dAry2(std::ifstream &stream, T *var, int rowSize) {
 
 /*****************************************************************/
 /*! Used to read in 1d arrays from input file with n Elements
-    Arg 1: ifstream object
+    Arg 1: Input file
     Arg 2: OUTPUT, array to place read values into
     Arg 3: Number of elements to read */
 template <typename T>
-void getInputAry(std::ifstream &stream, T *var, int nElements) {
+void getInputAry(InputReader &stream, std::vector<T> &var, int nElements) {
     int i;
     char ch;
     
     for (i = 0; i < nElements; i++) {
-        stream >> ch >> var[i];
+        // Read into a T, elements of std::vector<bool> are not references
+        T value;
+        stream >> ch >> value;
+        var[i] = value;
     }
 }
 
@@ -77,7 +83,7 @@ void getInputAry(std::ifstream &stream, T *var, int nElements) {
     Arg 2: Variable name
     ARg 3: Number of elements */
 template <typename T>
-void printAry(T *var, std::string varName, int nElements) {
+void printAry(const std::vector<T> &var, std::string varName, int nElements) {
     int i;
     nElements += -1;
     std::string logString = varName + " = {";
@@ -100,7 +106,7 @@ void printAry(T *var, std::string varName, int nElements) {
     Arg 2: Variable name
     ARg 3: Number of row */
 template <typename T>
-void print2dAry(T *var, std::string varName, int rowSize) {
+void print2dAry(const std::vector<T> &var, std::string varName, int rowSize) {
     int i;
     std::string logString = varName + " :\n";
     logger.writeLogFile(INFO,  logString);
@@ -115,11 +121,11 @@ void print2dAry(T *var, std::string varName, int rowSize) {
 
 /*****************************************************************/
 /*! Read list of elements from file seperated by spaces
-    Arg 1: ifstream object
+    Arg 1: Input file
     Arg 2: OUTPUT, Pointer to arary to store elements read
     Arg 3: Number of elements to read */
 template <typename T>
-void getElements(std::ifstream &stream, T *var, int nElements) {
+void getElements(InputReader &stream, std::vector<T> &var, int nElements) {
     int i;
     
     for(i = 0; i < nElements; i++) {
@@ -127,10 +133,10 @@ void getElements(std::ifstream &stream, T *var, int nElements) {
     }
 }
 
-void getRectCoords(std::ifstream &stream, double *var, int nRectangles);
-void printRectCoords(double *var, std::string varName, int nRectangles);
+void getRectCoords(InputReader &stream, std::vector<double> &var, int nRectangles);
+void printRectCoords(const std::vector<double> &var, std::string varName, int nRectangles);
 void printInputVars();
-void getInput(char* inputFile, std::vector<Shape> &shapeFamily);
+void getInput(const char *inputFile, std::vector<Shape> &shapeFamily);
 unsigned int getTimeBasedSeed();
 
 #endif
@@ -0,0 +1,768 @@
+#include "streaming.h"
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <climits>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h> // rmdir()
+#include "input.h"
+#include "output.h" // makeDIR()
+#include "binaryOutput.h" // writeBinaryHeader(), writeChunkHeader()
+#include "insertShape.h" // fractureReach()
+#include "indexList.h"
+#include "readInputFunctions.h" // error check for file open checkIfOpen()
+#include "logFile.h"
+
+/*! Column files, one per column of the FRAC, VERT, INTS and TRIP chunks of
+    dfn.bin (see binaryOutput.cpp), in the order they appear in the chunks */
+enum StreamColumn {
+    COL_NODES, COL_FAMILY, COL_XRADIUS, COL_YRADIUS, COL_ASPECT_RATIO, COL_AREA,
+    COL_TRANSLATION, COL_NORMAL, COL_FACES, COL_VERTEX_START, COL_VERTICES,
+    COL_FRACT1, COL_FRACT2, COL_END1, COL_END2, COL_TRIPLE_START, COL_TRIPLE_INDEX,
+    COL_TRIPLE_POINTS, COL_COUNT
+};
+
+static const char *columnNames[COL_COUNT] = {
+    "nodes", "family", "xradius", "yradius", "aspectRatio", "area",
+    "translation", "normal", "faces", "vertexStart", "vertices",
+    "fract1", "fract2", "end1", "end2", "tripleStart", "tripleIndex",
+    "triplePoints"
+};
+
+/*! Marks fractures, intersections and triple points which are not in memory (anymore) */
+static const unsigned int notInMemory = UINT_MAX;
+
+/*! Folder of the column files, <output folder>/dfngen_stream */
+static std::string streamFolder;
+static std::ofstream columns[COL_COUNT];
+
+/*! Number of slabs, 0 when not streaming */
+static unsigned int slabCount = 0;
+/*! Slab being filled */
+static unsigned int slab = 0;
+/*! Lower x of the first slab (lower x of the domain) */
+static double sweepMin;
+static double slabWidth;
+/*! Largest distance from a fracture's translation to its vertices, all families */
+static double reach;
+/*! Largest x of the written fractures. A new fracture must stay above it. */
+static double writtenLimit;
+
+/*! Part of a family's domain, layer or region before the end of each slab,
+    [family * slabCount + slab] */
+static std::vector<double> familyShare;
+/*! nPoly option: number of accepted fractures which completes each slab */
+static std::vector<unsigned int> slabTarget;
+/*! nPoly option: CDF of the families in the current slab */
+static float *currentCDF = NULL;
+/*! Radii of each family for each slab, [family * slabCount + slab]. The radii
+    list of a family is replaced with the slab's radii when the slab starts. */
+static std::vector<std::vector<double> > slabRadii;
+
+/*! Family and area of the written fractures, by fracture number */
+static std::vector<int> fractureFamily;
+static std::vector<float> fractureArea;
+/*! Number given to the triple points in memory which are already written, notInMemory otherwise */
+static std::vector<unsigned int> tripleIds;
+static unsigned int intersectionCount = 0;
+static unsigned int triplePointCount = 0;
+/*! Running totals of the CSR columns, vertexStart and tripleStart */
+static uint64_t vertexCount = 0;
+static uint64_t tripleIndexCount = 0;
+
+/* put() *************************************************************************************/
+/*! Appends values to a column file
+    Arg 1: Column
+    Arg 2: Pointer to first value
+    Arg 3: Number of values */
+template <typename T>
+static void put(StreamColumn column, const T *values, size_t count) {
+    columns[column].write(reinterpret_cast<const char*>(values), count * sizeof(T));
+}
+
+template <typename T>
+static void put(StreamColumn column, T value) {
+    put(column, &value, 1);
+}
+
+/* columnPath() ******************************************************************************/
+static std::string columnPath(int column) {
+    return streamFolder + "/" + columnNames[column] + ".col";
+}
+
+/* slabStart() *******************************************************************************/
+/*! Lower x of a slab. The first and last slab are open ended: fractures of
+    regions outside the domain go to them.
+    Arg 1: Slab
+    Return: Lower x of the slab */
+static double slabStart(unsigned int s) {
+    return s == 0 ? -HUGE_VAL : sweepMin + s * slabWidth;
+}
+
+static double slabEnd(unsigned int s) {
+    return s + 1 >= slabCount ? HUGE_VAL : sweepMin + (s + 1) * slabWidth;
+}
+
+/* share() ***********************************************************************************/
+/*! Part of a family's fractures (nPoly option) or intensity (P32 option) inserted
+    up to the end of a slab
+    Arg 1: Family index
+    Arg 2: Slab, -1 for none
+    Return: Share in [0, 1], 1 for the last slab */
+static double share(int familyIndex, int s) {
+    return s < 0 ? 0 : familyShare[familyIndex * slabCount + s];
+}
+
+/* setSlabCDF() ******************************************************************************/
+/*! nPoly option: sets the CDF of the current slab, famProb weighted by the part of
+    each family's translations which fall in the slab
+    Arg 1: Number of families */
+static void setSlabCDF(int totalFamilies) {
+    double sum = 0;
+    
+    for (int i = 0; i < totalFamilies; i++) {
+        sum += params->famProb[i] * (share(i, slab) - share(i, (int) slab - 1));
+    }
+    
+    // No family in this slab: it is complete as soon as it starts, the CDF is not used
+    if (sum <= 0) {
+        return;
+    }
+    
+    double cumulative = 0;
+    
+    for (int i = 0; i < totalFamilies; i++) {
+        cumulative += params->famProb[i] * (share(i, slab) - share(i, (int) slab - 1));
+        currentCDF[i] = cumulative / sum;
+    }
+}
+
+/* useSlabRadii() ****************************************************************************/
+/*! Replaces the radii list of each family with its radii for the current slab
+    Arg 1: Shape families */
+static void useSlabRadii(std::vector<Shape> &shapeFamilies) {
+    for (unsigned int i = 0; i < shapeFamilies.size(); i++) {
+        std::vector<double> &radii = slabRadii[i * slabCount + slab];
+        shapeFamilies[i].radiiList.swap(radii);
+        shapeFamilies[i].radiiIdx = 0;
+        std::vector<double>().swap(radii);
+    }
+}
+
+/* initStreaming() ***************************************************************************/
+/*! Starts streaming generation with the first slab and creates the column files.
+    Must be called after the user fractures are inserted and the radii lists are
+    generated, before the stochastic fractures are inserted.
+    Arg 1: Path to output folder
+    Arg 2: Number of slabs along x
+    Arg 3: Shape families
+    Arg 4: Program statistics, accepted fractures so far */
+void initStreaming(std::string outputFolder, unsigned int slabs, std::vector<Shape> &shapeFamilies, Stats &pstats) {
+    std::string logString;
+    
+    if (params->removeFracturesLessThan > 0 || params->polygonBoundaryFlag) {
+        logString = "Error: removeFracturesLessThan and polygonBoundaryFlag rebuild the whole DFN after generation, they can not be used with --stream\n";
+        logger.writeLogFile(ERROR,  logString);
+        throw DFNError();
+    }
+    
+    int totalFamilies = shapeFamilies.size();
+    slabCount = slabs;
+    slab = 0;
+    sweepMin = (-params->domainSize[0] - params->domainSizeIncrease[0]) / 2;
+    slabWidth = (params->domainSize[0] + params->domainSizeIncrease[0]) / slabs;
+    writtenLimit = -HUGE_VAL;
+    reach = fractureReach(shapeFamilies);
+    
+    // Share of each family up to the end of each slab, by the x range of its translations
+    familyShare.assign(totalFamilies * slabCount, 1);
+    
+    for (int i = 0; i < totalFamilies; i++) {
+        double xMin = sweepMin;
+        double xMax = -sweepMin;
+        
+        if (shapeFamilies[i].region > 0) {
+            int regionIdx = (shapeFamilies[i].region - 1) * 6;
+            xMin = params->regions[regionIdx];
+            xMax = params->regions[regionIdx + 1];
+        }
+        
+        for (unsigned int s = 0; s + 1 < slabCount; s++) {
+            double end = slabEnd(s);
+            
+            if (xMax > xMin) {
+                familyShare[i * slabCount + s] = std::min(1.0, std::max(0.0, (end - xMin) / (xMax - xMin)));
+            } else {
+                familyShare[i * slabCount + s] = end > xMin ? 1 : 0;
+            }
+        }
+    }
+    
+    // Radii lists are sorted, largest first. Each slab gets radii from the whole list,
+    // by the family's shares (golden ratio sequence), so that the first slab does
+    // not get the largest fractures.
+    slabRadii.assign(totalFamilies * slabCount, std::vector<double>());
+    
+    for (int i = 0; i < totalFamilies; i++) {
+        Shape &shapeFam = shapeFamilies[i];
+        
+        for (unsigned int j = shapeFam.radiiIdx; j < shapeFam.radiiList.size(); j++) {
+            double u = std::fmod((j - shapeFam.radiiIdx + 0.5) * 0.6180339887498949, 1.0);
+            unsigned int s = 0;
+            
+            while (s + 1 < slabCount && u >= share(i, s)) {
+                s++;
+            }
+            
+            slabRadii[i * slabCount + s].push_back(shapeFam.radiiList[j]);
+        }
+    }
+    
+    useSlabRadii(shapeFamilies);
+    
+    if (params->stopCondition == 0) {
+        // nPoly option: the fractures still to insert are split by the families' shares
+        unsigned int start = pstats.acceptedPolyCount;
+        unsigned int total = params->nPoly > start ? params->nPoly - start : 0;
+        slabTarget.resize(slabCount);
+        
+        for (unsigned int s = 0; s < slabCount; s++) {
+            double fraction = 0;
+            
+            for (int i = 0; i < totalFamilies; i++) {
+                fraction += params->famProb[i] * share(i, s);
+            }
+            
+            slabTarget[s] = start + (unsigned int) std::floor(total * fraction + 0.5);
+        }
+        
+        slabTarget[slabCount - 1] = start + total;
+        currentCDF = new float[std::max(totalFamilies, 1)];
+        setSlabCDF(totalFamilies);
+    }
+    
+    streamFolder = outputFolder + "/dfngen_stream";
+    makeDIR(streamFolder.c_str());
+    
+    for (int c = 0; c < COL_COUNT; c++) {
+        std::string fileName = columnPath(c);
+        columns[c].open(fileName.c_str(), std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+        checkIfOpen(columns[c], fileName);
+    }
+    
+    logString = "Streaming the DFN in " + to_string(slabCount) + " slabs of " + to_string(slabWidth)
+                + " m along x, fractures are written once more than " + to_string(reach) + " m behind the current slab\n";
+    logger.writeLogFile(INFO,  logString);
+    
+    if (slabWidth < reach) {
+        logString = "Slabs are narrower than the largest fractures, fractures stay in memory for "
+                    + to_string((int) std::ceil(reach / slabWidth) + 1) + " slabs\n";
+        logger.writeLogFile(INFO,  logString);
+    }
+}
+
+/* streaming() *******************************************************************************/
+/*! Return: True during streaming generation */
+bool streaming() {
+    return slabCount > 0;
+}
+
+/* limitToSlab() *****************************************************************************/
+/*! Limits the x range of a new translation to the current slab. No change when
+    not streaming or when the range is outside the slab (behindSlabs() still
+    applies). Used by randomTranslation().
+    Arg 1: Lower x, changed
+    Arg 2: Upper x, changed */
+void limitToSlab(float &xMin, float &xMax) {
+    if (slabCount == 0) {
+        return;
+    }
+    
+    double lower = std::max((double) xMin, slabStart(slab));
+    double upper = std::min((double) xMax, slabEnd(slab));
+    
+    if (lower < upper) {
+        xMin = lower;
+        xMax = upper;
+    }
+}
+
+/* slabCDF() *********************************************************************************/
+/*! nPoly option: CDF of the families in the current slab, replaces the CDF of famProb
+    Return: CDF, one element per family */
+float *slabCDF() {
+    return currentCDF;
+}
+
+/* familyInSlab() ****************************************************************************/
+/*! Checks if a family takes fractures in the current slab: part of its translations
+    fall in the slab and, with the P32 option, it has not reached its intensity for
+    the slab yet
+    Arg 1: Family index
+    Arg 2: Shape families
+    Return: True if a fracture of the family can be inserted */
+bool familyInSlab(int familyIndex, std::vector<Shape> &shapeFamilies) {
+    double slabShare = share(familyIndex, slab);
+    
+    if (slabShare <= share(familyIndex, (int) slab - 1)) {
+        return false;
+    }
+    
+    return params->stopCondition == 0 || shapeFamilies[familyIndex].currentP32 < shapeFamilies[familyIndex].p32Target * slabShare;
+}
+
+/* behindSlabs() *****************************************************************************/
+/*! Checks if a new fracture reaches the fractures already written. Only
+    happens if a radius is larger than the family's maximum (see reach).
+    Arg 1: New fracture, after truncation
+    Return: True if the fracture must be re-translated */
+bool behindSlabs(Poly &poly) {
+    for (int i = 0; i < poly.numberOfNodes; i++) {
+        if (poly.vertices[3 * i] <= writtenLimit) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/* slabComplete() ****************************************************************************/
+/*! Return: True if the current slab has all its fractures (nPoly option) or all
+            families have their intensity for the slab (P32 option) */
+static bool slabComplete(Stats &pstats, std::vector<Shape> &shapeFamilies) {
+    if (params->stopCondition == 0) {
+        return pstats.acceptedPolyCount >= slabTarget[slab];
+    }
+    
+    for (unsigned int i = 0; i < shapeFamilies.size(); i++) {
+        if (params->p32Status[i] == 0 && shapeFamilies[i].currentP32 < shapeFamilies[i].p32Target * share(i, slab)) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/* writeTriplePoint() ************************************************************************/
+/*! Return: Number of the written triple point */
+static unsigned int writeTriplePoint(Point &point) {
+    double pt[3] = {point.x, point.y, point.z};
+    put(COL_TRIPLE_POINTS, pt, 3);
+    return triplePointCount++;
+}
+
+/* writeFracture() ***************************************************************************/
+/*! Writes a fracture to the column files and frees its vertices
+    Arg 1: Fracture
+    Return: Number of the written fracture */
+static unsigned int writeFracture(Poly &poly) {
+    put(COL_NODES, (int32_t) poly.numberOfNodes);
+    put(COL_FAMILY, (int32_t) poly.familyNum);
+    put(COL_XRADIUS, poly.xradius);
+    put(COL_YRADIUS, poly.yradius);
+    put(COL_ASPECT_RATIO, poly.aspectRatio);
+    put(COL_AREA, poly.area);
+    put(COL_TRANSLATION, poly.translation, 3);
+    put(COL_NORMAL, poly.normal, 3);
+    
+    for (int k = 0; k < 6; k++) {
+        put(COL_FACES, (uint8_t) poly.faces[k]);
+    }
+    
+    put(COL_VERTEX_START, vertexCount);
+    put(COL_VERTICES, poly.vertices, 3 * poly.numberOfNodes);
+    vertexCount += poly.numberOfNodes;
+    writtenLimit = std::max(writtenLimit, poly.boundingBox[1]);
+    delete[] poly.vertices;
+    poly.vertices = NULL;
+    fractureFamily.push_back(poly.familyNum);
+    fractureArea.push_back(poly.area);
+    return fractureFamily.size() - 1;
+}
+
+/* writeIntersection() ***********************************************************************/
+/*! Writes an intersection of two written fractures, its triple points must be written
+    Arg 1: Intersection, fract1 and fract2 are -(number of the written fracture + 1) */
+static void writeIntersection(IntPoints &intersection) {
+    put(COL_FRACT1, (int64_t) (-intersection.fract1 - 1));
+    put(COL_FRACT2, (int64_t) (-intersection.fract2 - 1));
+    double end1[3] = {intersection.x1, intersection.y1, intersection.z1};
+    double end2[3] = {intersection.x2, intersection.y2, intersection.z2};
+    put(COL_END1, end1, 3);
+    put(COL_END2, end2, 3);
+    put(COL_TRIPLE_START, tripleIndexCount);
+    
+    for (unsigned int j = 0; j < intersection.triplePointsIdx.size(); j++) {
+        put(COL_TRIPLE_INDEX, (uint32_t) tripleIds[intersection.triplePointsIdx[j]]);
+        tripleIndexCount++;
+    }
+    
+    intersectionCount++;
+}
+
+/* writeFractures() **************************************************************************/
+/*! Writes the fractures which end before x = 'cut' to the column files, with the
+    intersections and triple points which only belong to written fractures, and
+    removes them from memory. The fractures, intersections and triple points left
+    are renumbered, as are the indices between them and the cluster lists.
+    Written fractures move from the polyList of their cluster to its streamedList.
+    Intersections with a written fracture keep -(its number + 1) in fract1 or fract2
+    until they are written.
+    Arg 1: Fractures in memory
+    Arg 2: Intersections in memory
+    Arg 3: Triple points in memory
+    Arg 4: Program statistics, cluster lists
+    Arg 5: x below which fractures are written, HUGE_VAL for all */
+static void writeFractures(std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints,
+                           Stats &pstats, double cut) {
+    // Fractures: new index, or notInMemory and the number they are written with
+    unsigned int n = acceptedPoly.size();
+    std::vector<unsigned int> polyMap(n);
+    std::vector<unsigned int> polyIds(n);
+    unsigned int kept = 0;
+    
+    for (unsigned int i = 0; i < n; i++) {
+        if (acceptedPoly[i].boundingBox[1] < cut) {
+            polyMap[i] = notInMemory;
+            polyIds[i] = writeFracture(acceptedPoly[i]);
+        } else {
+            polyMap[i] = kept;
+            acceptedPoly[kept++] = acceptedPoly[i];
+        }
+    }
+    
+    if (kept == n) {
+        // No intersection can be complete without a new written fracture
+        return;
+    }
+    
+    acceptedPoly.erase(acceptedPoly.begin() + kept, acceptedPoly.end());
+    // Intersections: written once both fractures are
+    tripleIds.resize(triplePoints.size(), notInMemory);
+    unsigned int k = intPts.size();
+    std::vector<unsigned int> intMap(k);
+    std::vector<bool> tripleUsed(triplePoints.size(), false);
+    std::vector<bool> tripleNeeded(triplePoints.size(), false);
+    
+    for (unsigned int j = 0; j < k; j++) {
+        IntPoints &intersection = intPts[j];
+        long int *fract[2] = {&intersection.fract1, &intersection.fract2};
+        
+        for (int f = 0; f < 2; f++) {
+            if (*fract[f] >= 0) {
+                unsigned int idx = *fract[f];
+                *fract[f] = polyMap[idx] == notInMemory ? -((long int) polyIds[idx] + 1) : (long int) polyMap[idx];
+            }
+        }
+        
+        bool written = intersection.fract1 < 0 && intersection.fract2 < 0;
+        intMap[j] = written ? notInMemory : 0;
+        
+        for (unsigned int t = 0; t < intersection.triplePointsIdx.size(); t++) {
+            if (written) {
+                tripleNeeded[intersection.triplePointsIdx[t]] = true;
+            } else {
+                tripleUsed[intersection.triplePointsIdx[t]] = true;
+            }
+        }
+    }
+    
+    // Triple points: written in order once a written intersection has them, kept
+    // while an intersection in memory has them
+    std::vector<unsigned int> tripleMap(triplePoints.size());
+    unsigned int keptTriples = 0;
+    
+    for (unsigned int t = 0; t < triplePoints.size(); t++) {
+        if (tripleIds[t] == notInMemory && (tripleNeeded[t] || !tripleUsed[t])) {
+            tripleIds[t] = writeTriplePoint(triplePoints[t]);
+        }
+    }
+    
+    unsigned int keptInts = 0;
+    
+    for (unsigned int j = 0; j < k; j++) {
+        if (intMap[j] == notInMemory) {
+            writeIntersection(intPts[j]);
+        } else {
+            intMap[j] = keptInts;
+            intPts[keptInts++] = intPts[j];
+        }
+    }
+    
+    intPts.erase(intPts.begin() + keptInts, intPts.end());
+    
+    for (unsigned int t = 0; t < triplePoints.size(); t++) {
+        if (tripleUsed[t]) {
+            tripleMap[t] = keptTriples;
+            tripleIds[keptTriples] = tripleIds[t];
+            triplePoints[keptTriples++] = triplePoints[t];
+        } else {
+            tripleMap[t] = notInMemory;
+        }
+    }
+    
+    triplePoints.erase(triplePoints.begin() + keptTriples, triplePoints.end());
+    tripleIds.resize(keptTriples);
+    
+    for (unsigned int j = 0; j < intPts.size(); j++) {
+        IndexList &list = intPts[j].triplePointsIdx;
+        
+        for (unsigned int t = 0; t < list.size(); t++) {
+            list[t] = tripleMap[list[t]];
+        }
+    }
+    
+    // Intersections of fractures in memory are in memory
+    for (unsigned int i = 0; i < acceptedPoly.size(); i++) {
+        IndexList &list = acceptedPoly[i].intersectionIndex;
+        
+        for (unsigned int j = 0; j < list.size(); j++) {
+            list[j] = intMap[list[j]];
+        }
+    }
+    
+    for (unsigned int g = 0; g < pstats.fractGroup.size(); g++) {
+        std::vector<unsigned int> &polyList = pstats.fractGroup[g].polyList;
+        unsigned int keptPolys = 0;
+        
+        for (unsigned int i = 0; i < polyList.size(); i++) {
+            unsigned int idx = polyList[i];
+            
+            if (polyMap[idx] == notInMemory) {
+                pstats.fractGroup[g].streamedList.push_back(polyIds[idx]);
+            } else {
+                polyList[keptPolys++] = polyMap[idx];
+            }
+        }
+        
+        polyList.resize(keptPolys);
+    }
+    
+    // Lists of the removed fractures and intersections are left in the index pool
+    compactIndexLists(acceptedPoly, intPts);
+}
+
+/* advanceSlab() *****************************************************************************/
+/*! Moves to the next slab once the current one is complete, and writes the
+    fractures which the next slab's fractures can not reach. Called before each
+    new fracture. The last slab is complete when generation ends.
+    Arg 1: Fractures in memory
+    Arg 2: Intersections in memory
+    Arg 3: Triple points in memory
+    Arg 4: Program statistics
+    Arg 5: Shape families
+    Return: True if a new slab was started */
+bool advanceSlab(std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints,
+                 Stats &pstats, std::vector<Shape> &shapeFamilies) {
+    if (slab + 1 >= slabCount || !slabComplete(pstats, shapeFamilies)) {
+        return false;
+    }
+    
+    slab++;
+    useSlabRadii(shapeFamilies);
+    
+    if (params->stopCondition == 0) {
+        setSlabCDF(shapeFamilies.size());
+    }
+    
+    unsigned int inMemory = acceptedPoly.size();
+    writeFractures(acceptedPoly, intPts, triplePoints, pstats, slabStart(slab) - reach);
+    std::string logString = "Slab " + to_string(slab + 1) + " of " + to_string(slabCount) + ": wrote "
+                            + to_string(inMemory - acceptedPoly.size()) + " fractures, " + to_string(acceptedPoly.size())
+                            + " fractures and " + to_string(intPts.size()) + " intersections in memory\n";
+    logger.writeLogFile(INFO,  logString);
+    return true;
+}
+
+/* finishStreaming() *************************************************************************/
+/*! Writes the fractures, intersections and triple points left in memory and closes
+    the column files. All cluster lists are streamedList's afterwards.
+    Arg 1: Fractures in memory, empty afterwards
+    Arg 2: Intersections in memory, empty afterwards
+    Arg 3: Triple points in memory, empty afterwards
+    Arg 4: Program statistics */
+void finishStreaming(std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints, Stats &pstats) {
+    writeFractures(acceptedPoly, intPts, triplePoints, pstats, HUGE_VAL);
+    
+    for (int c = 0; c < COL_COUNT; c++) {
+        columns[c].close();
+        
+        if (columns[c].fail()) {
+            std::string logString = "Error: Unable to write " + columnPath(c) + "\n";
+            logger.writeLogFile(ERROR,  logString);
+            throw DFNError();
+        }
+    }
+    
+    delete[] currentCDF;
+    currentCDF = NULL;
+    std::vector<std::vector<double> >().swap(slabRadii);
+    std::vector<unsigned int>().swap(tripleIds);
+}
+
+/* streamedFractureCount() *******************************************************************/
+unsigned int streamedFractureCount() {
+    return fractureFamily.size();
+}
+
+unsigned int streamedIntersectionCount() {
+    return intersectionCount;
+}
+
+unsigned int streamedTriplePointCount() {
+    return triplePointCount;
+}
+
+/* streamedFracture() ************************************************************************/
+/*! Family and area of a written fracture, for the statistics after generation
+    Arg 1: Number of the written fracture
+    Arg 2: OUTPUT, family index, < 0 for user fractures
+    Arg 3: OUTPUT, area */
+void streamedFracture(unsigned int id, int &familyNum, double &area) {
+    familyNum = fractureFamily[id];
+    area = fractureArea[id];
+}
+
+/* columnSize() ******************************************************************************/
+/*! Return: Size of a column file in bytes */
+static uint64_t columnSize(int column) {
+    std::string fileName = columnPath(column);
+    std::ifstream file(fileName.c_str(), std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+    checkIfOpen(file, fileName);
+    return file.tellg();
+}
+
+/* copyColumn() ******************************************************************************/
+/*! Appends a column file to the container
+    Arg 1: Container file
+    Arg 2: Column */
+static void copyColumn(std::ofstream &out, int column) {
+    std::string fileName = columnPath(column);
+    std::ifstream file(fileName.c_str(), std::ifstream::in | std::ifstream::binary);
+    checkIfOpen(file, fileName);
+    std::vector<char> buffer(1 << 20);
+    
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        out.write(buffer.data(), file.gcount());
+    }
+}
+
+/* copyFractureIds() *************************************************************************/
+/*! Appends the fract1 or fract2 column to the container, with the numbers of the
+    final fractures changed as adjustIntFractIDs() does
+    Arg 1: Container file
+    Arg 2: Column, COL_FRACT1 or COL_FRACT2
+    Arg 3: Numbers of the final fractures, ascending */
+static void copyFractureIds(std::ofstream &out, int column, std::vector<unsigned int> &finalFractures) {
+    std::string fileName = columnPath(column);
+    std::ifstream file(fileName.c_str(), std::ifstream::in | std::ifstream::binary);
+    checkIfOpen(file, fileName);
+    std::vector<int64_t> buffer(1 << 17);
+    
+    while (file) {
+        file.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(int64_t));
+        size_t count = file.gcount() / sizeof(int64_t);
+        
+        for (size_t i = 0; i < count; i++) {
+            std::vector<unsigned int>::iterator it = std::lower_bound(finalFractures.begin(), finalFractures.end(), buffer[i]);
+            
+            if (it != finalFractures.end() && *it == buffer[i]) {
+                buffer[i] = -((int64_t) (it - finalFractures.begin()) + 1);
+            }
+        }
+        
+        out.write(reinterpret_cast<const char*>(buffer.data()), count * sizeof(int64_t));
+    }
+}
+
+/* writeStreamedBinaryOutput() ***************************************************************/
+/*! Assembles the column files into the binary container dfnGen_output/dfn.bin,
+    in the layout written by writeBinaryOutput() without the FADJ chunk, and removes
+    them. Must be called after finishStreaming().
+    Arg 1: Numbers of the final fractures, ascending
+    Arg 2: Shape families
+    Arg 3: Path to output folder */
+void writeStreamedBinaryOutput(std::vector<unsigned int> &finalFractures, std::vector<Shape> &shapeFamilies, std::string outputFolder) {
+    std::string logString = "Writing Binary DFN File (dfn.bin)\n";
+    logger.writeLogFile(INFO,  logString);
+    std::string fileName = outputFolder + "/dfnGen_output/dfn.bin";
+    std::ofstream file;
+    file.open(fileName.c_str(), std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+    checkIfOpen(file, fileName);
+    writeBinaryHeader(file, shapeFamilies);
+    // FRAC
+    uint64_t n = fractureFamily.size();
+    uint64_t size = sizeof(n);
+    
+    for (int c = COL_NODES; c <= COL_FACES; c++) {
+        size += columnSize(c);
+    }
+    
+    writeChunkHeader(file, "FRAC", size);
+    file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    
+    for (int c = COL_NODES; c <= COL_FACES; c++) {
+        copyColumn(file, c);
+    }
+    
+    // VERT
+    writeChunkHeader(file, "VERT", columnSize(COL_VERTEX_START) + sizeof(vertexCount) + columnSize(COL_VERTICES));
+    copyColumn(file, COL_VERTEX_START);
+    file.write(reinterpret_cast<const char*>(&vertexCount), sizeof(vertexCount));
+    copyColumn(file, COL_VERTICES);
+    // FINL
+    uint64_t m = finalFractures.size();
+    writeChunkHeader(file, "FINL", sizeof(m) + m * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(&m), sizeof(m));
+    
+    for (uint64_t i = 0; i < m; i++) {
+        uint32_t id = finalFractures[i];
+        file.write(reinterpret_cast<const char*>(&id), sizeof(id));
+    }
+    
+    // INTS
+    uint64_t k = intersectionCount;
+    size = sizeof(k) + sizeof(tripleIndexCount);
+    
+    for (int c = COL_FRACT1; c <= COL_TRIPLE_INDEX; c++) {
+        size += columnSize(c);
+    }
+    
+    writeChunkHeader(file, "INTS", size);
+    file.write(reinterpret_cast<const char*>(&k), sizeof(k));
+    copyFractureIds(file, COL_FRACT1, finalFractures);
+    copyFractureIds(file, COL_FRACT2, finalFractures);
+    copyColumn(file, COL_END1);
+    copyColumn(file, COL_END2);
+    copyColumn(file, COL_TRIPLE_START);
+    file.write(reinterpret_cast<const char*>(&tripleIndexCount), sizeof(tripleIndexCount));
+    copyColumn(file, COL_TRIPLE_INDEX);
+    // TRIP
+    uint64_t t = triplePointCount;
+    writeChunkHeader(file, "TRIP", sizeof(t) + columnSize(COL_TRIPLE_POINTS));
+    file.write(reinterpret_cast<const char*>(&t), sizeof(t));
+    copyColumn(file, COL_TRIPLE_POINTS);
+    file.close();
+    
+    if (file.fail()) {
+        logString = "Error: Unable to write " + fileName + "\n";
+        logger.writeLogFile(ERROR,  logString);
+        throw DFNError();
+    }
+    
+    for (int c = 0; c < COL_COUNT; c++) {
+        std::remove(columnPath(c).c_str());
+    }
+    
+    rmdir(streamFolder.c_str());
+    slabCount = 0;
+    std::vector<int>().swap(fractureFamily);
+    std::vector<float>().swap(fractureArea);
+    intersectionCount = 0;
+    triplePointCount = 0;
+    vertexCount = 0;
+    tripleIndexCount = 0;
+}
@@ -0,0 +1,43 @@
+#ifndef _streaming_h_
+#define _streaming_h_
+#include <vector>
+#include <string>
+#include "structures.h"
+
+/*
+    Streaming generation (DFNGen --stream <slabs>) for networks which do not fit in memory.
+
+    The domain is swept along x in slabs: the stochastic fractures of a slab are
+    inserted before the fractures of the next slab, each family gets the share
+    of its intensity (P32 option) or of nPoly (nPoly option) which matches the
+    part of its domain, layer or region inside the slab, and its share of the
+    family's radii list (from the largest to the smallest radius). A fracture whose
+    bounding box ends more than the largest fracture size before the current
+    slab can not be intersected anymore. When a slab is started, these
+    fractures, and the intersections and triple points which only belong to
+    them, are written to column files (<output folder>/dfngen_stream) and
+    removed from memory. Only the fractures near the current slab and the
+    cluster data stay in memory.
+
+    Fractures, intersections and triple points are numbered in the order they
+    are written. After generation, writeStreamedBinaryOutput() assembles the
+    column files into dfnGen_output/dfn.bin, DFNBinaryToAscii converts it to
+    the usual output files.
+*/
+
+void initStreaming(std::string outputFolder, unsigned int slabs, std::vector<Shape> &shapeFamilies, Stats &pstats);
+bool streaming();
+void limitToSlab(float &xMin, float &xMax);
+float *slabCDF();
+bool familyInSlab(int familyIndex, std::vector<Shape> &shapeFamilies);
+bool behindSlabs(Poly &poly);
+bool advanceSlab(std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints,
+                 Stats &pstats, std::vector<Shape> &shapeFamilies);
+void finishStreaming(std::vector<Poly> &acceptedPoly, std::vector<IntPoints> &intPts, std::vector<Point> &triplePoints, Stats &pstats);
+unsigned int streamedFractureCount();
+unsigned int streamedIntersectionCount();
+unsigned int streamedTriplePointCount();
+void streamedFracture(unsigned int id, int &familyNum, double &area);
+void writeStreamedBinaryOutput(std::vector<unsigned int> &finalFractures, std::vector<Shape> &shapeFamilies, std::string outputFolder);
+
+#endif
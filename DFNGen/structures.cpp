@@ -104,6 +104,9 @@ Stats::Stats() {
     tripleNodeCount = 0;
     areaBeforeRemoval = 0;
     areaAfterRemoval = 0;
+    acceptedFromFam = NULL;
+    rejectedFromFam = NULL;
+    expectedFromFam = NULL;
 }
 
 // Constructor
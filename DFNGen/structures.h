@@ -2,6 +2,7 @@
 #define _polyStruct_h_
 #include <vector>
 #include <cmath>
+#include "indexList.h"
 
 
 /**************************************************************************************/
@@ -34,14 +35,14 @@ struct Poly {
     
     /*! X-radius before fracture-domain truncation. In the case of rectangles, radius is
         1/2 the width of the polygon.
-    
+        
         X-radius is equal to the value generated from randum distributions or given by the user
         in the case of constant distributions and user-defined fractures.*/
     double xradius;
     
     /*! Y-radius before fracture-domain truncation. In the case of rectangles, radius is 1/2
         the width of the polygon.
-    
+        
         Y-radius is equal to x-radius * aspect ratio (yradius = aspectRatio * xradius). */
     double yradius;
     
@@ -95,7 +96,7 @@ struct Poly {
     bool truncated;
     
     /*! List of indices to the permanent intersection array ('intPts' in main()) which belong to this polygon. */
-    std::vector<unsigned int> intersectionIndex;
+    IndexList intersectionIndex;
     
     // Constructor
     Poly();
@@ -155,7 +156,7 @@ struct IntPoints {
     /*! Intersection endpoint 2, z position.*/
     double z2;
     /*! Triple intersection points/nodes on intersection. */
-    std::vector<unsigned int> triplePointsIdx;
+    IndexList triplePointsIdx;
     
     /*! Used to update book keeping for keeping track of overal intersection length
         that has been shortened from shrinkIntersection(). Used in intersectionChecking(). */
@@ -166,6 +167,22 @@ struct IntPoints {
 
 
 
+/**************************************************************************************/
+/**************************************************************************************/
+/*! Intersection of a new fracture with an accepted fracture, found with
+    findIntersections() before the new fracture is checked with FRAM. Used by
+    the bulk insertion of user polygons, which finds intersections in parallel
+    (see intersectionChecking()). */
+struct FoundIntersection {
+    /*! Index of the intersecting fracture in the accepted polygons list */
+    unsigned int fracture;
+    
+    /*! Intersection, as returned by findIntersections() */
+    IntPoints intersection;
+};
+
+
+
 /**************************************************************************************/
 /**************************************************************************************/
 /*!
@@ -214,6 +231,8 @@ struct FractureGroups {
     unsigned long long int groupNum;
     /*! List of polygon indices in the 'acceptedPoly' array in main() which belong to this group. */
     std::vector<unsigned int> polyList;
+    /*! Streaming generation (see streaming.h): numbers of the written fractures of this group. */
+    std::vector<unsigned int> streamedList;
     FractureGroups();
 };
 
@@ -279,7 +298,7 @@ struct RejectionReasons {
 /*! Program and DFN statisistics structure. Keeps various statistics, including
     fracture cluster information, about the DFN being generated. */
 struct Stats {
-
+    
     /*! Counters for the number of polygons/fractures accepted by each stochastic
         family. Elements in this array are in the same order as the stochastic shape
         families array 'shapeFamilies' in main(). e.g. The counter for the second family
@@ -318,7 +337,7 @@ struct Stats {
         counter in writeIntersections() when generating output files. It is used
         to determine the number of nodes lagrit will see as duplicates and remove. */
 //   unsigned int numIntPoints;
-
+    
     /*! Total area of fractures before isolated fracture removal. Variable is set in main() after
         DFN generation has completed. */
     double areaBeforeRemoval;
@@ -394,7 +413,7 @@ struct Stats {
     and are placed in a Shape structure array.
 */
 struct Shape {
-
+    
     /*! 0 = ellipse, 1 = rectangle */
     short shapeFamily;
     
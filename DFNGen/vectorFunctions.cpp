@@ -21,7 +21,7 @@ double *projection( const double *v1, const double *v2 ) {
     double v2_ls = v2[0] * v2[0] + v2[1] * v2[1] + v2[2] * v2[2];
     double *result = new double[3];
     
-    if (v2_ls < eps) {
+    if (v2_ls < params->eps) {
         result[0] = 0;
         result[1] = 0;
         result[2] = 0;
@@ -44,7 +44,7 @@ inline void normalize(T *vec) {
     } else {
         std::string logString = "ERROR: Attempted to normalize a vector with magnitude = 0\n";
         logger.writeLogFile(ERROR,  logString);
-        exit(1);
+        throw DFNError();
     }
 }
 
@@ -115,7 +115,7 @@ inline bool parallel(double *v1, double *v2) {
     normalize(v2);
     double dotProd = dotProduct(v1, v2);
     
-    if (1 - eps < dotProd && dotProd < 1 + eps) {
+    if (1 - params->eps < dotProd && dotProd < 1 + params->eps) {
         return 1;
     } else {
         return 0;
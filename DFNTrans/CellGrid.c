@@ -0,0 +1,288 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include "FuncDef.h"
+
+struct cellgrid { /*! uniform grid of triangular cells of one fracture, defined in fracture's xy plane */
+    double xmin; // lower left corner of the grid
+    double ymin;
+    double dx; // size of grid bucket
+    double dy;
+    unsigned int nx; // number of buckets in x and y directions
+    unsigned int ny;
+    unsigned int *first; // index of the first cell of every bucket in the list of cells, nx*ny+1 values
+    unsigned int *cells; // list of cells ID, ordered by buckets
+};
+
+static struct cellgrid *fracgrid = NULL;
+
+//////////////////////////////////////////////////////////////////////////////
+void CellNodeXY(unsigned int nodeid, unsigned int fract, double xy[2])
+/*! Function returns xy coordinations of node nodeid in the plane of fracture fract (intersection nodes have two sets of xy coordinations). */
+{
+    if ((node[nodeid - 1].fracture[1] == fract) && (node[nodeid - 1].fracture[0] != fract)) {
+        xy[0] = node[nodeid - 1].coord_xy[3];
+        xy[1] = node[nodeid - 1].coord_xy[4];
+    } else {
+        xy[0] = node[nodeid - 1].coord_xy[0];
+        xy[1] = node[nodeid - 1].coord_xy[1];
+    }
+
+    return;
+}
+//////////////////////////////////////////////////////////////////////////////
+void CellBox(unsigned int numc, double bmin[2], double bmax[2])
+/*! Function defines a bounding box of triangular cell numc in the plane of its fracture. */
+{
+    int k;
+    double xy[2];
+
+    for (k = 0; k < 3; k++) {
+        CellNodeXY(cell[numc - 1].node_ind[k], cell[numc - 1].fracture, xy);
+
+        if ((k == 0) || (xy[0] < bmin[0])) {
+            bmin[0] = xy[0];
+        }
+
+        if ((k == 0) || (xy[1] < bmin[1])) {
+            bmin[1] = xy[1];
+        }
+
+        if ((k == 0) || (xy[0] > bmax[0])) {
+            bmax[0] = xy[0];
+        }
+
+        if ((k == 0) || (xy[1] > bmax[1])) {
+            bmax[1] = xy[1];
+        }
+    }
+
+    return;
+}
+//////////////////////////////////////////////////////////////////////////////
+unsigned int GridIndex(double x, double xmin, double dx, unsigned int n)
+/*! Function returns the index of grid bucket that contains coordinate x; indices out of grid are moved to the grid edge. */
+{
+    double ind;
+    ind = floor((x - xmin) / dx);
+
+    if (ind < 0.0) {
+        return 0;
+    }
+
+    if (ind > (double) (n - 1)) {
+        return n - 1;
+    }
+
+    return (unsigned int) ind;
+}
+//////////////////////////////////////////////////////////////////////////////
+void GridRange(struct cellgrid *g, double bmin[2], double bmax[2], unsigned int *ix0, unsigned int *ix1, unsigned int *iy0, unsigned int *iy1)
+/*! Function defines the range of grid buckets overlapped by a bounding box. */
+{
+    *ix0 = GridIndex(bmin[0], g->xmin, g->dx, g->nx);
+    *ix1 = GridIndex(bmax[0], g->xmin, g->dx, g->nx);
+    *iy0 = GridIndex(bmin[1], g->ymin, g->dy, g->ny);
+    *iy1 = GridIndex(bmax[1], g->ymin, g->dy, g->ny);
+    return;
+}
+//////////////////////////////////////////////////////////////////////////////
+void BuildCellGrid()
+/*! Function builds a uniform grid over every fracture in its xy plane. Every grid bucket keeps the list of triangular cells,
+ which bounding boxes overlap the bucket, so the cell that contains a given point is found by checking a few cells only (LocateCell).
+ The size of buckets is chosen to have about one triangle per bucket. */
+{
+    unsigned int i, c, b, ix, iy, ix0, ix1, iy0, iy1, firstc, lastc, nb;
+    unsigned int *fill;
+    double bmin[2], bmax[2], gmin[2], gmax[2], width, height, margin, bsize;
+    unsigned long totalsize = 0;
+    struct cellgrid *g;
+    fracgrid = (struct cellgrid*) malloc (nfract * sizeof(struct cellgrid));
+
+    if (fracgrid == NULL) {
+        printf("Allocation memory problem - cell grid\n");
+        exit(1);
+    }
+
+    for (i = 0; i < nfract; i++) {
+        g = &fracgrid[i];
+        g->nx = 0;
+        g->ny = 0;
+        g->first = NULL;
+        g->cells = NULL;
+
+        if (fracture[i].numbcells == 0) {
+            continue;
+        }
+
+        firstc = fracture[i].firstcell;
+        lastc = fracture[i].firstcell + fracture[i].numbcells - 1;
+
+        /* bounding box of the fracture */
+        CellBox(firstc, gmin, gmax);
+
+        for (c = firstc + 1; c <= lastc; c++) {
+            CellBox(c, bmin, bmax);
+
+            if (bmin[0] < gmin[0]) {
+                gmin[0] = bmin[0];
+            }
+
+            if (bmin[1] < gmin[1]) {
+                gmin[1] = bmin[1];
+            }
+
+            if (bmax[0] > gmax[0]) {
+                gmax[0] = bmax[0];
+            }
+
+            if (bmax[1] > gmax[1]) {
+                gmax[1] = bmax[1];
+            }
+        }
+
+        width = gmax[0] - gmin[0];
+        height = gmax[1] - gmin[1];
+        /* small margin keeps points on the fracture boundary inside the grid */
+        margin = 1e-6 * (width + height) + 1e-12;
+        g->xmin = gmin[0] - margin;
+        g->ymin = gmin[1] - margin;
+        width = width + 2.0 * margin;
+        height = height + 2.0 * margin;
+        bsize = sqrt(width * height / fracture[i].numbcells);
+        g->nx = (unsigned int) (width / bsize);
+        g->ny = (unsigned int) (height / bsize);
+
+        if (g->nx < 1) {
+            g->nx = 1;
+        }
+
+        if (g->ny < 1) {
+            g->ny = 1;
+        }
+
+        if (g->nx > fracture[i].numbcells) {
+            g->nx = fracture[i].numbcells;
+        }
+
+        if (g->ny > fracture[i].numbcells) {
+            g->ny = fracture[i].numbcells;
+        }
+
+        g->dx = width / g->nx;
+        g->dy = height / g->ny;
+        nb = g->nx * g->ny;
+        g->first = (unsigned int*) calloc (nb + 1, sizeof(unsigned int));
+        fill = (unsigned int*) malloc (nb * sizeof(unsigned int));
+
+        if ((g->first == NULL) || (fill == NULL)) {
+            printf("Allocation memory problem - cell grid\n");
+            exit(1);
+        }
+
+        /* count cells in every bucket, then fill the buckets */
+        for (c = firstc; c <= lastc; c++) {
+            CellBox(c, bmin, bmax);
+            GridRange(g, bmin, bmax, &ix0, &ix1, &iy0, &iy1);
+
+            for (iy = iy0; iy <= iy1; iy++) {
+                for (ix = ix0; ix <= ix1; ix++) {
+                    g->first[iy * g->nx + ix + 1]++;
+                }
+            }
+        }
+
+        for (b = 0; b < nb; b++) {
+            g->first[b + 1] = g->first[b + 1] + g->first[b];
+        }
+
+        g->cells = (unsigned int*) malloc (g->first[nb] * sizeof(unsigned int));
+
+        if (g->cells == NULL) {
+            printf("Allocation memory problem - cell grid\n");
+            exit(1);
+        }
+
+        memcpy(fill, g->first, nb * sizeof(unsigned int));
+
+        for (c = firstc; c <= lastc; c++) {
+            CellBox(c, bmin, bmax);
+            GridRange(g, bmin, bmax, &ix0, &ix1, &iy0, &iy1);
+
+            for (iy = iy0; iy <= iy1; iy++) {
+                for (ix = ix0; ix <= ix1; ix++) {
+                    b = iy * g->nx + ix;
+                    g->cells[fill[b]] = c;
+                    fill[b]++;
+                }
+            }
+        }
+
+        free(fill);
+        totalsize = totalsize + g->first[nb] + nb + 1;
+    }
+
+    printf("\n Cell search grid is built: %5.2f MB \n", (double)totalsize * sizeof(unsigned int) / (1024.0 * 1024.0));
+    return;
+}
+//////////////////////////////////////////////////////////////////////////////
+int LocateCell()
+/*! Function finds the triangular cell of fracture particle[np].fracture that contains particle's position, using the fracture's grid.
+ Returns 1 if the cell is found (particle's cell and interpolation weights are set by InsideCell), 0 otherwise. */
+{
+    unsigned int k, b, ix, iy, fract;
+    double x, y;
+    struct cellgrid *g;
+    fract = particle[np].fracture;
+
+    if ((fracgrid == NULL) || (fract == 0) || (fract > nfract)) {
+        return 0;
+    }
+
+    g = &fracgrid[fract - 1];
+
+    if (g->nx == 0) {
+        return 0;
+    }
+
+    x = particle[np].position[0];
+    y = particle[np].position[1];
+
+    /* particle is out of fracture's bounding box */
+    if ((x < g->xmin) || (y < g->ymin) || (x > g->xmin + g->nx * g->dx) || (y > g->ymin + g->ny * g->dy)) {
+        return 0;
+    }
+
+    ix = GridIndex(x, g->xmin, g->dx, g->nx);
+    iy = GridIndex(y, g->ymin, g->dy, g->ny);
+    b = iy * g->nx + ix;
+
+    for (k = g->first[b]; k < g->first[b + 1]; k++) {
+        if (InsideCell(g->cells[k]) == 1) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+//////////////////////////////////////////////////////////////////////////////
+void FreeCellGrid()
+/*! Function frees memory of the fractures grids. */
+{
+    unsigned int i;
+
+    if (fracgrid == NULL) {
+        return;
+    }
+
+    for (i = 0; i < nfract; i++) {
+        free(fracgrid[i].first);
+        free(fracgrid[i].cells);
+    }
+
+    free(fracgrid);
+    fracgrid = NULL;
+    return;
+}
+//////////////////////////////////////////////////////////////////////////////
@@ -1,5 +1,13 @@
 
 #define  pi 3.14159265359
+
+/*! Floating point type of node geometry and velocities. With "make PRECISION=single" they are kept in single precision,
+ relative to the fracture's origin; particles positions and times are always in double precision */
+#ifdef SINGLE_GEOMETRY
+typedef float geom_t;
+#else
+typedef double geom_t;
+#endif
 /*! The directory/path for particle tracking outputs, defined by user */
 extern char maindir[125];
 
@@ -68,6 +76,9 @@ extern unsigned int *nodezoneout;
 
 extern unsigned int flag_w;
 
+/*! number of particles kept in memory when particles are seeded in chunks (init_chunk); 0 - all particles are seeded at once */
+extern unsigned int chunkpart;
+
 
 
 /*! Material structure contains fracture parameters, read from DFN mesh */
@@ -99,10 +110,14 @@ struct material {
     
     /*! rotational matrix from 2d to 3d */
     double rot3mat[3][3];
+    
+    /*! origin of fracture's xy plane; node xy coordinations and particles positions are relative to it (zero in double precision geometry) */
+    double origin[3];
 };
 
 
-/*! Vertex is a node structure and contains all the information about the node/vertex of the DFN mesh */
+/*! Vertex is a node structure and contains the information about the node/vertex of the DFN mesh, that is used in particle tracking.
+ The data needed only for mesh reading, velocity reconstruction and particles seeding are kept separately in struct vertexdata. */
 struct vertex {
 
     /*! node type: 0 - interior node; 10 - boundary (exterior) node; 2 - intersection (interface) node; 12 - intersection boundary node; 300, 310, 302, 312 - node in in-flow boundary; 200, 210, 202, 212 - node in out-flow boundary */
@@ -111,27 +126,24 @@ struct vertex {
     /*! fracture ID where node is */
     unsigned int fracture[2];
     
-    /*! node's x,y,z coordinations */
-    double coord[3];
-    
-    /*! XYZ plane coordination of node; if the node is on intersection then two sets of XYZ coordinations are defined (each set for each intersecting fracture */
-    double coord_xy[6];
-    
-    /*! Voronoi polygon vlue associated with the cell center */
-    double pvolume;  // volume of Voronoi polygon
-    
-    /*! fluid pressure defined at the node by flow solver */
-    double pressure; //pressure
-    
     /*!  number of nodes connections */
     unsigned int numneighb;  //number of neighboring nodes
     
+    /*! XYZ plane coordination of node; if the node is on intersection then two sets of XYZ coordinations are defined (each set for each intersecting fracture */
+    geom_t coord_xy[6];
+    
     /*! reconstructed Darcy velocity at the node, four velocities are defined at intersection nodes */
-    double velocity[4][2]; //Darcy's velocity
+    geom_t velocity[4][2]; //Darcy's velocity
     
     /*! appropriate time step for particles is defined at the node according to the volume of control volume cell */
     double timestep[4]; // time step
     
+    /*! fracture aperture at the control volume cell */
+    double aperture; //aperture of the cell
+    
+    /*! fluid pressure defined at the node by flow solver */
+    double pressure; //pressure
+    
     /*! dynamic array of neighboring nodes ID*/
     unsigned int* indnodes; //array of neighboring node's indices
     
@@ -143,18 +155,23 @@ struct vertex {
     
     /*! dynamic array of types of neighbouring nodes */
     unsigned int* type; //array of node's type
+};
+
+
+/*! Vertexdata structure contains the node data that are not used in particles movement: mesh data, used in velocity reconstruction and particles seeding */
+struct vertexdata {
+
+    /*! node's x,y,z coordinations */
+    double coord[3];
+    
+    /*! Voronoi polygon vlue associated with the cell center */
+    double pvolume;  // volume of Voronoi polygon
     
     /*! dynamic array of flow fluxes at the edges of the control volume cell */
     double* flux;//array of fluxes
     
-    /*! dynamic array of 2D areas of the edges of the control volume cell */
-    double* area;//area of Voronoi facea
-    
-    /*! residential time of particles inside the control volume cell */
-    double residtime; //residential time of particles
-    
-    /*! fracture aperture at the control volume cell */
-    double aperture; //aperture of the cell
+    /*! dynamic array of 2D areas of the edges of the control volume cell, freed after velocity reconstruction */
+    geom_t* area;//area of Voronoi facea
 };
 
 
@@ -219,6 +236,9 @@ extern    struct material *fracture;
 /*! DYNAMIC ARRAY OF NODES in DFN mesh */
 extern    struct vertex *node;
 
+/*! DYNAMIC ARRAY OF NODES DATA, not used in particles movement */
+extern    struct vertexdata *nodedata;
+
 /*! DYNAMIC ARRAY OF PARTICLES */
 extern    struct contam *particle;
 
@@ -230,6 +250,7 @@ void ReadInit();
 void ReadDataFiles();
 void AdjacentCells(int  ln, int i, int  j, int  k);
 void Convertto2d();
+void PointTo2d(int j, double coord[3], double xyz[3]);
 void Convertto3d();
 void DarcyVelocity();
 struct matr   MatrixProducts (double normxarea[][2],  int number);
@@ -250,6 +271,12 @@ void AcrossIntersection (int prevcell, int int1, int int2, int mixing_rule);
 void ChangeFracture(int cell_win);
 struct posit3d CalculatePosition3D();
 int InitCell ();
+void CellNodeXY(unsigned int nodeid, unsigned int fract, double xy[2]);
+void CellBox(unsigned int numc, double bmin[2], double bmax[2]);
+unsigned int GridIndex(double x, double xmin, double dx, unsigned int n);
+void BuildCellGrid();
+int LocateCell();
+void FreeCellGrid();
 int InitPos();
 void Moving2Center(int nnp, int cellnumber);
 int Moving2NextCell(int stuck, int k);
@@ -276,12 +303,16 @@ void HalfPolygonVelocity(int i, int k, int fractn, int indc, unsigned int fractj
 struct posit3d CalculateVelocity3D();
 void BoundaryLine(int n1, int n2, int n3);
 void CheckGrid();
+void FreeNodeData();
 int BVelocityDirection(int b1, int b2);
 double InOutFlowCell(int indcell, int int1, double nposx, double nposy);
 void Moving2NextCellBound(int prevcell);
 struct inpfile Control_File(char fileobject[], int ctr);
 struct inpfile Control_Data(char fileobject[], int ctr);
 void ParticleOutput (int currentt, int frac_p);
+void SaveTempData(int tcurrent, double beta, double totallength, double posit3[3], double veloc3[3]);
+struct tempout *TempRecord(int tfind, int tfirst, int nrec);
+struct tempout *ReadTempData(int k);
 struct inpfile Control_Param(char fileobject[], int ctr);
 void FlowInWeight(int numbpart);
 int InitParticles_ones (int k_current, double inter_p[][4], int fracture, int parts_fracture, int ii, double thirdcoor, int zonenumb_in, int first_ind, int last_ind);
@@ -297,4 +328,16 @@ struct inpfile Control_File_Optional(char fileobject[], int ctr);
 double TimeDomainRW (double time_advect);
 int InitParticles_flux (int k_current, int firstn, int lastn, double weight_p);
 int InitInWell(int nodepart);
-
+int InitSeeding(int flag_in, unsigned int numberf, unsigned int firstind[], unsigned int lastind[], unsigned int firstnode[], unsigned int lastnode[]);
+void RewindSeeding();
+unsigned int NextParticles();
+int SeedParticle(unsigned int k);
+unsigned int RandomSeedCell(unsigned short xsubi[3]);
+double SeedInFlux();
+void FreeSeeding();
+double ParticleInFlux();
+void PlaceParticle_np (int k, int firstnd, int lastnd, int pf, int j, int first_ind, int last_ind);
+unsigned int EdgeParticles_eq (int firstn, int lastn, double parts_dist, double eqdist[2]);
+void PlaceParticle_eq (int k, int firstn, int j, double eqdist[2]);
+unsigned int NodeParticles_flux (unsigned int j, int first_ind, int last_ind, double weight_p, double startpos[2], double eqdist[2]);
+void PlaceParticle_flux (int k, int first_ind, int jj, double startpos[2], double eqdist[2], double weight_p);
@@ -17,6 +17,25 @@ struct posit3d {
     double cord3[3];
 };
 
+struct seeding { /*! state of particles seeding when particles are seeded in chunks (option init_chunk) */
+    int flag_in; // option of particles initial positions
+    unsigned int numberf; // number of fracture edges in in-flow boundary
+    unsigned int *firstind, *lastind, *firstnode, *lastnode; // first and last node of each boundary fracture edge and their index in nodezonein
+    int parts_fracture; // init_nf: number of particles per fracture edge
+    double parts_dist; // init_eqd: distance between particles
+    double weight_p; // init_fluxw: flux weight of a particle
+    int nodepart; // init_well: number of particles per in-flow node
+    double sum_aperture; // init_random, init_well: sum of apertures used to normalize the weights
+    unsigned int edge; // current boundary fracture edge (in-flow node in init_well)
+    unsigned int ind; // current in-flow node on the edge (init_fluxw)
+    unsigned int count; // number of particles already seeded on current edge / node
+    unsigned int total; // number of particles already seeded
+    unsigned short xsubi[3]; // state of random generator (init_random)
+    unsigned short xsubi0[3]; // state of random generator at the beginning of seeding
+};
+
+static struct seeding sgen;
+
 
 int InitPos()
 /*! Function defines the required option of particles initial positions defined at input control file; calculates number of particles, allocates memory. */
@@ -28,6 +47,13 @@ int InitPos()
     double ixmin = 0, ixmax = 0, iymin = 0, iymax = 0, izmin = 0, izmax = 0;
     double px[4] = {0.0, 0.0, 0.0, 0.0}, py[4] = {0.0, 0.0, 0.0, 0.0};
     double weight_p = 0.0;
+    /* particles can be seeded lazily, in chunks of init_chunk particles, instead of all at once */
+    initfile = Control_File_Optional("init_chunk:", 11);
+    chunkpart = 0;
+    
+    if (initfile.flag > 0) {
+        chunkpart = atoi(initfile.filename);
+    }
     
     /* calculating number of fractures in in-flow boundary face of the domain ****/
     
@@ -90,8 +116,12 @@ int InitPos()
         parts_fracture = initfile.flag;
         printf("\n  %d  particles per boundary fracture edge \n", parts_fracture);
         npart = (numbf + 1) * parts_fracture;
+        sgen.parts_fracture = parts_fracture;
+        
         /*  memory allocatation for particle  */
-        particle = (struct contam*) malloc (npart * sizeof(struct contam));
+        if (chunkpart == 0) {
+            particle = (struct contam*) malloc (npart * sizeof(struct contam));
+        }
     } else {
         initfile = Control_File("init_eqd:", 9);
         res = strncmp(initfile.filename, "yes", 3);
@@ -113,17 +143,20 @@ int InitPos()
             //npart = parts_fracture;
 
             /*  memory allocation for particle structures */
-            particle = (struct contam*) malloc ((npart) * sizeof(struct contam));
+            if (chunkpart == 0) {
+                particle = (struct contam*) malloc ((npart) * sizeof(struct contam));
+            }
 
             // define a distance between particles
             double length2 = 0.0, t_length = 0.0;
             // Get the total length of the fractures intersecting with the boundary zone 
             for (i = 0; i < numbf; i++) {
-                length2 = pow((node[firstnode[i] - 1].coord[0] - node[lastnode[i] - 1].coord[0]), 2) + pow((node[firstnode[i] - 1].coord[1] - node[lastnode[i] - 1].coord[1]), 2) + pow((node[firstnode[i] - 1].coord[2] - node[lastnode[i] - 1].coord[2]), 2);
+                length2 = pow((nodedata[firstnode[i] - 1].coord[0] - nodedata[lastnode[i] - 1].coord[0]), 2) + pow((nodedata[firstnode[i] - 1].coord[1] - nodedata[lastnode[i] - 1].coord[1]), 2) + pow((nodedata[firstnode[i] - 1].coord[2] - nodedata[lastnode[i] - 1].coord[2]), 2);
                 t_length = t_length + sqrt(length2);
             }
             
             parts_dist = t_length / (parts_fracture * numbf);
+            sgen.parts_dist = parts_dist;
             //parts_dist = t_length / parts_fracture;
 
             printf("\n");
@@ -145,6 +178,12 @@ int InitPos()
                  from the fracture edges that located inside the region */
                 initfile = Control_Data("in_partn:", 9 );
                 npart = initfile.flag;
+                
+                if (chunkpart > 0) {
+                    printf(" init_chunk is not supported by init_oneregion, all particles are seeded at once. \n");
+                    chunkpart = 0;
+                }
+                
                 /*  memory allocatation for particle structures */
                 particle = (struct contam*) malloc ((npart * 2) * sizeof(struct contam));
                 printf("Initializing particles into a single region \n");
@@ -206,13 +245,16 @@ int InitPos()
                     flag_in = 4;
                     initfile = Control_Data("in_randpart:", 12 );
                     npart = initfile.flag;
-                    /*  memory allocatation for particle structures */
-                    particle = (struct contam*) malloc ((npart + 1) * sizeof(struct contam));
                     printf("\n Initially particles will be distributed randomly over all fracture surfaces \n");
                     double random_number = 0, sum_aperture = 0.0;
                     unsigned int currentcell, k_curr = 0;
                     
-                    do {
+                    if (chunkpart == 0) {
+                        /*  memory allocatation for particle structures */
+                        particle = (struct contam*) malloc ((npart + 1) * sizeof(struct contam));
+                    }
+                    
+                    while ((chunkpart == 0) && (k_curr != npart)) {
                         random_number = drand48();
                         currentcell = random_number * ncells;
                         
@@ -229,11 +271,11 @@ int InitPos()
                             sum_aperture = sum_aperture + node[cell[currentcell - 1].node_ind[0] - 1].aperture;
                             k_curr++;
                         }
-                    } while(k_curr != npart);
+                    }
                     
                     k_new = k_curr;
                     
-                    for (i = 0; i < npart; i++) {
+                    for (i = 0; i < k_new; i++) {
                         particle[i].fl_weight = node[cell[particle[i].cell - 1].node_ind[0] - 1].aperture / sum_aperture;
                     }
                 } //end if flag_in=4
@@ -245,6 +287,11 @@ int InitPos()
                         res = strncmp(initfile.filename, "yes", 3);
                         
                         if (res == 0) {
+                            if (chunkpart > 0) {
+                                printf(" init_chunk is not supported by init_matrix, all particles are seeded at once. \n");
+                                chunkpart = 0;
+                            }
+                            
                             printf(" Initially particles are placed in rock matrix randomly. ");
                             printf(" The closest cells to initial particles positions ");
                             printf(" will be set as starting point in DFN. ");
@@ -272,8 +319,12 @@ int InitPos()
                                 printf("\n  Requested number of particles %d with flux weight %5.12e (Total Flux %5.12e) \n", npart, weight_p, totalFluxIn);
                                 int npart_alloc = 0;
                                 npart_alloc = npart * 3;
+                                sgen.weight_p = weight_p;
+                                
                                 /*  memory allocatation for particle structures */
-                                particle = (struct contam*) malloc (npart_alloc * sizeof(struct contam));
+                                if (chunkpart == 0) {
+                                    particle = (struct contam*) malloc (npart_alloc * sizeof(struct contam));
+                                }
                             }  // end if flag_in=6
                             else {
                                 initfile = Control_File("init_well:", 10);
@@ -287,9 +338,13 @@ int InitPos()
                                     initfile = Control_Data("init_nodepart:", 14 );
                                     nodepart = initfile.flag;
                                     npartalloc = (nzone_in + 1 ) * nodepart;
-                                    /*  memory allocatation for particle structures */
-                                    particle = (struct contam*) malloc (npartalloc * sizeof(struct contam));
-                                    k_new = InitInWell (nodepart);
+                                    sgen.nodepart = nodepart;
+                                    
+                                    if (chunkpart == 0) {
+                                        /*  memory allocatation for particle structures */
+                                        particle = (struct contam*) malloc (npartalloc * sizeof(struct contam));
+                                        k_new = InitInWell (nodepart);
+                                    }
                                 } // end if flag_in=7
                             }// end if/else flag_in=7
                         }//end if/else flag_in=6
@@ -302,7 +357,7 @@ int InitPos()
     /* loop on fractures and initial setting of particles */
     k_current = 0;
     
-    if ((flag_in <= 2) || (flag_in == 6)) {
+    if ((chunkpart == 0) && ((flag_in <= 2) || (flag_in == 6))) {
         for (i = 0; i < numberf; i++) {
             if (lastnode[i] != firstnode[i]) {
                 if (flag_in == 6) { //initial set according to in flow flux
@@ -332,13 +387,13 @@ int InitPos()
     int firstcoor = 0, secondcoor = 0, frc_count = 0;
     
     if (node[nodezonein[1] - 1].fracture[0] == frc) {
-        if (fabs(node[nodezonein[0] - 1].coord[0]) - fabs(node[nodezonein[1] - 1].coord[0]) < 1e-10) {
+        if (fabs(nodedata[nodezonein[0] - 1].coord[0]) - fabs(nodedata[nodezonein[1] - 1].coord[0]) < 1e-10) {
             firstcoor = 1;
             secondcoor = 2;
         } else {
             firstcoor = 0;
             
-            if (fabs(node[nodezonein[0] - 1].coord[1]) - fabs(node[nodezonein[1] - 1].coord[1]) < 1e-10) {
+            if (fabs(nodedata[nodezonein[0] - 1].coord[1]) - fabs(nodedata[nodezonein[1] - 1].coord[1]) < 1e-10) {
                 secondcoor = 2;
             } else {
                 secondcoor = 1;
@@ -353,25 +408,25 @@ int InitPos()
     for (i = 0; i < nzone_in - 1; i++) {
         //printf(" %d %d %d  %d %d %d\n", i,nodezonein[i], node[nodezonein[i]-1].fracture[0], node[nodezonein[i]-1].fracture[1], firstn, lastn);
         if (node[nodezonein[i] - 1].fracture[0] == frc) {
-            if (node[nodezonein[i] - 1].coord[firstcoor] != node[firstn - 1].coord[firstcoor]) {
-                if (node[nodezonein[i] - 1].coord[firstcoor] < node[firstn - 1].coord[firstcoor]) {
+            if (nodedata[nodezonein[i] - 1].coord[firstcoor] != nodedata[firstn - 1].coord[firstcoor]) {
+                if (nodedata[nodezonein[i] - 1].coord[firstcoor] < nodedata[firstn - 1].coord[firstcoor]) {
                     firstn = nodezonein[i];
                     first_ind = i;
                 }
                 
-                if (node[nodezonein[i] - 1].coord[firstcoor] > node[lastn - 1].coord[firstcoor]) {
+                if (nodedata[nodezonein[i] - 1].coord[firstcoor] > nodedata[lastn - 1].coord[firstcoor]) {
                     lastn = nodezonein[i];
                     last_ind = i;
                 }
                 
                 //	  fprintf(inp,"first coord, %d %d\n",firstn, lastn);
             } else {
-                if (node[nodezonein[i] - 1].coord[secondcoor] < node[firstn - 1].coord[secondcoor]) {
+                if (nodedata[nodezonein[i] - 1].coord[secondcoor] < nodedata[firstn - 1].coord[secondcoor]) {
                     firstn = nodezonein[i];
                     first_ind = i;
                 }
                 
-                if (node[nodezonein[i] - 1].coord[secondcoor] > node[lastn - 1].coord[secondcoor]) {
+                if (nodedata[nodezonein[i] - 1].coord[secondcoor] > nodedata[lastn - 1].coord[secondcoor]) {
                     lastn = nodezonein[i];
                     last_ind = i;
                 }
@@ -403,63 +458,63 @@ int InitPos()
                     inter_p[frc_count][3] = 1e-10;
                     
                     if ((zonenumb_in == 1) || (zonenumb_in == 2)) {
-                        cx1 = node[firstn - 1].coord[0];
-                        cy1 = node[firstn - 1].coord[1];
+                        cx1 = nodedata[firstn - 1].coord[0];
+                        cy1 = nodedata[firstn - 1].coord[1];
                         
                         if ((cx1 > ixmin) && (cx1 < ixmax) && (cy1 > iymin) && (cy1 < iymax)) {
                             inter_p[frc_count][0] = cx1;
                             inter_p[frc_count][1] = cy1;
                         }
                         
-                        cx2 = node[lastn - 1].coord[0];
-                        cy2 = node[lastn - 1].coord[1];
+                        cx2 = nodedata[lastn - 1].coord[0];
+                        cy2 = nodedata[lastn - 1].coord[1];
                         
                         if ((cx2 > ixmin) && (cx2 < ixmax) && (cy2 > iymin) && (cy2 < iymax)) {
                             inter_p[frc_count][0] = cx2;
                             inter_p[frc_count][1] = cy2;
                         }
                         
-                        thirdcoor = node[firstn - 1].coord[2];
+                        thirdcoor = nodedata[firstn - 1].coord[2];
                     }
                     
                     if ((zonenumb_in == 3) || (zonenumb_in == 5)) {
-                        cx1 = node[firstn - 1].coord[2];
-                        cy1 = node[firstn - 1].coord[1];
+                        cx1 = nodedata[firstn - 1].coord[2];
+                        cy1 = nodedata[firstn - 1].coord[1];
                         
                         if ((cx1 > izmin) && (cx1 < izmax) && (cy1 > iymin) && (cy1 < iymax)) {
                             inter_p[frc_count][0] = cx1;
                             inter_p[frc_count][1] = cy1;
                         }
                         
-                        cx2 = node[lastn - 1].coord[2];
-                        cy2 = node[lastn - 1].coord[1];
+                        cx2 = nodedata[lastn - 1].coord[2];
+                        cy2 = nodedata[lastn - 1].coord[1];
                         
                         if ((cx2 > izmin) && (cx2 < izmax) && (cy2 > iymin) && (cy2 < iymax)) {
                             inter_p[frc_count][0] = cx2;
                             inter_p[frc_count][1] = cy2;
                         }
                         
-                        thirdcoor = node[firstn - 1].coord[0];
+                        thirdcoor = nodedata[firstn - 1].coord[0];
                     }
                     
                     if ((zonenumb_in == 4) || (zonenumb_in == 6)) {
-                        cx1 = node[firstn - 1].coord[0];
-                        cy1 = node[firstn - 1].coord[2];
+                        cx1 = nodedata[firstn - 1].coord[0];
+                        cy1 = nodedata[firstn - 1].coord[2];
                         
                         if ((cx1 > ixmin) && (cx1 < ixmax) && (cy1 > izmin) && (cy1 < izmax)) {
                             inter_p[frc_count][0] = cx1;
                             inter_p[frc_count][1] = cy1;
                         }
                         
-                        cx2 = node[lastn - 1].coord[0];
-                        cy2 = node[lastn - 1].coord[2];
+                        cx2 = nodedata[lastn - 1].coord[0];
+                        cy2 = nodedata[lastn - 1].coord[2];
                         
                         if ((cx2 > ixmin) && (cx2 < ixmax) && (cy2 > izmin) && (cy2 < izmax)) {
                             inter_p[frc_count][0] = cx2;
                             inter_p[frc_count][1] = cy2;
                         }
                         
-                        thirdcoor = node[firstn - 1].coord[1];
+                        thirdcoor = nodedata[firstn - 1].coord[1];
                     }
                     
                     double pr1, pr2, pr3, pr4, p_x, p_y;
@@ -510,13 +565,13 @@ int InitPos()
                 
                 //		  fprintf(inp,"p %d %d %d %d\n", i, frc, firstn, lastn);
                 if (node[nodezonein[i + 1] - 1].fracture[0] == frc) {
-                    if (abs(node[nodezonein[i] - 1].coord[0]) - abs(node[nodezonein[i + 1] - 1].coord[0]) < 1e-10) {
+                    if (abs(nodedata[nodezonein[i] - 1].coord[0]) - abs(nodedata[nodezonein[i + 1] - 1].coord[0]) < 1e-10) {
                         firstcoor = 1;
                         secondcoor = 2;
                     } else {
                         firstcoor = 0;
                         
-                        if (abs(node[nodezonein[i] - 1].coord[1]) - abs(node[nodezonein[i + 1] - 1].coord[1]) < 1e-10) {
+                        if (abs(nodedata[nodezonein[i] - 1].coord[1]) - abs(nodedata[nodezonein[i + 1] - 1].coord[1]) < 1e-10) {
                             secondcoor = 2;
                         } else {
                             secondcoor = 1;
@@ -560,6 +615,10 @@ int InitPos()
         exit(1);
     }
     
+    if (chunkpart > 0) {
+        k_new = InitSeeding(flag_in, numberf, firstind, lastind, firstnode, lastnode);
+    }
+    
     return k_new;
 }
 
@@ -567,9 +626,15 @@ int InitPos()
 /////////////////////////////////////////////////////////////////////////////
 
 int InitCell ()
-/*! Function performs a search to find cell Id where the particle was initially placed.*/
+/*! Function performs a search to find cell Id where the particle was initially placed.
+ First, the cell is searched in the grid of particle's fracture; if not found, cells around in-flow nodes are checked.*/
 {
     int i, j, k, curcel, insc = 0;
+    insc = LocateCell();
+    
+    if (insc == 1) {
+        return insc;
+    }
     
     for (i = 0; i < nzone_in; i++) {
         for (j = 0; j < node[nodezonein[i] - 1].numneighb; j++) {
@@ -605,35 +670,12 @@ int InitCell ()
 int InitParticles_np (int k_current, int firstnd, int lastnd, int parts_fracture, int first_ind, int last_ind)
 /*! Function defines particle's initial positions on a single fracture edge. Option #1, init_nf */
 {
-    double deltax, deltay;
-    int j, pf;
-    pf = parts_fracture;
-    int ii, jj,  k, curcel, insc = 0;
-    deltax = fabs(node[nodezonein[last_ind] - 1].coord_xy[0] - node[nodezonein[first_ind] - 1].coord_xy[0]);
-    deltay = fabs(node[nodezonein[last_ind] - 1].coord_xy[1] - node[nodezonein[first_ind] - 1].coord_xy[1]);
+    int j;
     
-//   printf ("%d  %d %d %d %f %f\n", first_ind, last_ind,  firstnd, lastnd, deltax, deltay);
+//   printf ("%d  %d %d %d\n", first_ind, last_ind,  firstnd, lastnd);
 
-    for (j = 0; j < pf; j++) {
-        if (node[firstnd - 1].coord_xy[0] < node[lastnd - 1].coord_xy[0]) {
-            particle[k_current].position[0] = node[firstnd - 1].coord_xy[0] + (deltax / pf) * (j) + deltax / (2.0 * pf);
-        } else {
-            particle[k_current].position[0] = node[firstnd - 1].coord_xy[0] - (deltax / pf) * (j) - deltax / (2.0 * pf);
-        }
-        
-        if (node[firstnd - 1].coord_xy[1] < node[lastnd - 1].coord_xy[1]) {
-            particle[k_current].position[1] = node[firstnd - 1].coord_xy[1] + (deltay / pf) * (j) + deltay / (2.0 * pf);
-        } else {
-            particle[k_current].position[1] = node[firstnd - 1].coord_xy[1] - (deltay / pf) * (j) - deltay / (2.0 * pf);
-        }
-        
-        particle[k_current].velocity[0] = 0.;
-        particle[k_current].velocity[1] = 0.;
-        particle[k_current].fracture = node[firstnd - 1].fracture[0];
-        particle[k_current].intcell = 0;
-        particle[k_current].time = 0.0;
-        particle[k_current].fl_weight = 0.0;
-        particle[k_current].pressure = 0.0;
+    for (j = 0; j < parts_fracture; j++) {
+        PlaceParticle_np (k_current, firstnd, lastnd, parts_fracture, j, first_ind, last_ind);
         k_current++;
         
         if (k_current > npart) {
@@ -647,39 +689,48 @@ int InitParticles_np (int k_current, int firstnd, int lastnd, int parts_fracture
 }
 ////////////////////////////////////////////////////////////////////////////
 
+void PlaceParticle_np (int k, int firstnd, int lastnd, int pf, int j, int first_ind, int last_ind)
+/*! Function places particle k at j-th position of pf equidistant positions on a single fracture edge. Option #1, init_nf */
+{
+    double deltax, deltay;
+    deltax = fabs(node[nodezonein[last_ind] - 1].coord_xy[0] - node[nodezonein[first_ind] - 1].coord_xy[0]);
+    deltay = fabs(node[nodezonein[last_ind] - 1].coord_xy[1] - node[nodezonein[first_ind] - 1].coord_xy[1]);
+    
+    if (node[firstnd - 1].coord_xy[0] < node[lastnd - 1].coord_xy[0]) {
+        particle[k].position[0] = node[firstnd - 1].coord_xy[0] + (deltax / pf) * (j) + deltax / (2.0 * pf);
+    } else {
+        particle[k].position[0] = node[firstnd - 1].coord_xy[0] - (deltax / pf) * (j) - deltax / (2.0 * pf);
+    }
+    
+    if (node[firstnd - 1].coord_xy[1] < node[lastnd - 1].coord_xy[1]) {
+        particle[k].position[1] = node[firstnd - 1].coord_xy[1] + (deltay / pf) * (j) + deltay / (2.0 * pf);
+    } else {
+        particle[k].position[1] = node[firstnd - 1].coord_xy[1] - (deltay / pf) * (j) - deltay / (2.0 * pf);
+    }
+    
+    particle[k].velocity[0] = 0.;
+    particle[k].velocity[1] = 0.;
+    particle[k].fracture = node[firstnd - 1].fracture[0];
+    particle[k].cell = 0;
+    particle[k].intcell = 0;
+    particle[k].time = 0.0;
+    particle[k].fl_weight = 0.0;
+    particle[k].pressure = 0.0;
+    return;
+}
+////////////////////////////////////////////////////////////////////////////
+
 int InitParticles_eq (int k_current, int firstn, int lastn, double parts_dist, int first_ind, int last_ind)
 /*! Function defines particles initial positions at a single fracture edge, using calculated before distance between particles. Option #2, init_eqd. */
 {
-    double deltax, deltay, edgelength, eqdist_x, eqdist_y, pf_double;
+    double eqdist[2];
     unsigned int j, pf;
-    deltax = (node[lastn - 1].coord_xy[0] - node[firstn - 1].coord_xy[0]);
-    deltay = (node[lastn - 1].coord_xy[1] - node[firstn - 1].coord_xy[1]);
-    edgelength = sqrt(deltax * deltax + deltay * deltay);
-
-    pf_double = (edgelength / parts_dist); 
-    pf = (int) (edgelength / parts_dist);
-
-    if (pf < 2) {
-        pf = 1;
-        eqdist_x = deltax / 2.0;
-        eqdist_y = deltay / 2.0;
-    } else {
-        eqdist_x = deltax / pf_double;
-        eqdist_y = deltay / pf_double;
-    }
+    pf = EdgeParticles_eq (firstn, lastn, parts_dist, eqdist);
     
-    // printf("eqdist_x: %f eqdist_y: %f deltax: %f delta: %f\n", eqdist_x, eqdist_y, deltax, deltay);
+    // printf("eqdist_x: %f eqdist_y: %f\n", eqdist[0], eqdist[1]);
     
     for (j = 0; j < pf; j++) {
-        particle[k_current].position[0] = node[firstn - 1].coord_xy[0] + eqdist_x * (j) + eqdist_x / 2.0;
-        particle[k_current].position[1] = node[firstn - 1].coord_xy[1] + eqdist_y * (j) + eqdist_y / 2.0;
-        particle[k_current].velocity[0] = 0.;
-        particle[k_current].velocity[1] = 0.;
-        particle[k_current].fracture = node[firstn - 1].fracture[0];
-        particle[k_current].intcell = 0;
-        particle[k_current].time = 0.0;
-        particle[k_current].fl_weight = 0.0;
-        particle[k_current].pressure = 0.0;
+        PlaceParticle_eq (k_current, firstn, j, eqdist);
         //  if (particle[k_current].fracture == 13) {
         //       printf("os %lf %lf \n", particle[k_current].position[0], particle[k_current].position[1]);
         k_current++;
@@ -694,11 +745,53 @@ int InitParticles_eq (int k_current, int firstn, int lastn, double parts_dist, i
 }
 ////////////////////////////////////////////////////////////////////////////
 
+unsigned int EdgeParticles_eq (int firstn, int lastn, double parts_dist, double eqdist[2])
+/*! Function returns the number of particles placed on a single fracture edge in option #2, init_eqd, and the x and y distances between them. */
+{
+    double deltax, deltay, edgelength, pf_double;
+    unsigned int pf;
+    deltax = (node[lastn - 1].coord_xy[0] - node[firstn - 1].coord_xy[0]);
+    deltay = (node[lastn - 1].coord_xy[1] - node[firstn - 1].coord_xy[1]);
+    edgelength = sqrt(deltax * deltax + deltay * deltay);
+
+    pf_double = (edgelength / parts_dist); 
+    pf = (int) (edgelength / parts_dist);
+
+    if (pf < 2) {
+        pf = 1;
+        eqdist[0] = deltax / 2.0;
+        eqdist[1] = deltay / 2.0;
+    } else {
+        eqdist[0] = deltax / pf_double;
+        eqdist[1] = deltay / pf_double;
+    }
+    
+    return pf;
+}
+////////////////////////////////////////////////////////////////////////////
+
+void PlaceParticle_eq (int k, int firstn, int j, double eqdist[2])
+/*! Function places particle k at j-th position on a single fracture edge. Option #2, init_eqd. */
+{
+    particle[k].position[0] = node[firstn - 1].coord_xy[0] + eqdist[0] * (j) + eqdist[0] / 2.0;
+    particle[k].position[1] = node[firstn - 1].coord_xy[1] + eqdist[1] * (j) + eqdist[1] / 2.0;
+    particle[k].velocity[0] = 0.;
+    particle[k].velocity[1] = 0.;
+    particle[k].fracture = node[firstn - 1].fracture[0];
+    particle[k].cell = 0;
+    particle[k].intcell = 0;
+    particle[k].time = 0.0;
+    particle[k].fl_weight = 0.0;
+    particle[k].pressure = 0.0;
+    return;
+}
+////////////////////////////////////////////////////////////////////////////
+
 int InitParticles_ones (int k_current, double inter_p[][4], int fracture_n, int parts_fracture, int ii, double thirdcoor, int zonenumb_in, int first_ind, int last_ind)
 /*! Function defines particles initial positions in option #3, where user defines region at in-flow boundary face for particles. */
 {
     int j = fracture_n - 1;
-    double x_1 = 0, y_1 = 0, z_1 = 0, x_2 = 0, z_2 = 0, y_2 = 0;
+    double x_1 = 0, y_1 = 0, x_2 = 0, y_2 = 0;
     double x1cor = 0.0, y1cor = 0.0, z1cor = 0, x2cor = 0.0, y2cor = 0.0, z2cor = 0;
     
     if ((zonenumb_in == 1) || (zonenumb_in == 2)) {
@@ -728,22 +821,19 @@ int InitParticles_ones (int k_current, double inter_p[][4], int fracture_n, int
         z2cor = inter_p[ii][3];
     }
     
-    if (fracture[j].theta != 0.0) {
-        x_1 = fracture[j].rot2mat[0][0] * x1cor + fracture[j].rot2mat[0][1] * y1cor + fracture[j].rot2mat[0][2] * z1cor;
-        y_1 = fracture[j].rot2mat[1][0] * x1cor + fracture[j].rot2mat[1][1] * y1cor + fracture[j].rot2mat[1][2] * z1cor;
-        z_1 = fracture[j].rot2mat[2][0] * x1cor + fracture[j].rot2mat[2][1] * y1cor + fracture[j].rot2mat[2][2] * z1cor;
-        x_2 = fracture[j].rot2mat[0][0] * x2cor + fracture[j].rot2mat[0][1] * y2cor + fracture[j].rot2mat[0][2] * z2cor;
-        y_2 = fracture[j].rot2mat[1][0] * x2cor + fracture[j].rot2mat[1][1] * y2cor + fracture[j].rot2mat[1][2] * z2cor;
-        z_2 = fracture[j].rot2mat[2][0] * x2cor + fracture[j].rot2mat[2][1] * y2cor + fracture[j].rot2mat[2][2] * z2cor;
-    } else {
-        /* if angle =0 and fracture is parallel to xy plane, we use the same x and y coordinates */
-        x_1 = x1cor;
-        y_1 = y1cor;
-        z_1 = z1cor;
-        x_2 = x2cor;
-        y_2 = y2cor;
-        z_2 = z2cor;
-    }
+    double p3d[3], p2d[3];
+    p3d[0] = x1cor;
+    p3d[1] = y1cor;
+    p3d[2] = z1cor;
+    PointTo2d(j, p3d, p2d);
+    x_1 = p2d[0];
+    y_1 = p2d[1];
+    p3d[0] = x2cor;
+    p3d[1] = y2cor;
+    p3d[2] = z2cor;
+    PointTo2d(j, p3d, p2d);
+    x_2 = p2d[0];
+    y_2 = p2d[1];
     
     double deltax, deltay;
     unsigned int  pf;
@@ -775,87 +865,95 @@ int InitParticles_ones (int k_current, double inter_p[][4], int fracture_n, int
 ////////////////////////////////////////////////////////////////////////////
 void FlowInWeight(int numberpart)
 /*! Function calculates particle's in-flow flux weight. Used in option #1, #2, #3. */
+{
+    double particleflux[numberpart], totalflux = 0;
+    
+    for (np = 0; np < numberpart; np++) {
+        particleflux[np] = ParticleInFlux();
+        totalflux = totalflux + particleflux[np];
+    }
+    
+    for (np = 0; np < numberpart; np++) {
+        particle[np].fl_weight = particleflux[np] / totalflux;
+        // printf("%d   %5.12e %5.12e  %5.12e  \n", np+1,particleflux[np], totalflux, particle[np].fl_weight);
+    }
+    
+    return;
+}
+////////////////////////////////////////////////////////////////////////////
+double ParticleInFlux()
+/*! Function finds the initial cell of particle np and returns the in-flow flux of the boundary nodes of this cell, interpolated to particle's position. */
 {
     int ind1 = 0, ind2 = 0, ver1 = 0, ver2 = 0, ver3 = 0, incell = 0, n1in = 0, n2in = 0, jj;
     int ins;
-    double sumflux1 = 0, sumflux2 = 0, particleflux[numberpart], totalflux = 0;
+    double sumflux1 = 0, sumflux2 = 0, particleflux = 0.0;
+    ins = 0;
+    ins = InitCell();
+    incell = particle[np].cell;
     
-    for (np = 0; np < numberpart; np++) {
-        ins = 0;
-        ins = InitCell();
+    if (incell != 0) {
         incell = particle[np].cell;
+        ver1 = cell[incell - 1].node_ind[0];
+        ver2 = cell[incell - 1].node_ind[1];
+        ver3 = cell[incell - 1].node_ind[2];
+        n1in = 0;
+        n2in = 0;
         
-        if (incell != 0) {
-            incell = particle[np].cell;
-            ver1 = cell[incell - 1].node_ind[0];
-            ver2 = cell[incell - 1].node_ind[1];
-            ver3 = cell[incell - 1].node_ind[2];
-            n1in = 0;
-            n2in = 0;
-            
-            if (node[ver1 - 1].typeN >= 300) {
-                n1in = ver1;
-                ind1 = 0;
+        if (node[ver1 - 1].typeN >= 300) {
+            n1in = ver1;
+            ind1 = 0;
+        }
+        
+        if (node[ver2 - 1].typeN >= 300) {
+            if (n1in == 0) {
+                n1in = ver2;
+                ind1 = 1;
+            } else {
+                n2in = ver2;
+                ind2 = 1;
             }
+        }
+        
+        if (node[ver3 - 1].typeN >= 300) {
+            if (n1in == 0) {
+                n1in = ver3;
+                ind1 = 2;
+            } else {
+                n2in = ver3;
+                ind2 = 2;
+            }
+        }
+        
+        if ((n1in != 0) && (n2in != 0)) {
+            sumflux1 = 0;
+            sumflux2 = 0;
             
-            if (node[ver2 - 1].typeN >= 300) {
-                if (n1in == 0) {
-                    n1in = ver2;
-                    ind1 = 1;
-                } else {
-                    n2in = ver2;
-                    ind2 = 1;
-                }
+            for (jj = 0; jj < node[n1in - 1].numneighb; jj++) {
+                sumflux1 = sumflux1 + fabs(nodedata[n1in - 1].flux[jj]);
             }
             
-            if (node[ver3 - 1].typeN >= 300) {
-                if (n1in == 0) {
-                    n1in = ver3;
-                    ind1 = 2;
-                } else {
-                    n2in = ver3;
-                    ind2 = 2;
-                }
+            for (jj = 0; jj < node[n2in - 1].numneighb; jj++) {
+                sumflux2 = sumflux2 + fabs(nodedata[n2in - 1].flux[jj]);
             }
             
-            if ((n1in != 0) && (n2in != 0)) {
+            particleflux = particle[np].weight[ind1] * sumflux1 + particle[np].weight[ind2] * sumflux2;
+        } else {
+            int ncent = 0;
+            ncent = n1in + n2in;
+            
+            if (ncent != 0) {
                 sumflux1 = 0;
-                sumflux2 = 0;
                 
-                for (jj = 0; jj < node[n1in - 1].numneighb; jj++) {
-                    sumflux1 = sumflux1 + fabs(node[n1in - 1].flux[jj]);
+                for (jj = 0; jj < node[ncent - 1].numneighb; jj++) {
+                    sumflux1 = sumflux1 + fabs(nodedata[ncent - 1].flux[jj]);
                 }
                 
-                for (jj = 0; jj < node[n2in - 1].numneighb; jj++) {
-                    sumflux2 = sumflux2 + fabs(node[n2in - 1].flux[jj]);
-                }
-                
-                particleflux[np] = particle[np].weight[ind1] * sumflux1 + particle[np].weight[ind2] * sumflux2;
-                totalflux = totalflux + particleflux[np];
-            } else {
-                int ncent = 0;
-                ncent = n1in + n2in;
-                
-                if (ncent != 0) {
-                    sumflux1 = 0;
-                    
-                    for (jj = 0; jj < node[ncent - 1].numneighb; jj++) {
-                        sumflux1 = sumflux1 + fabs(node[ncent - 1].flux[jj]);
-                    }
-                    
-                    particleflux[np] = sumflux1;
-                    totalflux = totalflux + particleflux[np];
-                }
+                particleflux = sumflux1;
             }
         }
     }
     
-    for (np = 0; np < numberpart; np++) {
-        particle[np].fl_weight = particleflux[np] / totalflux;
-        // printf("%d   %5.12e %5.12e  %5.12e  \n", np+1,particleflux[np], totalflux, particle[np].fl_weight);
-    }
-    
-    return;
+    return particleflux;
 }
 //////////////////////////////////////////////////////////////////////////
 void InitInMatrix()
@@ -903,9 +1001,9 @@ void InitInMatrix()
             printf ("error");
         }
         
-        xp2 = (node[number - 1].coord[0] - xp) * (node[number - 1].coord[0] - xp);
-        yp2 = (node[number - 1].coord[1] - yp) * (node[number - 1].coord[1] - yp);
-        zp2 = (node[number - 1].coord[2] - zp) * (node[number - 1].coord[2] - zp);
+        xp2 = (nodedata[number - 1].coord[0] - xp) * (nodedata[number - 1].coord[0] - xp);
+        yp2 = (nodedata[number - 1].coord[1] - yp) * (nodedata[number - 1].coord[1] - yp);
+        zp2 = (nodedata[number - 1].coord[2] - zp) * (nodedata[number - 1].coord[2] - zp);
         distance[ii] = sqrt(xp2 + yp2 + zp2);
         particle[ii].velocity[0] = 0.;
         particle[ii].velocity[1] = 0.;
@@ -969,78 +1067,15 @@ int InitParticles_flux (int k_current, int first_ind, int last_ind, double weigh
 /*! Function defines particle's initial positions at single fracture edge in Option #6. Particles are placed according to input flux weights. In this case, all the particles have  the same flux weight, but number of particles per fracture edge depends on in-flow flux of this fracture. */
 
 {
-    double deltax, deltay, edgelength, eqdist_x, eqdist_y, sumflux = 0, startpos_x, startpos_y, sumdelta = 0.0;
-    double sumfluxfract = 0.0;
-    unsigned int i, k, j, jj, pf, curcel = 0, insc = 0, np, np_init;
-    struct posit3d particle3dposition;
-    np_init = k_current;
-    deltax = (node[nodezonein[last_ind] - 1].coord_xy[0] - node[nodezonein[first_ind] - 1].coord_xy[0]);
-    deltay = (node[nodezonein[last_ind] - 1].coord_xy[1] - node[nodezonein[first_ind] - 1].coord_xy[1]);
-    
-//      printf("firstn %d lastn %d %f %f \n", first_ind, last_ind, deltax, deltay);
+    double eqdist[2], startpos[2];
+    unsigned int j, jj, pf;
+    
+//      printf("firstn %d lastn %d \n", first_ind, last_ind);
     for (j = first_ind; j <= last_ind; j++) {
-        sumflux = 0.0;
-        
-        // calculate the flux of the current cell
-        for (jj = 0; jj < node[nodezonein[j] - 1].numneighb; jj++) {
-            sumflux = sumflux + (node[nodezonein[j] - 1].flux[jj]);
-        }
-        
-        sumflux = sumflux / density;
-        sumfluxfract = sumfluxfract + sumflux;
-        // ceiling number of particles in cell nodezonein[j]
-        pf = ceilf(fabs(sumflux) / weight_p);
-        
-        //     printf("%5.12e  %d  %5.12e  %5.12e\n", sumflux, pf, fabs(sumflux)/weight_p, density);
-        
-        if ((j > first_ind) && (j < last_ind)) {
-            //calculate distance between nodes
-            deltax = (node[nodezonein[j + 1] - 1].coord_xy[0] - node[nodezonein[j - 1] - 1].coord_xy[0]) / 2.0;
-            deltay = (node[nodezonein[j + 1] - 1].coord_xy[1] - node[nodezonein[j - 1] - 1].coord_xy[1]) / 2.0;
-            //define starting position of first particle
-            startpos_x = ((node[nodezonein[j] - 1].coord_xy[0]) - (node[nodezonein[j - 1] - 1].coord_xy[0])) / 2.0 + node[nodezonein[j - 1] - 1].coord_xy[0];
-            startpos_y = ((node[nodezonein[j] - 1].coord_xy[1]) - (node[nodezonein[j - 1] - 1].coord_xy[1])) / 2.0 + node[nodezonein[j - 1] - 1].coord_xy[1];
-        }
-        
-        if (j == first_ind) {
-            //calculate distance between nodes
-            deltax = (node[nodezonein[j + 1] - 1].coord_xy[0] - node[nodezonein[j] - 1].coord_xy[0]) / 2.0;
-            deltay = (node[nodezonein[j + 1] - 1].coord_xy[1] - node[nodezonein[j] - 1].coord_xy[1]) / 2.0;
-            //define starting position of first particle
-            startpos_x = node[nodezonein[j] - 1].coord_xy[0];
-            startpos_y = node[nodezonein[j] - 1].coord_xy[1];
-        }
-        
-        if (j == last_ind) {
-            //calculate distance between nodes
-            deltax = (node[nodezonein[j] - 1].coord_xy[0] - node[nodezonein[j - 1] - 1].coord_xy[0]) / 2.0;
-            deltay = (node[nodezonein[j] - 1].coord_xy[1] - node[nodezonein[j - 1] - 1].coord_xy[1]) / 2.0;
-            //define starting position of first particle
-            startpos_x = node[nodezonein[j - 1] - 1].coord_xy[0];
-            startpos_y = node[nodezonein[j - 1] - 1].coord_xy[1];
-        }
-        
-        if (pf < 2) {
-            pf = 1;
-            eqdist_x = deltax / 2.0;
-            eqdist_y = deltay / 2.0;
-        } else {
-            eqdist_x = deltax / pf;
-            eqdist_y = deltay / pf;
-        }
+        pf = NodeParticles_flux (j, first_ind, last_ind, weight_p, startpos, eqdist);
         
         for (jj = 0; jj < pf; jj++) {
-            particle[k_current].position[0] = startpos_x + eqdist_x * (jj);
-            particle[k_current].position[1] = startpos_y + eqdist_y * (jj);
-            particle[k_current].velocity[0] = 0.;
-            particle[k_current].velocity[1] = 0.;
-            particle[k_current].fracture = node[nodezonein[first_ind] - 1].fracture[0];
-            particle[k_current].intcell = 0;
-            particle[k_current].time = 0.0;
-            particle[k_current].fl_weight = weight_p;
-            particle[k_current].cell = 0;
-            particle[k_current].pressure = 0.0;
-            np = k_current;
+            PlaceParticle_flux (k_current, first_ind, jj, startpos, eqdist, weight_p);
             k_current++;
             
             if (k_current > npart * 3) {
@@ -1054,6 +1089,81 @@ int InitParticles_flux (int k_current, int first_ind, int last_ind, double weigh
     return k_current;
 }
 ////////////////////////////////////////////////////////////////////////////
+
+unsigned int NodeParticles_flux (unsigned int j, int first_ind, int last_ind, double weight_p, double startpos[2], double eqdist[2])
+/*! Function returns the number of particles placed around in-flow node nodezonein[j] in Option #6, init_fluxw, the position of the first particle and the x and y distances between particles. The number of particles is proportional to the in-flow flux of the node. */
+{
+    double deltax = 0.0, deltay = 0.0, sumflux = 0;
+    unsigned int jj, pf;
+    sumflux = 0.0;
+    
+    // calculate the flux of the current cell
+    for (jj = 0; jj < node[nodezonein[j] - 1].numneighb; jj++) {
+        sumflux = sumflux + (nodedata[nodezonein[j] - 1].flux[jj]);
+    }
+    
+    sumflux = sumflux / density;
+    // ceiling number of particles in cell nodezonein[j]
+    pf = ceilf(fabs(sumflux) / weight_p);
+    
+    //     printf("%5.12e  %d  %5.12e  %5.12e\n", sumflux, pf, fabs(sumflux)/weight_p, density);
+    
+    if ((j > first_ind) && (j < last_ind)) {
+        //calculate distance between nodes
+        deltax = (node[nodezonein[j + 1] - 1].coord_xy[0] - node[nodezonein[j - 1] - 1].coord_xy[0]) / 2.0;
+        deltay = (node[nodezonein[j + 1] - 1].coord_xy[1] - node[nodezonein[j - 1] - 1].coord_xy[1]) / 2.0;
+        //define starting position of first particle
+        startpos[0] = ((node[nodezonein[j] - 1].coord_xy[0]) - (node[nodezonein[j - 1] - 1].coord_xy[0])) / 2.0 + node[nodezonein[j - 1] - 1].coord_xy[0];
+        startpos[1] = ((node[nodezonein[j] - 1].coord_xy[1]) - (node[nodezonein[j - 1] - 1].coord_xy[1])) / 2.0 + node[nodezonein[j - 1] - 1].coord_xy[1];
+    }
+    
+    if (j == first_ind) {
+        //calculate distance between nodes
+        deltax = (node[nodezonein[j + 1] - 1].coord_xy[0] - node[nodezonein[j] - 1].coord_xy[0]) / 2.0;
+        deltay = (node[nodezonein[j + 1] - 1].coord_xy[1] - node[nodezonein[j] - 1].coord_xy[1]) / 2.0;
+        //define starting position of first particle
+        startpos[0] = node[nodezonein[j] - 1].coord_xy[0];
+        startpos[1] = node[nodezonein[j] - 1].coord_xy[1];
+    }
+    
+    if (j == last_ind) {
+        //calculate distance between nodes
+        deltax = (node[nodezonein[j] - 1].coord_xy[0] - node[nodezonein[j - 1] - 1].coord_xy[0]) / 2.0;
+        deltay = (node[nodezonein[j] - 1].coord_xy[1] - node[nodezonein[j - 1] - 1].coord_xy[1]) / 2.0;
+        //define starting position of first particle
+        startpos[0] = node[nodezonein[j - 1] - 1].coord_xy[0];
+        startpos[1] = node[nodezonein[j - 1] - 1].coord_xy[1];
+    }
+    
+    if (pf < 2) {
+        pf = 1;
+        eqdist[0] = deltax / 2.0;
+        eqdist[1] = deltay / 2.0;
+    } else {
+        eqdist[0] = deltax / pf;
+        eqdist[1] = deltay / pf;
+    }
+    
+    return pf;
+}
+////////////////////////////////////////////////////////////////////////////
+
+void PlaceParticle_flux (int k, int first_ind, int jj, double startpos[2], double eqdist[2], double weight_p)
+/*! Function places particle k at jj-th position around in-flow node. Option #6, init_fluxw. */
+{
+    particle[k].position[0] = startpos[0] + eqdist[0] * (jj);
+    particle[k].position[1] = startpos[1] + eqdist[1] * (jj);
+    particle[k].velocity[0] = 0.;
+    particle[k].velocity[1] = 0.;
+    particle[k].fracture = node[nodezonein[first_ind] - 1].fracture[0];
+    particle[k].intcell = 0;
+    particle[k].time = 0.0;
+    particle[k].fl_weight = weight_p;
+    particle[k].cell = 0;
+    particle[k].pressure = 0.0;
+    return;
+}
+////////////////////////////////////////////////////////////////////////////
 int InitInWell(int node_part) {
 // Function defines initial parameters for the particles in Option #7, where certain number of particles are seeded at nodes in in-flow zone.
     int i = 0, j = 0, k_current = 0;
@@ -1082,3 +1192,289 @@ int InitInWell(int node_part) {
     return k_current;
 }
 ////////////////////////////////////////////////////////////////////////////////
+int InitSeeding(int flag_in, unsigned int numberf, unsigned int firstind[], unsigned int lastind[], unsigned int firstnode[], unsigned int lastnode[])
+/*! Function prepares seeding of particles in chunks (option init_chunk): the in-flow boundary edges and the parameters of seeding option are kept, so that the particles positions are defined lazily by NextParticles, one chunk at a time, and only a chunk of particles is kept in memory. Returns the total number of particles. */
+{
+    unsigned int i, j, ntotal = 0;
+    double eqdist[2], startpos[2];
+    
+    if ((flag_in == 3) || (flag_in == 5)) {
+        chunkpart = 0;
+        return 0;
+    }
+    
+    sgen.flag_in = flag_in;
+    sgen.numberf = numberf;
+    sgen.firstind = (unsigned int*) malloc (numberf * sizeof(unsigned int));
+    sgen.lastind = (unsigned int*) malloc (numberf * sizeof(unsigned int));
+    sgen.firstnode = (unsigned int*) malloc (numberf * sizeof(unsigned int));
+    sgen.lastnode = (unsigned int*) malloc (numberf * sizeof(unsigned int));
+    
+    for (i = 0; i < numberf; i++) {
+        sgen.firstind[i] = firstind[i];
+        sgen.lastind[i] = lastind[i];
+        sgen.firstnode[i] = firstnode[i];
+        sgen.lastnode[i] = lastnode[i];
+    }
+    
+    /* total number of particles is calculated with the same rules that are used to place particles */
+    for (i = 0; i < numberf; i++) {
+        if (lastnode[i] != firstnode[i]) {
+            if (flag_in == 1) {
+                ntotal = ntotal + sgen.parts_fracture;
+            }
+            
+            if (flag_in == 2) {
+                ntotal = ntotal + EdgeParticles_eq (firstnode[i], lastnode[i], sgen.parts_dist, eqdist);
+            }
+            
+            if (flag_in == 6) {
+                for (j = firstind[i]; j <= lastind[i]; j++) {
+                    ntotal = ntotal + NodeParticles_flux (j, firstind[i], lastind[i], sgen.weight_p, startpos, eqdist);
+                }
+            }
+        }
+    }
+    
+    if (flag_in == 4) {
+        /* the private random sequence starts from the current state of drand48, so the particles
+         are placed at the same cells as without init_chunk. Particles are weighted by cell aperture, the
+         sum of apertures is calculated in advance by drawing the whole sequence of cells once */
+        unsigned short xsubi[3] = {0, 0, 0}, *current;
+        sgen.sum_aperture = 0.0;
+        current = seed48(xsubi);
+        memcpy(sgen.xsubi0, current, sizeof(sgen.xsubi0));
+        memcpy(sgen.xsubi, current, sizeof(sgen.xsubi));
+        
+        for (i = 0; i < npart; i++) {
+            j = RandomSeedCell(sgen.xsubi);
+            sgen.sum_aperture = sgen.sum_aperture + node[cell[j - 1].node_ind[0] - 1].aperture;
+        }
+        
+        /* the global random generator continues after the seeding sequence */
+        seed48(sgen.xsubi);
+        ntotal = npart;
+    }
+    
+    if (flag_in == 7) {
+        float sum_aperture = 0.0;
+        
+        for (i = 0; i < nzone_in; i++) {
+            for (j = 0; j < sgen.nodepart; j++) {
+                sum_aperture = sum_aperture + node[nodezonein[i] - 1].aperture;
+            }
+        }
+        
+        sgen.sum_aperture = sum_aperture;
+        ntotal = nzone_in * sgen.nodepart;
+    }
+    
+    /*  memory allocatation for one chunk of particle structures */
+    particle = (struct contam*) malloc (chunkpart * sizeof(struct contam));
+    
+    if (particle == NULL) {
+        printf("Allocation memory problem - particle\n");
+        exit(1);
+    }
+    
+    printf("\n Particles are seeded in chunks of %d particles \n", chunkpart);
+    RewindSeeding();
+    return ntotal;
+}
+////////////////////////////////////////////////////////////////////////////
+void RewindSeeding()
+/*! Function restarts the seeding of particles in chunks from the first particle. */
+{
+    sgen.edge = 0;
+    sgen.ind = 0;
+    sgen.count = 0;
+    sgen.total = 0;
+    
+    if (sgen.numberf > 0) {
+        sgen.ind = sgen.firstind[0];
+    }
+    
+    memcpy(sgen.xsubi, sgen.xsubi0, sizeof(sgen.xsubi));
+    return;
+}
+////////////////////////////////////////////////////////////////////////////
+unsigned int NextParticles()
+/*! Function places next chunk of particles into particle array, continuing the sequence where the previous chunk stopped.
+ Returns number of particles in the chunk; 0 when all particles are seeded. */
+{
+    unsigned int k = 0;
+    
+    while ((k < chunkpart) && (SeedParticle(k) == 1)) {
+        k++;
+    }
+    
+    return k;
+}
+////////////////////////////////////////////////////////////////////////////
+int SeedParticle(unsigned int k)
+/*! Function places next particle of the seeding sequence into particle[k]. Returns 0 if there are no more particles to seed. */
+{
+    unsigned int e, pf = 0, currentcell;
+    double eqdist[2], startpos[2];
+    
+    /* init_nf: the same number of particles on every boundary fracture edge */
+    if (sgen.flag_in == 1) {
+        while ((sgen.edge < sgen.numberf) && ((sgen.lastnode[sgen.edge] == sgen.firstnode[sgen.edge]) || (sgen.count >= sgen.parts_fracture))) {
+            sgen.edge++;
+            sgen.count = 0;
+        }
+        
+        if (sgen.edge >= sgen.numberf) {
+            return 0;
+        }
+        
+        e = sgen.edge;
+        PlaceParticle_np (k, sgen.firstnode[e], sgen.lastnode[e], sgen.parts_fracture, sgen.count, sgen.firstind[e], sgen.lastind[e]);
+    }
+    
+    /* init_eqd: particles are equidistant over all boundary fracture edges */
+    if (sgen.flag_in == 2) {
+        while (sgen.edge < sgen.numberf) {
+            if (sgen.lastnode[sgen.edge] != sgen.firstnode[sgen.edge]) {
+                pf = EdgeParticles_eq (sgen.firstnode[sgen.edge], sgen.lastnode[sgen.edge], sgen.parts_dist, eqdist);
+                
+                if (sgen.count < pf) {
+                    break;
+                }
+            }
+            
+            sgen.edge++;
+            sgen.count = 0;
+        }
+        
+        if (sgen.edge >= sgen.numberf) {
+            return 0;
+        }
+        
+        PlaceParticle_eq (k, sgen.firstnode[sgen.edge], sgen.count, eqdist);
+    }
+    
+    /* init_fluxw: number of particles on every in-flow node is proportional to node's flux */
+    if (sgen.flag_in == 6) {
+        while (sgen.edge < sgen.numberf) {
+            e = sgen.edge;
+            
+            if (sgen.lastnode[e] != sgen.firstnode[e]) {
+                while (sgen.ind <= sgen.lastind[e]) {
+                    pf = NodeParticles_flux (sgen.ind, sgen.firstind[e], sgen.lastind[e], sgen.weight_p, startpos, eqdist);
+                    
+                    if (sgen.count < pf) {
+                        break;
+                    }
+                    
+                    sgen.ind++;
+                    sgen.count = 0;
+                }
+                
+                if (sgen.ind <= sgen.lastind[e]) {
+                    break;
+                }
+            }
+            
+            sgen.edge++;
+            sgen.count = 0;
+            
+            if (sgen.edge < sgen.numberf) {
+                sgen.ind = sgen.firstind[sgen.edge];
+            }
+        }
+        
+        if (sgen.edge >= sgen.numberf) {
+            return 0;
+        }
+        
+        PlaceParticle_flux (k, sgen.firstind[sgen.edge], sgen.count, startpos, eqdist, sgen.weight_p);
+    }
+    
+    /* init_random: particles are placed in the centers of random cells */
+    if (sgen.flag_in == 4) {
+        if (sgen.total >= npart) {
+            return 0;
+        }
+        
+        unsigned int npsave = np;
+        currentcell = RandomSeedCell(sgen.xsubi);
+        particle[k].velocity[0] = 0.;
+        particle[k].velocity[1] = 0.;
+        particle[k].fracture = cell[currentcell - 1].fracture;
+        particle[k].cell = currentcell;
+        particle[k].intcell = 0;
+        particle[k].time = 0.0;
+        particle[k].pressure = 0.0;
+        particle[k].fl_weight = node[cell[currentcell - 1].node_ind[0] - 1].aperture / sgen.sum_aperture;
+        np = k;
+        Moving2Center (k, currentcell);
+        np = npsave;
+    }
+    
+    /* init_well: particles are seeded at in-flow nodes */
+    if (sgen.flag_in == 7) {
+        while ((sgen.edge < nzone_in) && (sgen.count >= sgen.nodepart)) {
+            sgen.edge++;
+            sgen.count = 0;
+        }
+        
+        if (sgen.edge >= nzone_in) {
+            return 0;
+        }
+        
+        e = nodezonein[sgen.edge] - 1;
+        particle[k].position[0] = node[e].coord_xy[0];
+        particle[k].position[1] = node[e].coord_xy[1];
+        particle[k].velocity[0] = 0.;
+        particle[k].velocity[1] = 0.;
+        particle[k].fracture = node[e].fracture[0];
+        particle[k].cell = 0;
+        particle[k].time = 0.0;
+        particle[k].fl_weight = node[e].aperture / sgen.sum_aperture;
+        particle[k].pressure = 0.0;
+    }
+    
+    sgen.count++;
+    sgen.total++;
+    return 1;
+}
+////////////////////////////////////////////////////////////////////////////
+unsigned int RandomSeedCell(unsigned short xsubi[3])
+/*! Function draws random cells (init_random) with the generator state xsubi until the cell that is not in out-flow boundary is found. */
+{
+    unsigned int currentcell;
+    
+    do {
+        currentcell = erand48(xsubi) * ncells;
+    } while ((currentcell == 0) || (((node[cell[currentcell - 1].node_ind[0] - 1].typeN >= 200) && (node[cell[currentcell - 1].node_ind[0] - 1].typeN <= 250)) || ((node[cell[currentcell - 1].node_ind[1] - 1].typeN >= 200) && (node[cell[currentcell - 1].node_ind[1] - 1].typeN <= 250)) || ((node[cell[currentcell - 1].node_ind[2] - 1].typeN >= 200) && (node[cell[currentcell - 1].node_ind[2] - 1].typeN <= 250))));
+    
+    return currentcell;
+}
+////////////////////////////////////////////////////////////////////////////
+double SeedInFlux()
+/*! Function goes once through the whole sequence of seeded particles (in chunks) and returns the sum of their in-flow fluxes; used to normalize particles flux weights. */
+{
+    unsigned int k;
+    double totalflux = 0.0;
+    
+    while ((k = NextParticles()) > 0) {
+        for (np = 0; np < k; np++) {
+            totalflux = totalflux + ParticleInFlux();
+        }
+    }
+    
+    RewindSeeding();
+    return totalflux;
+}
+////////////////////////////////////////////////////////////////////////////
+void FreeSeeding()
+/*! Function frees memory used for seeding particles in chunks. */
+{
+    free(sgen.firstind);
+    free(sgen.lastind);
+    free(sgen.firstnode);
+    free(sgen.lastnode);
+    return;
+}
+////////////////////////////////////////////////////////////////////////////////
@@ -76,12 +76,18 @@ The memory is allocated for data structures: NODE, CELL, FRACTURE */
      the number of cells "ncells"
      the memory is allocated for data structures ************************/
     node = (struct vertex*) malloc (nnodes * sizeof(struct vertex));
+    nodedata = (struct vertexdata*) malloc (nnodes * sizeof(struct vertexdata));
+    
+    if ((node == NULL) || (nodedata == NULL)) {
+        printf("Allocation memory problem - node\n");
+        exit(1);
+    }
     
     for (i = 0; i < nnodes; i++) {
         node[i].indnodes = (unsigned int*) malloc(max_neighb * sizeof(unsigned int));
         node[i].type = (unsigned int*) malloc(max_neighb * sizeof(unsigned int));
-        node[i].flux = (double*) malloc(max_neighb * sizeof(double));
-        node[i].area = (double*) malloc(max_neighb * sizeof(double));
+        nodedata[i].flux = (double*) malloc(max_neighb * sizeof(double));
+        nodedata[i].area = (geom_t*) malloc(max_neighb * sizeof(geom_t));
         node[i].cells = (unsigned  int**) malloc (max_neighb * sizeof(unsigned int*));
         node[i].fracts = (unsigned  int**) malloc (max_neighb * sizeof(unsigned  int*));
         
@@ -91,10 +97,6 @@ The memory is allocated for data structures: NODE, CELL, FRACTURE */
         }
     }
     
-    if (node == NULL) {
-        printf("Allocation memory problem - node\n");
-    }
-    
     /********** allocate memory for cell structure *****************************/
     cell = (struct element*) malloc (ncells * sizeof(struct element));
     
@@ -184,7 +186,7 @@ void  ReadDataFiles ()
     /* read 3D coordinations: x in [0], y in [1], and z in [2] for every node i+1 */
     
     for (i = 0; i < nnodes; i++) {
-        if (fscanf(fp, "%d  %lf %lf %lf \n", &n1, &node[i].coord[0], &node[i].coord[1], &node[i].coord[2]) != 4) {
+        if (fscanf(fp, "%d  %lf %lf %lf \n", &n1, &nodedata[i].coord[0], &nodedata[i].coord[1], &nodedata[i].coord[2]) != 4) {
             printf("Error");
         }
     }
@@ -321,7 +323,7 @@ void  ReadDataFiles ()
      with one node (that is a center of polygon) *************************/
     
     for (i = 0; i < nnodes; i++) {
-        if (fscanf(fps, "%lf", &node[i].pvolume) != 1) {
+        if (fscanf(fps, "%lf", &nodedata[i].pvolume) != 1) {
             printf("Error");
         }
     }
@@ -388,15 +390,18 @@ void  ReadDataFiles ()
     }
     
     /**** reading area coefficients *************************/
+    double areavalue;
     
     for (i = 0; i < nnodes; i++) {
         node[i].aperture = 0.0;
         
         for (j = 0; j < max_neighb; j++) {
             if (j < node[i].numneighb) {
-                if (fscanf(fps, "%lf", &node[i].area[j]) != 1) {
+                if (fscanf(fps, "%lf", &areavalue) != 1) {
                     printf("Error");
                 }
+                
+                nodedata[i].area[j] = areavalue;
             }
         }
     }
@@ -450,12 +455,12 @@ void  ReadDataFiles ()
             if (node[i].indnodes[j] != i + 1) {
                 node[i].indnodes[l] = node[i].indnodes[j];
                 node[i].type[l] = node[node[i].indnodes[l] - 1].typeN;
-                node[i].flux[l] = node[i].flux[j];
+                nodedata[i].flux[l] = nodedata[i].flux[j];
                 
-                if (node[i].area[j] < 0) {
-                    node[i].area[l] = node[i].area[j] * (-1.0);
+                if (nodedata[i].area[j] < 0) {
+                    nodedata[i].area[l] = nodedata[i].area[j] * (-1.0);
                 } else {
-                    node[i].area[l] = node[i].area[j];
+                    nodedata[i].area[l] = nodedata[i].area[j];
                 }
                 
                 for (k = 0; k < 4; k++) {
@@ -637,7 +642,7 @@ void ReadBoundaryNodes()
     
     for (i = 0; i < nzone_in; i++) {
         for (j = 0; j < node[nodezonein[i] - 1].numneighb; j++) {
-            sum_in = sum_in + node[nodezonein[i] - 1].flux[j];
+            sum_in = sum_in + nodedata[nodezonein[i] - 1].flux[j];
         }
     }
     
@@ -651,7 +656,7 @@ void ReadBoundaryNodes()
     
     for (i = 0; i < nzone_out; i++) {
         for (j = 0; j < node[nodezoneout[i] - 1].numneighb; j++) {
-            sum_out = sum_out + node[nodezoneout[i] - 1].flux[j];
+            sum_out = sum_out + nodedata[nodezoneout[i] - 1].flux[j];
         }
     }
     
@@ -737,18 +742,18 @@ void ReadPFLOTRANfile(int nedges)
         for (j = 0; j < node[n1 - 1].numneighb; j++) {
             if (node[n1 - 1].indnodes[j] == n2) {
                 if (flag != 0) {
-                    node[n1 - 1].area[j] = l_area;
+                    nodedata[n1 - 1].area[j] = l_area;
                 }
                 
-                node[n1 - 1].flux[j] = l_flux * (node[n1 - 1].area[j]);
+                nodedata[n1 - 1].flux[j] = l_flux * (nodedata[n1 - 1].area[j]);
                 
                 for (k = 0; k < node[n2 - 1].numneighb; k++) {
                     if (node[n2 - 1].indnodes[k] == n1) {
                         if (flag != 0) {
-                            node[n2 - 1].area[k] = l_area;
+                            nodedata[n2 - 1].area[k] = l_area;
                         }
                         
-                        node[n2 - 1].flux[k] = l_flux * (-1.0) * node[n2 - 1].area[k];
+                        nodedata[n2 - 1].flux[k] = l_flux * (-1.0) * nodedata[n2 - 1].area[k];
                         break;
                     }
                 }
@@ -788,7 +793,7 @@ void ReadPFLOTRANfile(int nedges)
     // update cell volumes according to aperture
     
     for (i = 0; i < nnodes; i++) {
-        node[i].pvolume = node[i].pvolume * node[i].aperture;
+        nodedata[i].pvolume = nodedata[i].pvolume * node[i].aperture;
     }
     
     return;
@@ -876,7 +881,7 @@ void ReadFEHMfile(int nedges)
             for (i = 0; i < nnodes; i++) {
                 for (j = 0; j < max_neighb; j++) {
                     if (j < node[i].numneighb) {
-                        if( fscanf(fpr, "%lf", &node[i].flux[j]) != 1) {
+                        if( fscanf(fpr, "%lf", &nodedata[i].flux[j]) != 1) {
                             i = i;
                         }
                     }
@@ -910,7 +915,7 @@ void WritingInit()
     
     for (i = 0; i < nnodes; i++) {
         fprintf(wp, "\n Node %d, type %d, x=%5.8e, y=%5.8e, z=%5.8e, aperture=%5.8e, \n", i + 1,
-                node[i].typeN, node[i].coord[0], node[i].coord[1], node[i].coord[2], node[i].aperture);
+                node[i].typeN, nodedata[i].coord[0], nodedata[i].coord[1], nodedata[i].coord[2], node[i].aperture);
         fprintf(wp, " Fracture(s) %d %d \n", node[i].fracture[0], node[i].fracture[1]);
         
         if (node[i].fracture[1] == 0) {
@@ -923,11 +928,11 @@ void WritingInit()
         }
         
         fprintf(wp, " Pressure %5.8e,   Volume %5.8e , Connections %d \n",
-                node[i].pressure,  node[i].pvolume, node[i].numneighb);
+                node[i].pressure,  nodedata[i].pvolume, node[i].numneighb);
                 
         for (j = 0; j < node[i].numneighb; j++) {
             fprintf(wp, " Face %d  %d (type %d), flux %5.8e, area %5.8e, cells:\n",
-                    i + 1, node[i].indnodes[j], node[i].type[j], node[i].flux[j], node[i].area[j]);
+                    i + 1, node[i].indnodes[j], node[i].type[j], nodedata[i].flux[j], nodedata[i].area[j]);
                     
             for (k = 0; k < 4; k++) {
                 if (node[i].cells[j][k] != 0)
@@ -963,6 +968,19 @@ void WritingInit()
     return;
 }
 ///////////////////////////////////////////////////////////////////////////
+void FreeNodeData()
+/*! Function frees the node data used only in velocity reconstruction (areas of control volume cells edges) */
+{
+    unsigned int i;
+    
+    for (i = 0; i < nnodes; i++) {
+        free(nodedata[i].area);
+        nodedata[i].area = NULL;
+    }
+    
+    return;
+}
+//////////////////////////////////////////////////////////////////////////////
 void CheckGrid()
 /*! The function checks the grid: looking for nodes that are defined as
  internal or external, but belong to two fractures
@@ -979,7 +997,7 @@ void CheckGrid()
                 for (k = 0; k < 4; k++) {
                     if ((node[i].fracts[j][k] != node[i].fracture[0]) && (node[i].fracts[j][k] != 0)) {
                         printf("GRID ERROR: fracture %d node %d / fracture %d \n", node[i].fracture[0], i + 1, node[i].fracts[j][k]);
-                        printf(" node %d  %lf  %lf  %lf \n",  i + 1, node[i + 1].coord[0],  node[i + 1].coord[1], node[i + 1].coord[2]);
+                        printf(" node %d  %lf  %lf  %lf \n",  i + 1, nodedata[i + 1].coord[0],  nodedata[i + 1].coord[1], nodedata[i + 1].coord[2]);
                         r++;
                         break;
                     }
@@ -21,7 +21,7 @@ void   Convertto2d()
     double check = 0;
     double norm = 0;
     unsigned int i, j, l;
-    double nve[3] = {0, 0, 0};
+    double nve[3] = {0, 0, 0}, xyz[3];
     float angle, anglecos, anglesin;
     
     // loop over all fractures in DFN mesh, defining rotational matrices 3D-2D
@@ -62,38 +62,61 @@ void   Convertto2d()
         } //end if
     } //loop j
     
+    /* origin of every fracture's xy plane: node geometry is kept relative to it.
+     Used with single precision geometry only, otherwise origin is zero */
+    for (j = 0; j < nfract; j++) {
+        fracture[j].origin[0] = 0.0;
+        fracture[j].origin[1] = 0.0;
+        fracture[j].origin[2] = 0.0;
+#ifdef SINGLE_GEOMETRY
+        PointTo2d(j, nodedata[fracture[j].firstnode - 1].coord, fracture[j].origin);
+#endif
+    }
+    
     /* loop over all nodes in fracture */
     for (i = 0; i < nnodes; i++) {
-        if (fracture[node[i].fracture[0] - 1].theta != 0.0) {
-            j = node[i].fracture[0] - 1;
-            node[i].coord_xy[0] = fracture[j].rot2mat[0][0] * node[i].coord[0] + fracture[j].rot2mat[0][1] * node[i].coord[1] + fracture[j].rot2mat[0][2] * node[i].coord[2];
-            node[i].coord_xy[1] = fracture[j].rot2mat[1][0] * node[i].coord[0] + fracture[j].rot2mat[1][1] * node[i].coord[1] + fracture[j].rot2mat[1][2] * node[i].coord[2];
-            node[i].coord_xy[2] = fracture[j].rot2mat[2][0] * node[i].coord[0] + fracture[j].rot2mat[2][1] * node[i].coord[1] + fracture[j].rot2mat[2][2] * node[i].coord[2];
-        } else {
-            /* if angle =0 and fracture is parallel to xy plane, we use the same x and y coordinates */
-            node[i].coord_xy[0] = node[i].coord[0];
-            node[i].coord_xy[1] = node[i].coord[1];
-            node[i].coord_xy[2] = node[i].coord[2];
-        }
+        PointTo2d(node[i].fracture[0] - 1, nodedata[i].coord, xyz);
+        node[i].coord_xy[0] = xyz[0];
+        node[i].coord_xy[1] = xyz[1];
+        node[i].coord_xy[2] = xyz[2];
         
         /** if node belongs to intersection, belongs to two fractures *****/
         if (node[i].fracture[1] != 0) {
-            if (fracture[node[i].fracture[1] - 1].theta != 0.0) {
-                j = node[i].fracture[1] - 1;
-                node[i].coord_xy[3] = fracture[j].rot2mat[0][0] * node[i].coord[0] + fracture[j].rot2mat[0][1] * node[i].coord[1] + fracture[j].rot2mat[0][2] * node[i].coord[2];
-                node[i].coord_xy[4] = fracture[j].rot2mat[1][0] * node[i].coord[0] + fracture[j].rot2mat[1][1] * node[i].coord[1] + fracture[j].rot2mat[1][2] * node[i].coord[2];
-                node[i].coord_xy[5] = fracture[j].rot2mat[2][0] * node[i].coord[0] + fracture[j].rot2mat[2][1] * node[i].coord[1] + fracture[j].rot2mat[2][2] * node[i].coord[2];
-            } else {
-                node[i].coord_xy[3] = node[i].coord[0];
-                node[i].coord_xy[4] = node[i].coord[1];
-                node[i].coord_xy[5] = node[i].coord[2];
-            }
+            PointTo2d(node[i].fracture[1] - 1, nodedata[i].coord, xyz);
+            node[i].coord_xy[3] = xyz[0];
+            node[i].coord_xy[4] = xyz[1];
+            node[i].coord_xy[5] = xyz[2];
         }
     } //loop i
     
     return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void PointTo2d(int j, double coord[3], double xyz[3])
+/*! Function rotates a point with 3D coordinations coord to xy plane of fracture j; result is given relative to fracture's origin. */
+{
+    double x, y, z;
+    x = coord[0];
+    y = coord[1];
+    z = coord[2];
+    
+    if (fracture[j].theta != 0.0) {
+        xyz[0] = fracture[j].rot2mat[0][0] * x + fracture[j].rot2mat[0][1] * y + fracture[j].rot2mat[0][2] * z;
+        xyz[1] = fracture[j].rot2mat[1][0] * x + fracture[j].rot2mat[1][1] * y + fracture[j].rot2mat[1][2] * z;
+        xyz[2] = fracture[j].rot2mat[2][0] * x + fracture[j].rot2mat[2][1] * y + fracture[j].rot2mat[2][2] * z;
+    } else {
+        /* if angle =0 and fracture is parallel to xy plane, we use the same x and y coordinates */
+        xyz[0] = x;
+        xyz[1] = y;
+        xyz[2] = z;
+    }
+    
+    xyz[0] = xyz[0] - fracture[j].origin[0];
+    xyz[1] = xyz[1] - fracture[j].origin[1];
+    xyz[2] = xyz[2] - fracture[j].origin[2];
+    return;
+}
 ///////////////////////////////////////////////////////////////////////////////
 /*** function calculates rotation matrix to convert 2D coordinates into 3D*****/
 
@@ -141,15 +164,11 @@ void ChangeFracture(int cell_win)
     int j;
     struct posit3d particle3dposit;
     particle3dposit = CalculatePosition3D(particle3dposit);
+    double xyz[3];
     j = cell[cell_win - 1].fracture - 1;
-    
-    if (fracture[j].theta != 0.0) {
-        particle[np].position[0] = fracture[j].rot2mat[0][0] * particle3dposit.cord3[0] + fracture[j].rot2mat[0][1] * particle3dposit.cord3[1] + fracture[j].rot2mat[0][2] * particle3dposit.cord3[2];
-        particle[np].position[1] = fracture[j].rot2mat[1][0] * particle3dposit.cord3[0] + fracture[j].rot2mat[1][1] * particle3dposit.cord3[1] + fracture[j].rot2mat[1][2] * particle3dposit.cord3[2];
-    } else {
-        particle[np].position[0] = particle3dposit.cord3[0];
-        particle[np].position[1] = particle3dposit.cord3[1];
-    }
+    PointTo2d(j, particle3dposit.cord3, xyz);
+    particle[np].position[0] = xyz[0];
+    particle[np].position[1] = xyz[1];
     
     particle[np].fracture = cell[cell_win - 1].fracture;
     particle[np].cell = cell_win;
@@ -162,9 +181,12 @@ struct posit3d CalculatePosition3D()
 /*! Function calculates 3D coordinates of current particle's position at 2D fracture plane*/
 {
     int j;
-    double  thirdcoord = 0.0;
+    double  thirdcoord = 0.0, x, y;
     struct posit3d particle3dposit;
     j = particle[np].fracture - 1;
+    /* particle's position is relative to fracture's origin */
+    x = particle[np].position[0] + fracture[j].origin[0];
+    y = particle[np].position[1] + fracture[j].origin[1];
     
     if (fracture[j].theta != 0.0) {
         if (node[fracture[j].firstnode - 1].fracture[0] == particle[np].fracture) {
@@ -173,13 +195,14 @@ struct posit3d CalculatePosition3D()
             thirdcoord = node[fracture[j].firstnode - 1].coord_xy[5];
         }
         
-        particle3dposit.cord3[0] = fracture[j].rot3mat[0][0] * particle[np].position[0] + fracture[j].rot3mat[0][1] * particle[np].position[1] + fracture[j].rot3mat[0][2] * thirdcoord;
-        particle3dposit.cord3[1] = fracture[j].rot3mat[1][0] * particle[np].position[0] + fracture[j].rot3mat[1][1] * particle[np].position[1] + fracture[j].rot3mat[1][2] * thirdcoord;
-        particle3dposit.cord3[2] = fracture[j].rot3mat[2][0] * particle[np].position[0] + fracture[j].rot3mat[2][1] * particle[np].position[1] + fracture[j].rot3mat[2][2] * thirdcoord;
+        thirdcoord = thirdcoord + fracture[j].origin[2];
+        particle3dposit.cord3[0] = fracture[j].rot3mat[0][0] * x + fracture[j].rot3mat[0][1] * y + fracture[j].rot3mat[0][2] * thirdcoord;
+        particle3dposit.cord3[1] = fracture[j].rot3mat[1][0] * x + fracture[j].rot3mat[1][1] * y + fracture[j].rot3mat[1][2] * thirdcoord;
+        particle3dposit.cord3[2] = fracture[j].rot3mat[2][0] * x + fracture[j].rot3mat[2][1] * y + fracture[j].rot3mat[2][2] * thirdcoord;
     } else {
-        particle3dposit.cord3[0] = particle[np].position[0];
-        particle3dposit.cord3[1] = particle[np].position[1];
-        particle3dposit.cord3[2] = node[fracture[j].firstnode - 1].coord[2];
+        particle3dposit.cord3[0] = x;
+        particle3dposit.cord3[1] = y;
+        particle3dposit.cord3[2] = nodedata[fracture[j].firstnode - 1].coord[2];
     }
     
     return particle3dposit;
@@ -214,7 +237,7 @@ void   Velocity3D()
                 cord3[2] = 0;
             }
             
-            fprintf(w3, " %05d  %5.8e   %5.8e   %5.8e %5.8e   %5.8e   %5.8e  %5.8e  %d\n", i + 1, node[i].coord[0], node[i].coord[1], node[i].coord[2], cord3[0], cord3[1], cord3[2], node[i].pvolume, node[i].fracture[0]);
+            fprintf(w3, " %05d  %5.8e   %5.8e   %5.8e %5.8e   %5.8e   %5.8e  %5.8e  %d\n", i + 1, nodedata[i].coord[0], nodedata[i].coord[1], nodedata[i].coord[2], cord3[0], cord3[1], cord3[2], nodedata[i].pvolume, node[i].fracture[0]);
         } else {
             for (v = 0; v < 2; v++) {
                 if (fracture[j].theta != 0) {
@@ -228,7 +251,7 @@ void   Velocity3D()
                     cord3[2] = 0;
                 }
                 
-                fprintf(w3, " %05d  %5.8e   %5.8e   %5.8e %5.8e   %5.8e   %5.8e  %5.8e  %d\n", i + 1, node[i].coord[0], node[i].coord[1], node[i].coord[2], cord3[0], cord3[1], cord3[2], node[i].pvolume, node[i].fracture[0] );
+                fprintf(w3, " %05d  %5.8e   %5.8e   %5.8e %5.8e   %5.8e   %5.8e  %5.8e  %d\n", i + 1, nodedata[i].coord[0], nodedata[i].coord[1], nodedata[i].coord[2], cord3[0], cord3[1], cord3[2], nodedata[i].pvolume, node[i].fracture[0] );
             }
         }
         
@@ -247,7 +270,7 @@ void   Velocity3D()
                     cord3[2] = 0;
                 }
                 
-                fprintf(w3, " %05d  %5.8e   %5.8e   %5.8e %5.8e   %5.8e   %5.8e  %5.8e  %d\n", i + 1, node[i].coord[0], node[i].coord[1], node[i].coord[2], cord3[0], cord3[1], cord3[2], node[i].pvolume, node[i].fracture[1] );
+                fprintf(w3, " %05d  %5.8e   %5.8e   %5.8e %5.8e   %5.8e   %5.8e  %5.8e  %d\n", i + 1, nodedata[i].coord[0], nodedata[i].coord[1], nodedata[i].coord[2], cord3[0], cord3[1], cord3[2], nodedata[i].pvolume, node[i].fracture[1] );
             }
         }
     }
@@ -53,9 +53,12 @@ struct tempout  /*! structure of the particle data, saved temporary for output p
     double pressure; // fluid pressure at particle's position
 };
 
-struct tempout *tempdata;
+struct tempout *tempdata = NULL; // trajectory buffer, reused by all segments and particles
+unsigned int tempsize = 0; // number of records allocated in trajectory buffer
+static struct tempout temprec; // record read back from the temporary file (out_filetemp)
 
 static FILE *tmp;
+
 static FILE *wpt;
 static FILE *wpt_att;
 static FILE *wv;
@@ -254,7 +257,7 @@ void ParticleTrack ()
     
     // open tortuosity file
     char path[125];
-    FILE *tort;
+    FILE *tort = NULL;
     
     if (tort_o > 0) {
         sprintf(filename, "%s/torts.dat", maindir);
@@ -391,8 +394,8 @@ void ParticleTrack ()
             inputfile = Control_Param("flowdir:", 8);
             flowd = inputfile.param;
             //node[nodezonein[0] - 1].fracture[0];
-            inflowcoord = node[nodezonein[0] - 1].coord[flowd];
-            outflowcoord = node[nodezoneout[0] - 1].coord[flowd];
+            inflowcoord = nodedata[nodezonein[0] - 1].coord[flowd];
+            outflowcoord = nodedata[nodezoneout[0] - 1].coord[flowd];
             controllength = fabs(outflowcoord) + fabs(inflowcoord);
             icl = controllength / deltaCP + 1;
         }
@@ -438,10 +441,19 @@ void ParticleTrack ()
     
     /**** calculate initial flux weight of particles *****/
     /**** works for first 3 options of particles initial positions ******/
+    double totalflux = 0.0;
     
     if (initweight == 1) {
-        FlowInWeight(numbpart);
+        if (chunkpart > 0) {
+            totalflux = SeedInFlux();
+        } else {
+            FlowInWeight(numbpart);
+        }
     }
+    
+    /* ip - particle's ID; np - particle's index in particle array, the same as ID
+     unless particles are seeded in chunks */
+    unsigned int ip, firstp = 0, nchunk = 0;
 
     double percentDone = 0;
     double percentCounter = 10;
@@ -449,13 +461,35 @@ void ParticleTrack ()
     printf("Starting Main Loop on Particles\n");
     printf("***************************************************\n");
     /************ LOOP ON PARTICLES  **********/
-    for (np = 0; np < numbpart; np++) {
+    for (ip = 0; ip < numbpart; ip++) {
+        np = ip;
+        
+        if (chunkpart > 0) {
+            /* seed next chunk of particles when the current one is done */
+            if (ip == firstp + nchunk) {
+                firstp = ip;
+                nchunk = NextParticles();
+                
+                if (nchunk == 0) {
+                    break;
+                }
+                
+                if (initweight == 1) {
+                    for (np = 0; np < nchunk; np++) {
+                        particle[np].fl_weight = ParticleInFlux() / totalflux;
+                    }
+                }
+            }
+            
+            np = ip - firstp;
+        }
+        
         t = 0;
         
-        percentDone = 100*(float)np/(float)numbpart;
+        percentDone = 100*(float)ip/(float)numbpart;
         if (percentDone >= percentCounter){
-            printf("%d particles out of %d have completed (%0.2f%%)\n",np,numbpart,percentDone);
-            printf("%d particles out of %d have exited successfully.\n\n",curr_n-1,np);
+            printf("%d particles out of %d have completed (%0.2f%%)\n",ip,numbpart,percentDone);
+            printf("%d particles out of %d have exited successfully.\n\n",curr_n-1,ip);
             percentCounter += 10;
         }
 
@@ -496,9 +530,13 @@ void ParticleTrack ()
             fprintf(diff, "       Advective travel time on the fracture, Diffusion time on the fracture, Total travel time on the fracture, fracture ID, Accumulative advective travel time, Accumulative total time, Accumulative diffusion time \n");
         }
         
-        // define capacity for temp data used for outputs
+        // define maximal number of time steps in trajectory segment saved for outputs
         int capacity = (int) timesteps / 10;
         
+        while ((capacity > 0) && (2 * capacity < timesteps)) {
+            capacity = 2 * capacity;
+        }
+        
         if (disp_o != 1) {
             time_d = 1;
         }
@@ -526,7 +564,7 @@ void ParticleTrack ()
         }
         
         if (ins == 0) {
-            printf("Initial cell is not found for particle %d %f %f in fract %d. \n", np + 1, particle[np].position[0], particle[np].position[1], particle[np].fracture);
+            printf("Initial cell is not found for particle %d %f %f in fract %d. \n", ip + 1, particle[np].position[0], particle[np].position[1], particle[np].fracture);
 
             fclose (wpt);
             fclose (wpt_att);
@@ -568,7 +606,7 @@ void ParticleTrack ()
             double beta = 0.0;
             
             if  (all_out > 0) {
-                fprintf(inp, "\n %d  %d  %d %5.12E %5.12E %5.12E %5.12E", np + 1, particle[np].cell, particle[np].fracture, particle3dposit.cord3[0], particle3dposit.cord3[1], particle3dposit.cord3[2], particle[np].fl_weight);
+                fprintf(inp, "\n %d  %d  %d %5.12E %5.12E %5.12E %5.12E", ip + 1, particle[np].cell, particle[np].fracture, particle3dposit.cord3[0], particle3dposit.cord3[1], particle3dposit.cord3[2], particle[np].fl_weight);
             }
             
             totallength = 0.0;
@@ -610,12 +648,12 @@ void ParticleTrack ()
                 }
             }
             
-            if (tfile > 0) {
+            if ((tfile == 1) && (no_out != 1)) {
                 sprintf(filename, "%s/tempdata_%d", maindir, np);
-                tmp = OpenFile(filename, "w");
+                tmp = OpenFile(filename, "w+b");
             }
             
-            timecounter = 0; //for temp data allocation
+            timecounter = 0; //for temp data buffer
             t_adv0 = 0; //for tdrw calculation; starting time
             particle[np].t_diff = 0.0;
             particle[np].t_adv_diff = 0.0;
@@ -635,63 +673,20 @@ void ParticleTrack ()
                 if (t == 1){
                         //printf("here\n");
                         particle3dvelocity = CalculateVelocity3D();
-                        fprintf(initialVelocityFile, "%05d  %5.12E  %5.12E  %5.12E  %5.12E \n", np+1, particle3dvelocity.cord3[0], particle3dvelocity.cord3[1], particle3dvelocity.cord3[2], sqrt( particle3dvelocity.cord3[0]*particle3dvelocity.cord3[0] + particle3dvelocity.cord3[1]*particle3dvelocity.cord3[1] +  particle3dvelocity.cord3[2]*    particle3dvelocity.cord3[2]));
+                        fprintf(initialVelocityFile, "%05d  %5.12E  %5.12E  %5.12E  %5.12E \n", ip+1, particle3dvelocity.cord3[0], particle3dvelocity.cord3[1], particle3dvelocity.cord3[2], sqrt( particle3dvelocity.cord3[0]*particle3dvelocity.cord3[0] + particle3dvelocity.cord3[1]*particle3dvelocity.cord3[1] +  particle3dvelocity.cord3[2]*    particle3dvelocity.cord3[2]));
                         //printf("here 2\n");
                         }
                 if (no_out != 1) {
+                    particle3dvelocity = CalculateVelocity3D();
+                    SaveTempData(t, beta, totallength, particle3dposit.cord3, particle3dvelocity.cord3);
+                    timecounter++;
                     
-
-                    if (tfile == 1) {
-                        fprintf(tmp, "%05d  %5.12E  %5.12E  %5.12E  %5.12E  %5.12E  %5.12E  %5.12E  %5.12E  %05d  %05d  %5.12E  %5.12E  %5.12E  %5.12E \n", t, particle[np].position[0], particle[np].position[1], particle3dposit.cord3[0], particle3dposit.cord3[1], particle3dposit.cord3[2], particle3dvelocity.cord3[0], particle3dvelocity.cord3[1], particle3dvelocity.cord3[2], particle[np].cell, particle[np].fracture, particle[np].time, beta, totallength, particle[np].pressure);
-                    } else {
-                        if (timecounter == 0) {
-                            tempdata = (struct tempout*) malloc (capacity * sizeof(struct tempout));
-                        }
-                        
-                        if (tempdata == NULL) {
-                            printf("Allocation memory problem - tempdata\n");
-                            printf("timecounter %d time %d capacity %d\n", timecounter, t, capacity);
-                        }
-                        
-                        particle3dvelocity = CalculateVelocity3D();
-                        tempdata[timecounter].times = t;
-                        tempdata[timecounter].position2d[0] = particle[np].position[0];
-                        tempdata[timecounter].position2d[1] = particle[np].position[1];
-                        tempdata[timecounter].position3d[0] = particle3dposit.cord3[0];
-                        tempdata[timecounter].position3d[1] = particle3dposit.cord3[1];
-                        tempdata[timecounter].position3d[2] = particle3dposit.cord3[2];
-                        tempdata[timecounter].velocity3d[0] = particle3dvelocity.cord3[0];
-                        tempdata[timecounter].velocity3d[1] = particle3dvelocity.cord3[1];
-                        tempdata[timecounter].velocity3d[2] = particle3dvelocity.cord3[2];
-                        tempdata[timecounter].cellp = particle[np].cell;
-                        tempdata[timecounter].fracturep = particle[np].fracture;
-                        tempdata[timecounter].timep = particle[np].time;
-                        tempdata[timecounter].betap = beta;
-                        tempdata[timecounter].length_t = totallength;
-                        tempdata[timecounter].pressure = particle[np].pressure;
-                        timecounter++;
-                        
-                        // if memory should be reallocated
-                        if (timecounter == capacity) {
-                            capacity = 2 * capacity;
-                            
-                            if (capacity >= timesteps) {
-                                printf("overload\n");
-                                FLAG_OUT = 0;
-                                t_end = t;
-
-                                if (!tfile)
-                                    free(tempdata);
-                                break;
-                            }
-                            
-                            tempdata = (struct tempout*)realloc(tempdata, sizeof(struct tempout) * capacity);
-                            
-                            if (tempdata == NULL) {
-                                printf("REAllocation memory problem - tempdata\n");
-                                printf("timecounter %d time %d capacity %d\n", timecounter, t, capacity);
-                            }
-                        }
+                    // trajectory segment is too long for the memory buffer
+                    if ((tfile == 0) && (timecounter == capacity)) {
+                        printf("overload\n");
+                        FLAG_OUT = 0;
+                        t_end = t;
+                        break;
                     }
                 }
                 
@@ -882,11 +877,10 @@ void ParticleTrack ()
 
 
                 if (all_out == 0) {
-                    if (tfile == 1) {
+                    if ((tfile == 1) && (no_out != 1)) {
                         fclose(tmp);
-                        int status;
                         sprintf(filename, "%s/tempdata_%d", maindir, np);
-                        status = remove(filename);
+                        remove(filename);
                     }
                     
                     if (out_control == 1) {
@@ -907,33 +901,13 @@ void ParticleTrack ()
                     particle3dposit = CalculatePosition3D();
                     particle3dvelocity = CalculateVelocity3D();
                     
-                    if (tfile == 1) {
-                        fprintf(tmp, "%05d  %5.12E  %5.12E  %5.12E  %5.12E  %5.12E  %5.12E  %5.12E  %5.12E  %05d  %05d  %5.12E  %5.12E  %5.12E  %5.12E \n", t, particle[np].position[0], particle[np].position[1], particle3dposit.cord3[0], particle3dposit.cord3[1], particle3dposit.cord3[2], particle3dvelocity.cord3[0], particle3dvelocity.cord3[1], particle3dvelocity.cord3[2], particle[np].cell, particle[np].fracture, particle[np].time, beta, totallength, particle[np].pressure);
-                    } else {
-                        tempdata[timecounter].times = t;
-                        tempdata[timecounter].position2d[0] = particle[np].position[0];
-                        tempdata[timecounter].position2d[1] = particle[np].position[1];
-                        tempdata[timecounter].position3d[0] = particle3dposit.cord3[0];
-                        tempdata[timecounter].position3d[1] = particle3dposit.cord3[1];
-                        tempdata[timecounter].position3d[2] = particle3dposit.cord3[2];
-                        tempdata[timecounter].velocity3d[0] = particle3dvelocity.cord3[0];
-                        tempdata[timecounter].velocity3d[1] = particle3dvelocity.cord3[1];
-                        tempdata[timecounter].velocity3d[2] = particle3dvelocity.cord3[2];
-                        tempdata[timecounter].cellp = particle[np].cell;
-                        tempdata[timecounter].fracturep = particle[np].fracture;
-                        tempdata[timecounter].timep = particle[np].time;
-                        tempdata[timecounter].betap = beta;
-                        tempdata[timecounter].length_t = totallength;
-                        tempdata[timecounter].pressure = particle[np].pressure;
-                    }
-                    
+                    SaveTempData(t, beta, totallength, particle3dposit.cord3, particle3dvelocity.cord3);
                     ParticleOutput(t, 0);
                     
                     if (tfile == 1) {
                         fclose(tmp);
-                        int status;
                         sprintf(filename, "%s/tempdata_%d", maindir, np);
-                        status = remove(filename);
+                        remove(filename);
                     }
                 } else {
                     if (particle[np].cell != 0) {
@@ -985,9 +959,9 @@ void ParticleTrack ()
                 
                 if (all_out == 1) {
                     if (particle[np].cell != 0) {
-                        fprintf(fnp, "\n %d  %d  %d  %5.12E  %5.12E  %5.12E   %5.12E ", np + 1, particle[np].cell, particle[np].fracture, particle3dposit.cord3[0], particle3dposit.cord3[1], particle3dposit.cord3[2], particle[np].fl_weight);
+                        fprintf(fnp, "\n %d  %d  %d  %5.12E  %5.12E  %5.12E   %5.12E ", ip + 1, particle[np].cell, particle[np].fracture, particle3dposit.cord3[0], particle3dposit.cord3[1], particle3dposit.cord3[2], particle[np].fl_weight);
                     }                               else {
-                        fprintf(fnp, "\n %d  %d  %d ", np + 1, particle[np].cell, particle[np].fracture);
+                        fprintf(fnp, "\n %d  %d  %d ", ip + 1, particle[np].cell, particle[np].fracture);
                     }
                 }
                 
@@ -1109,6 +1083,14 @@ void ParticleTrack ()
     }
     
     fclose(initialVelocityFile);
+    
+    if (chunkpart > 0) {
+        FreeSeeding();
+    }
+    
+    free(tempdata);
+    tempdata = NULL;
+    tempsize = 0;
 
 
     sprintf(filename, "%s/TotalNumberP", maindir);
@@ -1157,6 +1139,12 @@ void CheckNewCell()
         pfract = particle[np].fracture;
         particle[np].cell = 0;
         SearchNeighborCells(n1, n2, n3);
+        
+        if (particle[np].cell == 0) {
+            /**** particle moved further than neighboring cells - search in fracture's grid ***/
+            LocateCell();
+        }
+        
         cb = 0;
         
         if ((node[n1 - 1].typeN == 210) || (node[n1 - 1].typeN == 212) || (node[n1 - 1].typeN == 200) || (node[n1 - 1].typeN == 202)) {
@@ -1481,12 +1469,12 @@ void DefineTimeStep()
             
             if (dotvel1 > epsd) {
                 if (node[i].typeN == 10) {
-                    node[i].timestep[j] = 0.005 * sqrt(((node[i].pvolume) / node[i].aperture) / dotvel1);
+                    node[i].timestep[j] = 0.005 * sqrt(((nodedata[i].pvolume) / node[i].aperture) / dotvel1);
                 } else {
-                    node[i].timestep[j] = 0.005 * sqrt(((node[i].pvolume) / node[i].aperture) / dotvel1);
+                    node[i].timestep[j] = 0.005 * sqrt(((nodedata[i].pvolume) / node[i].aperture) / dotvel1);
                 }
             } else {
-                node[i].timestep[j] = 0.005 * sqrt(((node[i].pvolume) / node[i].aperture) / epsd);
+                node[i].timestep[j] = 0.005 * sqrt(((nodedata[i].pvolume) / node[i].aperture) / epsd);
             }
         }
     }
@@ -2388,39 +2376,31 @@ void Moving2NextCellBound(int prevcell)
 }
 //////////////////////////////////////////////////////////////////////////////
 void ParticleOutput (int currentt, int fract_p)
-/*! The function of particles trajectories outputs. Function is called at every intersection and outputs to file at each segment of particles trajectory: from intersection to intersection. The curvature of the trajectory is defined and dictate number of time steps for outputs (unless user requested every time step output). */
+/*! The function of particles trajectories outputs. Function is called at every intersection and outputs to file at each segment of particles trajectory: from intersection to intersection. The curvature of the trajectory is defined and dictate number of time steps for outputs (unless user requested every time step output). The segment data are taken from the memory buffer tempdata or, with out_filetemp, from the temporary file of the particle; both keep a record at every time step. */
 {
-    FILE *tmpp;
     double posit[3] = {0.0, 0.0, 0.0}, veloc[3] = {0.0, 0.0, 0.0};
-    double startx, starty, endx, endy, midx, midy, time, velocity_t = 0.0, obeta = 0.0, length_t = 0.0;
-    int i, tstart = -1, pcell = 0, pfrac = 0, tend = 0, tmid;
+    double startx, starty, endx, endy, midx = 0.0, midy = 0.0, time, velocity_t = 0.0, obeta = 0.0, length_t = 0.0;
+    int i, tstart = -1, pcell = 0, pfrac = 0, tend = 0, tmid = 0;
     int time_l, kdiv = 2;
     double eps = 0.05, pressure = 0.0;
     struct posit3d particle3dp, particle3dv;
-    char filename[125];
-    
-    if (tfile == 1) {
-        fclose(tmp);
-        sprintf(filename, "%s/tempdata_%d", maindir, np);
-        tmpp = OpenFile(filename, "r");
-        fscanf(tmpp, "%d %lf %lf %lf %lf %lf %lf %lf %lf %d %d %lf %lf %lf %lf\n ", &tstart, &startx, &starty, &posit[0], &posit[1], &posit[2], &veloc[0], &veloc[1], &veloc[2], &pcell, &pfrac, &time, &obeta, &length_t, &pressure);
-    } else {
-        startx = tempdata[0].position2d[0];
-        starty = tempdata[0].position2d[1];
-        posit[0] = tempdata[0].position3d[0];
-        posit[1] = tempdata[0].position3d[1];
-        posit[2] = tempdata[0].position3d[2];
-        veloc[0] = tempdata[0].velocity3d[0];
-        veloc[1] = tempdata[0].velocity3d[1];
-        veloc[2] = tempdata[0].velocity3d[2];
-        pcell = tempdata[0].cellp;
-        pfrac = tempdata[0].fracturep;
-        time = tempdata[0].timep;
-        obeta = tempdata[0].betap;
-        length_t = tempdata[0].length_t;
-        pressure = tempdata[0].pressure;
-        tstart = tempdata[0].times;
-    }
+    struct tempout *rec;
+    rec = ReadTempData(0);
+    startx = rec->position2d[0];
+    starty = rec->position2d[1];
+    posit[0] = rec->position3d[0];
+    posit[1] = rec->position3d[1];
+    posit[2] = rec->position3d[2];
+    veloc[0] = rec->velocity3d[0];
+    veloc[1] = rec->velocity3d[1];
+    veloc[2] = rec->velocity3d[2];
+    pcell = rec->cellp;
+    pfrac = rec->fracturep;
+    time = rec->timep;
+    obeta = rec->betap;
+    length_t = rec->length_t;
+    pressure = rec->pressure;
+    tstart = rec->times;
     
     if (traj_o == 1) {
         fprintf(wint, "%5.12E %5.12E  %5.12E   %5.12E  %5.12E %d %5.12E\n", length_t, time, posit[0], posit[1], posit[2], pfrac, obeta);
@@ -2446,7 +2426,7 @@ void ParticleOutput (int currentt, int fract_p)
                     fprintf(wpt_att, "%010d  %06d  %5.12E  %5.12E  %5.12E %5.12E  %5.12E  %5.12E  %5.12E\n", nodeID, pfrac, time, velocity_t, veloc[0], veloc[1], veloc[2], node[cell[pcell - 1].node_ind[0] - 1].aperture, pressure);
                 }
                 
-                int tstep, flag = 0, isch = 0;
+                int tstep, flag = 0;
                 double angle_m;
                 
                 do {
@@ -2454,34 +2434,23 @@ void ParticleOutput (int currentt, int fract_p)
                     kdiv = kdiv * 2;
                     tstep = (int) (time_l / 2.0);
                     
-                    if (tfile == 1) {
-                        rewind(tmp);
-                    }
-                    
-                    for (isch = 0; isch < time_l; isch++) {
-                        if (tfile == 1) {
-                            fscanf(tmpp, "%d %lf %lf %lf %lf %lf %lf %lf %lf %d %d %lf %lf %lf %lf\n ", &tmid, &midx, &midy, &posit[0], &posit[1], &posit[2], &veloc[0], &veloc[1], &veloc[2], &pcell, &pfrac, &time, &obeta, &length_t, &pressure);
-                        } else {
-                            tmid = tempdata[isch].times;
-                            midx = tempdata[isch].position2d[0];
-                            midy = tempdata[isch].position2d[1];
-                            posit[0] = tempdata[isch].position3d[0];
-                            posit[1] = tempdata[isch].position3d[1];
-                            posit[2] = tempdata[isch].position3d[2];
-                            veloc[0] = tempdata[isch].velocity3d[0];
-                            veloc[1] = tempdata[isch].velocity3d[1];
-                            veloc[2] = tempdata[isch].velocity3d[2];
-                            pcell = tempdata[isch].cellp;
-                            pfrac = tempdata[isch].fracturep;
-                            time = tempdata[isch].timep;
-                            obeta = tempdata[isch].betap;
-                            pressure = tempdata[isch].pressure;
-                            length_t = tempdata[isch].length_t;
-                        }
-                        
-                        if (tmid == tstart + tstep) {
-                            break;
-                        }
+                    if (time_l > 0) {
+                        rec = TempRecord(tstart + tstep, tstart, time_l);
+                        tmid = rec->times;
+                        midx = rec->position2d[0];
+                        midy = rec->position2d[1];
+                        posit[0] = rec->position3d[0];
+                        posit[1] = rec->position3d[1];
+                        posit[2] = rec->position3d[2];
+                        veloc[0] = rec->velocity3d[0];
+                        veloc[1] = rec->velocity3d[1];
+                        veloc[2] = rec->velocity3d[2];
+                        pcell = rec->cellp;
+                        pfrac = rec->fracturep;
+                        time = rec->timep;
+                        obeta = rec->betap;
+                        pressure = rec->pressure;
+                        length_t = rec->length_t;
                     }
                     
                     angle_m = DefineAngle(startx - midx, starty - midy, endx - midx, endy - midy);
@@ -2521,35 +2490,24 @@ void ParticleOutput (int currentt, int fract_p)
                     tstep = 1;
                 }
                 
-                if (tfile == 1) {
-                    rewind(tmp);
-                }
-                
                 for(i = 0; i < kdiv - 1; i++) {
-                    for (isch = 0; isch < time_l; isch++) {
-                        if (tfile == 1) {
-                            fscanf(tmpp, "%d %lf %lf %lf %lf %lf %lf %lf %lf %d %d %lf %lf %lf %lf\n ", &tmid, &midx, &midy, &posit[0], &posit[1], &posit[2], &veloc[0], &veloc[1], &veloc[2], &pcell, &pfrac, &time, &obeta, &length_t, &pressure);
-                        } else {
-                            tmid = tempdata[isch].times;
-                            midx = tempdata[isch].position2d[0];
-                            midy = tempdata[isch].position2d[1];
-                            posit[0] = tempdata[isch].position3d[0];
-                            posit[1] = tempdata[isch].position3d[1];
-                            posit[2] = tempdata[isch].position3d[2];
-                            veloc[0] = tempdata[isch].velocity3d[0];
-                            veloc[1] = tempdata[isch].velocity3d[1];
-                            veloc[2] = tempdata[isch].velocity3d[2];
-                            pcell = tempdata[isch].cellp;
-                            pfrac = tempdata[isch].fracturep;
-                            time = tempdata[isch].timep;
-                            obeta = tempdata[isch].betap;
-                            pressure = tempdata[isch].pressure;
-                            length_t = tempdata[isch].length_t;
-                        }
-                        
-                        if (tmid == tstart + tstep * (i + 1)) {
-                            break;
-                        }
+                    if (time_l > 0) {
+                        rec = TempRecord(tstart + tstep * (i + 1), tstart, time_l);
+                        tmid = rec->times;
+                        midx = rec->position2d[0];
+                        midy = rec->position2d[1];
+                        posit[0] = rec->position3d[0];
+                        posit[1] = rec->position3d[1];
+                        posit[2] = rec->position3d[2];
+                        veloc[0] = rec->velocity3d[0];
+                        veloc[1] = rec->velocity3d[1];
+                        veloc[2] = rec->velocity3d[2];
+                        pcell = rec->cellp;
+                        pfrac = rec->fracturep;
+                        time = rec->timep;
+                        obeta = rec->betap;
+                        pressure = rec->pressure;
+                        length_t = rec->length_t;
                     }
                     
                     if (traj_o == 1) {
@@ -2567,48 +2525,32 @@ void ParticleOutput (int currentt, int fract_p)
             }
         } else {
             /* in case of every time step output */
-            if (curv_o != 1) {
-                if (tfile == 1) {
-                    fscanf(tmpp, "%d %lf %lf %lf %lf %lf %lf %lf %lf %d %d %lf %lf %lf %lf\n ", &tstart, &startx, &starty, &posit[0], &posit[1], &posit[2], &veloc[0], &veloc[1], &veloc[2], &pcell, &pfrac, &time, &obeta, &length_t, &pressure);
-                    rewind(tmp);
-                    time_l = currentt - tstart;
-                } else {
-                    tstart = tempdata[0].times;
-                    time_l = currentt - tstart;
+            time_l = currentt - tstart;
+            
+            for (i = 0; i < time_l; i++) {
+                rec = ReadTempData(i);
+                tstart = rec->times;
+                posit[0] = rec->position3d[0];
+                posit[1] = rec->position3d[1];
+                posit[2] = rec->position3d[2];
+                veloc[0] = rec->velocity3d[0];
+                veloc[1] = rec->velocity3d[1];
+                veloc[2] = rec->velocity3d[2];
+                pcell = rec->cellp;
+                pfrac = rec->fracturep;
+                time = rec->timep;
+                obeta = rec->betap;
+                pressure = rec->pressure;
+                nodeID++;
+                
+                if (avs_o == 1) {
+                    fprintf(wpt, "%05d %5.12E %5.12E %5.12E \n", nodeID, posit[0], posit[1], posit[2]);
+                    velocity_t = sqrt(pow(veloc[0], 2) + pow(veloc[1], 2) + pow(veloc[2], 2));
+                    fprintf(wpt_att, "%010d  %06d  %5.12E  %5.12E  %5.12E %5.12E  %5.12E  %5.12E %5.12E\n", nodeID, pfrac, time, velocity_t, veloc[0], veloc[1], veloc[2], node[cell[pcell - 1].node_ind[0] - 1].aperture, pressure);
                 }
                 
-                for (i = 0; i < time_l; i++) {
-                    if (tfile == 1) {
-                        fscanf(tmpp, "%d %lf %lf %lf %lf %lf %lf %lf %lf %d %d %lf %lf %lf %lf\n ", &tstart, &startx, &starty, &posit[0], &posit[1], &posit[2], &veloc[0], &veloc[1], &veloc[2], &pcell, &pfrac, &time, &obeta, &length_t, &pressure);
-                    } else {
-                        tstart = tempdata[i].times;
-                        startx = tempdata[i].position2d[0];
-                        starty = tempdata[i].position2d[1];
-                        posit[0] = tempdata[i].position3d[0];
-                        posit[1] = tempdata[i].position3d[1];
-                        posit[2] = tempdata[i].position3d[2];
-                        veloc[0] = tempdata[i].velocity3d[0];
-                        veloc[1] = tempdata[i].velocity3d[1];
-                        veloc[2] = tempdata[i].velocity3d[2];
-                        pcell = tempdata[i].cellp;
-                        pfrac = tempdata[i].fracturep;
-                        time = tempdata[i].timep;
-                        obeta = tempdata[i].betap;
-                        pressure = tempdata[i].pressure;
-                        length_t = tempdata[i].length_t;
-                    }
-                    
-                    nodeID++;
-                    
-                    if (avs_o == 1) {
-                        fprintf(wpt, "%05d %5.12E %5.12E %5.12E \n", nodeID, posit[0], posit[1], posit[2]);
-                        velocity_t = sqrt(pow(veloc[0], 2) + pow(veloc[1], 2) + pow(veloc[2], 2));
-                        fprintf(wpt_att, "%010d  %06d  %5.12E  %5.12E  %5.12E %5.12E  %5.12E  %5.12E %5.12E\n", nodeID, pfrac, time, velocity_t, veloc[0], veloc[1], veloc[2], node[cell[pcell - 1].node_ind[0] - 1].aperture, pressure);
-                    }
-                    
-                    if (traj_o == 1) {
-                        fprintf(wv, "%05d  %5.12E %5.12E %5.12E %5.12E %5.12E %5.12E %05d %05d %5.12E %5.12E %5.12E %d %5.12E\n", tstart, posit[0], posit[1], posit[2], veloc[0], veloc[1], veloc[2], pcell, pfrac, time, node[cell[pcell - 1].node_ind[0] - 1].aperture, obeta, 0, pressure);
-                    }
+                if (traj_o == 1) {
+                    fprintf(wv, "%05d  %5.12E %5.12E %5.12E %5.12E %5.12E %5.12E %05d %05d %5.12E %5.12E %5.12E %d %5.12E\n", tstart, posit[0], posit[1], posit[2], veloc[0], veloc[1], veloc[2], pcell, pfrac, time, node[cell[pcell - 1].node_ind[0] - 1].aperture, obeta, 0, pressure);
                 }
             }
         }
@@ -2629,30 +2571,102 @@ void ParticleOutput (int currentt, int fract_p)
         }
     }
     
+    /* segment is written, the buffer or file is reused by the next segment */
+    timecounter = 0;
+    
     if (tfile == 1) {
-        fclose(tmpp);
-        int status;
-        sprintf(filename, "%s/tempdata_%d", maindir, np);
-        status = remove(filename);
-        
-        if (no_out != 1) {
-            if( status != 0 ) {
-                printf("Unable to delete the file %s\n", filename);
-                perror("Error");
-            }
-            
-            {
-                sprintf(filename, "%s/tempdata_%d", maindir, np);
-                tmp = OpenFile(filename, "w");
-            }
+        rewind(tmp);
+    }
+    
+    return;
+}
+//////////////////////////////////////////////////////////////////////////////
+void SaveTempData(int tcurrent, double beta, double totallength, double posit3[3], double veloc3[3])
+/*! Function saves particle's data of the current time step into the trajectory buffer at position timecounter. The buffer is allocated once and reused by all trajectory segments and particles; it is doubled when a longer segment is met, so its size adapts to the longest segment. With out_filetemp, the record is written to the temporary file of the particle instead, in binary, and no buffer is allocated. */
+{
+    struct tempout *rec;
+    
+    if (tfile == 1) {
+        rec = &temprec;
+    } else if (timecounter >= tempsize) {
+        unsigned int newsize = 2 * tempsize;
+        
+        if (newsize < 1024) {
+            newsize = 1024;
         }
-    } else {
-        timecounter = 0;
-        free(tempdata);
+        
+        while (newsize <= timecounter) {
+            newsize = 2 * newsize;
+        }
+        
+        tempdata = (struct tempout*) realloc (tempdata, newsize * sizeof(struct tempout));
+        
+        if (tempdata == NULL) {
+            printf("Allocation memory problem - tempdata\n");
+            printf("timecounter %d time %d capacity %d\n", timecounter, tcurrent, newsize);
+            exit(1);
+        }
+        
+        tempsize = newsize;
+    }
+    
+    if (tfile == 0) {
+        rec = &tempdata[timecounter];
+    }
+    
+    rec->times = tcurrent;
+    rec->position2d[0] = particle[np].position[0];
+    rec->position2d[1] = particle[np].position[1];
+    rec->position3d[0] = posit3[0];
+    rec->position3d[1] = posit3[1];
+    rec->position3d[2] = posit3[2];
+    rec->velocity3d[0] = veloc3[0];
+    rec->velocity3d[1] = veloc3[1];
+    rec->velocity3d[2] = veloc3[2];
+    rec->cellp = particle[np].cell;
+    rec->fracturep = particle[np].fracture;
+    rec->timep = particle[np].time;
+    rec->betap = beta;
+    rec->length_t = totallength;
+    rec->pressure = particle[np].pressure;
+    
+    if (tfile == 1) {
+        fseek(tmp, (long) timecounter * sizeof(struct tempout), SEEK_SET);
+        fwrite(rec, sizeof(struct tempout), 1, tmp);
     }
     
     return;
 }
+//////////////////////////////////////////////////////////////////////////////
+struct tempout *TempRecord(int tfind, int tfirst, int nrec)
+/*! Function returns the record of time step tfind from the first nrec records of trajectory buffer. Records are saved at every time step starting from tfirst, so the record is accessed directly; if tfind is out of range, the last record is returned. */
+{
+    int k;
+    k = tfind - tfirst;
+    
+    if ((k < 0) || (k >= nrec)) {
+        k = nrec - 1;
+    }
+    
+    return ReadTempData(k);
+}
+//////////////////////////////////////////////////////////////////////////////
+struct tempout *ReadTempData(int k)
+/*! Function returns record k of the current trajectory segment, from the memory buffer or, with out_filetemp, read from the temporary file of the particle. A record read from file is valid until the next call. */
+{
+    if (tfile == 1) {
+        fseek(tmp, (long) k * sizeof(struct tempout), SEEK_SET);
+        
+        if (fread(&temprec, sizeof(struct tempout), 1, tmp) != 1) {
+            printf("Reading problem - tempdata record %d\n", k);
+            exit(1);
+        }
+        
+        return &temprec;
+    }
+    
+    return &tempdata[k];
+}
 /////////////////////////////////////////////////////////////////////////////
 void FinalPosition()
 /*! Function calculates particles final position at out-flow boundary */
@@ -63,28 +63,28 @@ flow fluxes on each edge of control volume cells. Velocity on each control volum
                 if (node[i].fracture[0] == node[node[i].indnodes[fract_j1[j]] - 1].fracture[0]) {
                     if (pflotran == 1) {
                         length = sqrt(pow(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[0], 2) + pow(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[1], 2));
-                        normxarea11[j][0] = -1.0 * (node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[0]) * (node[i].area[j] / (length));
-                        normxarea11[j][1] = -1.0 * (node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[1]) * (node[i].area[j] / (length));
+                        normxarea11[j][0] = -1.0 * (node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[0]) * (nodedata[i].area[j] / (length));
+                        normxarea11[j][1] = -1.0 * (node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[1]) * (nodedata[i].area[j] / (length));
                     }
                     
                     if (fehm == 1) {
                         length = sqrt(pow(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[0], 2) + pow(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[1], 2));
-                        normxarea11[j][0] = -1.0 * (node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[0]) * (node[i].area[j]);
-                        normxarea11[j][1] = -1.0 * (node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[1]) * (node[i].area[j]);
+                        normxarea11[j][0] = -1.0 * (node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[0]) * (nodedata[i].area[j]);
+                        normxarea11[j][1] = -1.0 * (node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[1]) * (nodedata[i].area[j]);
                     }
                 }
                 
                 if (node[i].fracture[0] == node[node[i].indnodes[fract_j1[j]] - 1].fracture[1]) {
                     if (pflotran == 1) {
                         length = sqrt(pow(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[3], 2) + pow(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[4], 2));
-                        normxarea11[j][0] = -1.0 * (node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[3]) * (node[i].area[j] / (length));
-                        normxarea11[j][1] = -1.0 * (node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[4]) * (node[i].area[j] / (length));
+                        normxarea11[j][0] = -1.0 * (node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[3]) * (nodedata[i].area[j] / (length));
+                        normxarea11[j][1] = -1.0 * (node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[4]) * (nodedata[i].area[j] / (length));
                     }
                     
                     if (fehm == 1) {
                         length = sqrt(pow(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[3], 2) + pow(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[4], 2));
-                        normxarea11[j][0] = -1.0 * (node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[3]) * (node[i].area[j]);
-                        normxarea11[j][1] = -1.0 * (node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[4]) * (node[i].area[j]);
+                        normxarea11[j][0] = -1.0 * (node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[3]) * (nodedata[i].area[j]);
+                        normxarea11[j][1] = -1.0 * (node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[4]) * (nodedata[i].area[j]);
                     }
                 }
             }
@@ -128,28 +128,28 @@ flow fluxes on each edge of control volume cells. Velocity on each control volum
                 if (node[i].fracture[0] == node[node[i].indnodes[j] - 1].fracture[0]) {
                     if (pflotran == 1) {
                         length = sqrt(pow(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[0], 2) + pow(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[1], 2));
-                        normxarea11[j][0] = -1.*(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[0]) * (node[i].area[j] / (length));
-                        normxarea11[j][1] = -1.*(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[1]) * (node[i].area[j] / (length));
+                        normxarea11[j][0] = -1.*(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[0]) * (nodedata[i].area[j] / (length));
+                        normxarea11[j][1] = -1.*(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[1]) * (nodedata[i].area[j] / (length));
                     }
                     
                     if (fehm == 1) {
                         length = sqrt(pow(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[0], 2) + pow(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[1], 2));
-                        normxarea11[j][0] = -1.*(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[0]) * (node[i].area[j]);
-                        normxarea11[j][1] = -1.*(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[1]) * (node[i].area[j]);
+                        normxarea11[j][0] = -1.*(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[0]) * (nodedata[i].area[j]);
+                        normxarea11[j][1] = -1.*(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[1]) * (nodedata[i].area[j]);
                     }
                 }
                 
                 if (node[i].fracture[0] == node[node[i].indnodes[j] - 1].fracture[1]) {
                     if (pflotran == 1) {
                         length = sqrt(pow(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[3], 2) + pow(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[4], 2));
-                        normxarea11[j][0] = -1.*(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[3]) * (node[i].area[j] / (length));
-                        normxarea11[j][1] = -1.*(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[4]) * (node[i].area[j] / (length));
+                        normxarea11[j][0] = -1.*(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[3]) * (nodedata[i].area[j] / (length));
+                        normxarea11[j][1] = -1.*(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[4]) * (nodedata[i].area[j] / (length));
                     }
                     
                     if (fehm == 1) {
                         length = sqrt(pow(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[3], 2) + pow(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[4], 2));
-                        normxarea11[j][0] = -1.*(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[3]) * (node[i].area[j]);
-                        normxarea11[j][1] = -1.*(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[4]) * (node[i].area[j]);
+                        normxarea11[j][0] = -1.*(node[i].coord_xy[0] - node[node[i].indnodes[j] - 1].coord_xy[3]) * (nodedata[i].area[j]);
+                        normxarea11[j][1] = -1.*(node[i].coord_xy[1] - node[node[i].indnodes[j] - 1].coord_xy[4]) * (nodedata[i].area[j]);
                     }
                 }
             }
@@ -376,8 +376,8 @@ void VelocityInteriorNode (double normx_area[][2], int i, int number, unsigned i
         qhat[m] = 0;
         
         for (j = 0; j < number; j++) {
-            qhat[m] = qhat[m] + matrices.matrinvG[m][j] * node[i].flux[indj[j]];
-            massbalance = massbalance + node[i].flux[indj[j]];
+            qhat[m] = qhat[m] + matrices.matrinvG[m][j] * nodedata[i].flux[indj[j]];
+            massbalance = massbalance + nodedata[i].flux[indj[j]];
         }
         
         // velocity is Darcy's velocity qhat / density * porosity and converted to required time units
@@ -411,8 +411,8 @@ void VelocityExteriorNode (double norm_xarea[][2], int i, int number, unsigned i
         qhat[m] = 0;
         
         for (j = 0; j < number; j++) {
-            qhat[m] = qhat[m] + matrices.matrinvG[m][j] * node[i].flux[indj[j]];
-            massbalance = massbalance + node[i].flux[indj[j]];
+            qhat[m] = qhat[m] + matrices.matrinvG[m][j] * nodedata[i].flux[indj[j]];
+            massbalance = massbalance + nodedata[i].flux[indj[j]];
         }
         
         Bmatr[m] = lbound.norm[m] * lbound.length_b;
@@ -872,13 +872,13 @@ void HalfPolygonVelocity(int i, int k, int fractn, int indc, unsigned int fractj
             subcell1f[sc1f - 1] = fractj[j];
             
             if (fehm == 1) {
-                normxarea21[sc1f - 1][0] = -1.*(bx * node[i].area[fractj[j]]);
-                normxarea21[sc1f - 1][1] = -1.*(by * node[i].area[fractj[j]]);
+                normxarea21[sc1f - 1][0] = -1.*(bx * nodedata[i].area[fractj[j]]);
+                normxarea21[sc1f - 1][1] = -1.*(by * nodedata[i].area[fractj[j]]);
             }
             
             if (pflotran == 1) {
-                normxarea21[sc1f - 1][0] = -1.*(bx * node[i].area[fractj[j]] / (length));
-                normxarea21[sc1f - 1][1] = -1.*(by * node[i].area[fractj[j]] / (length));
+                normxarea21[sc1f - 1][0] = -1.*(bx * nodedata[i].area[fractj[j]] / (length));
+                normxarea21[sc1f - 1][1] = -1.*(by * nodedata[i].area[fractj[j]] / (length));
             }
             
             if ((node[i].type[fractj[j]] != 2) && (node[i].type[fractj[j]] != 12)) {
@@ -904,13 +904,13 @@ void HalfPolygonVelocity(int i, int k, int fractn, int indc, unsigned int fractj
             subcell2f[sc2f - 1] = fractj[j];
             
             if (fehm == 1) {
-                normxarea22[sc2f - 1][0] = -1.*(bx * node[i].area[fractj[j]]);
-                normxarea22[sc2f - 1][1] = -1.*(by * node[i].area[fractj[j]]);
+                normxarea22[sc2f - 1][0] = -1.*(bx * nodedata[i].area[fractj[j]]);
+                normxarea22[sc2f - 1][1] = -1.*(by * nodedata[i].area[fractj[j]]);
             }
             
             if (pflotran == 1) {
-                normxarea22[sc2f - 1][0] = -1.*(bx * node[i].area[fractj[j]] / (length));
-                normxarea22[sc2f - 1][1] = -1.*(by * node[i].area[fractj[j]] / (length));
+                normxarea22[sc2f - 1][0] = -1.*(bx * nodedata[i].area[fractj[j]] / (length));
+                normxarea22[sc2f - 1][1] = -1.*(by * nodedata[i].area[fractj[j]] / (length));
             }
             
             if ((node[i].type[fractj[j]] != 2) && (node[i].type[fractj[j]] != 12)) {
@@ -23,6 +23,7 @@
 /* particle - particle's data structure */
 /* cell - cell's data structure */
 /* pflotran and fehm are flags on which flow solver is used*/
+/* chunkpart - number of particles kept in memory when particles are seeded in chunks */
 
 unsigned int pflotran;
 unsigned int fehm;
@@ -36,8 +37,10 @@ unsigned int nzone_in;
 unsigned int *nodezonein;
 unsigned int *nodezoneout;
 unsigned int flag_w;
+unsigned int chunkpart;
 struct material *fracture;
 struct vertex *node;
+struct vertexdata *nodedata;
 struct contam *particle;
 struct element *cell;
 char maindir[125];
@@ -193,13 +196,20 @@ int main (int argc, char* controlf[]) {
     if(res == 0) {
         WritingInit();
     }
+    
+    /*** data used in velocity reconstruction only are not needed anymore ***/
+    FreeNodeData();
     printf("\n** Velocity reconstruction - done\n");
  
     printf("\n------------------PARTICLE TRACKING---------------------------\n");
+    /*** grid of cells on every fracture for a fast point location ******/
+    BuildCellGrid();
     ParticleTrack ();
+    FreeCellGrid();
     /****   free memory that was allocated for data structures *****/
     free(fracture);
     free(node);
+    free(nodedata);
     free(cell);
     free(nodezonein);
     free(nodezoneout);
@@ -146,6 +146,52 @@ def check_domain(params):
         local_print_log(params['boundaryFaces']['description'])
         hf.print_error("")
 
+def check_ecpm(params):
+    """ Check the ECPM upscaling parameters, used when ecpmOutput is on.
+    * ecpmCellSize, positive, must evenly divide each entry of domainSize
+    * ecpmAperture, positive
+    * ecpmMatrixPorosity, between 0 and 1
+    * ecpmMatrixPerm, non-negative
+
+    Parameters
+    -------------
+        params : dict
+            parameter dictionary
+    Returns
+    ---------
+        None
+
+    Notes
+    ---------
+        Exits program is inconsistencies are found.
+    """
+    for key in [
+            'ecpmCellSize', 'ecpmAperture', 'ecpmMatrixPorosity',
+            'ecpmMatrixPerm'
+    ]:
+        if params[key]['value'] is None:
+            hf.print_error(f"\"{key}\" must be provided when ecpmOutput is on.")
+
+    if params['ecpmAperture']['value'] <= 0:
+        hf.print_error(
+            f"\"ecpmAperture\" has value {params['ecpmAperture']['value']}. Value must be positive"
+        )
+    hf.check_values('ecpmMatrixPorosity',
+                    params['ecpmMatrixPorosity']['value'], 0, 1)
+    hf.check_values('ecpmMatrixPerm', params['ecpmMatrixPerm']['value'], 0)
+
+    cell_size = params['ecpmCellSize']['value']
+    if cell_size <= 0:
+        hf.print_error(
+            f"\"ecpmCellSize\" has value {cell_size}. Value must be positive")
+    for i, val in enumerate(params['domainSize']['value']):
+        cells = round(val / cell_size)
+        if cells < 1 or abs(cells * cell_size - val) > 1e-8 * val:
+            hf.print_error(
+                f"\"ecpmCellSize\" {cell_size} does not evenly divide \"domainSize\" entry {i+1} ({val})"
+            )
+
+
 def check_rejects_per_fracture(rejectsPerFracture):
     """ Check that the value of the rejectsPerFracture is a positive integer. If a value of 0 is provided, it's changed to 1. 
 
@@ -671,6 +717,8 @@ def check_general(params):
     check_rejects_per_fracture(params['rejectsPerFracture'])
     check_seed(params['seed'])
     check_fram(params)
+    if params['ecpmOutput']['value']:
+        check_ecpm(params)
     # check_aperture(params)
     # check_permeability(params)
 
@@ -347,6 +347,56 @@ def load_parameters(self):
             'description':
             'See dfnGen documenation https://dfnworks.lanl.gov/dfngen.html for more details'
         },
+        'ecpmCellSize': {
+            'type':
+            float,
+            'list':
+            False,
+            'value':
+            None,
+            'description':
+            'Edge length of the ECPM grid cells, must evenly divide domainSize. Required if ecpmOutput is on'
+        },
+        'ecpmAperture': {
+            'type':
+            float,
+            'list':
+            False,
+            'value':
+            None,
+            'description':
+            'Aperture of all fractures in the ECPM upscaling, permeability is b^2/12. Required if ecpmOutput is on'
+        },
+        'ecpmMatrixPorosity': {
+            'type':
+            float,
+            'list':
+            False,
+            'value':
+            None,
+            'description':
+            'Porosity of the ECPM cells without fractures. Required if ecpmOutput is on'
+        },
+        'ecpmMatrixPerm': {
+            'type':
+            float,
+            'list':
+            False,
+            'value':
+            None,
+            'description':
+            'Permeability of the ECPM matrix. Required if ecpmOutput is on'
+        },
+        'ecpmCorrectionFactor': {
+            'type':
+            bool,
+            'list':
+            False,
+            'value':
+            True,
+            'description':
+            'Apply the stair step correction factor to the ECPM anisotropic permeability'
+        },
         # Fracture Families
         'famProb': {
             'type':
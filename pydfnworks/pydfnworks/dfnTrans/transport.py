@@ -175,6 +175,7 @@ def check_dfn_trans_run_files(self):
         "in_partn:": None,
         "init_well:": None,
         "init_nodepart:": None,
+        "init_chunk:": None,
         "in_xmin:": None,
         "in_xmax:": None,
         "in_ymin:": None,